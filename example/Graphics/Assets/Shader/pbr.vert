@@ -1,25 +1,18 @@
 #version 450
 
-layout(push_constant) uniform PushConstants {
-    mat4 modelMatrix;
-} pushConstants;
+// Model matrices of every draw this frame, instanced draws start at their batch's first slot
+layout(std430, set = 0, binding = 2) readonly buffer InstanceData {
+    mat4 modelMatrices[];
+} instanceData;
 
 layout(std140, set = 0, binding = 0) uniform GlobalUniform {
     mat4 viewProjectionMatrix;
     vec3 cameraPosition;
     int numDirectionalLights;
-    int numPointLights;
-    int numSpotLights;
     vec4 dirLightDirections[4];
     vec4 dirLightColors[4];
-    vec4 pointLightPositions[8];
-    vec4 pointLightColors[8];
-    vec4 pointLightAttenuations[8];
-    vec4 spotLightPositions[4];
-    vec4 spotLightDirections[4];
-    vec4 spotLightColors[4];
-    vec4 spotLightAttenuations[4];
-    vec4 spotLightCutoffs[4];
+    vec4 cameraForward;  // xyz = camera view direction
+    vec4 clusterParams;  // x = depth slice scale, y = depth slice bias
     mat4 cascadeViewProjMatrices[4];
     float cascadeSplitDistances[4];
     vec4 ambientColor;
@@ -37,11 +30,12 @@ layout(location = 2) out vec2 fragUV;
 layout(location = 3) out mat3 fragTBN;
 
 void main() {
-    vec4 worldPos = pushConstants.modelMatrix * vec4(inPosition, 1.0);
+    mat4 modelMatrix = instanceData.modelMatrices[gl_InstanceIndex];
+    vec4 worldPos = modelMatrix * vec4(inPosition, 1.0);
     fragWorldPos = worldPos.xyz;
     
     // Transform normal to world space (using transpose of inverse of model matrix for non-uniform scaling)
-    mat3 normalMatrix = transpose(inverse(mat3(pushConstants.modelMatrix)));
+    mat3 normalMatrix = transpose(inverse(mat3(modelMatrix)));
     fragNormal = normalize(normalMatrix * inNormal);
     
     // Compute TBN matrix for normal mapping
@@ -1,38 +1,60 @@
 #version 450
+#extension GL_ARB_shader_viewport_layer_array : require
 
 layout(push_constant) uniform PushConstants {
-    mat4 modelMatrix;
-    uint cascadeIndex;
+    uint firstInstance; // instance buffer slot of the batch's first caster
+    uint cascadeMask;   // bit i set when the batch casts into cascade i, one instance per caster and set bit
+    uint cascadeStride; // gpu culled draws only, the instances of cascade i start at firstInstance + i * cascadeStride
 } pushConstants;
 
 layout(std140, set = 0, binding = 0) uniform GlobalUniform {
     mat4 viewProjectionMatrix;
     vec3 cameraPosition;
     int numDirectionalLights;
-    int numPointLights;
-    int numSpotLights;
     vec4 dirLightDirections[4];
     vec4 dirLightColors[4];
-    vec4 pointLightPositions[8];
-    vec4 pointLightColors[8];
-    vec4 pointLightAttenuations[8];
-    vec4 spotLightPositions[4];
-    vec4 spotLightDirections[4];
-    vec4 spotLightColors[4];
-    vec4 spotLightAttenuations[4];
-    vec4 spotLightCutoffs[4];
+    vec4 cameraForward;  // xyz = camera view direction
+    vec4 clusterParams;  // x = depth slice scale, y = depth slice bias
     mat4 cascadeViewProjMatrices[4];
     float cascadeSplitDistances[4];
     vec4 ambientColor;
     vec4 shadowBiasParams; // x = constant bias, y = slope scale factor, z = normal offset distance, w = unused
 } globalUniform;
 
+layout(std430, set = 0, binding = 2) readonly buffer InstanceData {
+    mat4 modelMatrices[];
+} instanceData;
+
 layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec3 inNormal;
 layout(location = 2) in vec2 inUV;
 layout(location = 3) in vec3 inTangent;
 
+// Cascade of the n-th set bit of the mask
+uint instanceCascade(uint mask, uint n) {
+    for (uint i = 0u; i < n; i++)
+        mask &= mask - 1u;
+    return uint(findLSB(mask));
+}
+
 void main() {
-    vec4 worldPos = pushConstants.modelMatrix * vec4(inPosition, 1.0);
-    gl_Position = globalUniform.cascadeViewProjMatrices[pushConstants.cascadeIndex] * worldPos;
+    uint instanceSlot;
+    uint cascadeIndex;
+    if (pushConstants.cascadeStride != 0u) {
+        // Each cascade's survivors are compacted into a range of their own, the
+        // indirect command's firstInstance already points at the right one
+        instanceSlot = uint(gl_InstanceIndex);
+        cascadeIndex = (instanceSlot - pushConstants.firstInstance) / pushConstants.cascadeStride;
+    } else {
+        // Instances are laid out caster major, one per cascade the batch falls into
+        uint cascadeCount = uint(bitCount(pushConstants.cascadeMask));
+        uint caster = uint(gl_InstanceIndex) / cascadeCount;
+        instanceSlot = pushConstants.firstInstance + caster;
+        cascadeIndex = instanceCascade(pushConstants.cascadeMask, uint(gl_InstanceIndex) % cascadeCount);
+    }
+
+    mat4 modelMatrix = instanceData.modelMatrices[instanceSlot];
+    vec4 worldPos = modelMatrix * vec4(inPosition, 1.0);
+    gl_Position = globalUniform.cascadeViewProjMatrices[cascadeIndex] * worldPos;
+    gl_Layer = int(cascadeIndex);
 }
@@ -4,18 +4,10 @@ layout(std140, set = 0, binding = 0) uniform GlobalUniform {
     mat4 viewProjectionMatrix;
     vec3 cameraPosition;
     int numDirectionalLights;
-    int numPointLights;
-    int numSpotLights;
     vec4 dirLightDirections[4];
     vec4 dirLightColors[4];
-    vec4 pointLightPositions[8];
-    vec4 pointLightColors[8];
-    vec4 pointLightAttenuations[8];
-    vec4 spotLightPositions[4];
-    vec4 spotLightDirections[4];
-    vec4 spotLightColors[4];
-    vec4 spotLightAttenuations[4];
-    vec4 spotLightCutoffs[4];
+    vec4 cameraForward;  // xyz = camera view direction
+    vec4 clusterParams;  // x = depth slice scale, y = depth slice bias
     mat4 cascadeViewProjMatrices[4];
     float cascadeSplitDistances[4];
     vec4 ambientColor;
@@ -34,17 +26,37 @@ layout(set = 1, binding = 0) uniform MaterialProperty {
 layout(set = 1, binding = 1) uniform sampler2D albedoTexture;
 layout(set = 1, binding = 2) uniform sampler2D normalTexture;
 
-// CSM shadow maps
-layout(set = 0, binding = 1) uniform sampler2D shadowMap0;
-layout(set = 0, binding = 2) uniform sampler2D shadowMap1;
-layout(set = 0, binding = 3) uniform sampler2D shadowMap2;
-layout(set = 0, binding = 4) uniform sampler2D shadowMap3;
+// CSM shadow maps - one array layer per cascade
+layout(set = 0, binding = 1) uniform sampler2DArray shadowMap;
 
 // IBL textures
 layout(set = 0, binding = 5) uniform samplerCube irradianceMap;
 layout(set = 0, binding = 6) uniform samplerCube prefilteredMap;
 layout(set = 0, binding = 7) uniform sampler2D brdfLUT;
 
+// Clustered point and spot lights, the grid must match LightClusterGrid
+const uint CLUSTER_GRID_X = 16u;
+const uint CLUSTER_GRID_Y = 9u;
+const uint CLUSTER_GRID_Z = 24u;
+const uint CLUSTER_COUNT = CLUSTER_GRID_X * CLUSTER_GRID_Y * CLUSTER_GRID_Z;
+
+struct LocalLight {
+    vec4 positionRange;       // xyz = position, w = range
+    vec4 colorIntensity;      // xyz = color, w = intensity
+    vec4 directionCosInner;   // xyz = spot direction, w = cos(inner)
+    vec4 attenuationCosOuter; // xyz = constant, linear, quadratic, w = cos(outer)
+};
+
+layout(std430, set = 0, binding = 3) readonly buffer LocalLightData {
+    LocalLight localLights[];
+} localLightData;
+
+// Offset and count of every cluster's lights in lightIndices
+layout(std430, set = 0, binding = 4) readonly buffer LightClusterData {
+    uvec2 clusterRanges[CLUSTER_COUNT];
+    uint lightIndices[];
+} lightClusterData;
+
 layout(location = 0) in vec3 fragWorldPos;
 layout(location = 1) in vec3 fragNormal;
 layout(location = 2) in vec2 fragUV;
@@ -107,14 +119,14 @@ int selectCascade(float viewDepth) {
     return 3;
 }
 
-float sampleShadowMap(sampler2D shadowMap, vec2 uv, float compareDepth, float bias) {
+float sampleShadowMap(int cascadeIndex, vec2 uv, float compareDepth, float bias) {
     if (uv.x < 0.0 || uv.x > 1.0 || uv.y < 0.0 || uv.y > 1.0)
         return 1.0;
     float shadow = 0.0;
-    vec2 texelSize = 1.0 / textureSize(shadowMap, 0);
+    vec2 texelSize = 1.0 / vec2(textureSize(shadowMap, 0).xy);
     for (int x = -1; x <= 1; x++) {
         for (int y = -1; y <= 1; y++) {
-            float depth = texture(shadowMap, uv + vec2(x, y) * texelSize).r;
+            float depth = texture(shadowMap, vec3(uv + vec2(x, y) * texelSize, float(cascadeIndex))).r;
             shadow += (compareDepth - bias > depth) ? 0.0 : 1.0;
         }
     }
@@ -132,10 +144,54 @@ float calculateShadow(vec3 worldPos, vec3 viewPos, vec3 N, vec3 L) {
     float currentDepth = projCoords.z;
     float cosTheta = max(dot(N, L), 0.0);
     float bias = globalUniform.shadowBiasParams.x + globalUniform.shadowBiasParams.y * (1.0 - cosTheta);
-    if (cascadeIndex == 0)      return sampleShadowMap(shadowMap0, projCoords.xy, currentDepth, bias);
-    else if (cascadeIndex == 1) return sampleShadowMap(shadowMap1, projCoords.xy, currentDepth, bias);
-    else if (cascadeIndex == 2) return sampleShadowMap(shadowMap2, projCoords.xy, currentDepth, bias);
-    else                        return sampleShadowMap(shadowMap3, projCoords.xy, currentDepth, bias);
+    return sampleShadowMap(cascadeIndex, projCoords.xy, currentDepth, bias);
+}
+
+// Cluster of a world position, same screen tiles and depth slices as LightClusterGrid
+uint getClusterIndex(vec3 worldPos) {
+    vec4 clipPos = globalUniform.viewProjectionMatrix * vec4(worldPos, 1.0);
+    vec2 ndc = clamp(clipPos.xy / clipPos.w, -1.0, 1.0);
+    uvec2 tile = min(uvec2((ndc * 0.5 + 0.5) * vec2(CLUSTER_GRID_X, CLUSTER_GRID_Y)),
+                     uvec2(CLUSTER_GRID_X - 1u, CLUSTER_GRID_Y - 1u));
+
+    float viewDepth = dot(worldPos - globalUniform.cameraPosition, globalUniform.cameraForward.xyz);
+    float slice = log(max(viewDepth, 1e-4)) * globalUniform.clusterParams.x + globalUniform.clusterParams.y;
+    uint sliceIndex = min(uint(max(slice, 0.0)), CLUSTER_GRID_Z - 1u);
+
+    return (sliceIndex * CLUSTER_GRID_Y + tile.y) * CLUSTER_GRID_X + tile.x;
+}
+
+// Point and spot lights assigned to the position's cluster
+vec3 calculateLocalLights(vec3 worldPos, vec3 N, vec3 V, vec3 albedo, float metallic, float roughness, vec3 F0) {
+    vec3 Lo = vec3(0.0);
+    uvec2 cluster = lightClusterData.clusterRanges[getClusterIndex(worldPos)];
+    for (uint i = 0u; i < cluster.y; i++) {
+        LocalLight light = localLightData.localLights[lightClusterData.lightIndices[cluster.x + i]];
+        vec3  toLight = light.positionRange.xyz - worldPos;
+        float dist    = length(toLight);
+        float range   = light.positionRange.w;
+        if (dist >= range) {
+            continue;
+        }
+        vec3 L = toLight / max(dist, 1e-4);
+
+        // Spot cone, point lights use cos(inner) = -1 and cos(outer) = -2 so every direction is inside
+        float theta = dot(L, -light.directionCosInner.xyz);
+        float inner = light.directionCosInner.w;
+        float outer = light.attenuationCosOuter.w;
+        float spotIntensity = clamp((theta - outer) / (inner - outer), 0.0, 1.0);
+
+        // Attenuation, faded out toward the range the light was culled with
+        vec3  k = light.attenuationCosOuter.xyz;
+        float attenuation = 1.0 / (k.x + k.y * dist + k.z * dist * dist);
+        float fade = clamp(1.0 - pow(dist / range, 4.0), 0.0, 1.0);
+        attenuation *= fade * fade;
+
+        vec3  lightColor = light.colorIntensity.rgb;
+        float intensity  = light.colorIntensity.w;
+        Lo += calculateLight(N, V, L, lightColor, intensity * attenuation * spotIntensity, albedo, metallic, roughness, F0);
+    }
+    return Lo;
 }
 
 void main() {
@@ -168,36 +224,8 @@ void main() {
         Lo += calculateLight(N, V, L, lightColor, intensity, albedo, metallic, roughness, F0) * shadow;
     }
 
-    for (int i = 0; i < globalUniform.numPointLights; i++) {
-        vec3  lightPos = globalUniform.pointLightPositions[i].xyz;
-        vec3  L        = normalize(lightPos - fragWorldPos);
-        float dist     = length(lightPos - fragWorldPos);
-        float c = globalUniform.pointLightAttenuations[i].x;
-        float l = globalUniform.pointLightAttenuations[i].y;
-        float q = globalUniform.pointLightAttenuations[i].z;
-        float attenuation = 1.0 / (c + l * dist + q * dist * dist);
-        vec3  lightColor  = globalUniform.pointLightColors[i].rgb;
-        float intensity   = globalUniform.pointLightColors[i].w;
-        Lo += calculateLight(N, V, L, lightColor, intensity * attenuation, albedo, metallic, roughness, F0);
-    }
-
-    for (int i = 0; i < globalUniform.numSpotLights; i++) {
-        vec3  lightPos  = globalUniform.spotLightPositions[i].xyz;
-        vec3  L         = normalize(lightPos - fragWorldPos);
-        float dist      = length(lightPos - fragWorldPos);
-        vec3  spotDir   = normalize(globalUniform.spotLightDirections[i].xyz);
-        float theta     = dot(L, -spotDir);
-        float inner     = globalUniform.spotLightCutoffs[i].x;
-        float outer     = globalUniform.spotLightCutoffs[i].y;
-        float spotIntensity = clamp((theta - outer) / (inner - outer), 0.0, 1.0);
-        float c = globalUniform.spotLightAttenuations[i].x;
-        float l = globalUniform.spotLightAttenuations[i].y;
-        float q = globalUniform.spotLightAttenuations[i].z;
-        float attenuation = 1.0 / (c + l * dist + q * dist * dist);
-        vec3  lightColor  = globalUniform.spotLightColors[i].rgb;
-        float intensity   = globalUniform.spotLightColors[i].w;
-        Lo += calculateLight(N, V, L, lightColor, intensity * attenuation * spotIntensity, albedo, metallic, roughness, F0);
-    }
+    // Point and spot lights of this pixel's cluster
+    Lo += calculateLocalLights(fragWorldPos, N, V, albedo, metallic, roughness, F0);
 
     float NdotV = max(dot(N, V), 0.0);
     vec3 F_ibl = fresnelSchlickRoughness(NdotV, F0, roughness);
@@ -1,8 +1,9 @@
 #version 450
 
-layout(push_constant) uniform PushConstants {
-    mat4 modelMatrix;
-} pushConstants;
+// Model matrices of every draw this frame, instanced draws start at their batch's first slot
+layout(std430, set = 0, binding = 2) readonly buffer InstanceData {
+    mat4 modelMatrices[];
+} instanceData;
 
 layout(std140, set = 0, binding = 0) uniform GlobalUniform {
     mat4 viewProjectionMatrix;
@@ -16,6 +17,7 @@ layout(location = 2) in vec2 uv;
 layout(location = 0) out vec2 outUV;
 
 void main() {
-    gl_Position = globalUniform.viewProjectionMatrix * pushConstants.modelMatrix * vec4(inPosition, 1.0);
+    mat4 modelMatrix = instanceData.modelMatrices[gl_InstanceIndex];
+    gl_Position = globalUniform.viewProjectionMatrix * modelMatrix * vec4(inPosition, 1.0);
     outUV = uv;
 }
\ No newline at end of file
@@ -17,7 +17,7 @@ from tools.miscs import log
 def compile_to_spv(src_path: str, dst_path: str, glslc_path: str) -> None:
     for root, dirs, files in os.walk(src_path):
         for file in files:
-            if file.endswith(".vert") or file.endswith(".frag"):
+            if file.endswith(".vert") or file.endswith(".frag") or file.endswith(".comp"):
                 src_file = os.path.join(root, file)
                 relative_path = os.path.relpath(root, src_path)
                 dst_dir = dst_path if relative_path == '.' else os.path.join(dst_path, relative_path)
@@ -54,7 +54,7 @@ def parse_args(argv: Sequence[str] | None = None) -> argparse.Namespace:
     parser.add_argument(
         "--src_directory",
         required=True,
-        help="Directory containing source shader files (.vert/.frag)."
+        help="Directory containing source shader files (.vert/.frag/.comp)."
     )
     parser.add_argument(
         "--dst_directory", 
@@ -6,6 +6,7 @@
 #include <memory>
 
 #include "Ailurus/Systems/TimeSystem/TimeSystem.h"
+#include "Ailurus/Systems/JobSystem/JobSystem.h"
 #include "Ailurus/Systems/InputSystem/InputSystem.h"
 #include "Ailurus/Systems/RenderSystem/RenderSystem.h"
 #include "Ailurus/Systems/SceneSystem/SceneSystem.h"
@@ -188,6 +189,7 @@ namespace Ailurus
 
         // System
         static std::unique_ptr<TimeSystem> _pTimeSystem;
+        static std::unique_ptr<JobSystem> _pJobSystem;
         static std::unique_ptr<InputSystem> _pInputManager;
         static std::unique_ptr<RenderSystem> _pRenderSystem;
     	static std::unique_ptr<AssetsSystem> _pAssetsSystem;
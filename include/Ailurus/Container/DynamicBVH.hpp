@@ -0,0 +1,467 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "Ailurus/Math/AABB.hpp"
+#include "Ailurus/Math/Frustum.hpp"
+
+namespace Ailurus
+{
+    /**
+     * @brief A dynamic bounding volume hierarchy over AABBs
+     *
+     * Leaves store a fattened copy of the inserted box, so small movements only need a
+     * containment check instead of a tree update. Internal nodes are kept balanced with
+     * AVL-style rotations and new leaves are placed with a surface area heuristic, the
+     * same scheme as Box2D's b2DynamicTree, extended to 3D.
+     *
+     * Queries walk the tree with an explicit stack and reject whole subtrees whose box is
+     * outside the query volume. For frustum queries, a subtree fully inside the frustum is
+     * reported without testing any of its children.
+     *
+     * Reported leaves are conservative: their fat box overlaps the query volume, callers
+     * that need exact results should test their own tight box.
+     *
+     * Not thread safe for writes; concurrent const queries are fine.
+     */
+    class DynamicBVH
+    {
+    public:
+        static constexpr int32_t NULL_NODE = -1;
+
+        /**
+         * @param margin Distance each leaf box is enlarged by on every side
+         */
+        explicit DynamicBVH(float margin = 0.1f)
+            : _margin(margin)
+        {
+        }
+
+    public:
+        /**
+         * @brief Insert a leaf, returns the node id used by the other functions
+         */
+        int32_t Insert(const AABBf& aabb, uint32_t userData)
+        {
+            const int32_t nodeId = AllocateNode();
+            _nodes[nodeId].aabb = Fatten(aabb);
+            _nodes[nodeId].userData = userData;
+            _nodes[nodeId].height = 0;
+
+            InsertLeaf(nodeId);
+            _leafCount++;
+            return nodeId;
+        }
+
+        void Remove(int32_t nodeId)
+        {
+            RemoveLeaf(nodeId);
+            FreeNode(nodeId);
+            _leafCount--;
+        }
+
+        /**
+         * @brief Update the box of a leaf
+         *
+         * @return true if the leaf was reinserted, false if the fat box still contains it
+         */
+        bool Move(int32_t nodeId, const AABBf& aabb)
+        {
+            if (_nodes[nodeId].aabb.Contains(aabb))
+                return false;
+
+            RemoveLeaf(nodeId);
+            _nodes[nodeId].aabb = Fatten(aabb);
+            InsertLeaf(nodeId);
+            return true;
+        }
+
+        uint32_t GetUserData(int32_t nodeId) const
+        {
+            return _nodes[nodeId].userData;
+        }
+
+        void SetUserData(int32_t nodeId, uint32_t userData)
+        {
+            _nodes[nodeId].userData = userData;
+        }
+
+        const AABBf& GetFatAABB(int32_t nodeId) const
+        {
+            return _nodes[nodeId].aabb;
+        }
+
+        uint32_t GetLeafCount() const
+        {
+            return _leafCount;
+        }
+
+        int32_t GetHeight() const
+        {
+            return _root == NULL_NODE ? 0 : _nodes[_root].height;
+        }
+
+        /**
+         * @brief Call func(userData) for each leaf whose fat box overlaps the frustum
+         */
+        template<typename Func>
+        void Query(const Frustum& frustum, Func&& func) const
+        {
+            if (_root == NULL_NODE)
+                return;
+
+            struct StackEntry
+            {
+                int32_t nodeId;
+                bool inside;
+            };
+
+            StackEntry stack[MAX_QUERY_STACK];
+            int32_t stackSize = 0;
+            stack[stackSize++] = { _root, false };
+
+            while (stackSize > 0)
+            {
+                const StackEntry entry = stack[--stackSize];
+
+                const Node& node = _nodes[entry.nodeId];
+                bool inside = entry.inside;
+                if (!inside)
+                {
+                    const FrustumContainment containment = frustum.Classify(node.aabb);
+                    if (containment == FrustumContainment::Outside)
+                        continue;
+
+                    inside = containment == FrustumContainment::Inside;
+                }
+
+                if (node.IsLeaf())
+                {
+                    func(node.userData);
+                    continue;
+                }
+
+                stack[stackSize++] = { node.child1, inside };
+                stack[stackSize++] = { node.child2, inside };
+            }
+        }
+
+        /**
+         * @brief Call func(userData) for each leaf whose fat box overlaps the given box
+         */
+        template<typename Func>
+        void Query(const AABBf& aabb, Func&& func) const
+        {
+            if (_root == NULL_NODE)
+                return;
+
+            int32_t stack[MAX_QUERY_STACK];
+            int32_t stackSize = 0;
+            stack[stackSize++] = _root;
+
+            while (stackSize > 0)
+            {
+                const Node& node = _nodes[stack[--stackSize]];
+
+                if (!node.aabb.Intersects(aabb))
+                    continue;
+
+                if (node.IsLeaf())
+                {
+                    func(node.userData);
+                    continue;
+                }
+
+                stack[stackSize++] = node.child1;
+                stack[stackSize++] = node.child2;
+            }
+        }
+
+    private:
+        /**
+         * Popping a node and pushing its two children keeps at most height + 1 entries on
+         * the query stack. The AVL balance bounds the height by about 1.44 log2(leafCount),
+         * so 64 entries cover any tree that fits in memory and queries never allocate.
+         */
+        static constexpr int32_t MAX_QUERY_STACK = 64;
+
+        struct Node
+        {
+            AABBf aabb;
+
+            // Next free node while in the free list
+            int32_t parent = NULL_NODE;
+            int32_t child1 = NULL_NODE;
+            int32_t child2 = NULL_NODE;
+
+            // Leaf is 0, free node is -1
+            int32_t height = -1;
+            uint32_t userData = 0;
+
+            bool IsLeaf() const
+            {
+                return child1 == NULL_NODE;
+            }
+        };
+
+        AABBf Fatten(const AABBf& aabb) const
+        {
+            const Vector3f margin(_margin, _margin, _margin);
+            return { aabb.min - margin, aabb.max + margin };
+        }
+
+        int32_t AllocateNode()
+        {
+            int32_t nodeId;
+            if (_freeList != NULL_NODE)
+            {
+                nodeId = _freeList;
+                _freeList = _nodes[nodeId].parent;
+            }
+            else
+            {
+                nodeId = static_cast<int32_t>(_nodes.size());
+                _nodes.emplace_back();
+            }
+
+            _nodes[nodeId] = Node{};
+            return nodeId;
+        }
+
+        void FreeNode(int32_t nodeId)
+        {
+            _nodes[nodeId].parent = _freeList;
+            _nodes[nodeId].height = -1;
+            _freeList = nodeId;
+        }
+
+        void InsertLeaf(int32_t leaf)
+        {
+            if (_root == NULL_NODE)
+            {
+                _root = leaf;
+                _nodes[_root].parent = NULL_NODE;
+                return;
+            }
+
+            // Find the best sibling by surface area heuristic
+            const AABBf leafAABB = _nodes[leaf].aabb;
+            int32_t index = _root;
+            while (!_nodes[index].IsLeaf())
+            {
+                const int32_t child1 = _nodes[index].child1;
+                const int32_t child2 = _nodes[index].child2;
+
+                const float area = _nodes[index].aabb.GetSurfaceArea();
+                const float combinedArea = AABBf::Merge(_nodes[index].aabb, leafAABB).GetSurfaceArea();
+
+                // Cost of creating a new parent for this node and the new leaf
+                const float cost = 2.0f * combinedArea;
+
+                // Minimum cost of pushing the leaf further down the tree
+                const float inheritanceCost = 2.0f * (combinedArea - area);
+
+                const float cost1 = DescendCost(child1, leafAABB) + inheritanceCost;
+                const float cost2 = DescendCost(child2, leafAABB) + inheritanceCost;
+
+                if (cost < cost1 && cost < cost2)
+                    break;
+
+                index = cost1 < cost2 ? child1 : child2;
+            }
+
+            const int32_t sibling = index;
+            const int32_t oldParent = _nodes[sibling].parent;
+            const int32_t newParent = AllocateNode();
+            _nodes[newParent].parent = oldParent;
+            _nodes[newParent].aabb = AABBf::Merge(leafAABB, _nodes[sibling].aabb);
+            _nodes[newParent].height = _nodes[sibling].height + 1;
+
+            if (oldParent != NULL_NODE)
+            {
+                if (_nodes[oldParent].child1 == sibling)
+                    _nodes[oldParent].child1 = newParent;
+                else
+                    _nodes[oldParent].child2 = newParent;
+            }
+            else
+                _root = newParent;
+
+            _nodes[newParent].child1 = sibling;
+            _nodes[newParent].child2 = leaf;
+            _nodes[sibling].parent = newParent;
+            _nodes[leaf].parent = newParent;
+
+            RefitAncestors(_nodes[leaf].parent);
+        }
+
+        void RemoveLeaf(int32_t leaf)
+        {
+            if (leaf == _root)
+            {
+                _root = NULL_NODE;
+                return;
+            }
+
+            const int32_t parent = _nodes[leaf].parent;
+            const int32_t grandParent = _nodes[parent].parent;
+            const int32_t sibling = _nodes[parent].child1 == leaf ? _nodes[parent].child2 : _nodes[parent].child1;
+
+            if (grandParent != NULL_NODE)
+            {
+                if (_nodes[grandParent].child1 == parent)
+                    _nodes[grandParent].child1 = sibling;
+                else
+                    _nodes[grandParent].child2 = sibling;
+
+                _nodes[sibling].parent = grandParent;
+                FreeNode(parent);
+                RefitAncestors(grandParent);
+            }
+            else
+            {
+                _root = sibling;
+                _nodes[sibling].parent = NULL_NODE;
+                FreeNode(parent);
+            }
+        }
+
+        float DescendCost(int32_t child, const AABBf& leafAABB) const
+        {
+            const float mergedArea = AABBf::Merge(leafAABB, _nodes[child].aabb).GetSurfaceArea();
+            if (_nodes[child].IsLeaf())
+                return mergedArea;
+
+            return mergedArea - _nodes[child].aabb.GetSurfaceArea();
+        }
+
+        void RefitAncestors(int32_t index)
+        {
+            while (index != NULL_NODE)
+            {
+                index = Balance(index);
+
+                Node& node = _nodes[index];
+                node.height = 1 + std::max(_nodes[node.child1].height, _nodes[node.child2].height);
+                node.aabb = AABBf::Merge(_nodes[node.child1].aabb, _nodes[node.child2].aabb);
+
+                index = node.parent;
+            }
+        }
+
+        /**
+         * @brief Rotate the taller child up if the subtree is imbalanced, returns the new subtree root
+         */
+        int32_t Balance(int32_t iA)
+        {
+            Node* A = &_nodes[iA];
+            if (A->IsLeaf() || A->height < 2)
+                return iA;
+
+            const int32_t iB = A->child1;
+            const int32_t iC = A->child2;
+            Node* B = &_nodes[iB];
+            Node* C = &_nodes[iC];
+
+            const int32_t balance = C->height - B->height;
+
+            // Rotate C up
+            if (balance > 1)
+            {
+                const int32_t iF = C->child1;
+                const int32_t iG = C->child2;
+                Node* F = &_nodes[iF];
+                Node* G = &_nodes[iG];
+
+                C->child1 = iA;
+                C->parent = A->parent;
+                A->parent = iC;
+                ReplaceChild(C->parent, iA, iC);
+
+                if (F->height > G->height)
+                {
+                    C->child2 = iF;
+                    A->child2 = iG;
+                    G->parent = iA;
+                    A->aabb = AABBf::Merge(B->aabb, G->aabb);
+                    C->aabb = AABBf::Merge(A->aabb, F->aabb);
+                    A->height = 1 + std::max(B->height, G->height);
+                    C->height = 1 + std::max(A->height, F->height);
+                }
+                else
+                {
+                    C->child2 = iG;
+                    A->child2 = iF;
+                    F->parent = iA;
+                    A->aabb = AABBf::Merge(B->aabb, F->aabb);
+                    C->aabb = AABBf::Merge(A->aabb, G->aabb);
+                    A->height = 1 + std::max(B->height, F->height);
+                    C->height = 1 + std::max(A->height, G->height);
+                }
+
+                return iC;
+            }
+
+            // Rotate B up
+            if (balance < -1)
+            {
+                const int32_t iD = B->child1;
+                const int32_t iE = B->child2;
+                Node* D = &_nodes[iD];
+                Node* E = &_nodes[iE];
+
+                B->child1 = iA;
+                B->parent = A->parent;
+                A->parent = iB;
+                ReplaceChild(B->parent, iA, iB);
+
+                if (D->height > E->height)
+                {
+                    B->child2 = iD;
+                    A->child1 = iE;
+                    E->parent = iA;
+                    A->aabb = AABBf::Merge(C->aabb, E->aabb);
+                    B->aabb = AABBf::Merge(A->aabb, D->aabb);
+                    A->height = 1 + std::max(C->height, E->height);
+                    B->height = 1 + std::max(A->height, D->height);
+                }
+                else
+                {
+                    B->child2 = iE;
+                    A->child1 = iD;
+                    D->parent = iA;
+                    A->aabb = AABBf::Merge(C->aabb, D->aabb);
+                    B->aabb = AABBf::Merge(A->aabb, E->aabb);
+                    A->height = 1 + std::max(C->height, D->height);
+                    B->height = 1 + std::max(A->height, E->height);
+                }
+
+                return iB;
+            }
+
+            return iA;
+        }
+
+        void ReplaceChild(int32_t parent, int32_t oldChild, int32_t newChild)
+        {
+            if (parent == NULL_NODE)
+            {
+                _root = newChild;
+                return;
+            }
+
+            if (_nodes[parent].child1 == oldChild)
+                _nodes[parent].child1 = newChild;
+            else
+                _nodes[parent].child2 = newChild;
+        }
+
+    private:
+        std::vector<Node> _nodes;
+        int32_t _root = NULL_NODE;
+        int32_t _freeList = NULL_NODE;
+        uint32_t _leafCount = 0;
+        float _margin;
+    };
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <iterator>
+#include <map>
+
+namespace Ailurus
+{
+    /**
+     * @brief First fit sub-allocator over a linear range of elements
+     *
+     * Only bookkeeping, the memory itself lives elsewhere (typically one large GPU buffer).
+     * Free ranges are kept sorted by offset so a freed range is merged with its neighbours
+     * right away and the range never fragments into adjacent free pieces.
+     *
+     * Offsets and sizes are in caller defined units (vertices, indices, bytes).
+     */
+    class RangeAllocator
+    {
+    public:
+        static constexpr uint32_t INVALID_OFFSET = UINT32_MAX;
+
+        explicit RangeAllocator(uint32_t capacity = 0)
+        {
+            Grow(capacity);
+        }
+
+    public:
+        /**
+         * @brief Allocate a range of size elements, returns INVALID_OFFSET when no free range fits
+         */
+        uint32_t Allocate(uint32_t size)
+        {
+            if (size == 0)
+                return INVALID_OFFSET;
+
+            for (auto itr = _freeRanges.begin(); itr != _freeRanges.end(); ++itr)
+            {
+                if (itr->second < size)
+                    continue;
+
+                const uint32_t offset = itr->first;
+                const uint32_t remaining = itr->second - size;
+                _freeRanges.erase(itr);
+                if (remaining > 0)
+                    _freeRanges.emplace(offset + size, remaining);
+
+                _usedSize += size;
+                return offset;
+            }
+
+            return INVALID_OFFSET;
+        }
+
+        /**
+         * @brief Return a range previously handed out by Allocate
+         */
+        void Free(uint32_t offset, uint32_t size)
+        {
+            if (offset == INVALID_OFFSET || size == 0)
+                return;
+
+            _usedSize -= size;
+
+            auto next = _freeRanges.lower_bound(offset);
+
+            // Merge with the free range right before
+            if (next != _freeRanges.begin())
+            {
+                auto prev = std::prev(next);
+                if (prev->first + prev->second == offset)
+                {
+                    offset = prev->first;
+                    size += prev->second;
+                    _freeRanges.erase(prev);
+                }
+            }
+
+            // Merge with the free range right after
+            if (next != _freeRanges.end() && offset + size == next->first)
+            {
+                size += next->second;
+                _freeRanges.erase(next);
+            }
+
+            _freeRanges.emplace(offset, size);
+        }
+
+        /**
+         * @brief Extend the range at its end, existing allocations keep their offsets
+         */
+        void Grow(uint32_t newCapacity)
+        {
+            if (newCapacity <= _capacity)
+                return;
+
+            const uint32_t oldCapacity = _capacity;
+            _capacity = newCapacity;
+
+            // Route through Free so a free tail is merged with the new space
+            _usedSize += newCapacity - oldCapacity;
+            Free(oldCapacity, newCapacity - oldCapacity);
+        }
+
+        uint32_t GetCapacity() const { return _capacity; }
+        uint32_t GetUsedSize() const { return _usedSize; }
+        size_t GetFreeRangeCount() const { return _freeRanges.size(); }
+
+    private:
+        uint32_t _capacity = 0;
+        uint32_t _usedSize = 0;
+        std::map<uint32_t, uint32_t> _freeRanges; // offset -> size
+    };
+} // namespace Ailurus
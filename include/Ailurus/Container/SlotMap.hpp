@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace Ailurus
+{
+    /**
+     * @brief Reference to a slot map element, stale once the element is removed
+     *
+     * The generation of a slot is bumped every time its element is removed, so a handle
+     * kept past the removal no longer matches even after the slot is reused.
+     */
+    struct SlotMapHandle
+    {
+        static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+        uint32_t index = INVALID_INDEX;
+        uint32_t generation = 0;
+
+        bool IsValid() const { return index != INVALID_INDEX; }
+
+        bool operator==(const SlotMapHandle& other) const = default;
+    };
+
+    /**
+     * @brief Vector of elements addressed through generational handles
+     *
+     * Removed slots go on a free list and are reused by later inserts, insert, remove and
+     * lookup are O(1) and never move other elements. Generations start at 1 so a default
+     * constructed handle never resolves.
+     */
+    template<typename T>
+    class SlotMap
+    {
+    public:
+        /**
+         * @brief Store value in a free slot, or a new one when none is free
+         */
+        SlotMapHandle Insert(T value)
+        {
+            uint32_t index;
+            if (!_freeSlots.empty())
+            {
+                index = _freeSlots.back();
+                _freeSlots.pop_back();
+            }
+            else
+            {
+                index = static_cast<uint32_t>(_slots.size());
+                _slots.emplace_back();
+            }
+
+            Slot& slot = _slots[index];
+            slot.value.emplace(std::move(value));
+            _size++;
+
+            return SlotMapHandle{ index, slot.generation };
+        }
+
+        /**
+         * @brief Destroy the element of handle, false when the handle is stale
+         */
+        bool Remove(SlotMapHandle handle)
+        {
+            if (!Contains(handle))
+                return false;
+
+            Slot& slot = _slots[handle.index];
+            slot.value.reset();
+            slot.generation++;
+            _size--;
+
+            // A slot whose generation wrapped around could be hit by an old handle, retire it
+            if (slot.generation != 0)
+                _freeSlots.push_back(handle.index);
+
+            return true;
+        }
+
+        /**
+         * @brief Element of handle, nullptr when the handle is stale
+         */
+        T* Get(SlotMapHandle handle)
+        {
+            return Contains(handle) ? &*_slots[handle.index].value : nullptr;
+        }
+
+        const T* Get(SlotMapHandle handle) const
+        {
+            return Contains(handle) ? &*_slots[handle.index].value : nullptr;
+        }
+
+        bool Contains(SlotMapHandle handle) const
+        {
+            return handle.index < _slots.size()
+                && _slots[handle.index].generation == handle.generation
+                && _slots[handle.index].value.has_value();
+        }
+
+        /**
+         * @brief Destroy every element, handles handed out before all turn stale
+         */
+        void Clear()
+        {
+            for (uint32_t i = 0; i < _slots.size(); i++)
+            {
+                if (_slots[i].value.has_value())
+                    Remove(SlotMapHandle{ i, _slots[i].generation });
+            }
+        }
+
+        size_t Size() const { return _size; }
+        size_t GetSlotCount() const { return _slots.size(); }
+        size_t GetFreeSlotCount() const { return _freeSlots.size(); }
+
+    private:
+        struct Slot
+        {
+            std::optional<T> value;
+            uint32_t generation = 1;
+        };
+
+        std::vector<Slot> _slots;
+        std::vector<uint32_t> _freeSlots;
+        size_t _size = 0;
+    };
+} // namespace Ailurus
@@ -0,0 +1,332 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace Ailurus
+{
+    /**
+     * @brief Two-level segregated fit sub-allocator over a linear range
+     *
+     * Only bookkeeping like RangeAllocator, but for many allocations of mixed sizes: free blocks
+     * are kept in lists by size class, a first level per power of two and a second level of
+     * SL_COUNT linear steps inside it, with a bitmap per level. Finding a block and freeing one
+     * are constant time, where first fit walks every free range.
+     *
+     * Block metadata lives in a node array beside the range, the range itself is never touched,
+     * so it can describe memory the CPU cannot address. Free blocks are merged with their
+     * physical neighbours right away. Offsets and sizes are bytes.
+     */
+    class TlsfRangeAllocator
+    {
+    public:
+        static constexpr uint32_t INVALID_NODE = UINT32_MAX;
+
+        struct Allocation
+        {
+            uint64_t offset = 0;
+            uint32_t node = INVALID_NODE; // Handle to give back to Free
+        };
+
+        explicit TlsfRangeAllocator(uint64_t capacity)
+            : _capacity(capacity)
+        {
+            _flBitmap = 0;
+            _slBitmaps.fill(0);
+            for (auto& heads : _freeHeads)
+                heads.fill(INVALID_NODE);
+
+            if (capacity == 0)
+                return;
+
+            const uint32_t node = NewNode();
+            _nodes[node].offset = 0;
+            _nodes[node].size = capacity;
+            InsertFree(node);
+        }
+
+    public:
+        /**
+         * @brief Allocate size bytes at an offset aligned to alignment, a power of two. The node is
+         * INVALID_NODE when no free block fits.
+         */
+        Allocation Allocate(uint64_t size, uint64_t alignment = 1)
+        {
+            if (size == 0 || size > _capacity)
+                return {};
+
+            if (alignment == 0)
+                alignment = 1;
+
+            // A block of the size class fits unless alignment padding pushes it over, then look for
+            // one that fits with any padding
+            uint32_t node = FindFree(size);
+            if (node != INVALID_NODE && AlignUp(_nodes[node].offset, alignment) + size > _nodes[node].offset + _nodes[node].size)
+                node = FindFree(size + alignment - 1);
+
+            if (node == INVALID_NODE)
+                return {};
+
+            RemoveFree(node);
+
+            // Padding in front becomes a free block of its own, the block before is in use
+            const uint64_t padding = AlignUp(_nodes[node].offset, alignment) - _nodes[node].offset;
+            if (padding > 0)
+            {
+                const uint32_t front = SplitFront(node, padding);
+                InsertFree(front);
+            }
+
+            // So does the remainder behind
+            if (_nodes[node].size > size)
+            {
+                const uint32_t back = SplitBack(node, size);
+                InsertFree(back);
+            }
+
+            _nodes[node].free = false;
+            _usedSize += size;
+            _allocationCount++;
+
+            return Allocation{ _nodes[node].offset, node };
+        }
+
+        /**
+         * @brief Return a block previously handed out by Allocate
+         */
+        void Free(uint32_t node)
+        {
+            if (node >= _nodes.size() || _nodes[node].free)
+                return;
+
+            _nodes[node].free = true;
+            _usedSize -= _nodes[node].size;
+            _allocationCount--;
+
+            // Merge with the physical neighbours, free blocks are never adjacent
+            const uint32_t prev = _nodes[node].prevPhysical;
+            if (prev != INVALID_NODE && _nodes[prev].free)
+            {
+                RemoveFree(prev);
+                Merge(prev, node);
+                node = prev;
+            }
+
+            const uint32_t next = _nodes[node].nextPhysical;
+            if (next != INVALID_NODE && _nodes[next].free)
+            {
+                RemoveFree(next);
+                Merge(node, next);
+            }
+
+            InsertFree(node);
+        }
+
+        uint64_t GetCapacity() const { return _capacity; }
+        uint64_t GetUsedSize() const { return _usedSize; }
+        uint32_t GetAllocationCount() const { return _allocationCount; }
+        bool IsEmpty() const { return _allocationCount == 0; }
+
+        size_t GetFreeBlockCount() const
+        {
+            size_t count = 0;
+            for (const auto& node : _nodes)
+            {
+                if (node.free && node.size > 0)
+                    count++;
+            }
+
+            return count;
+        }
+
+    private:
+        static constexpr uint32_t SL_BITS = 4;
+        static constexpr uint32_t SL_COUNT = 1u << SL_BITS;
+        static constexpr uint32_t FL_COUNT = 64 - SL_BITS + 1;
+
+        struct Node
+        {
+            uint64_t offset = 0;
+            uint64_t size = 0;
+            uint32_t prevPhysical = INVALID_NODE;
+            uint32_t nextPhysical = INVALID_NODE;
+            uint32_t prevFree = INVALID_NODE;
+            uint32_t nextFree = INVALID_NODE;
+            bool free = true;
+        };
+
+        static uint64_t AlignUp(uint64_t value, uint64_t alignment)
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        // Sizes below SL_COUNT share the first level linearly, above it the first level is the
+        // most significant bit and the second level the SL_BITS bits below it
+        static void MappingInsert(uint64_t size, uint32_t& fl, uint32_t& sl)
+        {
+            if (size < SL_COUNT)
+            {
+                fl = 0;
+                sl = static_cast<uint32_t>(size);
+                return;
+            }
+
+            const uint32_t msb = 63 - static_cast<uint32_t>(std::countl_zero(size));
+            fl = msb - SL_BITS + 1;
+            sl = static_cast<uint32_t>(size >> (msb - SL_BITS)) ^ SL_COUNT;
+        }
+
+        uint32_t FindFree(uint64_t size) const
+        {
+            // Round up to the next size class, every block listed there is large enough
+            if (size >= SL_COUNT)
+            {
+                const uint32_t msb = 63 - static_cast<uint32_t>(std::countl_zero(size));
+                size += (uint64_t{ 1 } << (msb - SL_BITS)) - 1;
+            }
+
+            uint32_t fl, sl;
+            MappingInsert(size, fl, sl);
+            if (fl >= FL_COUNT)
+                return INVALID_NODE;
+
+            uint32_t slMap = _slBitmaps[fl] & (~0u << sl);
+            if (slMap == 0)
+            {
+                const uint64_t flMap = fl + 1 < 64 ? _flBitmap & (~uint64_t{ 0 } << (fl + 1)) : 0;
+                if (flMap == 0)
+                    return INVALID_NODE;
+
+                fl = static_cast<uint32_t>(std::countr_zero(flMap));
+                slMap = _slBitmaps[fl];
+            }
+
+            sl = static_cast<uint32_t>(std::countr_zero(slMap));
+            return _freeHeads[fl][sl];
+        }
+
+        void InsertFree(uint32_t node)
+        {
+            uint32_t fl, sl;
+            MappingInsert(_nodes[node].size, fl, sl);
+
+            const uint32_t head = _freeHeads[fl][sl];
+            _nodes[node].free = true;
+            _nodes[node].prevFree = INVALID_NODE;
+            _nodes[node].nextFree = head;
+            if (head != INVALID_NODE)
+                _nodes[head].prevFree = node;
+
+            _freeHeads[fl][sl] = node;
+            _flBitmap |= uint64_t{ 1 } << fl;
+            _slBitmaps[fl] |= 1u << sl;
+        }
+
+        void RemoveFree(uint32_t node)
+        {
+            uint32_t fl, sl;
+            MappingInsert(_nodes[node].size, fl, sl);
+
+            const uint32_t prev = _nodes[node].prevFree;
+            const uint32_t next = _nodes[node].nextFree;
+            if (prev != INVALID_NODE)
+                _nodes[prev].nextFree = next;
+            if (next != INVALID_NODE)
+                _nodes[next].prevFree = prev;
+
+            if (_freeHeads[fl][sl] == node)
+            {
+                _freeHeads[fl][sl] = next;
+                if (next == INVALID_NODE)
+                {
+                    _slBitmaps[fl] &= ~(1u << sl);
+                    if (_slBitmaps[fl] == 0)
+                        _flBitmap &= ~(uint64_t{ 1 } << fl);
+                }
+            }
+
+            _nodes[node].prevFree = INVALID_NODE;
+            _nodes[node].nextFree = INVALID_NODE;
+        }
+
+        // Cut size bytes off the front of node into a new node placed before it
+        uint32_t SplitFront(uint32_t node, uint64_t size)
+        {
+            const uint32_t front = NewNode();
+            Node& target = _nodes[node];
+            Node& created = _nodes[front];
+
+            created.offset = target.offset;
+            created.size = size;
+            created.prevPhysical = target.prevPhysical;
+            created.nextPhysical = node;
+            if (target.prevPhysical != INVALID_NODE)
+                _nodes[target.prevPhysical].nextPhysical = front;
+
+            target.prevPhysical = front;
+            target.offset += size;
+            target.size -= size;
+            return front;
+        }
+
+        // Keep size bytes in node, the rest goes to a new node placed after it
+        uint32_t SplitBack(uint32_t node, uint64_t size)
+        {
+            const uint32_t back = NewNode();
+            Node& target = _nodes[node];
+            Node& created = _nodes[back];
+
+            created.offset = target.offset + size;
+            created.size = target.size - size;
+            created.prevPhysical = node;
+            created.nextPhysical = target.nextPhysical;
+            if (target.nextPhysical != INVALID_NODE)
+                _nodes[target.nextPhysical].prevPhysical = back;
+
+            target.nextPhysical = back;
+            target.size = size;
+            return back;
+        }
+
+        // Fold next, physically right after node, into node
+        void Merge(uint32_t node, uint32_t next)
+        {
+            _nodes[node].size += _nodes[next].size;
+            _nodes[node].nextPhysical = _nodes[next].nextPhysical;
+            if (_nodes[next].nextPhysical != INVALID_NODE)
+                _nodes[_nodes[next].nextPhysical].prevPhysical = node;
+
+            // An unused node reads as an empty free block
+            _nodes[next] = Node{};
+            _unusedNodes.push_back(next);
+        }
+
+        uint32_t NewNode()
+        {
+            if (!_unusedNodes.empty())
+            {
+                const uint32_t node = _unusedNodes.back();
+                _unusedNodes.pop_back();
+                _nodes[node] = Node{};
+                return node;
+            }
+
+            _nodes.emplace_back();
+            return static_cast<uint32_t>(_nodes.size() - 1);
+        }
+
+    private:
+        uint64_t _capacity = 0;
+        uint64_t _usedSize = 0;
+        uint32_t _allocationCount = 0;
+
+        std::vector<Node> _nodes;
+        std::vector<uint32_t> _unusedNodes;
+
+        uint64_t _flBitmap = 0;
+        std::array<uint32_t, FL_COUNT> _slBitmaps;
+        std::array<std::array<uint32_t, SL_COUNT>, FL_COUNT> _freeHeads;
+    };
+} // namespace Ailurus
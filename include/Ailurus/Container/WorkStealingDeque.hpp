@@ -0,0 +1,146 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+
+namespace Ailurus
+{
+    /**
+     * @brief A bounded single-owner work-stealing deque (Chase-Lev)
+     *
+     * The owner thread pushes and pops at the bottom (LIFO, hot in cache), while any
+     * number of thief threads steal from the top (FIFO, oldest work first). Only the
+     * race for the last remaining element is resolved with a CAS on the top index.
+     *
+     * Memory orderings follow Lê et al., "Correct and Efficient Work-Stealing for
+     * Weak Memory Models" (PPoPP 2013).
+     *
+     * The capacity is fixed and rounded up to a power of 2; Push returns false when
+     * the deque is full so the caller can fall back to another queue or run inline.
+     *
+     * @tparam T Element type, must be trivially copyable (typically a pointer)
+     * @tparam WantedSize Desired capacity, rounded up to the nearest power of 2
+     */
+    template<typename T, uint32_t WantedSize, uint32_t CACHE_LINE_SIZE = 64>
+    class WorkStealingDeque
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque requires a trivially copyable element type");
+
+        static constexpr uint32_t UpAlignmentPowerOfTwo(uint32_t value)
+        {
+            if (value <= 4)
+                return 4;
+
+            value--;
+            value |= value >> 1;
+            value |= value >> 2;
+            value |= value >> 4;
+            value |= value >> 8;
+            value |= value >> 16;
+
+            return value + 1;
+        }
+
+        static constexpr int64_t Size = UpAlignmentPowerOfTwo(WantedSize);
+
+    public:
+        constexpr uint32_t GetSize() const
+        {
+            return static_cast<uint32_t>(Size);
+        }
+
+        /**
+         * @brief Snapshot check, may be stale as soon as it returns
+         */
+        bool Empty() const
+        {
+            int64_t bottom = _bottom.load(std::memory_order_relaxed);
+            int64_t top = _top.load(std::memory_order_relaxed);
+            return bottom <= top;
+        }
+
+        /**
+         * @brief Push an element at the bottom. Owner thread only.
+         *
+         * @return false if the deque is full
+         */
+        bool Push(T value)
+        {
+            int64_t bottom = _bottom.load(std::memory_order_relaxed);
+            int64_t top = _top.load(std::memory_order_acquire);
+            if (bottom - top >= Size)
+                return false;
+
+            _data[bottom & (Size - 1)].store(value, std::memory_order_relaxed);
+
+            // Publish the element before the new bottom becomes visible to thieves
+            std::atomic_thread_fence(std::memory_order_release);
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        /**
+         * @brief Pop the most recently pushed element. Owner thread only.
+         */
+        std::optional<T> Pop()
+        {
+            int64_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+            _bottom.store(bottom, std::memory_order_relaxed);
+
+            // The reservation of bottom must be ordered before reading top
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t top = _top.load(std::memory_order_relaxed);
+
+            if (top > bottom)
+            {
+                // Empty, restore bottom
+                _bottom.store(bottom + 1, std::memory_order_relaxed);
+                return std::nullopt;
+            }
+
+            T value = _data[bottom & (Size - 1)].load(std::memory_order_relaxed);
+            if (top != bottom)
+                return value;
+
+            // Last element, race against thieves
+            bool won = _top.compare_exchange_strong(top, top + 1,
+                std::memory_order_seq_cst, std::memory_order_relaxed);
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+
+            if (!won)
+                return std::nullopt;
+
+            return value;
+        }
+
+        /**
+         * @brief Steal the oldest element. Safe to call from any thread.
+         *
+         * A failed CAS against another thief or the owner returns std::nullopt,
+         * callers are expected to retry or move on to another victim.
+         */
+        std::optional<T> Steal()
+        {
+            int64_t top = _top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t bottom = _bottom.load(std::memory_order_acquire);
+
+            if (top >= bottom)
+                return std::nullopt;
+
+            T value = _data[top & (Size - 1)].load(std::memory_order_relaxed);
+            if (!_top.compare_exchange_strong(top, top + 1,
+                std::memory_order_seq_cst, std::memory_order_relaxed))
+                return std::nullopt;
+
+            return value;
+        }
+
+    private:
+        alignas(CACHE_LINE_SIZE) std::atomic<int64_t> _top = 0;
+        alignas(CACHE_LINE_SIZE) std::atomic<int64_t> _bottom = 0;
+        alignas(CACHE_LINE_SIZE) std::atomic<T> _data[Size] = {};
+    };
+}
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cfloat>
+#include <cmath>
+#include <cstddef>
 #include "Vector3.hpp"
 #include "Vector4.hpp"
 #include "Matrix4x4.hpp"
@@ -28,32 +30,46 @@ namespace Ailurus
 		Vector3<T> GetCenter() const { return (min + max) * T(0.5); }
 		Vector3<T> GetExtents() const { return (max - min) * T(0.5); }
 
-		AABB Transform(const Matrix4x4<T>& matrix) const
+		T GetSurfaceArea() const
 		{
-			// Transform all 8 corners and recompute min/max
-			Vector3<T> corners[8] = {
-				{ min.x, min.y, min.z },
-				{ max.x, min.y, min.z },
-				{ min.x, max.y, min.z },
-				{ max.x, max.y, min.z },
-				{ min.x, min.y, max.z },
-				{ max.x, min.y, max.z },
-				{ min.x, max.y, max.z },
-				{ max.x, max.y, max.z },
-			};
+			const Vector3<T> size = max - min;
+			return T(2) * (size.x * size.y + size.y * size.z + size.z * size.x);
+		}
+
+		bool Contains(const AABB& other) const
+		{
+			return min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z
+				&& other.max.x <= max.x && other.max.y <= max.y && other.max.z <= max.z;
+		}
 
-			Vector3<T> newMin(std::numeric_limits<T>::max(), std::numeric_limits<T>::max(), std::numeric_limits<T>::max());
-			Vector3<T> newMax(std::numeric_limits<T>::lowest(), std::numeric_limits<T>::lowest(), std::numeric_limits<T>::lowest());
+		bool Intersects(const AABB& other) const
+		{
+			return min.x <= other.max.x && other.min.x <= max.x
+				&& min.y <= other.max.y && other.min.y <= max.y
+				&& min.z <= other.max.z && other.min.z <= max.z;
+		}
+
+		// Transform by an affine matrix (last row 0 0 0 1) in center-extent form: the new
+		// center is the transformed center, and each new half extent is the old extents
+		// projected onto the absolute matrix row. Gives the same box as transforming all
+		// 8 corners at a fraction of the cost.
+		AABB Transform(const Matrix4x4<T>& matrix) const
+		{
+			const Vector3<T> center = GetCenter();
+			const Vector3<T> extents = GetExtents();
 
-			for (const auto& corner : corners)
+			Vector3<T> newCenter(matrix(0, 3), matrix(1, 3), matrix(2, 3));
+			Vector3<T> newExtents(T(0), T(0), T(0));
+			for (std::size_t row = 0; row < 3; row++)
 			{
-				Vector4<T> transformed = matrix * Vector4<T>(corner.x, corner.y, corner.z, T(1));
-				Vector3<T> pos(transformed.x, transformed.y, transformed.z);
-				newMin = Vector3<T>::Min(newMin, pos);
-				newMax = Vector3<T>::Max(newMax, pos);
+				for (std::size_t col = 0; col < 3; col++)
+				{
+					newCenter[row] += matrix(row, col) * center[col];
+					newExtents[row] += std::abs(matrix(row, col)) * extents[col];
+				}
 			}
 
-			return { newMin, newMax };
+			return { newCenter - newExtents, newCenter + newExtents };
 		}
 
 		static AABB Merge(const AABB& a, const AABB& b)
@@ -17,6 +17,13 @@ namespace Ailurus
 		}
 	};
 
+	enum class FrustumContainment
+	{
+		Outside,
+		Intersecting,
+		Inside
+	};
+
 	struct Frustum
 	{
 		// Near, Far, Left, Right, Top, Bottom
@@ -71,5 +78,30 @@ namespace Ailurus
 			}
 			return true;
 		}
+
+		// Like Intersects, but also reports boxes fully inside, so hierarchical queries can
+		// accept a whole subtree without testing its children
+		FrustumContainment Classify(const AABBf& aabb) const
+		{
+			FrustumContainment result = FrustumContainment::Inside;
+			for (const auto& plane : planes)
+			{
+				Vector3f pVertex;
+				pVertex.x = (plane.normal.x >= 0.0f) ? aabb.max.x : aabb.min.x;
+				pVertex.y = (plane.normal.y >= 0.0f) ? aabb.max.y : aabb.min.y;
+				pVertex.z = (plane.normal.z >= 0.0f) ? aabb.max.z : aabb.min.z;
+				if (plane.SignedDistance(pVertex) < 0.0f)
+					return FrustumContainment::Outside;
+
+				// The n-vertex is the corner least in the direction of the normal
+				Vector3f nVertex;
+				nVertex.x = (plane.normal.x >= 0.0f) ? aabb.min.x : aabb.max.x;
+				nVertex.y = (plane.normal.y >= 0.0f) ? aabb.min.y : aabb.max.y;
+				nVertex.z = (plane.normal.z >= 0.0f) ? aabb.min.z : aabb.max.z;
+				if (plane.SignedDistance(nVertex) < 0.0f)
+					result = FrustumContainment::Intersecting;
+			}
+			return result;
+		}
 	};
 } // namespace Ailurus
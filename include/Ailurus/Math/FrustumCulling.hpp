@@ -0,0 +1,277 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+#include "AABB.hpp"
+#include "Frustum.hpp"
+
+#if defined(__AVX__)
+#	define AILURUS_FRUSTUM_CULLING_AVX 1
+#	include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define AILURUS_FRUSTUM_CULLING_SSE 1
+#	include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#	define AILURUS_FRUSTUM_CULLING_NEON 1
+#	include <arm_neon.h>
+#endif
+
+namespace Ailurus
+{
+	/// Bounding boxes stored as structure of arrays in center/extent form, the layout
+	/// consumed by the batch culling kernels. Arrays are padded to BATCH_SIZE so the
+	/// kernels never need a scalar tail.
+	class BoundingBoxArray
+	{
+	public:
+		static constexpr uint32_t BATCH_SIZE = 8;
+
+		void Clear()
+		{
+			_size = 0;
+			for (auto* pArray : { &_centerX, &_centerY, &_centerZ, &_extentX, &_extentY, &_extentZ })
+				pArray->clear();
+		}
+
+		void Reserve(uint32_t count)
+		{
+			const uint32_t padded = PaddedSize(count);
+			for (auto* pArray : { &_centerX, &_centerY, &_centerZ, &_extentX, &_extentY, &_extentZ })
+				pArray->reserve(padded);
+		}
+
+		uint32_t Add(const AABBf& aabb)
+		{
+			const uint32_t index = _size++;
+			const uint32_t padded = PaddedSize(_size);
+			if (padded != _centerX.size())
+			{
+				for (auto* pArray : { &_centerX, &_centerY, &_centerZ, &_extentX, &_extentY, &_extentZ })
+					pArray->resize(padded, 0.0f);
+			}
+
+			Set(index, aabb);
+			return index;
+		}
+
+		void Set(uint32_t index, const AABBf& aabb)
+		{
+			const Vector3f center = aabb.GetCenter();
+			const Vector3f extents = aabb.GetExtents();
+			_centerX[index] = center.x;
+			_centerY[index] = center.y;
+			_centerZ[index] = center.z;
+			_extentX[index] = extents.x;
+			_extentY[index] = extents.y;
+			_extentZ[index] = extents.z;
+		}
+
+		AABBf Get(uint32_t index) const
+		{
+			const Vector3f center(_centerX[index], _centerY[index], _centerZ[index]);
+			const Vector3f extents(_extentX[index], _extentY[index], _extentZ[index]);
+			return { center - extents, center + extents };
+		}
+
+		uint32_t Size() const { return _size; }
+		uint32_t PaddedSize() const { return static_cast<uint32_t>(_centerX.size()); }
+
+		const float* CenterX() const { return _centerX.data(); }
+		const float* CenterY() const { return _centerY.data(); }
+		const float* CenterZ() const { return _centerZ.data(); }
+		const float* ExtentX() const { return _extentX.data(); }
+		const float* ExtentY() const { return _extentY.data(); }
+		const float* ExtentZ() const { return _extentZ.data(); }
+
+	private:
+		static uint32_t PaddedSize(uint32_t count)
+		{
+			return (count + BATCH_SIZE - 1) / BATCH_SIZE * BATCH_SIZE;
+		}
+
+	private:
+		uint32_t _size = 0;
+		std::vector<float> _centerX;
+		std::vector<float> _centerY;
+		std::vector<float> _centerZ;
+		std::vector<float> _extentX;
+		std::vector<float> _extentY;
+		std::vector<float> _extentZ;
+	};
+} // namespace Ailurus
+
+namespace Ailurus::Math
+{
+	/// Bit i of word i / 64 is set when box i is visible.
+	inline bool IsVisible(const std::vector<uint64_t>& visibilityMask, uint32_t index)
+	{
+		return (visibilityMask[index >> 6] >> (index & 63)) & 1;
+	}
+
+	/// Reference implementation, one box at a time. A box is outside when its projected
+	/// radius |n|.e cannot reach the positive side of some plane, which is the same test
+	/// as Frustum::Intersects with the p-vertex.
+	inline void CullBoundingBoxesScalar(const Frustum& frustum, const BoundingBoxArray& boxes, std::vector<uint64_t>& visibilityMask)
+	{
+		const uint32_t count = boxes.Size();
+		visibilityMask.assign((count + 63) / 64, 0);
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			bool visible = true;
+			for (const auto& plane : frustum.planes)
+			{
+				const float distance = plane.normal.x * boxes.CenterX()[i]
+					+ plane.normal.y * boxes.CenterY()[i]
+					+ plane.normal.z * boxes.CenterZ()[i]
+					+ plane.distance;
+				const float radius = std::abs(plane.normal.x) * boxes.ExtentX()[i]
+					+ std::abs(plane.normal.y) * boxes.ExtentY()[i]
+					+ std::abs(plane.normal.z) * boxes.ExtentZ()[i];
+
+				if (distance + radius < 0.0f)
+				{
+					visible = false;
+					break;
+				}
+			}
+
+			if (visible)
+				visibilityMask[i >> 6] |= uint64_t(1) << (i & 63);
+		}
+	}
+
+	/// Cull all boxes against the frustum with the widest SIMD instruction set available at
+	/// compile time (AVX 8 boxes, SSE2 / NEON 4 boxes per iteration), falls back to the scalar
+	/// path otherwise. Results match CullBoundingBoxesScalar.
+	inline void CullBoundingBoxes(const Frustum& frustum, const BoundingBoxArray& boxes, std::vector<uint64_t>& visibilityMask)
+	{
+#if defined(AILURUS_FRUSTUM_CULLING_AVX) || defined(AILURUS_FRUSTUM_CULLING_SSE) || defined(AILURUS_FRUSTUM_CULLING_NEON)
+		const uint32_t count = boxes.Size();
+		visibilityMask.assign((count + 63) / 64, 0);
+		if (count == 0)
+			return;
+
+		// Plane data splatted once, absolute normals give the projected box radius
+		float nx[6], ny[6], nz[6], ax[6], ay[6], az[6], d[6];
+		for (int p = 0; p < 6; p++)
+		{
+			const auto& plane = frustum.planes[p];
+			nx[p] = plane.normal.x;
+			ny[p] = plane.normal.y;
+			nz[p] = plane.normal.z;
+			ax[p] = std::abs(plane.normal.x);
+			ay[p] = std::abs(plane.normal.y);
+			az[p] = std::abs(plane.normal.z);
+			d[p] = plane.distance;
+		}
+
+		const float* cx = boxes.CenterX();
+		const float* cy = boxes.CenterY();
+		const float* cz = boxes.CenterZ();
+		const float* ex = boxes.ExtentX();
+		const float* ey = boxes.ExtentY();
+		const float* ez = boxes.ExtentZ();
+		const uint32_t paddedCount = boxes.PaddedSize();
+
+#	if defined(AILURUS_FRUSTUM_CULLING_AVX)
+		constexpr uint32_t LANES = 8;
+		const __m256 zero = _mm256_setzero_ps();
+		for (uint32_t i = 0; i < paddedCount; i += LANES)
+		{
+			const __m256 vcx = _mm256_loadu_ps(cx + i);
+			const __m256 vcy = _mm256_loadu_ps(cy + i);
+			const __m256 vcz = _mm256_loadu_ps(cz + i);
+			const __m256 vex = _mm256_loadu_ps(ex + i);
+			const __m256 vey = _mm256_loadu_ps(ey + i);
+			const __m256 vez = _mm256_loadu_ps(ez + i);
+
+			__m256 visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+			for (int p = 0; p < 6; p++)
+			{
+				__m256 distance = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(nx[p]), vcx), _mm256_set1_ps(d[p]));
+				distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(ny[p]), vcy));
+				distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(nz[p]), vcz));
+
+				__m256 radius = _mm256_mul_ps(_mm256_set1_ps(ax[p]), vex);
+				radius = _mm256_add_ps(radius, _mm256_mul_ps(_mm256_set1_ps(ay[p]), vey));
+				radius = _mm256_add_ps(radius, _mm256_mul_ps(_mm256_set1_ps(az[p]), vez));
+
+				visible = _mm256_and_ps(visible, _mm256_cmp_ps(_mm256_add_ps(distance, radius), zero, _CMP_GE_OQ));
+			}
+
+			const uint64_t bits = static_cast<uint32_t>(_mm256_movemask_ps(visible));
+			visibilityMask[i >> 6] |= bits << (i & 63);
+		}
+#	elif defined(AILURUS_FRUSTUM_CULLING_SSE)
+		constexpr uint32_t LANES = 4;
+		const __m128 zero = _mm_setzero_ps();
+		for (uint32_t i = 0; i < paddedCount; i += LANES)
+		{
+			const __m128 vcx = _mm_loadu_ps(cx + i);
+			const __m128 vcy = _mm_loadu_ps(cy + i);
+			const __m128 vcz = _mm_loadu_ps(cz + i);
+			const __m128 vex = _mm_loadu_ps(ex + i);
+			const __m128 vey = _mm_loadu_ps(ey + i);
+			const __m128 vez = _mm_loadu_ps(ez + i);
+
+			__m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+			for (int p = 0; p < 6; p++)
+			{
+				__m128 distance = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(nx[p]), vcx), _mm_set1_ps(d[p]));
+				distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(ny[p]), vcy));
+				distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(nz[p]), vcz));
+
+				__m128 radius = _mm_mul_ps(_mm_set1_ps(ax[p]), vex);
+				radius = _mm_add_ps(radius, _mm_mul_ps(_mm_set1_ps(ay[p]), vey));
+				radius = _mm_add_ps(radius, _mm_mul_ps(_mm_set1_ps(az[p]), vez));
+
+				visible = _mm_and_ps(visible, _mm_cmpge_ps(_mm_add_ps(distance, radius), zero));
+			}
+
+			const uint64_t bits = static_cast<uint32_t>(_mm_movemask_ps(visible));
+			visibilityMask[i >> 6] |= bits << (i & 63);
+		}
+#	elif defined(AILURUS_FRUSTUM_CULLING_NEON)
+		constexpr uint32_t LANES = 4;
+		const float32x4_t zero = vdupq_n_f32(0.0f);
+		const uint32_t laneBitsData[4] = { 1, 2, 4, 8 };
+		const uint32x4_t laneBits = vld1q_u32(laneBitsData);
+		for (uint32_t i = 0; i < paddedCount; i += LANES)
+		{
+			const float32x4_t vcx = vld1q_f32(cx + i);
+			const float32x4_t vcy = vld1q_f32(cy + i);
+			const float32x4_t vcz = vld1q_f32(cz + i);
+			const float32x4_t vex = vld1q_f32(ex + i);
+			const float32x4_t vey = vld1q_f32(ey + i);
+			const float32x4_t vez = vld1q_f32(ez + i);
+
+			uint32x4_t visible = vdupq_n_u32(0xFFFFFFFFu);
+			for (int p = 0; p < 6; p++)
+			{
+				float32x4_t distance = vmlaq_n_f32(vdupq_n_f32(d[p]), vcx, nx[p]);
+				distance = vmlaq_n_f32(distance, vcy, ny[p]);
+				distance = vmlaq_n_f32(distance, vcz, nz[p]);
+
+				float32x4_t radius = vmulq_n_f32(vex, ax[p]);
+				radius = vmlaq_n_f32(radius, vey, ay[p]);
+				radius = vmlaq_n_f32(radius, vez, az[p]);
+
+				visible = vandq_u32(visible, vcgeq_f32(vaddq_f32(distance, radius), zero));
+			}
+
+			const uint64_t bits = vaddvq_u32(vandq_u32(visible, laneBits));
+			visibilityMask[i >> 6] |= bits << (i & 63);
+		}
+#	endif
+
+		// Padding lanes hold zero sized boxes at the origin, drop them
+		if ((count & 63) != 0)
+			visibilityMask.back() &= (uint64_t(1) << (count & 63)) - 1;
+#else
+		CullBoundingBoxesScalar(frustum, boxes, visibilityMask);
+#endif
+	}
+} // namespace Ailurus::Math
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "Matrix4x4.hpp"
+#include "Vector3.hpp"
+#include "Vector4.hpp"
+
+namespace Ailurus
+{
+	/// Froxel grid over the camera frustum for clustered light culling. The screen is split into
+	/// GRID_X x GRID_Y tiles in normalized device coordinates and the depth range into GRID_Z
+	/// slices growing exponentially from the near to the far plane. Lights are given as view
+	/// space bounding spheres and every cluster collects the indices of the lights touching it.
+	///
+	/// View space looks down -z. Slices can be assigned by different threads as long as their
+	/// slice ranges do not overlap. Shaders locate their cluster with the same tile and slice
+	/// formulas, so the grid constants here must match the ones in the lighting shaders.
+	class LightClusterGrid
+	{
+	public:
+		static constexpr uint32_t GRID_X = 16;
+		static constexpr uint32_t GRID_Y = 9;
+		static constexpr uint32_t GRID_Z = 24;
+		static constexpr uint32_t CLUSTER_COUNT = GRID_X * GRID_Y * GRID_Z;
+
+		/// Offset into the packed light indices and light count of one cluster
+		struct ClusterRange
+		{
+			uint32_t offset;
+			uint32_t count;
+		};
+
+		LightClusterGrid()
+			: _clusterLights(CLUSTER_COUNT)
+		{
+		}
+
+		void Setup(const Matrix4x4f& projection, float nearPlane, float farPlane)
+		{
+			_projection = projection;
+			_near = std::max(nearPlane, 1e-4f);
+			_far = std::max(farPlane, _near * 1.001f);
+
+			// slice = log(depth) * scale + bias puts the near plane at 0 and the far plane at GRID_Z
+			const float logRatio = std::log(_far / _near);
+			_sliceScale = static_cast<float>(GRID_Z) / logRatio;
+			_sliceBias = -static_cast<float>(GRID_Z) * std::log(_near) / logRatio;
+		}
+
+		/// Set this frame's lights as view space spheres, xyz = center and w = radius
+		void SetLights(const Vector4f* pViewSpheres, uint32_t count)
+		{
+			_lights.resize(count);
+			for (uint32_t i = 0; i < count; i++)
+			{
+				LightBounds& bounds = _lights[i];
+				bounds.sphere = pViewSpheres[i];
+
+				const float depth = -bounds.sphere.z;
+				const float radius = bounds.sphere.w;
+				if (radius <= 0.0f || depth + radius < _near || depth - radius > _far)
+				{
+					bounds.sliceBegin = 1;
+					bounds.sliceEnd = 0;
+					continue;
+				}
+
+				bounds.sliceBegin = GetSlice(depth - radius);
+				bounds.sliceEnd = GetSlice(depth + radius);
+			}
+		}
+
+		/// Collect the lights of every cluster in slices [sliceBegin, sliceEnd)
+		void AssignSlices(uint32_t sliceBegin, uint32_t sliceEnd)
+		{
+			sliceEnd = std::min(sliceEnd, GRID_Z);
+			for (uint32_t slice = sliceBegin; slice < sliceEnd; slice++)
+			{
+				for (uint32_t cluster = slice * GRID_X * GRID_Y; cluster < (slice + 1) * GRID_X * GRID_Y; cluster++)
+					_clusterLights[cluster].clear();
+
+				const float sliceNear = GetSliceDepth(slice);
+				const float sliceFar = GetSliceDepth(slice + 1);
+
+				for (uint32_t lightIndex = 0; lightIndex < static_cast<uint32_t>(_lights.size()); lightIndex++)
+				{
+					const LightBounds& bounds = _lights[lightIndex];
+					if (slice < bounds.sliceBegin || slice > bounds.sliceEnd)
+						continue;
+
+					uint32_t tileMinX, tileMinY, tileMaxX, tileMaxY;
+					if (!GetTileRect(bounds.sphere, sliceNear, sliceFar, tileMinX, tileMinY, tileMaxX, tileMaxY))
+						continue;
+
+					for (uint32_t y = tileMinY; y <= tileMaxY; y++)
+						for (uint32_t x = tileMinX; x <= tileMaxX; x++)
+							_clusterLights[GetClusterIndex(x, y, slice)].push_back(lightIndex);
+				}
+			}
+		}
+
+		/// Light indices written by Write, valid after every slice was assigned
+		uint32_t GetIndexCount() const
+		{
+			uint32_t count = 0;
+			for (const auto& lights : _clusterLights)
+				count += static_cast<uint32_t>(lights.size());
+			return count;
+		}
+
+		/// Pack every cluster's lights back to back, pRanges holds CLUSTER_COUNT entries
+		void Write(ClusterRange* pRanges, uint32_t* pIndices) const
+		{
+			uint32_t offset = 0;
+			for (uint32_t cluster = 0; cluster < CLUSTER_COUNT; cluster++)
+			{
+				const auto& lights = _clusterLights[cluster];
+				pRanges[cluster] = ClusterRange{ offset, static_cast<uint32_t>(lights.size()) };
+				std::copy(lights.begin(), lights.end(), pIndices + offset);
+				offset += static_cast<uint32_t>(lights.size());
+			}
+		}
+
+		const std::vector<uint32_t>& GetClusterLights(uint32_t cluster) const
+		{
+			return _clusterLights[cluster];
+		}
+
+		/// Cluster of a view space point, the shaders do the same from the world position
+		uint32_t GetClusterIndex(const Vector3f& viewPosition) const
+		{
+			const Vector4f clip = _projection * Vector4f(viewPosition.x, viewPosition.y, viewPosition.z, 1.0f);
+			const uint32_t x = GetTile(clip.x / clip.w, GRID_X);
+			const uint32_t y = GetTile(clip.y / clip.w, GRID_Y);
+			return GetClusterIndex(x, y, GetSlice(-viewPosition.z));
+		}
+
+		static uint32_t GetClusterIndex(uint32_t x, uint32_t y, uint32_t slice)
+		{
+			return (slice * GRID_Y + y) * GRID_X + x;
+		}
+
+		uint32_t GetSlice(float depth) const
+		{
+			const float slice = std::log(std::max(depth, _near)) * _sliceScale + _sliceBias;
+			return std::min(static_cast<uint32_t>(std::max(slice, 0.0f)), GRID_Z - 1);
+		}
+
+		/// View depth where a slice begins
+		float GetSliceDepth(uint32_t slice) const
+		{
+			return _near * std::pow(_far / _near, static_cast<float>(slice) / static_cast<float>(GRID_Z));
+		}
+
+		float GetSliceScale() const { return _sliceScale; }
+		float GetSliceBias() const { return _sliceBias; }
+
+	private:
+		struct LightBounds
+		{
+			Vector4f sphere;
+			uint32_t sliceBegin;
+			uint32_t sliceEnd;
+		};
+
+		static uint32_t GetTile(float ndc, uint32_t tileCount)
+		{
+			const float tile = (std::clamp(ndc, -1.0f, 1.0f) * 0.5f + 0.5f) * static_cast<float>(tileCount);
+			return std::min(static_cast<uint32_t>(tile), tileCount - 1);
+		}
+
+		/// Screen tiles covered by the part of a sphere between two view depths. The slab of the
+		/// sphere is bounded by a box whose corners all lie in front of the near plane, so the
+		/// rect of its projected corners contains its projection.
+		bool GetTileRect(const Vector4f& sphere, float sliceNear, float sliceFar,
+			uint32_t& tileMinX, uint32_t& tileMinY, uint32_t& tileMaxX, uint32_t& tileMaxY) const
+		{
+			const float depth = -sphere.z;
+			const float radius = sphere.w;
+			const float depthMin = std::max(sliceNear, depth - radius);
+			const float depthMax = std::min(sliceFar, depth + radius);
+			if (depthMin > depthMax)
+				return false;
+
+			// The widest cross section is at the depth in the slab closest to the center
+			const float closest = std::clamp(depth, depthMin, depthMax) - depth;
+			const float sectionSquared = radius * radius - closest * closest;
+			if (sectionSquared < 0.0f)
+				return false;
+
+			const float section = std::sqrt(sectionSquared);
+			float ndcMinX = 1.0f, ndcMinY = 1.0f, ndcMaxX = -1.0f, ndcMaxY = -1.0f;
+			for (int i = 0; i < 8; i++)
+			{
+				const Vector4f corner(
+					(i & 1) ? sphere.x + section : sphere.x - section,
+					(i & 2) ? sphere.y + section : sphere.y - section,
+					(i & 4) ? -depthMax : -depthMin,
+					1.0f);
+				const Vector4f clip = _projection * corner;
+				const float ndcX = clip.x / clip.w;
+				const float ndcY = clip.y / clip.w;
+				ndcMinX = std::min(ndcMinX, ndcX);
+				ndcMinY = std::min(ndcMinY, ndcY);
+				ndcMaxX = std::max(ndcMaxX, ndcX);
+				ndcMaxY = std::max(ndcMaxY, ndcY);
+			}
+
+			if (ndcMinX > 1.0f || ndcMaxX < -1.0f || ndcMinY > 1.0f || ndcMaxY < -1.0f)
+				return false;
+
+			tileMinX = GetTile(ndcMinX, GRID_X);
+			tileMaxX = GetTile(ndcMaxX, GRID_X);
+			tileMinY = GetTile(ndcMinY, GRID_Y);
+			tileMaxY = GetTile(ndcMaxY, GRID_Y);
+			return true;
+		}
+
+	private:
+		Matrix4x4f _projection = Matrix4x4f::Identity;
+		float _near = 0.1f;
+		float _far = 100.0f;
+		float _sliceScale = 1.0f;
+		float _sliceBias = 0.0f;
+
+		std::vector<LightBounds> _lights;
+		std::vector<std::vector<uint32_t>> _clusterLights;
+	};
+} // namespace Ailurus
@@ -0,0 +1,329 @@
+#pragma once
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "AABB.hpp"
+#include "Matrix4x4.hpp"
+#include "Vector4.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define AILURUS_OCCLUSION_BUFFER_SSE 1
+#	include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#	define AILURUS_OCCLUSION_BUFFER_NEON 1
+#	include <arm_neon.h>
+#endif
+
+namespace Ailurus
+{
+	/// Low resolution software depth buffer for occlusion culling. Occluder triangles are
+	/// rasterized four pixels at a time (SSE2 / NEON, scalar otherwise) keeping the nearest
+	/// depth, then a max depth mip chain is built on top. A box is occluded when its nearest
+	/// depth lies behind the farthest occluder depth of every texel its screen rect touches.
+	///
+	/// Depth follows the Vulkan convention, z / w in [0, 1] with the far plane at 1. Rows can
+	/// be rasterized by different threads as long as their row ranges do not overlap.
+	class OcclusionBuffer
+	{
+	public:
+		/// Vertices closer than this in clip w are treated as crossing the near plane
+		static constexpr float NEAR_CLIP_W = 1e-4f;
+
+		/// Width is rounded up to a multiple of 4 so a row is always whole SIMD quads
+		void Resize(uint32_t width, uint32_t height)
+		{
+			width = std::max((width + 3u) & ~3u, 4u);
+			height = std::max(height, 1u);
+
+			_levels.clear();
+			while (true)
+			{
+				_levels.push_back(Level{ width, height, std::vector<float>(width * height, 1.0f) });
+				if (width == 1 && height == 1)
+					break;
+
+				width = std::max((width + 1) / 2, 1u);
+				height = std::max((height + 1) / 2, 1u);
+			}
+		}
+
+		/// Reset rows [rowBegin, rowEnd) of the full resolution level to the far plane
+		void ClearRows(uint32_t rowBegin, uint32_t rowEnd)
+		{
+			auto& level = _levels[0];
+			rowEnd = std::min(rowEnd, level.height);
+			if (rowBegin < rowEnd)
+				std::fill(level.depth.begin() + rowBegin * level.width, level.depth.begin() + rowEnd * level.width, 1.0f);
+		}
+
+		void Clear()
+		{
+			ClearRows(0, GetHeight());
+		}
+
+		/// Rasterize indexed clip space triangles into rows [rowBegin, rowEnd). Triangles touching
+		/// the near plane are skipped, which only ever makes the buffer less occluding. Both
+		/// windings are filled so hulls do not need a consistent orientation.
+		void RasterizeTriangles(const Vector4f* pClipVertices, const uint32_t* pIndices, uint32_t indexCount,
+			uint32_t rowBegin, uint32_t rowEnd)
+		{
+			auto& level = _levels[0];
+			rowEnd = std::min(rowEnd, level.height);
+			if (rowBegin >= rowEnd)
+				return;
+
+			for (uint32_t i = 0; i + 2 < indexCount; i += 3)
+			{
+				ScreenVertex v[3];
+				bool clipped = false;
+				for (uint32_t k = 0; k < 3; k++)
+				{
+					const Vector4f& clip = pClipVertices[pIndices[i + k]];
+					if (clip.w < NEAR_CLIP_W || clip.z < 0.0f)
+					{
+						clipped = true;
+						break;
+					}
+
+					v[k] = ToScreen(clip);
+				}
+
+				if (!clipped)
+					RasterizeTriangle(v[0], v[1], v[2], rowBegin, rowEnd);
+			}
+		}
+
+		/// Rebuild the max depth mip chain from the full resolution level
+		void BuildHierarchy()
+		{
+			for (size_t l = 1; l < _levels.size(); l++)
+			{
+				const Level& src = _levels[l - 1];
+				Level& dst = _levels[l];
+				for (uint32_t y = 0; y < dst.height; y++)
+				{
+					const uint32_t y0 = std::min(y * 2, src.height - 1);
+					const uint32_t y1 = std::min(y * 2 + 1, src.height - 1);
+					for (uint32_t x = 0; x < dst.width; x++)
+					{
+						const uint32_t x0 = std::min(x * 2, src.width - 1);
+						const uint32_t x1 = std::min(x * 2 + 1, src.width - 1);
+						dst.depth[y * dst.width + x] = std::max(
+							std::max(src.At(x0, y0), src.At(x1, y0)),
+							std::max(src.At(x0, y1), src.At(x1, y1)));
+					}
+				}
+			}
+		}
+
+		/// Conservative test, false only when the whole box is hidden behind rasterized occluders.
+		/// BuildHierarchy must have been called after the last rasterization.
+		bool IsVisible(const AABBf& aabb, const Matrix4x4f& viewProjection) const
+		{
+			float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+			float minDepth = FLT_MAX;
+			for (int i = 0; i < 8; i++)
+			{
+				const Vector4f corner((i & 1) ? aabb.max.x : aabb.min.x,
+					(i & 2) ? aabb.max.y : aabb.min.y,
+					(i & 4) ? aabb.max.z : aabb.min.z,
+					1.0f);
+				const Vector4f clip = viewProjection * corner;
+
+				// Box reaches the camera, nothing can be in front of it
+				if (clip.w < NEAR_CLIP_W || clip.z < 0.0f)
+					return true;
+
+				const ScreenVertex screen = ToScreen(clip);
+				minX = std::min(minX, screen.x);
+				maxX = std::max(maxX, screen.x);
+				minY = std::min(minY, screen.y);
+				maxY = std::max(maxY, screen.y);
+				minDepth = std::min(minDepth, screen.z);
+			}
+
+			const Level& base = _levels[0];
+			const float clampedMinX = std::max(minX, 0.0f);
+			const float clampedMinY = std::max(minY, 0.0f);
+			const float clampedMaxX = std::min(maxX, static_cast<float>(base.width) - 1.0f);
+			const float clampedMaxY = std::min(maxY, static_cast<float>(base.height) - 1.0f);
+
+			// Off screen, frustum culling has the final word
+			if (clampedMinX > clampedMaxX || clampedMinY > clampedMaxY)
+				return true;
+
+			// Coarsest level where the rect still spans no more than three texels per axis
+			const float extent = std::max(clampedMaxX - clampedMinX, clampedMaxY - clampedMinY);
+			uint32_t levelIndex = 0;
+			while (levelIndex + 1 < _levels.size() && static_cast<float>(1u << (levelIndex + 1)) <= extent)
+				levelIndex++;
+
+			const Level& level = _levels[levelIndex];
+			const uint32_t x0 = static_cast<uint32_t>(clampedMinX) >> levelIndex;
+			const uint32_t y0 = static_cast<uint32_t>(clampedMinY) >> levelIndex;
+			const uint32_t x1 = std::min(static_cast<uint32_t>(clampedMaxX) >> levelIndex, level.width - 1);
+			const uint32_t y1 = std::min(static_cast<uint32_t>(clampedMaxY) >> levelIndex, level.height - 1);
+			for (uint32_t y = y0; y <= y1; y++)
+			{
+				for (uint32_t x = x0; x <= x1; x++)
+				{
+					if (level.At(x, y) >= minDepth)
+						return true;
+				}
+			}
+
+			return false;
+		}
+
+		uint32_t GetWidth() const { return _levels.empty() ? 0 : _levels[0].width; }
+		uint32_t GetHeight() const { return _levels.empty() ? 0 : _levels[0].height; }
+		uint32_t GetLevelCount() const { return static_cast<uint32_t>(_levels.size()); }
+
+		float GetDepth(uint32_t levelIndex, uint32_t x, uint32_t y) const
+		{
+			return _levels[levelIndex].At(x, y);
+		}
+
+	private:
+		struct Level
+		{
+			uint32_t width;
+			uint32_t height;
+			std::vector<float> depth;
+
+			float At(uint32_t x, uint32_t y) const { return depth[y * width + x]; }
+		};
+
+		struct ScreenVertex
+		{
+			float x, y, z;
+		};
+
+		ScreenVertex ToScreen(const Vector4f& clip) const
+		{
+			const float invW = 1.0f / clip.w;
+			return ScreenVertex{
+				(clip.x * invW * 0.5f + 0.5f) * static_cast<float>(_levels[0].width),
+				(clip.y * invW * 0.5f + 0.5f) * static_cast<float>(_levels[0].height),
+				clip.z * invW };
+		}
+
+		void RasterizeTriangle(ScreenVertex v0, ScreenVertex v1, ScreenVertex v2, uint32_t rowBegin, uint32_t rowEnd)
+		{
+			float area = (v1.x - v0.x) * (v2.y - v0.y) - (v2.x - v0.x) * (v1.y - v0.y);
+			if (std::abs(area) < 1e-8f)
+				return;
+
+			// Make every edge function positive inside
+			if (area < 0.0f)
+			{
+				std::swap(v1, v2);
+				area = -area;
+			}
+
+			Level& level = _levels[0];
+			const float minXf = std::min({ v0.x, v1.x, v2.x });
+			const float maxXf = std::max({ v0.x, v1.x, v2.x });
+			const float minYf = std::min({ v0.y, v1.y, v2.y });
+			const float maxYf = std::max({ v0.y, v1.y, v2.y });
+			if (maxXf < 0.0f || maxYf < 0.0f || minXf >= static_cast<float>(level.width) || minYf >= static_cast<float>(rowEnd))
+				return;
+
+			// Pixel centers inside the bounds, x starts on a quad boundary
+			const uint32_t minX = static_cast<uint32_t>(std::max(minXf, 0.0f)) & ~3u;
+			const uint32_t maxX = std::min(static_cast<uint32_t>(maxXf), level.width - 1);
+			const uint32_t minY = std::max(static_cast<uint32_t>(std::max(minYf, 0.0f)), rowBegin);
+			const uint32_t maxY = std::min(static_cast<uint32_t>(maxYf), rowEnd - 1);
+			if (minY > maxY)
+				return;
+
+			// Edge functions e = a * x + b * y + c, depth plane z = za * x + zb * y + zc
+			const EdgeFunction edges[3] = {
+				EdgeFunction::From(v1, v2),
+				EdgeFunction::From(v2, v0),
+				EdgeFunction::From(v0, v1)
+			};
+
+			const float invArea = 1.0f / area;
+			const float za = ((v1.z - v0.z) * (v2.y - v0.y) - (v2.z - v0.z) * (v1.y - v0.y)) * invArea;
+			const float zb = ((v2.z - v0.z) * (v1.x - v0.x) - (v1.z - v0.z) * (v2.x - v0.x)) * invArea;
+			const float zc = v0.z - za * v0.x - zb * v0.y;
+
+			for (uint32_t y = minY; y <= maxY; y++)
+			{
+				const float py = static_cast<float>(y) + 0.5f;
+				float* pRow = level.depth.data() + y * level.width;
+				for (uint32_t x = minX; x <= maxX; x += 4)
+				{
+					const float px = static_cast<float>(x) + 0.5f;
+					ShadeQuad(pRow + x,
+						edges[0].At(px, py), edges[1].At(px, py), edges[2].At(px, py),
+						edges[0].a, edges[1].a, edges[2].a,
+						za * px + zb * py + zc, za);
+				}
+			}
+		}
+
+		struct EdgeFunction
+		{
+			float a, b, c;
+
+			static EdgeFunction From(const ScreenVertex& from, const ScreenVertex& to)
+			{
+				const float a = from.y - to.y;
+				const float b = to.x - from.x;
+				return EdgeFunction{ a, b, -(a * from.x + b * from.y) };
+			}
+
+			float At(float x, float y) const { return a * x + b * y + c; }
+		};
+
+		/// Four pixels starting at pDepth, values are for the first pixel and steps per pixel
+		static void ShadeQuad(float* pDepth, float e0, float e1, float e2,
+			float step0, float step1, float step2, float z, float zStep)
+		{
+#if defined(AILURUS_OCCLUSION_BUFFER_SSE)
+			const __m128 lane = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 ve0 = _mm_add_ps(_mm_set1_ps(e0), _mm_mul_ps(_mm_set1_ps(step0), lane));
+			const __m128 ve1 = _mm_add_ps(_mm_set1_ps(e1), _mm_mul_ps(_mm_set1_ps(step1), lane));
+			const __m128 ve2 = _mm_add_ps(_mm_set1_ps(e2), _mm_mul_ps(_mm_set1_ps(step2), lane));
+			const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(ve0, zero), _mm_cmpge_ps(ve1, zero)), _mm_cmpge_ps(ve2, zero));
+			if (_mm_movemask_ps(inside) == 0)
+				return;
+
+			const __m128 depth = _mm_loadu_ps(pDepth);
+			const __m128 nearest = _mm_min_ps(depth, _mm_add_ps(_mm_set1_ps(z), _mm_mul_ps(_mm_set1_ps(zStep), lane)));
+			_mm_storeu_ps(pDepth, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, depth)));
+#elif defined(AILURUS_OCCLUSION_BUFFER_NEON)
+			const float laneData[4] = { 0.0f, 1.0f, 2.0f, 3.0f };
+			const float32x4_t lane = vld1q_f32(laneData);
+			const float32x4_t zero = vdupq_n_f32(0.0f);
+			const float32x4_t ve0 = vmlaq_n_f32(vdupq_n_f32(e0), lane, step0);
+			const float32x4_t ve1 = vmlaq_n_f32(vdupq_n_f32(e1), lane, step1);
+			const float32x4_t ve2 = vmlaq_n_f32(vdupq_n_f32(e2), lane, step2);
+			const uint32x4_t inside = vandq_u32(vandq_u32(vcgeq_f32(ve0, zero), vcgeq_f32(ve1, zero)), vcgeq_f32(ve2, zero));
+			if (vmaxvq_u32(inside) == 0)
+				return;
+
+			const float32x4_t depth = vld1q_f32(pDepth);
+			const float32x4_t nearest = vminq_f32(depth, vmlaq_n_f32(vdupq_n_f32(z), lane, zStep));
+			vst1q_f32(pDepth, vbslq_f32(inside, nearest, depth));
+#else
+			for (int i = 0; i < 4; i++)
+			{
+				const float fi = static_cast<float>(i);
+				if (e0 + step0 * fi >= 0.0f && e1 + step1 * fi >= 0.0f && e2 + step2 * fi >= 0.0f)
+					pDepth[i] = std::min(pDepth[i], z + zStep * fi);
+			}
+#endif
+		}
+
+	private:
+		std::vector<Level> _levels;
+	};
+} // namespace Ailurus
@@ -19,6 +19,7 @@ namespace Ailurus
 			StageShaderArray shaders;
 			std::unique_ptr<UniformSet> pUniformSet;
 			std::unordered_map<std::string, AssetRef<Texture>> textures; // uniform var name -> texture
+			bool bindless = false; // Textures are sampled from the bindless table by index
 		};
 
 	public:
@@ -26,6 +27,7 @@ namespace Ailurus
 		auto GetPassShaderArray(RenderPassType pass) const -> const StageShaderArray*;
 		auto GetUniformSet(RenderPassType pass) const -> const UniformSet*;
 		auto GetTextures(RenderPassType pass) const -> const std::unordered_map<std::string, AssetRef<Texture>>*;
+		bool IsPassBindless(RenderPassType pass) const;
 
 	private:
 		friend class AssetsSystem;
@@ -33,6 +35,7 @@ namespace Ailurus
 		void SetPassShaderAndUniform(RenderPassType pass, const std::vector<const Shader*>& shaders,
 			std::unique_ptr<UniformSet>&& pUniformSet);
 		void SetPassTexture(RenderPassType pass, const std::string& uniformVarName, const AssetRef<Texture>& texture);
+		void SetPassBindless(RenderPassType pass, bool bindless);
 
 	private:
 		std::unordered_map<RenderPassType, MaterialRenderPassInfo> _renderPassInfoMap;
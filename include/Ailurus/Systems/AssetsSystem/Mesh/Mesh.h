@@ -1,6 +1,7 @@
 #pragma once
 
-#include <memory>
+#include <cstdint>
+#include <vector>
 #include "Ailurus/Utility/NonCopyable.h"
 #include "Ailurus/Utility/NonMovable.h"
 #include "Ailurus/Systems/RenderSystem/Vertex/IndexBufferFormat.h"
@@ -8,9 +9,13 @@
 
 namespace Ailurus
 {
-	class VulkanVertexBuffer;
-	class VulkanIndexBuffer;
+	class VulkanGeometryArena;
 
+	/// Geometry lives in the shared arena of the mesh's vertex layout, the mesh only
+	/// remembers its ranges there. Indices are relative to the mesh's own first vertex.
+	///
+	/// Indexed meshes may carry simplified levels of detail. Every level indexes the same
+	/// vertices with an index range of its own, level 0 is the full mesh.
 	class Mesh: public NonCopyable, public NonMovable
 	{
 	public:
@@ -20,17 +25,38 @@ namespace Ailurus
 		~Mesh();
 
 	public:
+		/// @brief Append a coarser level of detail, indices refer to the mesh's vertices
+		/// @param geometricError Largest distance of the level's surface from the full mesh
+		bool AddLod(const uint32_t* indexData, uint32_t indexCount, float geometricError);
+
 		uint32_t GetVertexCount() const;
-		const VulkanVertexBuffer* GetVertexBuffer() const;
+		uint32_t GetVertexOffset() const;
+		uint32_t GetLodCount() const;
+		uint32_t GetIndexCount(uint32_t lod = 0) const;
+		uint32_t GetFirstIndex(uint32_t lod = 0) const;
+		float GetLodError(uint32_t lod) const;
+		bool HasIndices() const;
+		VulkanGeometryArena* GetGeometryArena() const;
 		uint64_t GetVertexLayoutId() const;
-		const VulkanIndexBuffer* GetIndexBuffer() const;
 		const AABBf& GetLocalAABB() const;
 
 	private:
-		uint32_t _vertexCount;
-		std::unique_ptr<VulkanVertexBuffer> _pVertexBuffer;
+		struct Lod
+		{
+			uint32_t firstIndex;
+			uint32_t indexCount;
+			float geometricError;
+		};
+
+		/// Levels past the last one draw the last one
+		const Lod* FindLod(uint32_t lod) const;
+
+	private:
+		VulkanGeometryArena* _pArena;
 		uint64_t _layoutId;
-		std::unique_ptr<VulkanIndexBuffer> _pIndexBuffer;
+		uint32_t _vertexOffset;
+		uint32_t _vertexCount;
+		std::vector<Lod> _lods;
 		AABBf _localAABB;
 	};
-} // namespace Ailurus
\ No newline at end of file
+} // namespace Ailurus
@@ -14,12 +14,27 @@ namespace Ailurus
 		const std::vector<std::unique_ptr<Mesh>>& GetMeshes() const;
 		const AABBf& GetLocalAABB() const;
 
+		/// @brief Levels of detail of the model, the most any of its meshes has
+		uint32_t GetLodCount() const;
+
+		/// @brief Projected size below which level lod may be drawn, level 0 has none
+		float GetLodScreenSize(uint32_t lod) const;
+
+		/// @brief Level to draw at a projected size, the bounding radius over the distance scaled
+		/// by the projection. A switch needs the size to pass the threshold by the hysteresis
+		/// fraction, so objects resting near one do not flicker between two levels.
+		uint32_t SelectLod(float screenSize, uint32_t currentLod, float hysteresis = 0.1f) const;
+
 	private:
 		friend class AssetsSystem;
 		Model(uint64_t assetId, std::vector<std::unique_ptr<Mesh>>&& meshes);
 
 	private:
+		/// Projected geometric error a level may have before it is visible, about a pixel at 1080p
+		static constexpr float LOD_SCREEN_ERROR = 0.002f;
+
 		std::vector<std::unique_ptr<Mesh>> _meshes;
 		AABBf _localAABB;
+		std::vector<float> _lodScreenSizes;
 	};
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <cstdint>
+#include "Ailurus/Container/SlotMap.hpp"
 #include "Ailurus/Systems/AssetsSystem/Asset.h"
 
 namespace Ailurus
@@ -19,13 +20,17 @@ namespace Ailurus
 		auto GetImage() const -> VulkanImage*;
 		auto GetSampler() const -> VulkanSampler*;
 		auto GetBindingId() const -> uint32_t;
+		auto GetBindlessIndex() const -> uint32_t;
 		void SetImage(VulkanImage* pImage);
 		void SetSampler(VulkanSampler* pSampler);
 		void SetBindingId(uint32_t bindingId);
+		void SetBindlessIndex(uint32_t bindlessIndex);
 
 	private:
-		VulkanImage* _pImage;
-		VulkanSampler* _pSampler;
+		// Resolved on access, a texture outliving its GPU resources yields nullptr instead of a dangling pointer
+		SlotMapHandle _imageHandle;
+		SlotMapHandle _samplerHandle;
 		uint32_t _bindingId = 0;
+		uint32_t _bindlessIndex = UINT32_MAX; // Slot in the bindless texture table, UINT32_MAX when not registered
 	};
 } // namespace Ailurus
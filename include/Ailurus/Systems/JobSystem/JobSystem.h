@@ -0,0 +1,115 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Ailurus/Utility/NonCopyable.h"
+#include "Ailurus/Utility/NonMovable.h"
+#include "Ailurus/Container/LockFreeQueue.hpp"
+#include "Ailurus/Container/WorkStealingDeque.hpp"
+
+namespace Ailurus
+{
+	struct JobNode;
+
+	/// Tracks a group of scheduled jobs. The counter is incremented when a job is
+	/// scheduled with it and decremented when that job finishes. Jobs scheduled with
+	/// JobSystem::ScheduleAfter are released once the counter reaches zero.
+	/// A counter must outlive every job that references it, and may be reused once done.
+	class JobCounter : public NonCopyable, public NonMovable
+	{
+		friend class JobSystem;
+
+	public:
+		JobCounter() = default;
+
+	public:
+		bool IsDone() const;
+		uint32_t GetValue() const;
+
+	private:
+		std::atomic<uint32_t> _value = 0;
+		mutable std::mutex _mutex;
+		std::vector<JobNode*> _continuations;
+	};
+
+	class JobSystem : public NonCopyable, public NonMovable
+	{
+	public:
+		using JobFunction = std::function<void()>;
+		using RangeFunction = std::function<void(uint32_t begin, uint32_t end)>;
+
+		static constexpr uint32_t INVALID_THREAD_INDEX = UINT32_MAX;
+		static constexpr uint32_t MAIN_THREAD_INDEX = 0;
+
+	public:
+		/// Must be constructed on the main thread.
+		/// @param workerCount Worker thread count, 0 means hardware concurrency minus one.
+		explicit JobSystem(uint32_t workerCount = 0);
+		~JobSystem();
+
+	public:
+		/// Schedule a job on any worker (or the main thread while it waits).
+		void Schedule(const JobFunction& job, JobCounter* pCounter = nullptr);
+
+		/// Schedule a job that starts only after pDependency reaches zero.
+		void ScheduleAfter(JobCounter* pDependency, const JobFunction& job, JobCounter* pCounter = nullptr);
+
+		/// Split [0, count) into batches of batchSize and run them in parallel, returns
+		/// immediately, completion is signalled through pCounter.
+		void ParallelFor(uint32_t count, uint32_t batchSize, const RangeFunction& func, JobCounter* pCounter);
+
+		/// Split [0, count) into batches of batchSize and run them in parallel, blocks until all done.
+		void ParallelFor(uint32_t count, uint32_t batchSize, const RangeFunction& func);
+
+		/// Block until the counter reaches zero. The calling thread helps executing worker jobs,
+		/// main thread jobs are never run here, so the main thread must not wait on their counters
+		/// before calling PumpMainThreadJobs.
+		void Wait(const JobCounter* pCounter);
+
+		/// Queue a job that must run on the main thread, executed by PumpMainThreadJobs.
+		void RunOnMainThread(const JobFunction& job, JobCounter* pCounter = nullptr);
+
+		/// Execute queued main thread jobs, called once per frame by Application.
+		void PumpMainThreadJobs();
+
+		/// Worker thread count, not including the main thread.
+		uint32_t GetWorkerCount() const;
+
+		/// Worker thread count plus the main thread, i.e. the range of GetCurrentThreadIndex.
+		uint32_t GetThreadCount() const;
+
+		/// Main thread is 0, workers are 1..GetWorkerCount(), other threads are INVALID_THREAD_INDEX.
+		uint32_t GetCurrentThreadIndex() const;
+
+		bool IsMainThread() const;
+
+	private:
+		using Deque = WorkStealingDeque<JobNode*, 4096>;
+		using Queue = LockFreeQueue<JobNode*, 4096>;
+
+		void WorkerLoop(uint32_t threadIndex);
+		void Submit(JobNode* pJob);
+		JobNode* FetchJob(uint32_t threadIndex);
+		bool TryRunOneJob();
+		void Execute(JobNode* pJob);
+		void WakeWorker();
+
+	private:
+		std::vector<std::thread> _workers;
+		std::vector<std::unique_ptr<Deque>> _deques;
+		std::unique_ptr<Queue> _injectionQueue;
+		std::unique_ptr<Queue> _mainThreadQueue;
+
+		std::atomic<int32_t> _pendingJobs = 0;
+		std::atomic<uint32_t> _sleepingWorkers = 0;
+		std::atomic<bool> _shutdown = false;
+		std::mutex _sleepMutex;
+		std::condition_variable _sleepCondition;
+	};
+} // namespace Ailurus
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+#include "DescriptorSetSchema.h"
+
+namespace Ailurus
+{
+	/// One update after bind array of combined image samplers in its own descriptor set, bound as
+	/// set 2 by bindless materials. Textures are registered into stable slots and materials carry
+	/// the slot indices in their uniform data. A slot is handed out again only after every frame in
+	/// flight that may still sample it has finished.
+	class BindlessTextureTable : public DescriptorSetSchema
+	{
+	public:
+		static constexpr uint32_t SET_ID = 2;
+		static constexpr uint32_t TEXTURE_BINDING = 0;
+		static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+		explicit BindlessTextureTable(uint32_t capacity);
+		~BindlessTextureTable() override;
+
+	public:
+		/// Write the texture into a free slot, INVALID_INDEX when the table is full
+		auto Register(vk::ImageView imageView, vk::Sampler sampler) -> uint32_t;
+		auto Unregister(uint32_t index) -> void;
+
+		/// Release the slots unregistered before the last completed frame, once per frame
+		auto GarbageCollect() -> void;
+
+		auto GetDescriptorSet() const -> vk::DescriptorSet;
+		auto GetCapacity() const -> uint32_t;
+		auto GetRegisteredCount() const -> uint32_t;
+
+	private:
+		struct PendingFree
+		{
+			uint32_t index;
+			uint64_t retireFrame;
+		};
+
+		uint32_t _capacity;
+		vk::DescriptorPool _pool = nullptr;
+		vk::DescriptorSet _descriptorSet = nullptr;
+
+		uint32_t _nextIndex = 0;
+		std::vector<uint32_t> _freeIndices;
+		std::vector<PendingFree> _pendingFrees;
+	};
+} // namespace Ailurus
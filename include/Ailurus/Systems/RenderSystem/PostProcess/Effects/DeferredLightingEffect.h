@@ -2,6 +2,7 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 #include <vulkan/vulkan.hpp>
 #include <Ailurus/Systems/RenderSystem/PostProcess/PostProcessEffect.h>
 #include <Ailurus/Math/Matrix4x4.hpp>
@@ -57,7 +58,8 @@ namespace Ailurus
         // ---- Per-frame data setters (called by RenderSystem before Render()) ----
         void SetGBufferViews(vk::ImageView normalAO, vk::ImageView albedoRoughness, vk::ImageView metallic);
         void SetDepthImageView(vk::ImageView depth);
-        void SetGlobalDescriptorSet(vk::DescriptorSet globalSet);
+        /// @param dynamicOffsets Ring offsets of the set's dynamic uniform buffers, one per binding.
+        void SetGlobalDescriptorSet(vk::DescriptorSet globalSet, const std::vector<uint32_t>& dynamicOffsets);
         void SetInverseViewProjMatrix(const Matrix4x4f& mat);
 
     private:
@@ -75,6 +77,7 @@ namespace Ailurus
         vk::ImageView     _gBufferMetallic        = nullptr;
         vk::ImageView     _depthImageView         = nullptr;
         vk::DescriptorSet _globalDescriptorSet    = nullptr;
+        std::vector<uint32_t> _globalDynamicOffsets;
         Matrix4x4f        _inverseViewProj;
 
         // Descriptor set layout for set 1 (G-Buffer samplers)
@@ -10,7 +10,10 @@ namespace Ailurus
 		uint32_t triangleCount = 0;
 		uint32_t entityCount = 0;
 		uint32_t culledEntityCount = 0;
+		uint32_t occludedEntityCount = 0;
 		uint32_t meshCount = 0;
+		uint32_t localLightCount = 0;
+		uint32_t uniformUploadBytes = 0;	// Uniform data copied to GPU visible memory
 		float frameTimeMs = 0.0f;
 
 		void Reset()
@@ -19,7 +22,10 @@ namespace Ailurus
 			triangleCount = 0;
 			entityCount = 0;
 			culledEntityCount = 0;
+			occludedEntityCount = 0;
 			meshCount = 0;
+			localLightCount = 0;
+			uniformUploadBytes = 0;
 		}
 	};
 } // namespace Ailurus
@@ -5,6 +5,7 @@
 #include <unordered_map>
 #include <memory>
 #include <string>
+#include <vector>
 #include "Ailurus/Utility/NonCopyable.h"
 #include "Ailurus/Utility/NonMovable.h"
 #include "Ailurus/Systems/RenderSystem/RenderPass/RenderPassType.h"
@@ -12,6 +13,7 @@
 #include "Ailurus/Systems/SceneSystem/Component/CompCamera.h"
 #include "Ailurus/Systems/RenderSystem/PostProcess/PostProcessChain.h"
 #include "Ailurus/Systems/RenderSystem/RenderStats.h"
+#include "Ailurus/Systems/RenderSystem/Uniform/UniformHandle.h"
 
 namespace Ailurus
 {
@@ -23,13 +25,21 @@ namespace Ailurus
 	class CompStaticMeshRender;
 	class VulkanCommandBuffer;
 	class VulkanDescriptorAllocator;
-	class VulkanUniformBuffer;
+	class VulkanStorageBuffer;
 	class VulkanSampler;
 	class UniformSet;
 	class UniformSetMemory;
 	class Skybox;
 	class IBLManager;
+	class GpuCulling;
+	class OcclusionCulling;
+	class ClusteredLighting;
+	class BindlessTextureTable;
+	class RenderWorld;
 	struct RenderIntermediateVariable;
+	struct RenderingMesh;
+	struct DrawChunk;
+	struct VulkanRenderingInheritance;
 
 	class RenderSettingsObserver
 	{
@@ -52,6 +62,9 @@ namespace Ailurus
 		void RequestRebuildSwapChain();
 		auto GetGlobalUniformSet() const -> UniformSet*;
 
+		// Bindless material textures (set 2), nullptr when the device has no descriptor indexing
+		auto GetBindlessTextureTable() const -> BindlessTextureTable*;
+
 		// Shader library
 		ShaderLibrary* GetShaderLibrary() const;
 
@@ -86,6 +99,21 @@ namespace Ailurus
 		void SetSkyboxEnabled(bool enabled);
 		bool IsSkyboxEnabled() const;
 
+		// GPU driven culling, needs draw indirect count support
+		void SetGPUDrivenCullingEnabled(bool enabled);
+		bool IsGPUDrivenCullingEnabled() const;
+
+		// CPU occlusion culling against entities marked as occluders, skipped by GPU driven culling
+		void SetOcclusionCullingEnabled(bool enabled);
+		bool IsOcclusionCullingEnabled() const;
+
+		// Level of detail, projected sizes are scaled by the bias before a level is picked.
+		// Below 1 coarser levels come in closer, shadow casters default to coarser levels.
+		void SetLodBias(float bias);
+		void SetShadowLodBias(float bias);
+		float GetLodBias() const { return _lodBias; }
+		float GetShadowLodBias() const { return _shadowLodBias; }
+
 		// Render stats
 		const RenderStats& GetRenderStats() const;
 
@@ -120,34 +148,36 @@ namespace Ailurus
 		void CollectRenderingContext();
 		void CollectLights();
 		void CalculateCascadeShadows();
-		void UpdateGlobalUniformBuffer(VulkanCommandBuffer* pCommandBuffer, class VulkanDescriptorAllocator* pDescriptorAllocator);
-		void UpdateMaterialInstanceUniformBuffer(VulkanCommandBuffer* pCommandBuffer, class VulkanDescriptorAllocator* pDescriptorAllocator);
+		void CollectShadowCasters();
+		void SortRenderingMeshes(std::vector<RenderingMesh>& meshes);
+		void UploadInstanceData(VulkanCommandBuffer* pCommandBuffer, class VulkanDescriptorAllocator* pDescriptorAllocator);
+		void UploadGpuCullingData(VulkanCommandBuffer* pCommandBuffer, class VulkanDescriptorAllocator* pDescriptorAllocator);
+		void UpdateGlobalUniformBuffer(VulkanCommandBuffer* pCommandBuffer);
+		void UpdateMaterialInstanceUniformBuffer();
 		void RebuildSwapChain();
 		void SyncMainCameraAspectToSwapChain();
 		void NotifyRenderSettingsChanged();
+		void RecordDrawChunks();
+		void RecordDrawChunk(DrawChunk& chunk) const;
+		void RecordMeshDraws(RenderPassType pass, const RenderingMesh* pBegin, const RenderingMesh* pEnd, VulkanCommandBuffer* pCommandBuffer, DrawChunk& chunk) const;
+		void RecordShadowDraws(const RenderingMesh* pBegin, const RenderingMesh* pEnd, VulkanCommandBuffer* pCommandBuffer) const;
+		auto GetPassRenderingInheritance(RenderPassType pass) const -> VulkanRenderingInheritance;
+		auto GetDrawChunkCommandBuffers(RenderPassType pass) const -> std::vector<VulkanCommandBuffer*>;
 		void RenderPass(RenderPassType pass, VulkanCommandBuffer* pCommandBuffer);
 		void RenderShadowPass(VulkanCommandBuffer* pCommandBuffer, class VulkanDescriptorAllocator* pDescriptorAllocator);
 		void RenderGBufferPass(VulkanCommandBuffer* pCommandBuffer);
 		void RenderDeferredLighting(VulkanCommandBuffer* pCommandBuffer, class VulkanDescriptorAllocator* pDescriptorAllocator, vk::ImageView outputImageView, vk::Extent2D extent);
 		void RenderTransparentPass(VulkanCommandBuffer* pCommandBuffer);
-		void RenderSkybox(VulkanCommandBuffer* pCommandBuffer);
+		void RenderSkybox(VulkanCommandBuffer* pCommandBuffer) const;
 
 		// Global uniform
 		static auto GetGlobalUniformAccessNameViewProjMat() -> const std::string&;
 		static auto GetGlobalUniformAccessNameCameraPos() -> const std::string&;
 		static auto GetGlobalUniformAccessNameNumDirLights() -> const std::string&;
-		static auto GetGlobalUniformAccessNameNumPointLights() -> const std::string&;
-		static auto GetGlobalUniformAccessNameNumSpotLights() -> const std::string&;
 		static auto GetGlobalUniformAccessNameDirLightDirections() -> const std::string&;
 		static auto GetGlobalUniformAccessNameDirLightColors() -> const std::string&;
-		static auto GetGlobalUniformAccessNamePointLightPositions() -> const std::string&;
-		static auto GetGlobalUniformAccessNamePointLightColors() -> const std::string&;
-		static auto GetGlobalUniformAccessNamePointLightAttenuations() -> const std::string&;
-		static auto GetGlobalUniformAccessNameSpotLightPositions() -> const std::string&;
-		static auto GetGlobalUniformAccessNameSpotLightDirections() -> const std::string&;
-		static auto GetGlobalUniformAccessNameSpotLightColors() -> const std::string&;
-		static auto GetGlobalUniformAccessNameSpotLightAttenuations() -> const std::string&;
-		static auto GetGlobalUniformAccessNameSpotLightCutoffs() -> const std::string&;
+		static auto GetGlobalUniformAccessNameCameraForward() -> const std::string&;
+		static auto GetGlobalUniformAccessNameClusterParams() -> const std::string&;
 		static auto GetGlobalUniformAccessNameCascadeViewProjMatrices() -> const std::string&;
 		static auto GetGlobalUniformAccessNameCascadeSplitDistances() -> const std::string&;
 		static auto GetGlobalUniformAccessNameAmbientColor() -> const std::string&;
@@ -163,6 +193,9 @@ namespace Ailurus
 		// Shader library
 		std::unique_ptr<ShaderLibrary> _pShaderLibrary;
 
+		// Render side proxies of the scene, updated incrementally
+		std::unique_ptr<RenderWorld> _pRenderWorld;
+
 		// Intermediate variables for every frame
 		std::unique_ptr<RenderIntermediateVariable> _pIntermediateVariable;
 
@@ -171,28 +204,49 @@ namespace Ailurus
 		static const char* GLOBAL_UNIFORM_ACCESS_VIEW_PROJ_MAT;
 		static const char* GLOBAL_UNIFORM_ACCESS_CAMERA_POS;
 		static const char* GLOBAL_UNIFORM_ACCESS_NUM_DIR_LIGHTS;
-		static const char* GLOBAL_UNIFORM_ACCESS_NUM_POINT_LIGHTS;
-		static const char* GLOBAL_UNIFORM_ACCESS_NUM_SPOT_LIGHTS;
 		static const char* GLOBAL_UNIFORM_ACCESS_DIR_LIGHT_DIRECTIONS;
 		static const char* GLOBAL_UNIFORM_ACCESS_DIR_LIGHT_COLORS;
-		static const char* GLOBAL_UNIFORM_ACCESS_POINT_LIGHT_POSITIONS;
-		static const char* GLOBAL_UNIFORM_ACCESS_POINT_LIGHT_COLORS;
-		static const char* GLOBAL_UNIFORM_ACCESS_POINT_LIGHT_ATTENUATIONS;
-		static const char* GLOBAL_UNIFORM_ACCESS_SPOT_LIGHT_POSITIONS;
-		static const char* GLOBAL_UNIFORM_ACCESS_SPOT_LIGHT_DIRECTIONS;
-		static const char* GLOBAL_UNIFORM_ACCESS_SPOT_LIGHT_COLORS;
-		static const char* GLOBAL_UNIFORM_ACCESS_SPOT_LIGHT_ATTENUATIONS;
-		static const char* GLOBAL_UNIFORM_ACCESS_SPOT_LIGHT_CUTOFFS;
+		static const char* GLOBAL_UNIFORM_ACCESS_CAMERA_FORWARD;
+		static const char* GLOBAL_UNIFORM_ACCESS_CLUSTER_PARAMS;
 		static const char* GLOBAL_UNIFORM_ACCESS_CASCADE_VIEW_PROJ_MATRICES;
 		static const char* GLOBAL_UNIFORM_ACCESS_CASCADE_SPLIT_DISTANCES;
 		static const char* GLOBAL_UNIFORM_ACCESS_AMBIENT_COLOR;
 		static const char* GLOBAL_UNIFORM_ACCESS_SHADOW_BIAS_PARAMS;
 		static constexpr int MAX_DIRECTIONAL_LIGHTS = 4;
-		static constexpr int MAX_POINT_LIGHTS = 8;
-		static constexpr int MAX_SPOT_LIGHTS = 4;
+
+		// Max draws recorded into one secondary command buffer
+		static constexpr uint32_t DRAW_CHUNK_SIZE = 256;
 		std::unique_ptr<UniformSet> _pGlobalUniformSet;
 		std::unique_ptr<UniformSetMemory> _pGlobalUniformMemory;
 
+		// Global uniform members, resolved once when the global uniform is built
+		struct GlobalUniformHandles
+		{
+			UniformHandle viewProjectionMatrix;
+			UniformHandle cameraPosition;
+			UniformHandle numDirectionalLights;
+			UniformHandle dirLightDirections;
+			UniformHandle dirLightColors;
+			UniformHandle cameraForward;
+			UniformHandle clusterParams;
+			UniformHandle cascadeViewProjMatrices;
+			UniformHandle cascadeSplitDistances;
+			UniformHandle ambientColor;
+			UniformHandle shadowBiasParams;
+		};
+		GlobalUniformHandles _globalUniformHandles;
+
+		// Binding groups of the persistent global and material sets written apart from their
+		// uniform buffers, the storage buffers of the global set are rewritten every frame
+		static constexpr uint32_t GLOBAL_SHADOW_BINDING_GROUP = 1;
+		static constexpr uint32_t GLOBAL_IBL_BINDING_GROUP = 2;
+		static constexpr uint32_t MATERIAL_TEXTURE_BINDING_GROUP = 1;
+
+		// Per instance model matrices of every draw list, read through gl_InstanceIndex (set 0, binding 2)
+		static constexpr uint32_t INSTANCE_BUFFER_BINDING = 2;
+		static constexpr size_t INSTANCE_BUFFER_INITIAL_CAPACITY = 1024 * sizeof(Matrix4x4f);
+		std::unique_ptr<VulkanStorageBuffer> _pInstanceBuffer;
+
 		// Clear color
 		std::array<float, 4> _clearColor = {0.1f, 0.1f, 0.1f, 1.0f};
 
@@ -223,6 +277,24 @@ namespace Ailurus
 		// IBL
 		std::unique_ptr<IBLManager> _pIBLManager;
 
+		// GPU driven culling, created when first enabled
+		std::unique_ptr<GpuCulling> _pGpuCulling;
+		bool _gpuDrivenCullingEnabled = false;
+
+		// Software occlusion culling
+		std::unique_ptr<OcclusionCulling> _pOcclusionCulling;
+		bool _occlusionCullingEnabled = true;
+
+		// Point and spot lights binned into froxels (set 0, bindings 3 and 4)
+		std::unique_ptr<ClusteredLighting> _pClusteredLighting;
+
+		// Textures of bindless materials, indexed from their uniform data
+		std::unique_ptr<BindlessTextureTable> _pBindlessTextures;
+
+		// Level of detail selection
+		float _lodBias = 1.0f;
+		float _shadowLodBias = 0.5f;
+
 		// Render statistics
 		RenderStats _renderStats;
 
@@ -7,13 +7,14 @@ namespace Ailurus
 {
 	REFLECTION_ENUM(ShaderStage,
 		Vertex,
-		Fragment)
+		Fragment,
+		Compute)
 
 	class Shader;
 
 	struct StageShaderArray
 	{
-		const Shader* shaders[EnumReflection<ShaderStage>::Size()];
+		const Shader* shaders[EnumReflection<ShaderStage>::Size()] = {};
 
 		constexpr static size_t Size()
 		{
@@ -10,6 +10,17 @@
 
 namespace Ailurus
 {
+	/// std140 placement of one access path inside a binding point
+	struct UniformAccessLayout
+	{
+		UniformVariableType variableType = UniformVariableType::Numeric;
+		UniformValueType valueType = UniformValueType::Int;	// Element type for arrays, unused for structures
+		uint32_t offset = 0;
+		uint32_t size = 0;			// Bytes spanned, including array and structure padding
+		uint32_t arrayStride = 0;	// Arrays only
+		uint32_t arrayCount = 0;	// Arrays only
+	};
+
 	class UniformBindingPoint: public NonCopyable, public NonMovable
 	{
 	public:
@@ -24,6 +35,7 @@ namespace Ailurus
 		UniformVariable* GetUniform();
 		uint32_t GetTotalSize() const;
 		std::optional<uint32_t> GetAccessOffset(const std::string& accessName) const;
+		std::optional<UniformAccessLayout> GetAccessLayout(const std::string& accessName) const;
 
 	private:
 		uint32_t _bindingPoint = 0;
@@ -32,6 +44,6 @@ namespace Ailurus
 		std::unique_ptr<UniformVariable> _pUniformVariable;
 
 		uint32_t _totalSize = 0;
-		std::unordered_map<std::string, uint32_t> _accessNameToBufferOffsetMap;
+		std::unordered_map<std::string, UniformAccessLayout> _accessNameToLayoutMap;
 	};
 } // namespace Ailurus
\ No newline at end of file
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include "UniformBindingPoint.h"
+
+namespace Ailurus
+{
+	/// An access path of a uniform set resolved once by UniformSet::ResolveHandle. Writing through
+	/// a handle copies straight to the uniform buffer offset, no string building or map lookup.
+	struct UniformHandle
+	{
+		uint32_t bindingId = 0;
+		uint32_t offset = 0;	// In the set's uniform buffer, binding point offset included
+		UniformAccessLayout layout;
+		bool valid = false;
+
+		bool IsValid() const { return valid; }
+	};
+
+	/// Uniform value type written by a C++ type
+	template <typename T>
+	struct UniformValueTypeOf;
+
+	template <>
+	struct UniformValueTypeOf<int32_t>
+	{
+		static constexpr UniformValueType value = UniformValueType::Int;
+	};
+
+	template <>
+	struct UniformValueTypeOf<float>
+	{
+		static constexpr UniformValueType value = UniformValueType::Float;
+	};
+
+	template <>
+	struct UniformValueTypeOf<Vector2f>
+	{
+		static constexpr UniformValueType value = UniformValueType::Vector2;
+	};
+
+	template <>
+	struct UniformValueTypeOf<Vector3f>
+	{
+		static constexpr UniformValueType value = UniformValueType::Vector3;
+	};
+
+	template <>
+	struct UniformValueTypeOf<Vector4f>
+	{
+		static constexpr UniformValueType value = UniformValueType::Vector4;
+	};
+
+	template <>
+	struct UniformValueTypeOf<Matrix4x4f>
+	{
+		static constexpr UniformValueType value = UniformValueType::Mat4;
+	};
+} // namespace Ailurus
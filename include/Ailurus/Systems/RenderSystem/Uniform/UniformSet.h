@@ -5,13 +5,14 @@
 #include <vector>
 #include "Ailurus/Utility/EnumReflection.h"
 #include "UniformBindingPoint.h"
+#include "UniformHandle.h"
 #include "Ailurus/Systems/RenderSystem/Descriptor/DescriptorSetSchema.h"
 
 namespace Ailurus
 {
-	class VulkanUniformBuffer;
 	class VulkanDescriptorSetLayout;
 	struct TextureBindingInfo;
+	struct StorageBufferBindingInfo;
 
 	REFLECTION_ENUM(UniformSetUsage,
 		General,
@@ -31,6 +32,8 @@ namespace Ailurus
 		void InitUniformBufferInfo();
 		void InitDescriptorSetLayout(); // For uniform sets without textures
 		void InitDescriptorSetLayout(const std::vector<TextureBindingInfo>& textureBindings); // For uniform sets with textures
+		void InitDescriptorSetLayout(const std::vector<TextureBindingInfo>& textureBindings,
+			const std::vector<StorageBufferBindingInfo>& storageBufferBindings); // For uniform sets with textures and storage buffers
 
 		// Getter
 		auto GetAllBindingPoints() const -> const BindingPointMap&;
@@ -39,6 +42,9 @@ namespace Ailurus
 		auto GetSetId() const -> uint32_t;
 		auto GetUniformBufferSize() const -> uint32_t;
 
+		// Resolve an access path once for UniformSetMemory::Write, invalid if it does not exist
+		auto ResolveHandle(uint32_t bindingPoint, const std::string& access) const -> UniformHandle;
+
 	private:
 		// Set id in shader
 		uint32_t _setId;
@@ -1,30 +1,78 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 #include <vulkan/vulkan.hpp>
 #include "UniformSet.h"
 #include "UniformAccess.h"
+#include "UniformHandle.h"
 #include "Ailurus/Systems/RenderSystem/Descriptor/DescriptorSetData.h"
 #include "VulkanContext/Descriptor/VulkanDescriptorSet.h"
 
 namespace Ailurus
 {
-	class VulkanUniformBuffer;
+	class VulkanHostBuffer;
 	class VulkanCommandBuffer;
+	class VulkanPersistentDescriptorSet;
 	class MaterialInstance;
 
+	enum class UniformSetMemoryUsage
+	{
+		// Written rarely, e.g. material constants. Values are recorded by access name and each frame
+		// in flight keeps its own copy, only the bytes changed since that copy was last used are uploaded.
+		Static,
+		// Rewritten every frame, e.g. the global uniform. Nothing is recorded and the whole set is
+		// copied into the frame's uniform ring.
+		PerFrame,
+	};
+
 	class UniformSetMemory : public DescriptorSetData
 	{
 	public:
-		UniformSetMemory(const UniformSet* pTargetUniformSet);
+		explicit UniformSetMemory(const UniformSet* pTargetUniformSet, UniformSetMemoryUsage usage = UniformSetMemoryUsage::Static);
 		~UniformSetMemory() override;
 
 	public:
 		auto GetUniformValueMap() const -> const UniformValueMap&;
 		auto SetUniformValue(uint32_t bindingId, const std::string& access, const UniformValue& value) -> void;
 		auto SetUniformValue(const UniformAccess& entry, const UniformValue& value) -> void;
-		auto UpdateToDescriptorSet(VulkanCommandBuffer* pCommandBuffer, VulkanDescriptorSet descriptorSet) const -> void;
+
+		// Binding group of the uniform buffers in the persistent descriptor set, callers writing the
+		// set's other bindings use the groups after it
+		static constexpr uint32_t UNIFORM_BINDING_GROUP = 0;
+
+		// Upload the values for this frame and return this frame's persistent descriptor set, its
+		// uniform bindings rewritten only when the buffer behind them changed. The set is then
+		// bound with GetDynamicOffset() once per binding point.
+		auto UpdatePersistentDescriptorSet() -> VulkanDescriptorSet;
+		auto GetPersistentDescriptorSet() const -> VulkanPersistentDescriptorSet*;
+		auto GetDynamicOffset() const -> uint32_t;
+		auto GetDynamicOffsetCount() const -> uint32_t;
+
+		// Bumped by every write that changes a byte
+		auto GetVersion() const -> uint64_t;
+
+		// Bytes copied to GPU visible memory by the last upload
+		auto GetLastUploadSize() const -> uint32_t;
+
+		// Writes through resolved handles copy straight into the values and are never recorded
+		template <typename T>
+		auto Write(const UniformHandle& handle, const T& value) -> void
+		{
+			WriteValue(handle, UniformValueTypeOf<T>::value, &value, sizeof(T));
+		}
+
+		// Write count elements of an array handle starting at firstElement
+		template <typename T>
+		auto WriteArray(const UniformHandle& handle, const T* pElements, uint32_t count, uint32_t firstElement = 0) -> void
+		{
+			WriteElements(handle, UniformValueTypeOf<T>::value, pElements, sizeof(T), count, firstElement);
+		}
+
+		// Copy bytes already laid out in std140 over the start of any handle, e.g. a whole structure
+		auto WriteBlock(const UniformHandle& handle, const void* pData, uint32_t size) -> void;
 
 	protected:
 		void PrepareGpuData(VulkanCommandBuffer* pCmdBuffer) override;
@@ -32,16 +80,42 @@ namespace Ailurus
 		auto ComputeBindingHash() const -> size_t override;
 
 	private:
-		auto TransitionDataToGpu(VulkanCommandBuffer* pCommandBuffer) const -> void;
+		auto Upload() -> void;
+		auto UploadToFrameRing() -> void;
+		auto UploadToFrameCopy() -> void;
+		auto WriteBytes(uint32_t offset, const void* pData, uint32_t size) -> void;
+		auto WriteValue(const UniformHandle& handle, UniformValueType type, const void* pData, uint32_t size) -> void;
+		auto WriteElements(const UniformHandle& handle, UniformValueType type, const void* pElements,
+			uint32_t elementSize, uint32_t count, uint32_t firstElement) -> void;
 
 	private:
 		// Target uniform set
 		const UniformSet* _pTargetUniformSet;
 
-		// Uniform access -> uniform value
+		// Uniform access -> uniform value, static sets only
+		UniformSetMemoryUsage _usage;
 		UniformValueMap _uniformValueMap;
 
-		// Uniform buffer memory
-		std::unique_ptr<VulkanUniformBuffer> _pUniformBuffer;
+		// Values of every binding point laid out as in the set's uniform buffer
+		std::vector<uint8_t> _data;
+		uint64_t _version = 0;
+
+		// Static sets, one copy per frame in flight with the bytes written since it was last uploaded
+		struct FrameCopy
+		{
+			VulkanHostBuffer* pBuffer = nullptr;
+			uint64_t version = 0;
+			uint32_t dirtyBegin = 0;
+			uint32_t dirtyEnd = 0;
+		};
+		std::vector<FrameCopy> _frameCopies;
+
+		// Allocated on first update, kept for the lifetime of the memory
+		std::unique_ptr<VulkanPersistentDescriptorSet> _pPersistentSet;
+
+		// Buffer and offset the values were last uploaded to
+		VulkanHostBuffer* _pFrameBuffer = nullptr;
+		uint32_t _frameOffset = 0;
+		uint32_t _lastUploadSize = 0;
 	};
 } // namespace Ailurus
\ No newline at end of file
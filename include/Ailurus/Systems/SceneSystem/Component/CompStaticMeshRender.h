@@ -1,5 +1,6 @@
 #pragma once
 
+#include <optional>
 #include "CompRender.h"
 #include "Ailurus/Systems/AssetsSystem/Model/Model.h"
 #include "Ailurus/Systems/AssetsSystem/Material/MaterialInstance.h"
@@ -21,10 +22,22 @@ namespace Ailurus
 		const AssetRef<MaterialInstance>& GetMaterialInstanceAsset() const;
 		AABBf GetWorldAABB() const;
 
+		// Occluders are rasterized into the software occlusion buffer to hide what is behind them
+		void SetOccluder(bool isOccluder);
+		bool IsOccluder() const;
+
+		// Local space box rasterized as the occluder hull. It must stay inside the rendered geometry,
+		// a hull larger than the mesh hides visible objects. Occluders without one are not rasterized,
+		// the model bounds of a concave mesh would cover its openings.
+		void SetOccluderBounds(const AABBf& localBounds);
+		const std::optional<AABBf>& GetOccluderBounds() const;
+
 		nlohmann::json Serialize() const override;
 
 	private:
 		AssetRef<Model> _modelAsset;
 		AssetRef<MaterialInstance> _materialAsset;
+		bool _isOccluder = false;
+		std::optional<AABBf> _occluderBounds;
 	};
 } // namespace Ailurus
\ No newline at end of file
@@ -80,12 +80,29 @@ namespace Ailurus
 		template <typename T>
 		auto RemoveComponent() -> bool;
 
-		/// Get the model matrix of the entity
-		auto GetModelMatrix() const -> Matrix4x4f;
+		/// Get the local TRS matrix of the entity, cached until the transform changes
+		auto GetLocalMatrix() const -> const Matrix4x4f&;
+
+		/// Get the model (world) matrix of the entity, cached until the entity or an ancestor
+		/// changes. Recomputing a dirty matrix is not thread safe, SceneSystem::UpdateTransforms
+		/// refreshes all of them once per frame before rendering.
+		auto GetModelMatrix() const -> const Matrix4x4f&;
 
 	private:
 		friend class SceneSystem;
 
+		/// Call OnAttach and notify the scene system, shared by the AddComponent templates
+		auto OnComponentAttached(Component* pComp) -> void;
+
+		/// Call OnDetach and notify the scene system, before the component is destroyed
+		auto OnComponentDetached(Component* pComp) -> void;
+
+		/// Local transform changed, the local matrix and the whole subtree are stale
+		auto MarkLocalMatrixDirty() -> void;
+
+		/// World matrix of this entity and all descendants is stale
+		auto MarkWorldMatrixDirty() -> void;
+
 		// Global uid
 		uint32_t _guid;
 		SceneSystem* _sceneSystem = nullptr;
@@ -102,6 +119,16 @@ namespace Ailurus
 		Quaternionf _rotation = Quaternionf::Identity;
 		Vector3f _scale = Vector3f::One;
 
+		// Cached matrices. A dirty world matrix implies the world matrices of all
+		// descendants are dirty too, which lets dirty propagation stop early.
+		mutable Matrix4x4f _localMatrix = Matrix4x4f::Identity;
+		mutable Matrix4x4f _worldMatrix = Matrix4x4f::Identity;
+		mutable bool _localMatrixDirty = true;
+		mutable bool _worldMatrixDirty = true;
+
+		// Root subtree range in SceneSystem's flattened hierarchy
+		uint32_t _hierarchyRootIndex = 0;
+
 		// Components
 		std::unordered_map<ComponentType, std::vector<std::unique_ptr<Component>>> _components;
 	};
@@ -118,7 +145,7 @@ namespace Ailurus
 		auto& vec = _components[T::StaticType];
 		vec.push_back(std::move(pComp));
 		T* result = static_cast<T*>(vec.back().get());
-		result->OnAttach();
+		OnComponentAttached(result);
 		return result;
 	}
 
@@ -134,7 +161,7 @@ namespace Ailurus
 		auto& vec = _components[T::StaticType];
 		vec.push_back(std::move(pComp));
 		T* result = static_cast<T*>(vec.back().get());
-		result->OnAttach();
+		OnComponentAttached(result);
 		return result;
 	}
 
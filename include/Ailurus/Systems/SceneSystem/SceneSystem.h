@@ -1,8 +1,10 @@
 #pragma once
 
+#include <cstdint>
 #include <unordered_map>
 #include <memory>
 #include <string>
+#include <vector>
 #include "Ailurus/Utility/NonCopyable.h"
 #include "Ailurus/Utility/NonMovable.h"
 #include "Entity/Entity.h"
@@ -19,6 +21,8 @@ namespace Ailurus
 		virtual void OnEntityNameChanged(const Entity& entity) {}
 		virtual void OnEntityParentChanged(const Entity& entity) {}
 		virtual void OnEntityTransformChanged(const Entity& entity) {}
+		virtual void OnComponentAttached(const Entity& entity, const Component& component) {}
+		virtual void OnComponentDetached(const Entity& entity, const Component& component) {}
 	};
 
     class SceneSystem : public NonCopyable, public NonMovable
@@ -35,6 +39,9 @@ namespace Ailurus
 		bool DestroyEntity(const std::weak_ptr<Entity>& pEntity);
 		std::vector<Entity*> GetAllRawEntities() const;
 		void UpdateAllComponents(float deltaTime);
+		/// Refresh cached world matrices of every entity whose transform changed, root subtrees
+		/// are updated in parallel. Called once per frame by Application before rendering.
+		void UpdateTransforms();
 		void SaveToFile(const std::string& filePath) const;
 		void LoadFromFile(const std::string& filePath);
 
@@ -47,11 +54,28 @@ namespace Ailurus
 		void NotifyEntityNameChanged(const Entity& entity);
 		void NotifyEntityParentChanged(const Entity& entity);
 		void NotifyEntityTransformChanged(const Entity& entity);
+		void NotifyComponentAttached(const Entity& entity, const Component& component);
+		void NotifyComponentDetached(const Entity& entity, const Component& component);
+		void MarkTransformDirty(const Entity& entity);
+		void MarkHierarchyDirty();
+		void RebuildHierarchy();
+		void UpdateHierarchyRange(uint32_t begin, uint32_t end);
 
 	private:
 		uint32_t _entityIdCounter = 0;
 		std::unordered_map<uint32_t, std::shared_ptr<Entity>> _entityMap;
 		std::unordered_map<void*, SceneObserver*> _observers;
+
+		// Transform hierarchy flattened in parent-before-child order, one contiguous range per
+		// root subtree: range i is [_hierarchyRootBegins[i], _hierarchyRootBegins[i + 1]).
+		static constexpr uint32_t INVALID_HIERARCHY_INDEX = UINT32_MAX;
+		static constexpr uint32_t HIERARCHY_ROOTS_PER_JOB = 32;
+		std::vector<Entity*> _hierarchyEntities;
+		std::vector<uint32_t> _hierarchyParentIndices;
+		std::vector<uint32_t> _hierarchyRootBegins;
+		std::vector<uint8_t> _hierarchyDirtyRoots;
+		std::vector<uint32_t> _dirtyRootIndices;
+		bool _hierarchyNeedRebuild = true;
 	};
 
 } // namespace Ailurus
\ No newline at end of file
@@ -0,0 +1,412 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+namespace Ailurus
+{
+    /// Quadric error metric edge collapse simplification of an indexed triangle list.
+    ///
+    /// Collapses are half-edge collapses, a vertex is merged into a neighbour and takes its
+    /// position, so the result indexes the original vertices and can share their buffer.
+    /// Vertices on open borders and on attribute seams (several vertices at one position) are
+    /// locked, silhouettes and texture seams stay intact. Each pass sorts the candidate
+    /// collapses by error and applies the cheapest ones that do not touch each other or flip
+    /// a triangle, until the target is reached or the next collapse would exceed maxError.
+    class MeshSimplifier
+    {
+    public:
+        /// @param positions First position, three floats per vertex
+        /// @param positionStride Bytes between two consecutive positions
+        /// @param maxError Largest allowed distance of the surface from the original
+        /// @param pResultError Distance error of the returned mesh, optional
+        /// @return Triangle list indexing the original vertices, as close to targetIndexCount as
+        ///         maxError and the locked vertices allow
+        static std::vector<uint32_t> Simplify(const float* positions, uint32_t vertexCount, size_t positionStride,
+            const uint32_t* indices, uint32_t indexCount, uint32_t targetIndexCount, float maxError,
+            float* pResultError = nullptr)
+        {
+            std::vector<uint32_t> result(indices, indices + indexCount);
+            if (pResultError != nullptr)
+                *pResultError = 0.0f;
+
+            if (indexCount % 3 != 0 || indexCount <= targetIndexCount)
+                return result;
+
+            MeshSimplifier simplifier(positions, vertexCount, positionStride);
+            simplifier.BuildQuadrics(result);
+            simplifier.LockBorders(result);
+
+            const double maxCost = static_cast<double>(maxError) * maxError;
+            double resultCost = 0.0;
+            while (result.size() > targetIndexCount)
+            {
+                const uint32_t trianglesToRemove = static_cast<uint32_t>(result.size() - targetIndexCount) / 3;
+                if (!simplifier.CollapsePass(result, std::max(trianglesToRemove, 1u), maxCost, resultCost))
+                    break;
+            }
+
+            if (pResultError != nullptr)
+                *pResultError = static_cast<float>(std::sqrt(resultCost));
+
+            return result;
+        }
+
+    private:
+        using Vec3 = std::array<double, 3>;
+
+        // A collapse may rotate a surviving triangle's normal by at most about 75 degrees
+        static constexpr double MIN_NORMAL_COS = 0.25;
+
+        /// Symmetric 4x4 matrix, upper triangle row by row, and the summed area of its planes
+        struct Quadric
+        {
+            std::array<double, 10> m{};
+            double weight = 0.0;
+
+            static Quadric FromPlane(double a, double b, double c, double d, double weight)
+            {
+                Quadric q;
+                q.m = { a * a, a * b, a * c, a * d, b * b, b * c, b * d, c * c, c * d, d * d };
+                for (double& value : q.m)
+                    value *= weight;
+                q.weight = weight;
+                return q;
+            }
+
+            void Add(const Quadric& other)
+            {
+                for (size_t i = 0; i < m.size(); i++)
+                    m[i] += other.m[i];
+                weight += other.weight;
+            }
+
+            /// Area weighted mean squared distance of p to the planes
+            double Evaluate(const Vec3& p) const
+            {
+                if (weight <= 0.0)
+                    return 0.0;
+
+                const double x = p[0], y = p[1], z = p[2];
+                const double error = m[0] * x * x + 2 * m[1] * x * y + 2 * m[2] * x * z + 2 * m[3] * x
+                    + m[4] * y * y + 2 * m[5] * y * z + 2 * m[6] * y
+                    + m[7] * z * z + 2 * m[8] * z
+                    + m[9];
+                return std::max(error, 0.0) / weight;
+            }
+        };
+
+        struct Collapse
+        {
+            uint32_t from;
+            uint32_t to;
+            double cost;
+        };
+
+        MeshSimplifier(const float* positions, uint32_t vertexCount, size_t positionStride)
+            : _positions(vertexCount)
+            , _quadrics(vertexCount)
+            , _normals(vertexCount, Vec3{ 0.0, 0.0, 0.0 })
+            , _locked(vertexCount, 0)
+            , _touched(vertexCount, 0)
+            , _remap(vertexCount)
+        {
+            const auto* pBytes = reinterpret_cast<const uint8_t*>(positions);
+            for (uint32_t i = 0; i < vertexCount; i++)
+            {
+                float p[3];
+                std::memcpy(p, pBytes + i * positionStride, sizeof(p));
+                _positions[i] = { p[0], p[1], p[2] };
+            }
+
+            LockSeams(pBytes, positionStride);
+        }
+
+        static Vec3 Sub(const Vec3& a, const Vec3& b)
+        {
+            return { a[0] - b[0], a[1] - b[1], a[2] - b[2] };
+        }
+
+        static Vec3 Cross(const Vec3& a, const Vec3& b)
+        {
+            return { a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0] };
+        }
+
+        static double Dot(const Vec3& a, const Vec3& b)
+        {
+            return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+        }
+
+        Vec3 TriangleNormal(uint32_t a, uint32_t b, uint32_t c) const
+        {
+            return Cross(Sub(_positions[b], _positions[a]), Sub(_positions[c], _positions[a]));
+        }
+
+        void LockSeams(const uint8_t* pBytes, size_t positionStride)
+        {
+            struct PositionKey
+            {
+                uint32_t bits[3];
+                bool operator==(const PositionKey& other) const { return std::memcmp(bits, other.bits, sizeof(bits)) == 0; }
+            };
+
+            struct PositionHash
+            {
+                size_t operator()(const PositionKey& key) const
+                {
+                    return (key.bits[0] * 73856093u) ^ (key.bits[1] * 19349663u) ^ (key.bits[2] * 83492791u);
+                }
+            };
+
+            // Vertices sharing a position differ in another attribute, moving one of them tears the surface
+            std::unordered_map<PositionKey, uint32_t, PositionHash> firstVertex;
+            firstVertex.reserve(_positions.size());
+            for (uint32_t i = 0; i < static_cast<uint32_t>(_positions.size()); i++)
+            {
+                PositionKey key;
+                std::memcpy(key.bits, pBytes + i * positionStride, sizeof(key.bits));
+
+                const auto [itr, inserted] = firstVertex.emplace(key, i);
+                if (!inserted)
+                {
+                    _locked[i] = 1;
+                    _locked[itr->second] = 1;
+                }
+            }
+        }
+
+        void BuildQuadrics(const std::vector<uint32_t>& indices)
+        {
+            for (size_t t = 0; t < indices.size(); t += 3)
+            {
+                const uint32_t a = indices[t], b = indices[t + 1], c = indices[t + 2];
+                const Vec3 normal = TriangleNormal(a, b, c);
+                const double length = std::sqrt(Dot(normal, normal));
+                if (length <= 0.0)
+                    continue;
+
+                // Weighted by area, large faces dominate the error of their corners
+                const Vec3 n = { normal[0] / length, normal[1] / length, normal[2] / length };
+                const Quadric plane = Quadric::FromPlane(n[0], n[1], n[2], -Dot(n, _positions[a]), length * 0.5);
+                for (const uint32_t corner : { a, b, c })
+                {
+                    _quadrics[corner].Add(plane);
+                    for (int i = 0; i < 3; i++)
+                        _normals[corner][i] += normal[i];
+                }
+            }
+        }
+
+        void LockBorders(const std::vector<uint32_t>& indices)
+        {
+            // An edge used by one triangle only lies on an open border
+            std::unordered_map<uint64_t, uint32_t> edgeUses;
+            edgeUses.reserve(indices.size());
+            for (size_t t = 0; t < indices.size(); t += 3)
+            {
+                for (int e = 0; e < 3; e++)
+                {
+                    const uint32_t a = indices[t + e], b = indices[t + (e + 1) % 3];
+                    edgeUses[EdgeKey(a, b)]++;
+                }
+            }
+
+            for (const auto& [key, uses] : edgeUses)
+            {
+                if (uses != 1)
+                    continue;
+
+                _locked[static_cast<uint32_t>(key >> 32)] = 1;
+                _locked[static_cast<uint32_t>(key)] = 1;
+            }
+        }
+
+        static uint64_t EdgeKey(uint32_t a, uint32_t b)
+        {
+            return a < b ? (uint64_t(a) << 32) | b : (uint64_t(b) << 32) | a;
+        }
+
+        void BuildAdjacency(const std::vector<uint32_t>& indices)
+        {
+            _adjacencyOffsets.assign(_positions.size() + 1, 0);
+            for (const uint32_t index : indices)
+                _adjacencyOffsets[index + 1]++;
+
+            for (size_t i = 1; i < _adjacencyOffsets.size(); i++)
+                _adjacencyOffsets[i] += _adjacencyOffsets[i - 1];
+
+            _adjacency.resize(indices.size());
+            std::vector<uint32_t> cursor(_adjacencyOffsets.begin(), _adjacencyOffsets.end() - 1);
+            for (size_t i = 0; i < indices.size(); i++)
+                _adjacency[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+
+        /// Vertices adjacent to both ends of the edge, other than the tips of the triangles on it.
+        /// Collapsing such an edge pinches the surface and leaves folded duplicate triangles.
+        bool ViolatesLink(const std::vector<uint32_t>& indices, uint32_t from, uint32_t to)
+        {
+            _fromNeighbours.clear();
+            uint32_t edgeTriangles = 0;
+            for (uint32_t i = _adjacencyOffsets[from]; i < _adjacencyOffsets[from + 1]; i++)
+            {
+                const uint32_t t = _adjacency[i] * 3;
+                bool hasTo = false;
+                for (uint32_t j = t; j < t + 3; j++)
+                {
+                    hasTo |= indices[j] == to;
+                    if (indices[j] != from)
+                        _fromNeighbours.push_back(indices[j]);
+                }
+                edgeTriangles += hasTo ? 1 : 0;
+            }
+
+            std::sort(_fromNeighbours.begin(), _fromNeighbours.end());
+            _fromNeighbours.erase(std::unique(_fromNeighbours.begin(), _fromNeighbours.end()), _fromNeighbours.end());
+
+            _sharedNeighbours.clear();
+            for (uint32_t i = _adjacencyOffsets[to]; i < _adjacencyOffsets[to + 1]; i++)
+            {
+                const uint32_t t = _adjacency[i] * 3;
+                for (uint32_t j = t; j < t + 3; j++)
+                {
+                    if (indices[j] != to && std::binary_search(_fromNeighbours.begin(), _fromNeighbours.end(), indices[j]))
+                        _sharedNeighbours.push_back(indices[j]);
+                }
+            }
+
+            std::sort(_sharedNeighbours.begin(), _sharedNeighbours.end());
+            const auto sharedCount = std::unique(_sharedNeighbours.begin(), _sharedNeighbours.end()) - _sharedNeighbours.begin();
+            return sharedCount > edgeTriangles;
+        }
+
+        /// Moving from onto to must not turn any surviving triangle around, nor fold it close to its
+        /// edge. Checked against the original surface around from too, small rotations of
+        /// successive passes would add up otherwise.
+        bool FlipsTriangle(const std::vector<uint32_t>& indices, uint32_t from, uint32_t to) const
+        {
+            for (uint32_t i = _adjacencyOffsets[from]; i < _adjacencyOffsets[from + 1]; i++)
+            {
+                const uint32_t t = _adjacency[i] * 3;
+                uint32_t corners[3] = { indices[t], indices[t + 1], indices[t + 2] };
+                if (corners[0] == to || corners[1] == to || corners[2] == to)
+                    continue;
+
+                const Vec3 before = TriangleNormal(corners[0], corners[1], corners[2]);
+                for (uint32_t& corner : corners)
+                    corner = corner == from ? to : corner;
+
+                const Vec3 after = TriangleNormal(corners[0], corners[1], corners[2]);
+                if (Dot(before, after) <= MIN_NORMAL_COS * std::sqrt(Dot(before, before) * Dot(after, after)))
+                    return true;
+
+                if (Dot(_normals[from], after) <= 0.0)
+                    return true;
+            }
+
+            return false;
+        }
+
+        bool CollapsePass(std::vector<uint32_t>& indices, uint32_t trianglesToRemove, double maxCost, double& resultCost)
+        {
+            BuildAdjacency(indices);
+
+            _collapses.clear();
+            for (size_t t = 0; t < indices.size(); t += 3)
+            {
+                for (int e = 0; e < 3; e++)
+                {
+                    const uint32_t a = indices[t + e], b = indices[t + (e + 1) % 3];
+                    if (!_locked[a])
+                        _collapses.push_back(Collapse{ a, b, CollapseCost(a, b) });
+                    if (!_locked[b])
+                        _collapses.push_back(Collapse{ b, a, CollapseCost(b, a) });
+                }
+            }
+
+            if (_collapses.empty())
+                return false;
+
+            std::sort(_collapses.begin(), _collapses.end(), [](const Collapse& lhs, const Collapse& rhs) -> bool {
+                return lhs.cost < rhs.cost;
+            });
+
+            for (uint32_t i = 0; i < static_cast<uint32_t>(_remap.size()); i++)
+                _remap[i] = i;
+            std::fill(_touched.begin(), _touched.end(), 0);
+
+            // An interior edge collapse removes the two triangles sharing it
+            uint32_t removed = 0;
+            bool collapsed = false;
+            for (const Collapse& collapse : _collapses)
+            {
+                if (removed >= trianglesToRemove || collapse.cost > maxCost)
+                    break;
+
+                if (_touched[collapse.from] || _touched[collapse.to])
+                    continue;
+
+                if (FlipsTriangle(indices, collapse.from, collapse.to) || ViolatesLink(indices, collapse.from, collapse.to))
+                    continue;
+
+                // Every corner of a triangle around from changes, keep later collapses away from them
+                for (uint32_t i = _adjacencyOffsets[collapse.from]; i < _adjacencyOffsets[collapse.from + 1]; i++)
+                {
+                    const uint32_t t = _adjacency[i] * 3;
+                    _touched[indices[t]] = _touched[indices[t + 1]] = _touched[indices[t + 2]] = 1;
+                }
+
+                _remap[collapse.from] = collapse.to;
+                _quadrics[collapse.to].Add(_quadrics[collapse.from]);
+                for (int i = 0; i < 3; i++)
+                    _normals[collapse.to][i] += _normals[collapse.from][i];
+                resultCost = std::max(resultCost, collapse.cost);
+                removed += 2;
+                collapsed = true;
+            }
+
+            if (!collapsed)
+                return false;
+
+            size_t writeIndex = 0;
+            for (size_t t = 0; t < indices.size(); t += 3)
+            {
+                const uint32_t a = _remap[indices[t]], b = _remap[indices[t + 1]], c = _remap[indices[t + 2]];
+                if (a == b || b == c || a == c)
+                    continue;
+
+                indices[writeIndex++] = a;
+                indices[writeIndex++] = b;
+                indices[writeIndex++] = c;
+            }
+
+            indices.resize(writeIndex);
+            return true;
+        }
+
+        double CollapseCost(uint32_t from, uint32_t to) const
+        {
+            Quadric q = _quadrics[from];
+            q.Add(_quadrics[to]);
+            return q.Evaluate(_positions[to]);
+        }
+
+    private:
+        std::vector<Vec3> _positions;
+        std::vector<Quadric> _quadrics;
+        std::vector<Vec3> _normals;
+        std::vector<uint8_t> _locked;
+        std::vector<uint8_t> _touched;
+        std::vector<uint32_t> _remap;
+        std::vector<uint32_t> _adjacencyOffsets;
+        std::vector<uint32_t> _adjacency;
+        std::vector<Collapse> _collapses;
+        std::vector<uint32_t> _fromNeighbours;
+        std::vector<uint32_t> _sharedNeighbours;
+    };
+}
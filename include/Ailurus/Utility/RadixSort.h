@@ -0,0 +1,77 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Ailurus
+{
+    /// Stable LSD radix sort by a 64-bit key, 8 bits per pass. All digit histograms are built in
+    /// one read of the input, then passes whose digit is identical for every key are skipped, so
+    /// keys that only use a few bits cost a few passes. Scratch is kept by the caller to reuse its
+    /// capacity across frames.
+    template <typename T, typename KeyFunc>
+    void RadixSort(std::vector<T>& items, std::vector<T>& scratch, KeyFunc&& getKey)
+    {
+        constexpr uint32_t DIGIT_BITS = 8;
+        constexpr uint32_t DIGIT_COUNT = 1u << DIGIT_BITS;
+        constexpr uint32_t DIGIT_MASK = DIGIT_COUNT - 1;
+        constexpr uint32_t PASS_COUNT = 64 / DIGIT_BITS;
+
+        // Below this the histograms cost more than a comparison sort
+        constexpr size_t SMALL_INPUT_SIZE = 64;
+
+        const size_t count = items.size();
+        if (count < 2)
+            return;
+
+        if (count <= SMALL_INPUT_SIZE)
+        {
+            std::stable_sort(items.begin(), items.end(), [&getKey](const T& lhs, const T& rhs) -> bool {
+                return getKey(lhs) < getKey(rhs);
+            });
+            return;
+        }
+
+        std::array<std::array<size_t, DIGIT_COUNT>, PASS_COUNT> histograms{};
+        for (const T& item : items)
+        {
+            const uint64_t key = getKey(item);
+            for (uint32_t pass = 0; pass < PASS_COUNT; pass++)
+                histograms[pass][(key >> (pass * DIGIT_BITS)) & DIGIT_MASK]++;
+        }
+
+        const uint64_t firstKey = getKey(items[0]);
+        scratch.resize(count);
+
+        for (uint32_t pass = 0; pass < PASS_COUNT; pass++)
+        {
+            const uint32_t shift = pass * DIGIT_BITS;
+            auto& histogram = histograms[pass];
+
+            // Every key shares this digit, the pass would only copy
+            if (histogram[(firstKey >> shift) & DIGIT_MASK] == count)
+                continue;
+
+            // Exclusive prefix sum turns counts into output offsets
+            size_t offset = 0;
+            for (auto& bucket : histogram)
+            {
+                const size_t bucketSize = bucket;
+                bucket = offset;
+                offset += bucketSize;
+            }
+
+            for (T& item : items)
+            {
+                const size_t digit = (getKey(item) >> shift) & DIGIT_MASK;
+                scratch[histogram[digit]++] = std::move(item);
+            }
+
+            items.swap(scratch);
+        }
+    }
+}
@@ -52,6 +52,7 @@ namespace Ailurus
 	std::function<void()> 			Application::_onMainLoopPreRender = nullptr;
 
 	std::unique_ptr<TimeSystem> 	Application::_pTimeSystem = nullptr;
+	std::unique_ptr<JobSystem> 		Application::_pJobSystem = nullptr;
 	std::unique_ptr<InputSystem> 	Application::_pInputManager = nullptr;
 	std::unique_ptr<RenderSystem> 	Application::_pRenderSystem = nullptr;
 	std::unique_ptr<AssetsSystem> 	Application::_pAssetsSystem = nullptr;
@@ -93,6 +94,9 @@ namespace Ailurus
 
 		SetWindowVisible(true);
 
+		// Created before vulkan so per-thread resources can be sized by worker count
+		_pJobSystem.reset(new JobSystem());
+
 		VulkanContext::Initialize(VulkanContextGetInstanceExtensions, VulkanContextCreateSurface, true);
 		if (!VulkanContext::Initialized())
 		{
@@ -102,9 +106,11 @@ namespace Ailurus
 
 		_pTimeSystem.reset(new TimeSystem());
 		_pInputManager.reset(new InputSystem());
+
+		// Created before render system, which observes the scene
+		_pSceneManager.reset(new SceneSystem());
 		_pRenderSystem.reset(new RenderSystem(style.enableRender3D, style.skyboxHDRTexturePath));
 		_pAssetsSystem.reset(new AssetsSystem());
-		_pSceneManager.reset(new SceneSystem());
 
 		if (_onWindowCreated != nullptr)
 			_onWindowCreated();
@@ -126,6 +132,8 @@ namespace Ailurus
 
 			VulkanContext::Destroy(VulkanContextDestroySurface);
 
+			_pJobSystem = nullptr;
+
 			SDL_DestroyWindow(static_cast<SDL_Window*>(_pWindow));
 			_pWindow = nullptr;
 
@@ -156,6 +164,8 @@ namespace Ailurus
 			if (_onMainLoopPostEvent != nullptr)
 				_onMainLoopPostEvent();
 
+			_pJobSystem->PumpMainThreadJobs();
+
 			_pRenderSystem->CheckRebuildSwapChain();
 
 			_pSceneManager->UpdateAllComponents(static_cast<float>(_pTimeSystem->DeltaTime()));
@@ -166,6 +176,8 @@ namespace Ailurus
 			if (_onMainLoopPreRender != nullptr)
 				_onMainLoopPreRender();
 
+			_pSceneManager->UpdateTransforms();
+
 			_pRenderSystem->RenderScene();
 
 			// Frame rate limiting
@@ -419,6 +431,12 @@ namespace Ailurus
 		return _pAssetsSystem.get();
 	}
 
+	template <>
+	JobSystem* Application::Get<JobSystem>()
+	{
+		return _pJobSystem.get();
+	}
+
 	void Application::EventLoop(bool* quitLoop)
 	{
 		if (_pInputManager != nullptr)
@@ -12,6 +12,7 @@
 #include <Ailurus/Systems/RenderSystem/Uniform/UniformSetMemory.h>
 #include <Ailurus/Systems/RenderSystem/Uniform/UniformSet.h>
 #include <Ailurus/Systems/RenderSystem/RenderSystem.h>
+#include <Ailurus/Systems/RenderSystem/Descriptor/BindlessTextureTable.h>
 #include <VulkanContext/VulkanContext.h>
 #include <VulkanContext/Resource/VulkanResourceManager.h>
 #include <VulkanContext/Resource/Image/VulkanImage.h>
@@ -383,7 +384,8 @@ namespace Ailurus
 }	static std::unordered_map<std::string, AssetRef<Texture>> JsonReadTextures(
 		AssetsSystem* pAssetsSystem,
 		const std::string& path,
-		const nlohmann::basic_json<>& renderPassConfig)
+		const nlohmann::basic_json<>& renderPassConfig,
+		bool bindless)
 	{
 		std::unordered_map<std::string, AssetRef<Texture>> result;
 
@@ -401,13 +403,14 @@ namespace Ailurus
 
 		for (const auto& textureConfig : texturesConfig)
 		{
-			if (!textureConfig.contains("binding") || !textureConfig.contains("uniformVarName") || !textureConfig.contains("path"))
+			// Bindless textures have no binding of their own, their index goes to "indexUniform"
+			if ((!bindless && !textureConfig.contains("binding")) || !textureConfig.contains("uniformVarName") || !textureConfig.contains("path"))
 			{
 				Logger::LogError("Material texture config missing binding, uniformVarName or path, {}, {}", path, textureConfig.dump());
 				continue;
 			}
 
-			const uint32_t binding = textureConfig["binding"].get<uint32_t>();
+			const uint32_t binding = textureConfig.contains("binding") ? textureConfig["binding"].get<uint32_t>() : 0;
 			const std::string& uniformVarName = textureConfig["uniformVarName"].get<std::string>();
 			const std::string& texturePath = textureConfig["path"].get<std::string>();
 			const std::string& textureFullPath = Path::ResolvePath(texturePath);
@@ -472,6 +475,66 @@ namespace Ailurus
 		return result;
 	}
 
+	static bool JsonReadBindless(const std::string& path, const nlohmann::basic_json<>& renderPassConfig)
+	{
+		if (!renderPassConfig.contains("bindless"))
+			return false;
+
+		const auto& bindlessNode = renderPassConfig["bindless"];
+		if (!bindlessNode.is_boolean())
+		{
+			Logger::LogError("Material render pass bindless config error, {}, {}", path, bindlessNode.dump());
+			return false;
+		}
+
+		return bindlessNode.get<bool>();
+	}
+
+	static void RegisterBindlessTextures(
+		const std::string& path,
+		RenderPassType renderPass,
+		const nlohmann::basic_json<>& renderPassConfig,
+		const std::unordered_map<std::string, AssetRef<Texture>>& textures,
+		std::unordered_map<RenderPassType, UniformValueMap>& outAccessValues)
+	{
+		auto* pBindlessTextures = Application::Get<RenderSystem>()->GetBindlessTextureTable();
+		for (const auto& textureConfig : renderPassConfig["textures"])
+		{
+			if (!textureConfig.contains("uniformVarName"))
+				continue;
+
+			const auto itr = textures.find(textureConfig["uniformVarName"].get<std::string>());
+			if (itr == textures.end() || itr->second.Get() == nullptr)
+				continue;
+
+			if (!textureConfig.contains("indexUniform"))
+			{
+				Logger::LogError("Material bindless texture config missing indexUniform, {}, {}", path, textureConfig.dump());
+				continue;
+			}
+
+			const auto& indexUniformConfig = textureConfig["indexUniform"];
+			if (!indexUniformConfig.contains("binding") || !indexUniformConfig.contains("access"))
+			{
+				Logger::LogError("Material bindless texture indexUniform missing binding or access, {}, {}", path, textureConfig.dump());
+				continue;
+			}
+
+			Texture* pTexture = itr->second.Get();
+			const uint32_t index = pBindlessTextures->Register(pTexture->GetImage()->GetImageView(),
+				pTexture->GetSampler()->GetSampler());
+			if (index == BindlessTextureTable::INVALID_INDEX)
+				continue;
+
+			pTexture->SetBindlessIndex(index);
+
+			// Shaders read the slot from the material uniform data
+			const auto access = UniformAccess{ indexUniformConfig["binding"].get<uint32_t>(),
+				indexUniformConfig["access"].get<std::string>() };
+			outAccessValues[renderPass][access] = static_cast<int>(index);
+		}
+	}
+
 	AssetRef<MaterialInstance> AssetsSystem::LoadMaterial(const std::string& inPath)
 	{
 		auto path = Path::ResolvePath(inPath);
@@ -510,16 +573,40 @@ namespace Ailurus
 		if (!passOpt.has_value())
 			continue;
 
+		// Bindless passes sample the bindless texture table and need the device to support it
+		const bool bindless = JsonReadBindless(path, renderPassConfig);
+		if (bindless && Application::Get<RenderSystem>()->GetBindlessTextureTable() == nullptr)
+		{
+			Logger::LogError("Material render pass {} is bindless but descriptor indexing is not supported, {}",
+				EnumReflection<RenderPassType>::ToString(*passOpt), path);
+			continue;
+		}
+
 		// Read shader config
 		auto shaders = JsonReadShader(path, renderPassConfig);
 
 		// Read the uniform set (may be null for passes with no material uniforms, e.g. shadow pass)
 		auto pUniformSet = JsonReadUniformSet(path, *passOpt, renderPassConfig, accessValues);
 
+		// Texture indices of bindless passes live in the uniform set
+		if (bindless && pUniformSet == nullptr)
+		{
+			Logger::LogError("Material render pass {} is bindless but has no uniforms, {}",
+				EnumReflection<RenderPassType>::ToString(*passOpt), path);
+			continue;
+		}
+
 		// Read and load textures
-		auto textures = JsonReadTextures(this, path, renderPassConfig);
+		auto textures = JsonReadTextures(this, path, renderPassConfig, bindless);
+		if (bindless)
+			RegisterBindlessTextures(path, *passOpt, renderPassConfig, textures, accessValues);
 
-		if (pUniformSet != nullptr)
+		if (pUniformSet != nullptr && bindless)
+		{
+			// No texture bindings, the textures are in set 2
+			pUniformSet->InitDescriptorSetLayout();
+		}
+		else if (pUniformSet != nullptr)
 		{
 			// Build texture binding information for descriptor set layout
 			std::vector<TextureBindingInfo> textureBindings;
@@ -540,6 +627,7 @@ namespace Ailurus
 
 		// Set shader and uniform
 		pMaterialRaw->SetPassShaderAndUniform(*passOpt, shaders, std::move(pUniformSet));
+		pMaterialRaw->SetPassBindless(*passOpt, bindless);
 
 		// Set textures
 		for (const auto& [uniformVarName, textureRef] : textures)
@@ -5,6 +5,7 @@
 #include <Ailurus/Systems/AssetsSystem/AssetsSystem.h>
 #include <Ailurus/Systems/AssetsSystem/Model/Model.h>
 #include <Ailurus/Utility/Logger.h>
+#include <Ailurus/Utility/MeshSimplifier.h>
 #include <Ailurus/OS/Path.h>
 #include <Ailurus/Assert.h>
 #include <Ailurus/Math/AABB.hpp>
@@ -147,6 +148,54 @@ namespace Ailurus
 		return meshIndexData;
 	}
 
+	/// Append simplified levels to an indexed mesh, each aiming at half the triangles of the
+	/// previous one. The chain ends once a level no longer removes enough or the error grows
+	/// past a fraction of the mesh's size.
+	static void GenerateLods(const aiMesh* pAssimpMesh, const AABBf& localAABB, Mesh* pMesh)
+	{
+		constexpr uint32_t MAX_LOD_COUNT = 5;
+		constexpr uint32_t MIN_LOD_INDEX_COUNT = 3 * 64;
+		constexpr float LOD_REDUCTION = 0.5f;
+		constexpr float MIN_LOD_REDUCTION = 0.9f;
+		constexpr float MAX_LOD_RELATIVE_ERROR = 0.05f;
+
+		if (!pAssimpMesh->HasPositions() || pMesh->GetLodCount() != 1)
+			return;
+
+		std::vector<uint32_t> indices;
+		indices.reserve(pAssimpMesh->mNumFaces * 3);
+		for (unsigned int i = 0; i < pAssimpMesh->mNumFaces; i++)
+		{
+			const aiFace& face = pAssimpMesh->mFaces[i];
+			if (face.mNumIndices == 3)
+				indices.insert(indices.end(), face.mIndices, face.mIndices + 3);
+		}
+
+		const float maxError = localAABB.GetExtents().Magnitude() * 2.0f * MAX_LOD_RELATIVE_ERROR;
+		while (pMesh->GetLodCount() < MAX_LOD_COUNT && indices.size() >= MIN_LOD_INDEX_COUNT)
+		{
+			// Each level simplifies the previous one, their errors add up along the chain
+			const float previousError = pMesh->GetLodError(pMesh->GetLodCount() - 1);
+			if (previousError >= maxError)
+				break;
+
+			const auto targetIndexCount = static_cast<uint32_t>(indices.size() * LOD_REDUCTION);
+
+			float error = 0.0f;
+			std::vector<uint32_t> lodIndices = MeshSimplifier::Simplify(&pAssimpMesh->mVertices[0].x,
+				pAssimpMesh->mNumVertices, sizeof(aiVector3D), indices.data(), static_cast<uint32_t>(indices.size()),
+				targetIndexCount, maxError - previousError, &error);
+
+			if (lodIndices.size() > indices.size() * MIN_LOD_REDUCTION)
+				break;
+
+			if (!pMesh->AddLod(lodIndices.data(), static_cast<uint32_t>(lodIndices.size()), previousError + error))
+				break;
+
+			indices = std::move(lodIndices);
+		}
+	}
+
 	static std::unique_ptr<Mesh> GenerateMesh(const aiMesh* pAssimpMesh)
 	{
 		std::vector<AttributeType> layout = ReadLayout(pAssimpMesh);
@@ -173,7 +222,7 @@ namespace Ailurus
 		{
 			IndexBufferFormat indexFormat = ReadIndexFormat(pAssimpMesh);
 			std::vector<uint8_t> indexData = ReadIndex(pAssimpMesh, indexFormat);
-			return std::make_unique<Mesh>(
+			auto pMesh = std::make_unique<Mesh>(
 				vertexData.data(),
 				vertexData.size(),
 				layoutId,
@@ -181,6 +230,9 @@ namespace Ailurus
 				indexData.data(),
 				indexData.size(),
 				localAABB);
+
+			GenerateLods(pAssimpMesh, localAABB, pMesh.get());
+			return pMesh;
 		}
 
 		return std::make_unique<Mesh>(
@@ -58,4 +58,17 @@ namespace Ailurus
 			return &itr->second.textures;
 		return nullptr;
 	}
+
+	bool Material::IsPassBindless(RenderPassType pass) const
+	{
+		const auto itr = _renderPassInfoMap.find(pass);
+		if (itr != _renderPassInfoMap.end())
+			return itr->second.bindless;
+		return false;
+	}
+
+	void Material::SetPassBindless(RenderPassType pass, bool bindless)
+	{
+		_renderPassInfoMap[pass].bindless = bindless;
+	}
 } // namespace Ailurus
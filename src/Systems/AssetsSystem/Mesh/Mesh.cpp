@@ -1,41 +1,80 @@
+#include <algorithm>
 #include "Ailurus/Systems/AssetsSystem/Mesh/Mesh.h"
-#include "VulkanContext/DataBuffer/VulkanIndexBuffer.h"
-#include "VulkanContext/DataBuffer/VulkanVertexBuffer.h"
+#include "Ailurus/Utility/Logger.h"
+#include "VulkanContext/VulkanContext.h"
+#include "VulkanContext/Helper/VulkanHelper.h"
+#include "VulkanContext/Geometry/VulkanGeometryManager.h"
 
 namespace Ailurus
 {
 	Mesh::Mesh(const void* vertexData, size_t vertexDataSizeInBytes, uint64_t vertexLayoutId, const AABBf& localAABB)
-		: _pVertexBuffer(std::make_unique<VulkanVertexBuffer>(vertexData, vertexDataSizeInBytes))
+		: _pArena(VulkanContext::GetGeometryManager()->GetArena(vertexLayoutId))
 		, _layoutId(vertexLayoutId)
-		, _pIndexBuffer(nullptr)
+		, _vertexOffset(RangeAllocator::INVALID_OFFSET)
+		, _vertexCount(0)
 		, _localAABB(localAABB)
 	{
+		if (_pArena == nullptr)
+			return;
+
+		const uint32_t stride = _pArena->GetVertexStride();
+		if (stride == 0 || vertexDataSizeInBytes % stride != 0)
+		{
+			Logger::LogError("Mesh: Vertex data size {} is not a multiple of the layout stride {}", vertexDataSizeInBytes, stride);
+			return;
+		}
+
+		const auto vertexCount = static_cast<uint32_t>(vertexDataSizeInBytes / stride);
+		_vertexOffset = _pArena->AllocateVertices(vertexData, vertexCount);
+		if (_vertexOffset != RangeAllocator::INVALID_OFFSET)
+			_vertexCount = vertexCount;
 	}
 
 	Mesh::Mesh(const void* vertexData, size_t vertexDataSizeInBytes, uint64_t vertexLayoutId,
 		IndexBufferFormat format, const void* indexData, size_t indexDtaSizeInBytes, const AABBf& localAABB)
-		: _pVertexBuffer(std::make_unique<VulkanVertexBuffer>(vertexData, vertexDataSizeInBytes))
-		, _layoutId(vertexLayoutId)
-		, _pIndexBuffer(std::make_unique<VulkanIndexBuffer>(format, indexData, indexDtaSizeInBytes))
-		, _localAABB(localAABB)
+		: Mesh(vertexData, vertexDataSizeInBytes, vertexLayoutId, localAABB)
 	{
-	}
+		if (_pArena == nullptr || _vertexCount == 0)
+			return;
 
-	Mesh::~Mesh() = default;
+		const auto indexSize = VulkanHelper::SizeOf(format);
+		if (indexSize == 0 || indexDtaSizeInBytes % indexSize != 0)
+		{
+			Logger::LogError("Index buffer data size is not a multiple of {}",
+				EnumReflection<IndexBufferFormat>::ToString(format));
+			return;
+		}
 
-	const VulkanVertexBuffer* Mesh::GetVertexBuffer() const
-	{
-		return _pVertexBuffer.get();
+		const auto indexCount = static_cast<uint32_t>(indexDtaSizeInBytes / indexSize);
+		const uint32_t firstIndex = _pArena->AllocateIndices(format, indexData, indexCount);
+		if (firstIndex != RangeAllocator::INVALID_OFFSET)
+			_lods.push_back(Lod{ firstIndex, indexCount, 0.0f });
 	}
 
-	uint64_t Mesh::GetVertexLayoutId() const
+	Mesh::~Mesh()
 	{
-		return _layoutId;
+		if (_pArena == nullptr)
+			return;
+
+		_pArena->FreeVertices(_vertexOffset, _vertexCount);
+		for (const Lod& lod : _lods)
+			_pArena->FreeIndices(lod.firstIndex, lod.indexCount);
 	}
 
-	const VulkanIndexBuffer* Mesh::GetIndexBuffer() const
+	bool Mesh::AddLod(const uint32_t* indexData, uint32_t indexCount, float geometricError)
 	{
-		return _pIndexBuffer.get();
+		if (_lods.empty())
+		{
+			Logger::LogError("Mesh: Levels of detail need an indexed mesh");
+			return false;
+		}
+
+		const uint32_t firstIndex = _pArena->AllocateIndices(IndexBufferFormat::UInt32, indexData, indexCount);
+		if (firstIndex == RangeAllocator::INVALID_OFFSET)
+			return false;
+
+		_lods.push_back(Lod{ firstIndex, indexCount, geometricError });
+		return true;
 	}
 
 	uint32_t Mesh::GetVertexCount() const
@@ -43,8 +82,59 @@ namespace Ailurus
 		return _vertexCount;
 	}
 
+	uint32_t Mesh::GetVertexOffset() const
+	{
+		return _vertexOffset;
+	}
+
+	uint32_t Mesh::GetLodCount() const
+	{
+		return _lods.empty() ? 1 : static_cast<uint32_t>(_lods.size());
+	}
+
+	uint32_t Mesh::GetIndexCount(uint32_t lod) const
+	{
+		const Lod* pLod = FindLod(lod);
+		return pLod != nullptr ? pLod->indexCount : 0;
+	}
+
+	uint32_t Mesh::GetFirstIndex(uint32_t lod) const
+	{
+		const Lod* pLod = FindLod(lod);
+		return pLod != nullptr ? pLod->firstIndex : RangeAllocator::INVALID_OFFSET;
+	}
+
+	float Mesh::GetLodError(uint32_t lod) const
+	{
+		const Lod* pLod = FindLod(lod);
+		return pLod != nullptr ? pLod->geometricError : 0.0f;
+	}
+
+	bool Mesh::HasIndices() const
+	{
+		return !_lods.empty();
+	}
+
+	VulkanGeometryArena* Mesh::GetGeometryArena() const
+	{
+		return _pArena;
+	}
+
+	uint64_t Mesh::GetVertexLayoutId() const
+	{
+		return _layoutId;
+	}
+
 	const AABBf& Mesh::GetLocalAABB() const
 	{
 		return _localAABB;
 	}
+
+	auto Mesh::FindLod(uint32_t lod) const -> const Lod*
+	{
+		if (_lods.empty())
+			return nullptr;
+
+		return &_lods[std::min<size_t>(lod, _lods.size() - 1)];
+	}
 } // namespace Ailurus
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <limits>
 #include <Ailurus/Systems/AssetsSystem/Model/Model.h>
 #include <Ailurus/Utility/Logger.h>
 #include <Ailurus/Math/Vector2.hpp>
@@ -16,6 +18,26 @@ namespace Ailurus
 			for (size_t i = 1; i < _meshes.size(); i++)
 				_localAABB = AABBf::Merge(_localAABB, _meshes[i]->GetLocalAABB());
 		}
+
+		// A level's error projects to size * error / radius, it may be drawn once that stays
+		// below LOD_SCREEN_ERROR. The model switches as a whole, its worst mesh decides.
+		uint32_t lodCount = 1;
+		for (const auto& pMesh : _meshes)
+			lodCount = std::max(lodCount, pMesh->GetLodCount());
+
+		const float radius = _localAABB.GetExtents().Magnitude();
+		_lodScreenSizes.assign(lodCount, std::numeric_limits<float>::max());
+		for (uint32_t lod = 1; lod < lodCount; lod++)
+		{
+			float error = 0.0f;
+			for (const auto& pMesh : _meshes)
+				error = std::max(error, pMesh->GetLodError(lod));
+
+			const float screenSize = error > 0.0f ? LOD_SCREEN_ERROR * radius / error : std::numeric_limits<float>::max();
+
+			// Coarser levels never start at a larger size than finer ones
+			_lodScreenSizes[lod] = std::min(screenSize, _lodScreenSizes[lod - 1]);
+		}
 	}
 
 	const std::vector<std::unique_ptr<Mesh>>& Model::GetMeshes() const
@@ -27,4 +49,28 @@ namespace Ailurus
 	{
 		return _localAABB;
 	}
+
+	uint32_t Model::GetLodCount() const
+	{
+		return static_cast<uint32_t>(_lodScreenSizes.size());
+	}
+
+	float Model::GetLodScreenSize(uint32_t lod) const
+	{
+		return lod < _lodScreenSizes.size() ? _lodScreenSizes[lod] : 0.0f;
+	}
+
+	uint32_t Model::SelectLod(float screenSize, uint32_t currentLod, float hysteresis) const
+	{
+		const uint32_t lodCount = GetLodCount();
+		uint32_t lod = std::min(currentLod, lodCount - 1);
+
+		while (lod + 1 < lodCount && screenSize < _lodScreenSizes[lod + 1] * (1.0f - hysteresis))
+			lod++;
+
+		while (lod > 0 && screenSize > _lodScreenSizes[lod] * (1.0f + hysteresis))
+			lod--;
+
+		return lod;
+	}
 } // namespace Ailurus
\ No newline at end of file
@@ -1,6 +1,11 @@
 #include "Ailurus/Systems/AssetsSystem/Texture/Texture.h"
+#include "Ailurus/Application.h"
+#include "Ailurus/Systems/RenderSystem/RenderSystem.h"
+#include "Ailurus/Systems/RenderSystem/Descriptor/BindlessTextureTable.h"
 #include "VulkanContext/Resource/Image/VulkanImage.h"
 #include "VulkanContext/Resource/Image/VulkanSampler.h"
+#include "VulkanContext/Resource/VulkanResourceManager.h"
+#include "VulkanContext/VulkanContext.h"
 
 namespace Ailurus
 {
@@ -11,20 +16,30 @@ namespace Ailurus
 
 	Texture::~Texture()
 	{
-		if (_pImage)
-			_pImage->MarkDelete();
-		if (_pSampler)
-			_pSampler->MarkDelete();
+		if (_bindlessIndex != BindlessTextureTable::INVALID_INDEX)
+		{
+			auto* pRenderSystem = Application::Get<RenderSystem>();
+			auto* pBindlessTable = pRenderSystem != nullptr ? pRenderSystem->GetBindlessTextureTable() : nullptr;
+			if (pBindlessTable != nullptr)
+				pBindlessTable->Unregister(_bindlessIndex);
+		}
+
+		if (auto pImage = GetImage())
+			pImage->MarkDelete();
+		if (auto pSampler = GetSampler())
+			pSampler->MarkDelete();
 	}
 
 	auto Texture::GetImage() const -> VulkanImage*
 	{
-		return _pImage;
+		auto pResourceManager = VulkanContext::GetResourceManager();
+		return pResourceManager != nullptr ? pResourceManager->Get<VulkanImage>(_imageHandle) : nullptr;
 	}
 
 	auto Texture::GetSampler() const -> VulkanSampler*
 	{
-		return _pSampler;
+		auto pResourceManager = VulkanContext::GetResourceManager();
+		return pResourceManager != nullptr ? pResourceManager->Get<VulkanSampler>(_samplerHandle) : nullptr;
 	}
 
 	auto Texture::GetBindingId() const -> uint32_t
@@ -32,18 +47,28 @@ namespace Ailurus
 		return _bindingId;
 	}
 
+	auto Texture::GetBindlessIndex() const -> uint32_t
+	{
+		return _bindlessIndex;
+	}
+
 	void Texture::SetImage(VulkanImage* pImage)
 	{
-		_pImage = pImage;
+		_imageHandle = pImage != nullptr ? pImage->GetHandle() : SlotMapHandle{};
 	}
 
 	void Texture::SetSampler(VulkanSampler* pSampler)
 	{
-		_pSampler = pSampler;
+		_samplerHandle = pSampler != nullptr ? pSampler->GetHandle() : SlotMapHandle{};
 	}
 
 	void Texture::SetBindingId(uint32_t bindingId)
 	{
 		_bindingId = bindingId;
 	}
+
+	void Texture::SetBindlessIndex(uint32_t bindlessIndex)
+	{
+		_bindlessIndex = bindlessIndex;
+	}
 } // namespace Ailurus
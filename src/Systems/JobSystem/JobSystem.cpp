@@ -0,0 +1,364 @@
+#include <algorithm>
+#include "Ailurus/Systems/JobSystem/JobSystem.h"
+#include "Ailurus/Utility/SpinPause.h"
+#include "Ailurus/Utility/Logger.h"
+
+namespace Ailurus
+{
+	struct JobNode
+	{
+		JobSystem::JobFunction function;
+		JobCounter* pCounter;
+	};
+
+	static thread_local const JobSystem* gCurrentJobSystem = nullptr;
+	static thread_local uint32_t gCurrentThreadIndex = JobSystem::INVALID_THREAD_INDEX;
+	static thread_local uint32_t gStealSeed = 0;
+
+	/// Number of fetch attempts a worker makes before going to sleep.
+	static constexpr uint32_t WORKER_SPIN_COUNT = 64;
+
+	static uint32_t NextStealVictim()
+	{
+		// xorshift32, only used to spread thieves across victims
+		uint32_t x = gStealSeed == 0 ? 0x9E3779B9u + gCurrentThreadIndex : gStealSeed;
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		gStealSeed = x;
+		return x;
+	}
+
+	bool JobCounter::IsDone() const
+	{
+		if (_value.load(std::memory_order_acquire) != 0)
+			return false;
+
+		// The finishing job decrements under the lock, taking it here guarantees
+		// that job is no longer touching this counter once we return true.
+		std::lock_guard lock(_mutex);
+		return _value.load(std::memory_order_relaxed) == 0;
+	}
+
+	uint32_t JobCounter::GetValue() const
+	{
+		return _value.load(std::memory_order_acquire);
+	}
+
+	JobSystem::JobSystem(uint32_t workerCount)
+	{
+		if (workerCount == 0)
+		{
+			uint32_t hardwareThreads = std::thread::hardware_concurrency();
+			workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+		}
+
+		gCurrentJobSystem = this;
+		gCurrentThreadIndex = MAIN_THREAD_INDEX;
+
+		_injectionQueue = std::make_unique<Queue>();
+		_mainThreadQueue = std::make_unique<Queue>();
+
+		// One deque per thread, main thread included
+		for (uint32_t i = 0; i < workerCount + 1; i++)
+			_deques.push_back(std::make_unique<Deque>());
+
+		for (uint32_t i = 0; i < workerCount; i++)
+			_workers.emplace_back(&JobSystem::WorkerLoop, this, i + 1);
+
+		Logger::LogInfo("Job system started with {} worker threads", workerCount);
+	}
+
+	JobSystem::~JobSystem()
+	{
+		{
+			std::lock_guard lock(_sleepMutex);
+			_shutdown.store(true);
+		}
+		_sleepCondition.notify_all();
+
+		for (auto& worker : _workers)
+		{
+			if (worker.joinable())
+				worker.join();
+		}
+
+		// Run whatever is left so that no counter stays pending forever
+		while (TryRunOneJob())
+			continue;
+
+		while (auto job = _mainThreadQueue->TryDequeue())
+			Execute(*job);
+
+		if (gCurrentJobSystem == this)
+		{
+			gCurrentJobSystem = nullptr;
+			gCurrentThreadIndex = INVALID_THREAD_INDEX;
+		}
+	}
+
+	void JobSystem::Schedule(const JobFunction& job, JobCounter* pCounter)
+	{
+		if (pCounter != nullptr)
+			pCounter->_value.fetch_add(1, std::memory_order_relaxed);
+
+		Submit(new JobNode{ job, pCounter });
+	}
+
+	void JobSystem::ScheduleAfter(JobCounter* pDependency, const JobFunction& job, JobCounter* pCounter)
+	{
+		if (pDependency == nullptr)
+		{
+			Schedule(job, pCounter);
+			return;
+		}
+
+		if (pCounter != nullptr)
+			pCounter->_value.fetch_add(1, std::memory_order_relaxed);
+
+		JobNode* pJob = new JobNode{ job, pCounter };
+		{
+			std::lock_guard lock(pDependency->_mutex);
+			if (pDependency->_value.load(std::memory_order_relaxed) != 0)
+			{
+				pDependency->_continuations.push_back(pJob);
+				return;
+			}
+		}
+
+		Submit(pJob);
+	}
+
+	void JobSystem::ParallelFor(uint32_t count, uint32_t batchSize, const RangeFunction& func, JobCounter* pCounter)
+	{
+		if (count == 0)
+			return;
+
+		batchSize = std::max(batchSize, 1u);
+
+		auto pFunc = std::make_shared<RangeFunction>(func);
+		for (uint32_t begin = 0; begin < count; begin += batchSize)
+		{
+			uint32_t end = std::min(count, begin + batchSize);
+			Schedule([pFunc, begin, end]() -> void { (*pFunc)(begin, end); }, pCounter);
+		}
+	}
+
+	void JobSystem::ParallelFor(uint32_t count, uint32_t batchSize, const RangeFunction& func)
+	{
+		if (count == 0)
+			return;
+
+		// Not worth the scheduling overhead
+		if (count <= batchSize || _workers.empty())
+		{
+			func(0, count);
+			return;
+		}
+
+		JobCounter counter;
+		ParallelFor(count, batchSize, func, &counter);
+		Wait(&counter);
+	}
+
+	void JobSystem::Wait(const JobCounter* pCounter)
+	{
+		if (pCounter == nullptr)
+			return;
+
+		// Main thread jobs are left to the frame boundary, running them here would re-enter
+		// whatever the waiting code is in the middle of while workers read its data
+		while (!pCounter->IsDone())
+		{
+			if (!TryRunOneJob())
+				SpinPause();
+		}
+	}
+
+	void JobSystem::RunOnMainThread(const JobFunction& job, JobCounter* pCounter)
+	{
+		if (pCounter != nullptr)
+			pCounter->_value.fetch_add(1, std::memory_order_relaxed);
+
+		JobNode* pJob = new JobNode{ job, pCounter };
+		if (IsMainThread())
+		{
+			// Full queue on the main thread, nobody else would drain it, just run now
+			if (!_mainThreadQueue->TryEnqueue(pJob))
+				Execute(pJob);
+		}
+		else
+			_mainThreadQueue->Enqueue(pJob);
+	}
+
+	void JobSystem::PumpMainThreadJobs()
+	{
+		if (!IsMainThread())
+		{
+			Logger::LogError("JobSystem::PumpMainThreadJobs called outside main thread");
+			return;
+		}
+
+		// Bounded so that jobs re-posting themselves can not stall the frame
+		uint32_t budget = _mainThreadQueue->GetSize();
+		while (budget-- > 0)
+		{
+			auto job = _mainThreadQueue->TryDequeue();
+			if (!job.has_value())
+				break;
+
+			Execute(*job);
+		}
+	}
+
+	uint32_t JobSystem::GetWorkerCount() const
+	{
+		return static_cast<uint32_t>(_workers.size());
+	}
+
+	uint32_t JobSystem::GetThreadCount() const
+	{
+		return static_cast<uint32_t>(_deques.size());
+	}
+
+	uint32_t JobSystem::GetCurrentThreadIndex() const
+	{
+		return gCurrentJobSystem == this ? gCurrentThreadIndex : INVALID_THREAD_INDEX;
+	}
+
+	bool JobSystem::IsMainThread() const
+	{
+		return GetCurrentThreadIndex() == MAIN_THREAD_INDEX;
+	}
+
+	void JobSystem::WorkerLoop(uint32_t threadIndex)
+	{
+		gCurrentJobSystem = this;
+		gCurrentThreadIndex = threadIndex;
+
+		uint32_t idleCount = 0;
+		while (!_shutdown.load(std::memory_order_relaxed))
+		{
+			if (JobNode* pJob = FetchJob(threadIndex))
+			{
+				Execute(pJob);
+				idleCount = 0;
+				continue;
+			}
+
+			if (++idleCount < WORKER_SPIN_COUNT)
+			{
+				SpinPause();
+				continue;
+			}
+
+			idleCount = 0;
+
+			std::unique_lock lock(_sleepMutex);
+			_sleepingWorkers.fetch_add(1);
+			_sleepCondition.wait(lock, [this]() -> bool {
+				return _shutdown.load() || _pendingJobs.load() > 0;
+			});
+			_sleepingWorkers.fetch_sub(1);
+		}
+
+		gCurrentJobSystem = nullptr;
+		gCurrentThreadIndex = INVALID_THREAD_INDEX;
+	}
+
+	void JobSystem::Submit(JobNode* pJob)
+	{
+		_pendingJobs.fetch_add(1);
+
+		bool queued = false;
+		uint32_t threadIndex = GetCurrentThreadIndex();
+		if (threadIndex != INVALID_THREAD_INDEX)
+			queued = _deques[threadIndex]->Push(pJob);
+
+		if (!queued)
+			queued = _injectionQueue->TryEnqueue(pJob);
+
+		if (!queued)
+		{
+			// Every queue is saturated, run inline instead of blocking
+			_pendingJobs.fetch_sub(1);
+			Execute(pJob);
+			return;
+		}
+
+		WakeWorker();
+	}
+
+	JobNode* JobSystem::FetchJob(uint32_t threadIndex)
+	{
+		std::optional<JobNode*> job = std::nullopt;
+
+		if (threadIndex != INVALID_THREAD_INDEX)
+			job = _deques[threadIndex]->Pop();
+
+		if (!job.has_value())
+			job = _injectionQueue->TryDequeue();
+
+		if (!job.has_value())
+		{
+			const uint32_t dequeCount = static_cast<uint32_t>(_deques.size());
+			const uint32_t start = NextStealVictim() % dequeCount;
+			for (uint32_t i = 0; i < dequeCount && !job.has_value(); i++)
+			{
+				uint32_t victim = (start + i) % dequeCount;
+				if (victim != threadIndex)
+					job = _deques[victim]->Steal();
+			}
+		}
+
+		if (!job.has_value())
+			return nullptr;
+
+		_pendingJobs.fetch_sub(1);
+		return *job;
+	}
+
+	bool JobSystem::TryRunOneJob()
+	{
+		JobNode* pJob = FetchJob(GetCurrentThreadIndex());
+		if (pJob == nullptr)
+			return false;
+
+		Execute(pJob);
+		return true;
+	}
+
+	void JobSystem::Execute(JobNode* pJob)
+	{
+		if (pJob->function)
+			pJob->function();
+
+		JobCounter* pCounter = pJob->pCounter;
+		delete pJob;
+
+		if (pCounter == nullptr)
+			return;
+
+		std::vector<JobNode*> released;
+		{
+			std::lock_guard lock(pCounter->_mutex);
+			if (pCounter->_value.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				released.swap(pCounter->_continuations);
+		}
+
+		for (JobNode* pContinuation : released)
+			Submit(pContinuation);
+	}
+
+	void JobSystem::WakeWorker()
+	{
+		if (_sleepingWorkers.load() == 0)
+			return;
+
+		// Taking the lock orders this notify after the sleeper's predicate check
+		{
+			std::lock_guard lock(_sleepMutex);
+		}
+		_sleepCondition.notify_one();
+	}
+} // namespace Ailurus
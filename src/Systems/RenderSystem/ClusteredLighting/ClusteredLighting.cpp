@@ -0,0 +1,158 @@
+#include "ClusteredLighting.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include "Ailurus/Application.h"
+#include "Ailurus/Systems/JobSystem/JobSystem.h"
+#include <VulkanContext/DataBuffer/VulkanStorageBuffer.h>
+#include <VulkanContext/Descriptor/VulkanDescriptorWriter.h>
+#include <VulkanContext/Resource/DataBuffer/VulkanDeviceBuffer.h>
+
+namespace Ailurus
+{
+	ClusteredLighting::ClusteredLighting()
+	{
+		_pLightBuffer = std::make_unique<VulkanStorageBuffer>(LIGHT_BUFFER_INITIAL_CAPACITY);
+		_pClusterBuffer = std::make_unique<VulkanStorageBuffer>(CLUSTER_BUFFER_INITIAL_CAPACITY);
+	}
+
+	ClusteredLighting::~ClusteredLighting() = default;
+
+	void ClusteredLighting::Clear()
+	{
+		_lights.clear();
+		_worldSpheres.clear();
+	}
+
+	void ClusteredLighting::AddPointLight(const Vector3f& position, const Vector3f& color, float intensity, const Vector3f& attenuation)
+	{
+		const float range = CalculateRange(color, intensity, attenuation);
+		if (range <= 0.0f)
+			return;
+
+		// A cone wider than any direction, the spot factor is always 1
+		_lights.push_back(GpuLight{
+			Vector4f(position.x, position.y, position.z, range),
+			Vector4f(color.x, color.y, color.z, intensity),
+			Vector4f(0.0f, 0.0f, 0.0f, -1.0f),
+			Vector4f(attenuation.x, attenuation.y, attenuation.z, -2.0f) });
+		_worldSpheres.push_back(Vector4f(position.x, position.y, position.z, range));
+	}
+
+	void ClusteredLighting::AddSpotLight(const Vector3f& position, const Vector3f& direction, const Vector3f& color,
+		float intensity, const Vector3f& attenuation, float cosInner, float cosOuter)
+	{
+		const float range = CalculateRange(color, intensity, attenuation);
+		if (range <= 0.0f)
+			return;
+
+		// Keep the blend between the cones well defined
+		cosOuter = std::clamp(cosOuter, -1.0f, 1.0f);
+		cosInner = std::max(cosInner, cosOuter + 1e-4f);
+
+		const Vector3f axis = direction.Normalized();
+		_lights.push_back(GpuLight{
+			Vector4f(position.x, position.y, position.z, range),
+			Vector4f(color.x, color.y, color.z, intensity),
+			Vector4f(axis.x, axis.y, axis.z, cosInner),
+			Vector4f(attenuation.x, attenuation.y, attenuation.z, cosOuter) });
+
+		// Bounding sphere of the cone, narrow cones are centered along the axis
+		Vector3f center = position;
+		float radius = range;
+		if (cosOuter > std::sqrt(0.5f))
+		{
+			radius = range / (2.0f * cosOuter);
+			center = position + axis * radius;
+		}
+		else if (cosOuter > 0.0f)
+		{
+			radius = range * std::sqrt(1.0f - cosOuter * cosOuter);
+			center = position + axis * (range * cosOuter);
+		}
+		_worldSpheres.push_back(Vector4f(center.x, center.y, center.z, radius));
+	}
+
+	uint32_t ClusteredLighting::GetLightCount() const
+	{
+		return static_cast<uint32_t>(_lights.size());
+	}
+
+	void ClusteredLighting::Build(const Matrix4x4f& viewMatrix, const Matrix4x4f& projectionMatrix, float nearPlane, float farPlane)
+	{
+		_viewSpheres.resize(_worldSpheres.size());
+		for (size_t i = 0; i < _worldSpheres.size(); i++)
+		{
+			const Vector4f& sphere = _worldSpheres[i];
+			const Vector4f center = viewMatrix * Vector4f(sphere.x, sphere.y, sphere.z, 1.0f);
+			_viewSpheres[i] = Vector4f(center.x, center.y, center.z, sphere.w);
+		}
+
+		_grid.Setup(projectionMatrix, nearPlane, farPlane);
+		_grid.SetLights(_viewSpheres.data(), static_cast<uint32_t>(_viewSpheres.size()));
+
+		// Slices own disjoint clusters, each job fills its own
+		Application::Get<JobSystem>()->ParallelFor(LightClusterGrid::GRID_Z, SLICE_BATCH_SIZE,
+			[this](uint32_t begin, uint32_t end) -> void { _grid.AssignSlices(begin, end); });
+	}
+
+	void ClusteredLighting::Upload(VulkanCommandBuffer* pCommandBuffer)
+	{
+		// Never empty, the descriptors always need a buffer to point at
+		const size_t lightDataSize = std::max<size_t>(_lights.size(), 1) * sizeof(GpuLight);
+		if (void* pLightData = _pLightBuffer->BeginFrame(lightDataSize))
+		{
+			if (!_lights.empty())
+				std::memcpy(pLightData, _lights.data(), _lights.size() * sizeof(GpuLight));
+			_pLightBuffer->TransitionDataToGpu(pCommandBuffer, vk::PipelineStageFlagBits::eFragmentShader);
+		}
+
+		// Cluster ranges followed by the packed light indices
+		const size_t rangeDataSize = LightClusterGrid::CLUSTER_COUNT * sizeof(LightClusterGrid::ClusterRange);
+		const size_t indexCount = std::max<size_t>(_grid.GetIndexCount(), 1);
+		if (auto* pClusterData = static_cast<uint8_t*>(_pClusterBuffer->BeginFrame(rangeDataSize + indexCount * sizeof(uint32_t))))
+		{
+			_grid.Write(reinterpret_cast<LightClusterGrid::ClusterRange*>(pClusterData),
+				reinterpret_cast<uint32_t*>(pClusterData + rangeDataSize));
+			_pClusterBuffer->TransitionDataToGpu(pCommandBuffer, vk::PipelineStageFlagBits::eFragmentShader);
+		}
+	}
+
+	void ClusteredLighting::WriteDescriptorSet(vk::DescriptorSet descriptorSet) const
+	{
+		auto* pLightBuffer = _pLightBuffer->GetThisFrameDeviceBuffer();
+		auto* pClusterBuffer = _pClusterBuffer->GetThisFrameDeviceBuffer();
+		if (pLightBuffer == nullptr || pClusterBuffer == nullptr)
+			return;
+
+		VulkanDescriptorWriter writer;
+		writer.WriteStorageBuffer(LIGHT_BUFFER_BINDING, pLightBuffer->buffer, 0, _pLightBuffer->GetDataSize());
+		writer.WriteStorageBuffer(CLUSTER_BUFFER_BINDING, pClusterBuffer->buffer, 0, _pClusterBuffer->GetDataSize());
+		writer.UpdateSet(descriptorSet);
+	}
+
+	Vector4f ClusteredLighting::GetClusterParams() const
+	{
+		return Vector4f(_grid.GetSliceScale(), _grid.GetSliceBias(), 0.0f, 0.0f);
+	}
+
+	float ClusteredLighting::CalculateRange(const Vector3f& color, float intensity, const Vector3f& attenuation)
+	{
+		// Solve intensity * color / (constant + linear * d + quadratic * d^2) = LIGHT_CUTOFF for d
+		const float brightness = intensity * std::max({ color.x, color.y, color.z });
+		const float target = brightness / LIGHT_CUTOFF - attenuation.x;
+		if (target <= 0.0f)
+			return 0.0f;
+
+		const float linear = attenuation.y;
+		const float quadratic = attenuation.z;
+		if (quadratic > FLT_EPSILON)
+			return (-linear + std::sqrt(linear * linear + 4.0f * quadratic * target)) / (2.0f * quadratic);
+		if (linear > FLT_EPSILON)
+			return target / linear;
+
+		// No falloff, reaches everything. Kept finite so the cluster bounds stay finite too
+		return UNBOUNDED_RANGE;
+	}
+} // namespace Ailurus
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+#include <Ailurus/Math/LightClusterGrid.hpp>
+#include <Ailurus/Math/Matrix4x4.hpp>
+#include <Ailurus/Math/Vector3.hpp>
+#include <Ailurus/Math/Vector4.hpp>
+#include <Ailurus/Utility/NonCopyable.h>
+#include <Ailurus/Utility/NonMovable.h>
+
+namespace Ailurus
+{
+	class VulkanCommandBuffer;
+	class VulkanStorageBuffer;
+
+	/// Clustered culling of point and spot lights. Every light gets a range from its attenuation,
+	/// its bounding sphere is binned into the camera's LightClusterGrid one depth slice per job,
+	/// and the lights and per cluster index lists are uploaded as storage buffers read by the
+	/// forward, deferred and transparent lighting shaders.
+	class ClusteredLighting : public NonCopyable, public NonMovable
+	{
+	public:
+		static constexpr uint32_t LIGHT_BUFFER_BINDING = 3;
+		static constexpr uint32_t CLUSTER_BUFFER_BINDING = 4;
+
+		/// Lit contribution below which a light is considered out of range
+		static constexpr float LIGHT_CUTOFF = 0.01f;
+
+		ClusteredLighting();
+		~ClusteredLighting();
+
+		/// Drop the previous frame's lights
+		void Clear();
+
+		void AddPointLight(const Vector3f& position, const Vector3f& color, float intensity, const Vector3f& attenuation);
+
+		/// Cone angles are given as cosines, cosOuter <= cosInner
+		void AddSpotLight(const Vector3f& position, const Vector3f& direction, const Vector3f& color, float intensity,
+			const Vector3f& attenuation, float cosInner, float cosOuter);
+
+		uint32_t GetLightCount() const;
+
+		/// Assign the lights to the clusters of the view on the job system
+		void Build(const Matrix4x4f& viewMatrix, const Matrix4x4f& projectionMatrix, float nearPlane, float farPlane);
+
+		/// Copy the lights and cluster lists into this frame's storage buffers
+		void Upload(VulkanCommandBuffer* pCommandBuffer);
+
+		/// Point the light and cluster bindings of the global descriptor set at this frame's buffers
+		void WriteDescriptorSet(vk::DescriptorSet descriptorSet) const;
+
+		/// x = depth slice scale, y = depth slice bias, a view depth d lies in slice log(d) * x + y
+		Vector4f GetClusterParams() const;
+
+		/// Distance at which the light's contribution falls below LIGHT_CUTOFF
+		static float CalculateRange(const Vector3f& color, float intensity, const Vector3f& attenuation);
+
+	private:
+		/// std430 mirror of the shaders' LocalLight
+		struct GpuLight
+		{
+			Vector4f positionRange;			// xyz = position, w = range
+			Vector4f colorIntensity;		// xyz = color, w = intensity
+			Vector4f directionCosInner;		// xyz = spot direction, w = cos(inner), point lights never cut
+			Vector4f attenuationCosOuter;	// xyz = constant, linear, quadratic, w = cos(outer)
+		};
+
+	private:
+		static constexpr uint32_t SLICE_BATCH_SIZE = 1;
+		static constexpr float UNBOUNDED_RANGE = 1e6f;
+		static constexpr size_t LIGHT_BUFFER_INITIAL_CAPACITY = 256 * sizeof(GpuLight);
+		static constexpr size_t CLUSTER_BUFFER_INITIAL_CAPACITY =
+			LightClusterGrid::CLUSTER_COUNT * (sizeof(LightClusterGrid::ClusterRange) + 8 * sizeof(uint32_t));
+
+		LightClusterGrid _grid;
+
+		std::vector<GpuLight> _lights;
+		std::vector<Vector4f> _worldSpheres;	// xyz = center, w = radius
+		std::vector<Vector4f> _viewSpheres;
+
+		std::unique_ptr<VulkanStorageBuffer> _pLightBuffer;
+		std::unique_ptr<VulkanStorageBuffer> _pClusterBuffer;
+	};
+} // namespace Ailurus
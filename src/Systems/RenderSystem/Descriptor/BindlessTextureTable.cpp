@@ -0,0 +1,117 @@
+#include "Ailurus/Systems/RenderSystem/Descriptor/BindlessTextureTable.h"
+#include "Ailurus/Utility/Logger.h"
+#include "VulkanContext/VulkanContext.h"
+#include "VulkanContext/Descriptor/VulkanDescriptorSetLayout.h"
+#include "VulkanContext/Descriptor/VulkanDescriptorWriter.h"
+
+namespace Ailurus
+{
+	BindlessTextureTable::BindlessTextureTable(uint32_t capacity)
+		: _capacity(capacity)
+	{
+		vk::DescriptorSetLayoutBinding binding;
+		binding.setBinding(TEXTURE_BINDING)
+			.setDescriptorType(vk::DescriptorType::eCombinedImageSampler)
+			.setDescriptorCount(_capacity)
+			.setStageFlags(vk::ShaderStageFlagBits::eFragment);
+
+		// Slots are written while earlier frames still sample other slots, and most stay empty
+		const vk::DescriptorBindingFlags bindingFlags = vk::DescriptorBindingFlagBits::eUpdateAfterBind
+			| vk::DescriptorBindingFlagBits::ePartiallyBound;
+
+		_pDescriptorSetLayout = std::make_unique<VulkanDescriptorSetLayout>(
+			std::vector{ binding }, std::vector{ bindingFlags },
+			vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPool);
+
+		const vk::DescriptorPoolSize poolSize(vk::DescriptorType::eCombinedImageSampler, _capacity);
+		vk::DescriptorPoolCreateInfo poolCreateInfo;
+		poolCreateInfo.setPoolSizes(poolSize)
+			.setMaxSets(1)
+			.setFlags(vk::DescriptorPoolCreateFlagBits::eUpdateAfterBind);
+
+		try
+		{
+			_pool = VulkanContext::GetDevice().createDescriptorPool(poolCreateInfo);
+
+			const vk::DescriptorSetLayout layout = _pDescriptorSetLayout->GetDescriptorSetLayout();
+			vk::DescriptorSetAllocateInfo allocateInfo;
+			allocateInfo.setDescriptorPool(_pool)
+				.setSetLayouts(layout);
+
+			_descriptorSet = VulkanContext::GetDevice().allocateDescriptorSets(allocateInfo)[0];
+		}
+		catch (const vk::SystemError& e)
+		{
+			Logger::LogError("Failed to create bindless texture table of {} textures: {}", _capacity, e.what());
+		}
+	}
+
+	BindlessTextureTable::~BindlessTextureTable()
+	{
+		if (_pool)
+			VulkanContext::GetDevice().destroyDescriptorPool(_pool);
+	}
+
+	auto BindlessTextureTable::Register(vk::ImageView imageView, vk::Sampler sampler) -> uint32_t
+	{
+		if (!_descriptorSet)
+			return INVALID_INDEX;
+
+		uint32_t index;
+		if (!_freeIndices.empty())
+		{
+			index = _freeIndices.back();
+			_freeIndices.pop_back();
+		}
+		else if (_nextIndex < _capacity)
+		{
+			index = _nextIndex++;
+		}
+		else
+		{
+			Logger::LogError("Bindless texture table is full, capacity {}", _capacity);
+			return INVALID_INDEX;
+		}
+
+		VulkanDescriptorWriter writer;
+		writer.WriteImageArrayElement(TEXTURE_BINDING, index, imageView, sampler);
+		writer.UpdateSet(_descriptorSet);
+
+		return index;
+	}
+
+	auto BindlessTextureTable::Unregister(uint32_t index) -> void
+	{
+		if (index >= _nextIndex)
+			return;
+
+		_pendingFrees.push_back(PendingFree{ index, VulkanContext::GetFrameNumber() });
+	}
+
+	auto BindlessTextureTable::GarbageCollect() -> void
+	{
+		const uint64_t completedFrame = VulkanContext::GetCompletedFrameNumber();
+		std::erase_if(_pendingFrees, [this, completedFrame](const PendingFree& pending) -> bool {
+			if (pending.retireFrame > completedFrame)
+				return false;
+
+			_freeIndices.push_back(pending.index);
+			return true;
+		});
+	}
+
+	auto BindlessTextureTable::GetDescriptorSet() const -> vk::DescriptorSet
+	{
+		return _descriptorSet;
+	}
+
+	auto BindlessTextureTable::GetCapacity() const -> uint32_t
+	{
+		return _capacity;
+	}
+
+	auto BindlessTextureTable::GetRegisteredCount() const -> uint32_t
+	{
+		return _nextIndex - static_cast<uint32_t>(_freeIndices.size() + _pendingFrees.size());
+	}
+} // namespace Ailurus
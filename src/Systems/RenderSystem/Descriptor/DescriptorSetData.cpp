@@ -13,6 +13,9 @@ namespace Ailurus
 	{
 		auto* pLayout = pSchema->GetDescriptorSetLayout();
 
+		// Before hashing, the prepared data decides which buffers the bindings point at
+		PrepareGpuData(pCmdBuffer);
+
 		VulkanDescriptorAllocator::CacheKey key;
 		key.layout = pLayout->GetDescriptorSetLayout();
 		key.bindingHash = ComputeBindingHash();
@@ -20,8 +23,6 @@ namespace Ailurus
 		bool wasCacheHit = false;
 		auto descriptorSet = pAllocator->AllocateDescriptorSet(pLayout, &key, &wasCacheHit);
 
-		PrepareGpuData(pCmdBuffer);
-
 		if (wasCacheHit)
 			return descriptorSet;
 
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include "Ailurus/Systems/RenderSystem/RenderPass/RenderPassType.h"
+
+namespace Ailurus
+{
+	/// Packed 64-bit draw sort keys, the most significant field sorts first.
+	///
+	///   Opaque:      | pass 3 | material 12 | vertex layout 6 | material instance 14 | mesh 13 | depth 16, front to back |
+	///   Transparent: | pass 3 | depth 16, back to front | material 12 | vertex layout 6 | material instance 14 | mesh 13 |
+	///
+	/// Material and vertex layout together select the pipeline, draws of the same mesh under one
+	/// material instance end up adjacent so the recorders can merge them into instanced draws.
+	/// The mesh field hashes the mesh together with its level of detail, every level is a batch.
+	/// Ids are truncated or hashed to their field, a collision only costs an extra bind or a
+	/// split batch since the recorders still compare the real objects.
+	struct DrawSortKey
+	{
+		static constexpr uint32_t PASS_BITS = 3;
+		static constexpr uint32_t MATERIAL_BITS = 12;
+		static constexpr uint32_t VERTEX_LAYOUT_BITS = 6;
+		static constexpr uint32_t MATERIAL_INSTANCE_BITS = 14;
+		static constexpr uint32_t MESH_BITS = 13;
+		static constexpr uint32_t DEPTH_BITS = 16;
+
+		/// depth01 is the camera distance normalized by the far plane
+		static uint64_t Opaque(RenderPassType pass, uint64_t materialId, uint64_t vertexLayoutId,
+			uint64_t materialInstanceId, const void* pMesh, uint32_t lodIndex, float depth01)
+		{
+			uint64_t key = Field(static_cast<uint64_t>(pass), PASS_BITS);
+			key = (key << MATERIAL_BITS) | Field(materialId, MATERIAL_BITS);
+			key = (key << VERTEX_LAYOUT_BITS) | Fold(vertexLayoutId, VERTEX_LAYOUT_BITS);
+			key = (key << MATERIAL_INSTANCE_BITS) | Field(materialInstanceId, MATERIAL_INSTANCE_BITS);
+			key = (key << MESH_BITS) | Fold(reinterpret_cast<uintptr_t>(pMesh) + lodIndex, MESH_BITS);
+			key = (key << DEPTH_BITS) | QuantizeDepth(depth01);
+			return key;
+		}
+
+		static uint64_t Transparent(RenderPassType pass, uint64_t materialId, uint64_t vertexLayoutId,
+			uint64_t materialInstanceId, const void* pMesh, uint32_t lodIndex, float depth01)
+		{
+			constexpr uint64_t DEPTH_MAX = (uint64_t(1) << DEPTH_BITS) - 1;
+
+			uint64_t key = Field(static_cast<uint64_t>(pass), PASS_BITS);
+			key = (key << DEPTH_BITS) | (DEPTH_MAX - QuantizeDepth(depth01));
+			key = (key << MATERIAL_BITS) | Field(materialId, MATERIAL_BITS);
+			key = (key << VERTEX_LAYOUT_BITS) | Fold(vertexLayoutId, VERTEX_LAYOUT_BITS);
+			key = (key << MATERIAL_INSTANCE_BITS) | Field(materialInstanceId, MATERIAL_INSTANCE_BITS);
+			key = (key << MESH_BITS) | Fold(reinterpret_cast<uintptr_t>(pMesh) + lodIndex, MESH_BITS);
+			return key;
+		}
+
+	private:
+		static uint64_t Field(uint64_t value, uint32_t bits)
+		{
+			return value & ((uint64_t(1) << bits) - 1);
+		}
+
+		static uint64_t QuantizeDepth(float depth01)
+		{
+			constexpr float DEPTH_SCALE = static_cast<float>((uint64_t(1) << DEPTH_BITS) - 1);
+			return static_cast<uint64_t>(std::clamp(depth01, 0.0f, 1.0f) * DEPTH_SCALE);
+		}
+
+		static uint64_t Fold(uint64_t value, uint32_t bits)
+		{
+			// Layout ids are packed attribute lists and meshes are pointers rather than indices, hash them down
+			return (value * 0x9E3779B97F4A7C15ull) >> (64 - bits);
+		}
+	};
+}
@@ -14,7 +14,8 @@ namespace Ailurus
 	class Mesh;
 	class Material;
 	class MaterialInstance;
-	class Entity;
+	class VulkanCommandBuffer;
+	struct MeshRenderProxy;
 
 	struct RenderingMesh
 	{
@@ -22,48 +23,106 @@ namespace Ailurus
 		const MaterialInstance* pMaterialInstance;
 		uint64_t vertexLayoutId;
 		const Mesh* pTargetMesh;
+
+		// Level of detail of the mesh to draw, clamped to the levels it has
+		uint32_t lodIndex;
 		
-		// Additional information
-		const Entity* pEntity;
+		// Additional information, world matrix and position are cached in the proxy
+		const MeshRenderProxy* pProxy;
+
+		// Shadow pass only, bit i set when the mesh casts into cascade i
+		uint32_t shadowCascadeMask = 0;
+
+		// Packed DrawSortKey, draw lists are radix sorted by it
+		uint64_t sortKey = 0;
+
+		// Slot of the model matrix in the frame's instance buffer, assigned after sorting so
+		// consecutive draws of one batch occupy consecutive slots
+		uint32_t instanceIndex = 0;
+
+		// GPU driven culling only, multi-draw bucket of the mesh's batch
+		uint32_t drawBucketIndex = 0;
+	};
+
+	/// A contiguous range of one pass's draw list, recorded into one secondary command buffer
+	struct DrawChunk
+	{
+		RenderPassType pass;
+		uint32_t begin;
+		uint32_t end;
+		bool withSkybox;			// Last forward chunk also draws the skybox
+
+		// Filled by the recording job
+		VulkanCommandBuffer* pCommandBuffer;
+		uint32_t drawCalls;
+		uint32_t triangleCount;
+	};
+
+	/// Descriptor set of a uniform set and its slice of this frame's uniform ring, the slice is
+	/// bound as the dynamic offset of every uniform binding point of the set
+	struct BoundUniformSet
+	{
+		VulkanDescriptorSet descriptorSet;
+		uint32_t dynamicOffset = 0;
+		uint32_t dynamicOffsetCount = 0;
 	};
 
 	struct RenderIntermediateVariable
 	{
-		using MatInstDescriptorSetMap = std::unordered_map<const MaterialInstance*, VulkanDescriptorSet>;
+		using MatInstDescriptorSetMap = std::unordered_map<const MaterialInstance*, BoundUniformSet>;
+
+		// Culling and draw submission of this frame run on the GPU
+		bool gpuDrivenCulling = false;
 
 		// View and projection matrices
+		Matrix4x4f viewMatrix;
+		Matrix4x4f projectionMatrix;
 		Matrix4x4f viewProjectionMatrix;
 
+		// Scales a bounding radius to its projected size for level of detail selection,
+		// divided by the camera distance under a perspective projection
+		float lodProjectionScale = 1.0f;
+		bool lodPerspective = true;
+
 		// Rendering meshes
 		std::unordered_map<RenderPassType, std::vector<RenderingMesh>> renderingMeshes;
 
+		// Radix sort scratch shared by all draw lists
+		std::vector<RenderingMesh> sortScratch;
+
 		// Material instance descriptor sets map
 		std::unordered_map<RenderPassType, MatInstDescriptorSetMap> materialInstanceDescriptorsMap;
 
 		// Rendering descriptor sets
-		std::array<VulkanDescriptorSet, EnumReflection<UniformSetUsage>::Size()> renderingDescriptorSets;
+		std::array<BoundUniformSet, EnumReflection<UniformSetUsage>::Size()> renderingDescriptorSets;
 
-		// Light data (packed as Vector4f for GPU upload)
+		// Draw chunks recorded in parallel, executed in order by the primary command buffer
+		std::vector<DrawChunk> drawChunks;
+
+		// Directional light data (packed as Vector4f for GPU upload), point and spot lights go to ClusteredLighting
 		int numDirectionalLights = 0;
-		int numPointLights = 0;
-		int numSpotLights = 0;
 		std::vector<Vector4f> dirLightDirections;  // xyz = direction, w = unused
 		std::vector<Vector4f> dirLightColors;      // xyz = color, w = intensity
-		std::vector<Vector4f> pointLightPositions; // xyz = position, w = unused
-		std::vector<Vector4f> pointLightColors;    // xyz = color, w = intensity
-		std::vector<Vector4f> pointLightAttenuations; // xyz = attenuation, w = unused
-		std::vector<Vector4f> spotLightPositions;  // xyz = position, w = unused
-		std::vector<Vector4f> spotLightDirections; // xyz = direction, w = unused
-		std::vector<Vector4f> spotLightColors;     // xyz = color, w = intensity
-		std::vector<Vector4f> spotLightAttenuations; // xyz = attenuation, w = unused
-		std::vector<Vector4f> spotLightCutoffs;    // x = cos(inner), y = cos(outer), zw = unused
 
 		// Camera frustum for culling
 		Frustum cameraFrustum;
 
+		// Mesh proxy indices that passed camera frustum culling
+		std::vector<uint32_t> visibleMeshProxies;
+
 		// CSM data
 		static constexpr uint32_t CSM_CASCADE_COUNT = 4;
 		std::array<Matrix4x4f, CSM_CASCADE_COUNT> cascadeViewProjMatrices;
 		std::array<float, CSM_CASCADE_COUNT> cascadeSplitDistances;
+
+		// Per cascade light space volume, open toward the light, used to cull shadow casters
+		std::array<Frustum, CSM_CASCADE_COUNT> cascadeCullingVolumes;
+
+		// Shadow casters of all cascades in one list, each carrying the mask of cascades it
+		// falls into. Culled against the cascade volumes instead of the camera frustum.
+		std::vector<RenderingMesh> shadowCasterMeshes;
+		std::vector<uint32_t> shadowCasterProxies;
+		std::vector<uint32_t> shadowCasterMasks;	// Indexed by mesh proxy
+		std::vector<uint32_t> cascadeProxies;		// Scratch for one cascade volume query
 	};
 }
\ No newline at end of file
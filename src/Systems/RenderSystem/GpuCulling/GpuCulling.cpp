@@ -0,0 +1,207 @@
+#include "GpuCulling.h"
+#include <algorithm>
+#include <cstring>
+#include "Ailurus/Utility/Logger.h"
+#include "Ailurus/Systems/AssetsSystem/Mesh/Mesh.h"
+#include "Ailurus/Systems/RenderSystem/Shader/ShaderLibrary.h"
+#include "Ailurus/Systems/RenderSystem/Shader/ShaderStage.h"
+#include <VulkanContext/CommandBuffer/VulkanCommandBuffer.h>
+#include <VulkanContext/DataBuffer/VulkanStorageBuffer.h>
+#include <VulkanContext/Descriptor/VulkanDescriptorAllocator.h>
+#include <VulkanContext/Descriptor/VulkanDescriptorSetLayout.h>
+#include <VulkanContext/Descriptor/VulkanDescriptorWriter.h>
+#include <VulkanContext/Pipeline/VulkanComputePipeline.h>
+#include <VulkanContext/Resource/DataBuffer/VulkanDeviceBuffer.h>
+
+namespace Ailurus
+{
+	static const char* GPU_CULL_COMP_PATH = "./Assets/ShaderBin/gpu_cull.comp.spv";
+
+	GpuCulling::GpuCulling() = default;
+
+	GpuCulling::~GpuCulling()
+	{
+		Shutdown();
+	}
+
+	void GpuCulling::Init(ShaderLibrary* pShaderLibrary)
+	{
+		std::vector<vk::DescriptorSetLayoutBinding> bindings(3);
+		for (uint32_t i = 0; i < bindings.size(); i++)
+		{
+			bindings[i].setBinding(i)
+				.setDescriptorType(vk::DescriptorType::eStorageBuffer)
+				.setDescriptorCount(1)
+				.setStageFlags(vk::ShaderStageFlagBits::eCompute);
+		}
+
+		_pDescriptorSetLayout = std::make_unique<VulkanDescriptorSetLayout>(bindings);
+
+		auto* pShader = pShaderLibrary->GetShader(ShaderStage::Compute, GPU_CULL_COMP_PATH);
+		if (pShader == nullptr)
+		{
+			Logger::LogError("GpuCulling: Failed to load culling shader {}", GPU_CULL_COMP_PATH);
+			return;
+		}
+
+		std::vector<vk::DescriptorSetLayout> layouts = { _pDescriptorSetLayout->GetDescriptorSetLayout() };
+		_pPipeline = std::make_unique<VulkanComputePipeline>(pShader, layouts);
+
+		_pObjectBuffer = std::make_unique<VulkanStorageBuffer>(OBJECT_BUFFER_INITIAL_CAPACITY);
+		_pDrawBuffer = std::make_unique<VulkanStorageBuffer>(DRAW_BUFFER_INITIAL_CAPACITY, DeviceBufferUsage::Indirect);
+	}
+
+	void GpuCulling::Shutdown()
+	{
+		_pPipeline.reset();
+		_pDescriptorSetLayout.reset();
+		_pObjectBuffer.reset();
+		_pDrawBuffer.reset();
+	}
+
+	bool GpuCulling::IsReady() const
+	{
+		return _pPipeline != nullptr && _pPipeline->GetPipeline() && _pObjectBuffer != nullptr && _pDrawBuffer != nullptr;
+	}
+
+	void GpuCulling::BeginFrame(const std::array<Frustum, VIEW_COUNT>& views)
+	{
+		_objects.clear();
+		_commands.clear();
+		_commandFirstInstances.clear();
+		_commandBucketCommands.clear();
+		_buckets.clear();
+		_dispatched = false;
+
+		for (uint32_t view = 0; view < VIEW_COUNT; view++)
+		{
+			for (uint32_t p = 0; p < 6; p++)
+			{
+				const FrustumPlane& plane = views[view].planes[p];
+				_header.viewPlanes[view * 6 + p] = Vector4f(plane.normal.x, plane.normal.y, plane.normal.z, plane.distance);
+			}
+		}
+	}
+
+	uint32_t GpuCulling::AddDrawBucket()
+	{
+		_buckets.push_back(DrawBucket{ static_cast<uint32_t>(_commands.size()), 0 });
+		return static_cast<uint32_t>(_buckets.size() - 1);
+	}
+
+	uint32_t GpuCulling::AddDrawCommand(const Mesh* pMesh, uint32_t lodIndex, uint32_t firstInstance)
+	{
+		if (_buckets.empty())
+			AddDrawBucket();
+
+		// Instance counts start at zero, the culling pass increments them per visible object.
+		// Geometry ranges point into the mesh's layout arena, which the recorder binds.
+		const DrawCommand command = pMesh->HasIndices()
+			? DrawCommand{ pMesh->GetIndexCount(lodIndex), 0, pMesh->GetFirstIndex(lodIndex), pMesh->GetVertexOffset(), firstInstance }
+			: DrawCommand{ pMesh->GetVertexCount(), 0, pMesh->GetVertexOffset(), firstInstance, 0 };
+
+		_commands.push_back(command);
+		_commandFirstInstances.push_back(firstInstance);
+		_commandBucketCommands.push_back(_buckets.back().firstCommand);
+		_buckets.back().commandCount++;
+		return static_cast<uint32_t>(_commands.size() - 1);
+	}
+
+	void GpuCulling::AddObject(const Matrix4x4f& modelMatrix, const AABBf& worldAABB, uint32_t viewIndex, uint32_t commandIndex)
+	{
+		// The two record layouts keep firstInstance at different offsets, the object carries it for the shader.
+		// The bucket's first command locates the draw count the survivors extend.
+		const auto& center = worldAABB.GetCenter();
+		const auto& extent = worldAABB.GetExtents();
+		_objects.push_back(CullObject{
+			modelMatrix,
+			Vector4f(center.x, center.y, center.z, 0.0f),
+			Vector4f(extent.x, extent.y, extent.z, 0.0f),
+			commandIndex,
+			viewIndex,
+			_commandFirstInstances[commandIndex],
+			_commandBucketCommands[commandIndex] });
+	}
+
+	void GpuCulling::Dispatch(VulkanCommandBuffer* pCommandBuffer, VulkanDescriptorAllocator* pDescriptorAllocator,
+		VulkanDeviceBuffer* pInstanceBuffer)
+	{
+		if (_commands.empty() || pInstanceBuffer == nullptr)
+			return;
+
+		const uint32_t commandCount = static_cast<uint32_t>(_commands.size());
+		const uint32_t objectCount = static_cast<uint32_t>(_objects.size());
+		_header.objectCount = objectCount;
+		_header.countOffset = commandCount * sizeof(DrawCommand) / sizeof(uint32_t);
+
+		// Objects
+		const size_t objectDataSize = sizeof(CullHeader) + objectCount * sizeof(CullObject);
+		auto* pObjectData = static_cast<uint8_t*>(_pObjectBuffer->BeginFrame(objectDataSize));
+		if (pObjectData == nullptr)
+			return;
+
+		std::memcpy(pObjectData, &_header, sizeof(CullHeader));
+		std::memcpy(pObjectData + sizeof(CullHeader), _objects.data(), objectCount * sizeof(CullObject));
+
+		// Commands followed by their zeroed draw counts
+		const size_t commandDataSize = commandCount * sizeof(DrawCommand);
+		const size_t drawDataSize = commandDataSize + commandCount * sizeof(uint32_t);
+		auto* pDrawData = static_cast<uint8_t*>(_pDrawBuffer->BeginFrame(drawDataSize));
+		if (pDrawData == nullptr)
+			return;
+
+		std::memcpy(pDrawData, _commands.data(), commandDataSize);
+		std::memset(pDrawData + commandDataSize, 0, commandCount * sizeof(uint32_t));
+
+		_pObjectBuffer->TransitionDataToGpu(pCommandBuffer, vk::PipelineStageFlagBits::eComputeShader);
+		_pDrawBuffer->TransitionDataToGpu(pCommandBuffer, vk::PipelineStageFlagBits::eComputeShader,
+			vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite);
+
+		auto* pObjectBuffer = _pObjectBuffer->GetThisFrameDeviceBuffer();
+		auto* pDrawBuffer = _pDrawBuffer->GetThisFrameDeviceBuffer();
+
+		auto descriptorSet = pDescriptorAllocator->AllocateDescriptorSet(_pDescriptorSetLayout.get());
+		VulkanDescriptorWriter writer;
+		writer.WriteStorageBuffer(0, pObjectBuffer->buffer, 0, objectDataSize);
+		writer.WriteStorageBuffer(1, pDrawBuffer->buffer, 0, drawDataSize);
+		writer.WriteStorageBuffer(2, pInstanceBuffer->buffer, 0, VK_WHOLE_SIZE);
+		writer.UpdateSet(descriptorSet);
+
+		pCommandBuffer->BindComputePipeline(_pPipeline.get());
+		pCommandBuffer->BindComputeDescriptorSet(_pPipeline->GetPipelineLayout(), { descriptorSet });
+		pCommandBuffer->Dispatch((objectCount + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE);
+
+		// Indirect draws read the compacted commands, vertex shaders the compacted model matrices
+		pCommandBuffer->BufferMemoryBarrier(pDrawBuffer,
+			vk::AccessFlagBits::eShaderWrite,
+			vk::AccessFlagBits::eIndirectCommandRead,
+			vk::PipelineStageFlagBits::eComputeShader,
+			vk::PipelineStageFlagBits::eDrawIndirect);
+
+		pCommandBuffer->BufferMemoryBarrier(pInstanceBuffer,
+			vk::AccessFlagBits::eShaderWrite,
+			vk::AccessFlagBits::eShaderRead,
+			vk::PipelineStageFlagBits::eComputeShader,
+			vk::PipelineStageFlagBits::eVertexShader);
+
+		_dispatched = true;
+	}
+
+	void GpuCulling::RecordDraw(VulkanCommandBuffer* pCommandBuffer, uint32_t bucketIndex, bool indexed) const
+	{
+		if (!_dispatched || bucketIndex >= _buckets.size())
+			return;
+
+		// Culled commands inside the bucket keep a zero instance count and draw nothing
+		const DrawBucket& bucket = _buckets[bucketIndex];
+		auto* pDrawBuffer = _pDrawBuffer->GetThisFrameDeviceBuffer();
+		const vk::DeviceSize commandOffset = bucket.firstCommand * sizeof(DrawCommand);
+		const vk::DeviceSize countOffset = (_header.countOffset + bucket.firstCommand) * sizeof(uint32_t);
+
+		if (indexed)
+			pCommandBuffer->DrawIndexedIndirectCount(pDrawBuffer, commandOffset, pDrawBuffer, countOffset, bucket.commandCount, sizeof(DrawCommand));
+		else
+			pCommandBuffer->DrawIndirectCount(pDrawBuffer, commandOffset, pDrawBuffer, countOffset, bucket.commandCount, sizeof(DrawCommand));
+	}
+
+} // namespace Ailurus
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+#include <Ailurus/Math/AABB.hpp>
+#include <Ailurus/Math/Frustum.hpp>
+#include <Ailurus/Math/Matrix4x4.hpp>
+#include <Ailurus/Math/Vector4.hpp>
+
+namespace Ailurus
+{
+	class Mesh;
+	class ShaderLibrary;
+	class VulkanCommandBuffer;
+	class VulkanComputePipeline;
+	class VulkanDescriptorAllocator;
+	class VulkanDescriptorSetLayout;
+	class VulkanDeviceBuffer;
+	class VulkanStorageBuffer;
+
+	/// Frustum culling of draw batches on the GPU. Every batch gets one indirect draw command
+	/// per view it is tested against, a compute pass culls its objects, compacts the survivors'
+	/// model matrices into the command's instance range and writes the instance and draw counts
+	/// read by the indirect draws. Commands sharing pipeline, material set and geometry arena
+	/// are grouped into a bucket and drawn by a single multi-draw.
+	class GpuCulling
+	{
+	public:
+		/// Camera frustum followed by the CSM cascade volumes
+		static constexpr uint32_t VIEW_COUNT = 5;
+
+		GpuCulling();
+		~GpuCulling();
+
+		void Init(ShaderLibrary* pShaderLibrary);
+		void Shutdown();
+		bool IsReady() const;
+
+		/// Start collecting the frame's draw commands and objects
+		void BeginFrame(const std::array<Frustum, VIEW_COUNT>& views);
+
+		/// Start a bucket, draw commands added until the next one are recorded by one multi-draw, returns its index
+		uint32_t AddDrawBucket();
+
+		/// Add a draw command of the mesh's level of detail whose instances start at firstInstance to the
+		/// current bucket, returns its index. All commands of a bucket must agree on being indexed.
+		uint32_t AddDrawCommand(const Mesh* pMesh, uint32_t lodIndex, uint32_t firstInstance);
+
+		/// Add an object culled against one view, its model matrix is appended to the command's instances when visible
+		void AddObject(const Matrix4x4f& modelMatrix, const AABBf& worldAABB, uint32_t viewIndex, uint32_t commandIndex);
+
+		/// Upload the frame's data and record the culling dispatch, pInstanceBuffer receives the compacted model matrices
+		void Dispatch(VulkanCommandBuffer* pCommandBuffer, VulkanDescriptorAllocator* pDescriptorAllocator,
+			VulkanDeviceBuffer* pInstanceBuffer);
+
+		/// Record the multi-draw of one bucket, commands past its last survivor are skipped
+		void RecordDraw(VulkanCommandBuffer* pCommandBuffer, uint32_t bucketIndex, bool indexed) const;
+
+	private:
+		/// std430 mirror of the compute shader's input header
+		struct CullHeader
+		{
+			std::array<Vector4f, VIEW_COUNT * 6> viewPlanes;	// xyz = normal, w = distance
+			uint32_t objectCount;
+			uint32_t countOffset;								// First draw count, in uints of the draw buffer
+			uint32_t padding[2];
+		};
+
+		/// std430 mirror of the compute shader's per object input
+		struct CullObject
+		{
+			Matrix4x4f modelMatrix;
+			Vector4f boundsCenter;
+			Vector4f boundsExtent;
+			uint32_t commandIndex;
+			uint32_t viewIndex;
+			uint32_t firstInstance;
+			uint32_t bucketCommand;								// First command of the bucket
+		};
+
+		/// VkDrawIndexedIndirectCommand, non-indexed draws use the first four uints as VkDrawIndirectCommand.
+		/// instanceCount is the second uint of both.
+		struct DrawCommand
+		{
+			uint32_t words[5];
+		};
+
+		static_assert(sizeof(CullHeader) == 496, "CullHeader must match the std430 layout of gpu_cull.comp");
+		static_assert(sizeof(CullObject) == 112, "CullObject must match the std430 layout of gpu_cull.comp");
+		static_assert(sizeof(DrawCommand) == 20, "DrawCommand must match VkDrawIndexedIndirectCommand");
+
+		struct DrawBucket
+		{
+			uint32_t firstCommand;
+			uint32_t commandCount;
+		};
+
+		static constexpr uint32_t WORKGROUP_SIZE = 64;
+		static constexpr size_t OBJECT_BUFFER_INITIAL_CAPACITY = sizeof(CullHeader) + 1024 * sizeof(CullObject);
+		static constexpr size_t DRAW_BUFFER_INITIAL_CAPACITY = 1024 * (sizeof(DrawCommand) + sizeof(uint32_t));
+
+		// Frame data collected on the cpu
+		CullHeader _header{};
+		std::vector<CullObject> _objects;
+		std::vector<DrawCommand> _commands;
+		std::vector<uint32_t> _commandFirstInstances;
+		std::vector<uint32_t> _commandBucketCommands;
+		std::vector<DrawBucket> _buckets;
+		bool _dispatched = false;
+
+		// Per frame buffers, the draw buffer holds the commands followed by one draw count per command.
+		// Only the count of a bucket's first command is read, it ends up one past the bucket's last survivor.
+		std::unique_ptr<VulkanStorageBuffer> _pObjectBuffer;
+		std::unique_ptr<VulkanStorageBuffer> _pDrawBuffer;
+
+		// Objects, draw buffer and instance buffer at bindings 0 - 2
+		std::unique_ptr<VulkanDescriptorSetLayout> _pDescriptorSetLayout;
+		std::unique_ptr<VulkanComputePipeline> _pPipeline;
+	};
+} // namespace Ailurus
@@ -9,6 +9,7 @@
 #include <VulkanContext/RenderTarget/RenderTarget.h>
 #include <VulkanContext/Descriptor/VulkanDescriptorWriter.h>
 #include <VulkanContext/CommandBuffer/VulkanCommandBuffer.h>
+#include <VulkanContext/Upload/VulkanUploadManager.h>
 #include <Ailurus/Math/Math.hpp>
 
 namespace Ailurus
@@ -93,6 +94,9 @@ namespace Ailurus
 			.setSetLayouts(_emptyDescriptorSetLayout);
 		_emptyDescriptorSet = device.allocateDescriptorSets(emptyAllocInfo)[0];
 
+		// The environment cubemap may still be on its way through the upload queue
+		VulkanContext::GetUploadManager()->FlushAndWait();
+
 		// Submit each IBL compute pass in its own command buffer.
 		// Using the engine's VulkanCommandBuffer wrapper ensures the same
 		// MoltenVK-compatible dynamic rendering code path as post-process effects.
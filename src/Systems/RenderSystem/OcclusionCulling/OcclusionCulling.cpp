@@ -0,0 +1,129 @@
+#include "OcclusionCulling.h"
+#include <algorithm>
+#include "Ailurus/Systems/JobSystem/JobSystem.h"
+#include "Ailurus/Systems/SceneSystem/Component/CompStaticMeshRender.h"
+#include "Systems/RenderSystem/RenderWorld/RenderWorld.h"
+
+namespace Ailurus
+{
+	// Twelve triangles of a box whose corner i has bit 0/1/2 selecting max x/y/z
+	static constexpr uint32_t BOX_INDICES[36] = {
+		0, 1, 3, 0, 3, 2, // -z
+		4, 6, 7, 4, 7, 5, // +z
+		0, 4, 5, 0, 5, 1, // -y
+		2, 3, 7, 2, 7, 6, // +y
+		0, 2, 6, 0, 6, 4, // -x
+		1, 5, 7, 1, 7, 3, // +x
+	};
+
+	/// Only occluders with an explicit hull are rasterized, the others are tested like any proxy
+	static bool IsRasterizedOccluder(const MeshRenderProxy& proxy)
+	{
+		return proxy.pMeshRender->IsOccluder() && proxy.pMeshRender->GetOccluderBounds().has_value();
+	}
+
+	OcclusionCulling::OcclusionCulling(JobSystem* pJobSystem)
+		: _pJobSystem(pJobSystem)
+	{
+		_buffer.Resize(BUFFER_WIDTH, BUFFER_HEIGHT);
+	}
+
+	uint32_t OcclusionCulling::Cull(const std::vector<MeshRenderProxy>& proxies, const Matrix4x4f& viewProjection,
+		const Vector3f& cameraPosition, std::vector<uint32_t>& visibleProxies)
+	{
+		CollectOccluders(proxies, cameraPosition, visibleProxies);
+		if (_occluders.empty())
+			return 0;
+
+		BuildOccluderTriangles(proxies, viewProjection);
+
+		// Each band owns its rows, clears and rasterizes every occluder triangle clipped to them
+		const uint32_t bandCount = (_buffer.GetHeight() + ROWS_PER_BAND - 1) / ROWS_PER_BAND;
+		_pJobSystem->ParallelFor(bandCount, 1, [this](uint32_t begin, uint32_t end) -> void {
+			for (uint32_t band = begin; band < end; band++)
+			{
+				const uint32_t rowBegin = band * ROWS_PER_BAND;
+				const uint32_t rowEnd = rowBegin + ROWS_PER_BAND;
+				_buffer.ClearRows(rowBegin, rowEnd);
+				_buffer.RasterizeTriangles(_clipVertices.data(), _indices.data(),
+					static_cast<uint32_t>(_indices.size()), rowBegin, rowEnd);
+			}
+		});
+
+		_buffer.BuildHierarchy();
+
+		// Occluders stay, they would only be tested against their own hull
+		const uint32_t visibleCount = static_cast<uint32_t>(visibleProxies.size());
+		_visible.assign(visibleCount, 1);
+		_pJobSystem->ParallelFor(visibleCount, TEST_BATCH_SIZE,
+			[this, &proxies, &viewProjection, &visibleProxies](uint32_t begin, uint32_t end) -> void {
+				for (uint32_t i = begin; i < end; i++)
+				{
+					const MeshRenderProxy& proxy = proxies[visibleProxies[i]];
+					if (!IsRasterizedOccluder(proxy))
+						_visible[i] = _buffer.IsVisible(proxy.worldAABB, viewProjection);
+				}
+			});
+
+		uint32_t keptCount = 0;
+		for (uint32_t i = 0; i < visibleCount; i++)
+		{
+			if (_visible[i])
+				visibleProxies[keptCount++] = visibleProxies[i];
+		}
+
+		visibleProxies.resize(keptCount);
+		return visibleCount - keptCount;
+	}
+
+	void OcclusionCulling::CollectOccluders(const std::vector<MeshRenderProxy>& proxies, const Vector3f& cameraPosition,
+		const std::vector<uint32_t>& visibleProxies)
+	{
+		_occluders.clear();
+		for (const uint32_t proxyIndex : visibleProxies)
+		{
+			if (IsRasterizedOccluder(proxies[proxyIndex]))
+				_occluders.push_back(proxyIndex);
+		}
+
+		if (_occluders.size() <= MAX_OCCLUDERS)
+			return;
+
+		// Keep the ones covering most of the screen, size over distance approximates it
+		auto screenSize = [&proxies, &cameraPosition](uint32_t proxyIndex) -> float {
+			const MeshRenderProxy& proxy = proxies[proxyIndex];
+			const float distance = std::max((proxy.worldPosition - cameraPosition).Magnitude(), 0.001f);
+			return proxy.worldAABB.GetExtents().Magnitude() / distance;
+		};
+
+		std::nth_element(_occluders.begin(), _occluders.begin() + MAX_OCCLUDERS, _occluders.end(),
+			[&screenSize](uint32_t lhs, uint32_t rhs) -> bool { return screenSize(lhs) > screenSize(rhs); });
+		_occluders.resize(MAX_OCCLUDERS);
+	}
+
+	void OcclusionCulling::BuildOccluderTriangles(const std::vector<MeshRenderProxy>& proxies, const Matrix4x4f& viewProjection)
+	{
+		_clipVertices.clear();
+		_indices.clear();
+
+		for (const uint32_t proxyIndex : _occluders)
+		{
+			const MeshRenderProxy& proxy = proxies[proxyIndex];
+			const AABBf& hull = *proxy.pMeshRender->GetOccluderBounds();
+			const Matrix4x4f modelViewProjection = viewProjection * proxy.worldMatrix;
+
+			const uint32_t baseVertex = static_cast<uint32_t>(_clipVertices.size());
+			for (int i = 0; i < 8; i++)
+			{
+				const Vector4f corner((i & 1) ? hull.max.x : hull.min.x,
+					(i & 2) ? hull.max.y : hull.min.y,
+					(i & 4) ? hull.max.z : hull.min.z,
+					1.0f);
+				_clipVertices.push_back(modelViewProjection * corner);
+			}
+
+			for (const uint32_t index : BOX_INDICES)
+				_indices.push_back(baseVertex + index);
+		}
+	}
+} // namespace Ailurus
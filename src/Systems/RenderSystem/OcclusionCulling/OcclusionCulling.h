@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <Ailurus/Math/Matrix4x4.hpp>
+#include <Ailurus/Math/Vector3.hpp>
+#include <Ailurus/Math/Vector4.hpp>
+#include <Ailurus/Math/OcclusionBuffer.hpp>
+#include <Ailurus/Utility/NonCopyable.h>
+#include <Ailurus/Utility/NonMovable.h>
+
+namespace Ailurus
+{
+	struct MeshRenderProxy;
+	class JobSystem;
+
+	/// CPU occlusion culling of frustum visible mesh proxies. The hull boxes of the largest
+	/// on-screen occluders are rasterized into a low resolution OcclusionBuffer in row bands on
+	/// the job system, then every other proxy's world AABB is tested against its depth hierarchy.
+	class OcclusionCulling : public NonCopyable, public NonMovable
+	{
+	public:
+		explicit OcclusionCulling(JobSystem* pJobSystem);
+
+		/// Remove the proxies hidden behind occluders from visibleProxies, returns how many were removed
+		uint32_t Cull(const std::vector<MeshRenderProxy>& proxies, const Matrix4x4f& viewProjection,
+			const Vector3f& cameraPosition, std::vector<uint32_t>& visibleProxies);
+
+	private:
+		void CollectOccluders(const std::vector<MeshRenderProxy>& proxies, const Vector3f& cameraPosition,
+			const std::vector<uint32_t>& visibleProxies);
+		void BuildOccluderTriangles(const std::vector<MeshRenderProxy>& proxies, const Matrix4x4f& viewProjection);
+
+	private:
+		static constexpr uint32_t BUFFER_WIDTH = 256;
+		static constexpr uint32_t BUFFER_HEIGHT = 128;
+		static constexpr uint32_t ROWS_PER_BAND = 16;
+		static constexpr uint32_t TEST_BATCH_SIZE = 64;
+		static constexpr uint32_t MAX_OCCLUDERS = 64;
+
+		JobSystem* _pJobSystem;
+		OcclusionBuffer _buffer;
+
+		// Frame scratch
+		std::vector<uint32_t> _occluders;
+		std::vector<Vector4f> _clipVertices;
+		std::vector<uint32_t> _indices;
+		std::vector<uint8_t> _visible;
+	};
+} // namespace Ailurus
@@ -138,7 +138,7 @@ namespace Ailurus
 
         // Bind [set 0 = global uniform, set 1 = G-Buffer samplers]
         std::vector<vk::DescriptorSet> sets = { _globalDescriptorSet, gBufferSet };
-        pCmdBuffer->BindDescriptorSet(_pipeline->GetPipelineLayout(), sets);
+        pCmdBuffer->BindDescriptorSet(_pipeline->GetPipelineLayout(), sets, _globalDynamicOffsets);
 
         // Push constant: inverse view-projection for world position reconstruction
         PushConstants pc{ _inverseViewProj };
@@ -174,9 +174,10 @@ namespace Ailurus
         _depthImageView = depth;
     }
 
-    void DeferredLightingEffect::SetGlobalDescriptorSet(vk::DescriptorSet globalSet)
+    void DeferredLightingEffect::SetGlobalDescriptorSet(vk::DescriptorSet globalSet, const std::vector<uint32_t>& dynamicOffsets)
     {
         _globalDescriptorSet = globalSet;
+        _globalDynamicOffsets = dynamicOffsets;
     }
 
     void DeferredLightingEffect::SetInverseViewProjMatrix(const Matrix4x4f& mat)
@@ -1,14 +1,18 @@
 #include <algorithm>
+#include <bit>
 #include <cstdint>
 #include <array>
 #include <cmath>
+#include <numeric>
 #include <Ailurus/Utility/EnumReflection.h>
 #include <Ailurus/Utility/Logger.h>
+#include <Ailurus/Utility/RadixSort.h>
 #include <Ailurus/Application.h>
 #include <Ailurus/Systems/RenderSystem/RenderSystem.h>
 #include <Ailurus/Systems/RenderSystem/Uniform/UniformSet.h>
 #include <Ailurus/Systems/RenderSystem/Uniform/UniformBindingPoint.h>
 #include <Ailurus/Systems/RenderSystem/Uniform/UniformSetMemory.h>
+#include <Ailurus/Systems/RenderSystem/Descriptor/BindlessTextureTable.h>
 #include <Ailurus/Systems/AssetsSystem/Material/MaterialInstance.h>
 #include <Ailurus/Systems/AssetsSystem/Texture/Texture.h>
 #include <Ailurus/Systems/AssetsSystem/Mesh/Mesh.h>
@@ -25,35 +29,126 @@
 #include <VulkanContext/CommandBuffer/VulkanCommandBuffer.h>
 #include <VulkanContext/Pipeline/VulkanPipelineManager.h>
 #include <VulkanContext/Pipeline/VulkanPipelineEntry.h>
-#include <VulkanContext/DataBuffer/VulkanVertexBuffer.h>
-#include <VulkanContext/DataBuffer/VulkanIndexBuffer.h>
-#include <VulkanContext/DataBuffer/VulkanUniformBuffer.h>
+#include <VulkanContext/DataBuffer/VulkanUniformRingBuffer.h>
+#include <VulkanContext/DataBuffer/VulkanStorageBuffer.h>
+#include <VulkanContext/Resource/DataBuffer/VulkanDeviceBuffer.h>
 #include <VulkanContext/Vertex/VulkanVertexLayoutManager.h>
+#include <VulkanContext/Geometry/VulkanGeometryArena.h>
 #include <VulkanContext/Descriptor/VulkanDescriptorAllocator.h>
+#include <VulkanContext/Descriptor/VulkanPersistentDescriptorSet.h>
 #include <VulkanContext/Descriptor/VulkanDescriptorSetLayout.h>
 #include <VulkanContext/Descriptor/VulkanDescriptorWriter.h>
 #include <VulkanContext/Resource/Image/VulkanSampler.h>
 #include <VulkanContext/Resource/Image/VulkanImage.h>
 #include "Ailurus/Systems/RenderSystem/RenderPass/RenderPassType.h"
 #include "Detail/RenderIntermediateVariable.h"
+#include "Detail/DrawSortKey.h"
 #include "Skybox/Skybox.h"
 #include "IBL/IBLManager.h"
+#include "GpuCulling/GpuCulling.h"
+#include "OcclusionCulling/OcclusionCulling.h"
+#include "ClusteredLighting/ClusteredLighting.h"
+#include "RenderWorld/RenderWorld.h"
 #include <Ailurus/Systems/RenderSystem/PostProcess/Effects/SSAOEffect.h>
 #include <Ailurus/Systems/RenderSystem/PostProcess/Effects/DeferredLightingEffect.h>
 
 namespace Ailurus
 {
+	static constexpr uint32_t SHADOW_MAP_SIZE = 2048;
+
+	/// Consecutive draws the recorders merge into one instanced draw. Shadow casters bind
+	/// nothing per material instance and must agree on their cascades instead.
+	static bool IsSameDrawBatch(RenderPassType pass, const RenderingMesh& lhs, const RenderingMesh& rhs)
+	{
+		if (lhs.pTargetMesh != rhs.pTargetMesh || lhs.lodIndex != rhs.lodIndex
+			|| lhs.pMaterial != rhs.pMaterial || lhs.vertexLayoutId != rhs.vertexLayoutId)
+			return false;
+
+		return pass == RenderPassType::Shadow
+			? lhs.shadowCascadeMask == rhs.shadowCascadeMask
+			: lhs.pMaterialInstance == rhs.pMaterialInstance;
+	}
+
+	/// Batches one GPU culled multi-draw can cover, they share pipeline, material set and bound geometry
+	static bool IsSameDrawBucket(RenderPassType pass, const RenderingMesh& lhs, const RenderingMesh& rhs)
+	{
+		if (lhs.pMaterial != rhs.pMaterial || lhs.vertexLayoutId != rhs.vertexLayoutId
+			|| lhs.pTargetMesh->GetGeometryArena() != rhs.pTargetMesh->GetGeometryArena()
+			|| lhs.pTargetMesh->HasIndices() != rhs.pTargetMesh->HasIndices())
+			return false;
+
+		return pass == RenderPassType::Shadow || lhs.pMaterialInstance == rhs.pMaterialInstance;
+	}
+
+	/// Meshes of one vertex layout share an arena, its buffers are bound once and stay bound
+	/// across pipeline switches until a mesh of another layout shows up.
+	static void BindGeometryArena(VulkanCommandBuffer* pCommandBuffer, const Mesh* pMesh, const VulkanGeometryArena*& pBoundArena)
+	{
+		const VulkanGeometryArena* pArena = pMesh->GetGeometryArena();
+		if (pArena == pBoundArena || pArena == nullptr)
+			return;
+
+		pBoundArena = pArena;
+		pCommandBuffer->BindVertexBuffer(pArena->GetVertexBuffer());
+		if (pArena->GetIndexBuffer() != nullptr)
+			pCommandBuffer->BindIndexBuffer(pArena->GetIndexBuffer(), VulkanGeometryArena::GetIndexType());
+	}
+
+	/// Mix an image binding into the hash of a persistent descriptor set's binding group
+	static size_t HashImageBinding(size_t hash, vk::ImageView imageView, vk::Sampler sampler)
+	{
+		const size_t imageHash = std::hash<VkImageView>{}(static_cast<VkImageView>(imageView));
+		const size_t samplerHash = std::hash<VkSampler>{}(static_cast<VkSampler>(sampler));
+		hash ^= imageHash + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+		hash ^= samplerHash + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+		return hash;
+	}
+
+	/// Bind uniform sets from set 0 on, with the ring slice of each set for all of its uniform bindings
+	static void BindUniformSets(VulkanCommandBuffer* pCommandBuffer, vk::PipelineLayout layout,
+		const BoundUniformSet* pSets, size_t count)
+	{
+		std::vector<vk::DescriptorSet> descriptorSets;
+		std::vector<uint32_t> dynamicOffsets;
+		for (size_t i = 0; i < count; i++)
+		{
+			descriptorSets.push_back(pSets[i].descriptorSet);
+			dynamicOffsets.insert(dynamicOffsets.end(), pSets[i].dynamicOffsetCount, pSets[i].dynamicOffset);
+		}
+
+		pCommandBuffer->BindDescriptorSet(layout, descriptorSets, dynamicOffsets);
+	}
+
+	/// Bounding radius of the proxy projected to normalized device units, what model LOD thresholds are given in
+	static float ProjectedSize(const MeshRenderProxy& proxy, const Vector3f& cameraPos, const RenderIntermediateVariable& var)
+	{
+		const float radius = proxy.worldAABB.GetExtents().Magnitude();
+		if (!var.lodPerspective)
+			return radius * var.lodProjectionScale;
+
+		const float distance = std::max((proxy.worldPosition - cameraPos).Magnitude(), 0.001f);
+		return radius * var.lodProjectionScale / distance;
+	}
+
 	void RenderSystem::RenderPrepare()
 	{
 		_renderStats.Reset();
 
 		const Matrix4x4f projMat = _pMainCamera->GetProjectionMatrix();
 		const Matrix4x4f viewMat = _pMainCamera->GetViewMatrix();
+		_pIntermediateVariable->viewMatrix = viewMat;
+		_pIntermediateVariable->projectionMatrix = projMat;
 		_pIntermediateVariable->viewProjectionMatrix = projMat * viewMat;
+		_pIntermediateVariable->lodProjectionScale = std::abs(projMat(1, 1));
+		_pIntermediateVariable->lodPerspective = _pMainCamera->IsPerspective();
 		_pIntermediateVariable->cameraFrustum = Frustum::FromViewProjection(_pIntermediateVariable->viewProjectionMatrix);
 		_pIntermediateVariable->renderingMeshes.clear();
 		_pIntermediateVariable->materialInstanceDescriptorsMap.clear();
-		_pIntermediateVariable->renderingDescriptorSets.fill(vk::DescriptorSet{});
+		_pIntermediateVariable->renderingDescriptorSets.fill(BoundUniformSet{});
+		_pIntermediateVariable->gpuDrivenCulling = _gpuDrivenCullingEnabled && _pGpuCulling != nullptr && _pGpuCulling->IsReady();
+
+		if (_pBindlessTextures != nullptr)
+			_pBindlessTextures->GarbageCollect();
 	}
 
 	void RenderSystem::CollectRenderingContext()
@@ -61,12 +156,40 @@ namespace Ailurus
 		auto& renderingMeshesMap = _pIntermediateVariable->renderingMeshes;
 		renderingMeshesMap.clear();
 
-		const auto allEntities = Application::Get<SceneSystem>()->GetAllRawEntities();
-		for (const auto pEntity : allEntities)
+		_pRenderWorld->Update();
+
+		// Proxies remember the level of detail they were drawn with
+		auto& meshProxies = _pRenderWorld->GetMeshProxies();
+
+		// Frustum culling through the spatial index, the GPU driven path submits every proxy and culls in its compute pass
+		auto& visibleProxies = _pIntermediateVariable->visibleMeshProxies;
+		visibleProxies.clear();
+		if (_pIntermediateVariable->gpuDrivenCulling)
 		{
-			const auto pMeshRender = pEntity->GetComponent<CompStaticMeshRender>();
-			if (pMeshRender == nullptr)
-				continue;
+			visibleProxies.resize(meshProxies.size());
+			std::iota(visibleProxies.begin(), visibleProxies.end(), 0u);
+		}
+		else
+		{
+			_pRenderWorld->QueryMeshProxies(_pIntermediateVariable->cameraFrustum, visibleProxies);
+		}
+
+		_renderStats.culledEntityCount += static_cast<uint32_t>(meshProxies.size() - visibleProxies.size());
+
+		const Vector3f cameraPos = _pMainCamera->GetEntity()->GetPosition();
+
+		// Then drop what hides behind occluders, shadow casters are collected separately and keep them
+		if (_occlusionCullingEnabled && !_pIntermediateVariable->gpuDrivenCulling)
+		{
+			_renderStats.occludedEntityCount += _pOcclusionCulling->Cull(meshProxies,
+				_pIntermediateVariable->viewProjectionMatrix, cameraPos, visibleProxies);
+		}
+		const float invFarPlane = 1.0f / _pMainCamera->GetFar();
+
+		for (const uint32_t proxyIndex : visibleProxies)
+		{
+			MeshRenderProxy& proxy = meshProxies[proxyIndex];
+			const auto pMeshRender = proxy.pMeshRender;
 
 			const auto& modelRef = pMeshRender->GetModelAsset();
 			if (!modelRef)
@@ -76,83 +199,60 @@ namespace Ailurus
 			if (!materialInstRef)
 				continue;
 
-			// Frustum culling
-			AABBf worldAABB = pMeshRender->GetWorldAABB();
-			if (!_pIntermediateVariable->cameraFrustum.Intersects(worldAABB))
-			{
-				_renderStats.culledEntityCount++;
-				continue;
-			}
-
 			_renderStats.entityCount++;
 
 			const auto* pMaterial = materialInstRef->GetTargetMaterial();
 			const auto* pMaterialInstance = materialInstRef.Get();
+			const float depth01 = (proxy.worldPosition - cameraPos).Magnitude() * invFarPlane;
+
+			const float screenSize = ProjectedSize(proxy, cameraPos, *_pIntermediateVariable) * _lodBias;
+			proxy.lodIndex = modelRef->SelectLod(screenSize, proxy.lodIndex);
+			const uint32_t lodIndex = proxy.lodIndex;
+
 			for (auto i = 0; i < EnumReflection<RenderPassType>::Size(); i++)
 			{
 				auto passType = static_cast<RenderPassType>(i);
 				if (!pMaterial->HasRenderPass(passType))
 					continue;
 
+				// Shadow casters are collected per cascade by CollectShadowCasters
+				if (passType == RenderPassType::Shadow)
+					continue;
+
 				const auto& allMeshes = modelRef->GetMeshes();
 				for (const auto& pMesh : allMeshes)
 				{
 					const auto vertexLayoutId = pMesh->GetVertexLayoutId();
 
+					// Opaque passes go front-to-back inside each pipeline, transparent back-to-front
+					const uint64_t sortKey = passType == RenderPassType::Transparent
+						? DrawSortKey::Transparent(passType, pMaterial->GetAssetId(), vertexLayoutId, pMaterialInstance->GetAssetId(), pMesh.get(), lodIndex, depth01)
+						: DrawSortKey::Opaque(passType, pMaterial->GetAssetId(), vertexLayoutId, pMaterialInstance->GetAssetId(), pMesh.get(), lodIndex, depth01);
+
 					renderingMeshesMap[passType].push_back(RenderingMesh{
 						pMaterial,
 						pMaterialInstance,
 						vertexLayoutId,
 						pMesh.get(),
-						pEntity });
+						lodIndex,
+						&proxy,
+						0,
+						sortKey });
 
 					_renderStats.meshCount++;
 				}
 			}
 		}
 
-		// Opaque meshes sorted by material & material instance
-		auto& forwardPassMeshes = renderingMeshesMap[RenderPassType::Forward];
-		std::sort(forwardPassMeshes.begin(), forwardPassMeshes.end(),
-			[](const RenderingMesh& lhs, const RenderingMesh& rhs) -> bool {
-				// Compare by Material
-				if (lhs.pMaterial != rhs.pMaterial)
-					return lhs.pMaterial < rhs.pMaterial;
-
-				// Compare by MaterialInstance
-				if (lhs.pMaterialInstance != rhs.pMaterialInstance)
-					return lhs.pMaterialInstance < rhs.pMaterialInstance;
-
-				// Compare by vertexLayoutId
-				return lhs.vertexLayoutId < rhs.vertexLayoutId;
-			});
-
-		// G-Buffer meshes sorted the same way as forward meshes (front-to-back is optimal for deferred)
-		auto& gBufferPassMeshes = renderingMeshesMap[RenderPassType::GBuffer];
-		std::sort(gBufferPassMeshes.begin(), gBufferPassMeshes.end(),
-			[](const RenderingMesh& lhs, const RenderingMesh& rhs) -> bool {
-				if (lhs.pMaterial != rhs.pMaterial)
-					return lhs.pMaterial < rhs.pMaterial;
-				if (lhs.pMaterialInstance != rhs.pMaterialInstance)
-					return lhs.pMaterialInstance < rhs.pMaterialInstance;
-				return lhs.vertexLayoutId < rhs.vertexLayoutId;
-			});
+		// Every pass list is ordered by its packed key, the ordering policy lives in DrawSortKey
+		for (auto& [passType, meshes] : renderingMeshesMap)
+			SortRenderingMeshes(meshes);
+	}
 
-		// Transparent meshes must be sorted back-to-front for correct alpha blending
-		auto& transparentPassMeshes = renderingMeshesMap[RenderPassType::Transparent];
-		if (!transparentPassMeshes.empty() && _pMainCamera)
-		{
-			const Vector3f cameraPos = _pMainCamera->GetEntity()->GetPosition();
-			std::sort(transparentPassMeshes.begin(), transparentPassMeshes.end(),
-				[&cameraPos](const RenderingMesh& lhs, const RenderingMesh& rhs) -> bool {
-					const Vector3f lhsPos = lhs.pEntity->GetPosition();
-					const Vector3f rhsPos = rhs.pEntity->GetPosition();
-					const float lhsDist = (lhsPos - cameraPos).SquareMagnitude();
-					const float rhsDist = (rhsPos - cameraPos).SquareMagnitude();
-					// Back-to-front: larger distance drawn first
-					return lhsDist > rhsDist;
-				});
-		}
+	void RenderSystem::SortRenderingMeshes(std::vector<RenderingMesh>& meshes)
+	{
+		RadixSort(meshes, _pIntermediateVariable->sortScratch,
+			[](const RenderingMesh& mesh) -> uint64_t { return mesh.sortKey; });
 	}
 
 	void RenderSystem::CollectLights()
@@ -160,26 +260,14 @@ namespace Ailurus
 		// Clear previous light data
 		auto& var = _pIntermediateVariable;
 		var->numDirectionalLights = 0;
-		var->numPointLights = 0;
-		var->numSpotLights = 0;
 		var->dirLightDirections.clear();
 		var->dirLightColors.clear();
-		var->pointLightPositions.clear();
-		var->pointLightColors.clear();
-		var->pointLightAttenuations.clear();
-		var->spotLightPositions.clear();
-		var->spotLightDirections.clear();
-		var->spotLightColors.clear();
-		var->spotLightAttenuations.clear();
-		var->spotLightCutoffs.clear();
-
-		// Collect lights from all entities
-		const auto allEntities = Application::Get<SceneSystem>()->GetAllRawEntities();
-		for (const auto pEntity : allEntities)
+		_pClusteredLighting->Clear();
+
+		// Light proxies are refreshed by CollectRenderingContext
+		for (const LightProxy& proxy : _pRenderWorld->GetLightProxies())
 		{
-			const auto pLight = pEntity->GetComponent<CompLight>();
-			if (pLight == nullptr)
-				continue;
+			const auto pLight = proxy.pLight;
 
 			const LightType lightType = pLight->GetLightType();
 			const Vector3f color = pLight->GetColor();
@@ -192,35 +280,18 @@ namespace Ailurus
 				var->dirLightColors.push_back(Vector4f(color.x, color.y, color.z, intensity));
 				var->numDirectionalLights++;
 			}
-			else if (lightType == LightType::Point && var->numPointLights < MAX_POINT_LIGHTS)
+			else if (lightType == LightType::Point)
 			{
-				const Vector3f position = pEntity->GetPosition();
-				const Vector3f attenuation = pLight->GetAttenuation();
-				var->pointLightPositions.push_back(Vector4f(position.x, position.y, position.z, 0.0f));
-				var->pointLightColors.push_back(Vector4f(color.x, color.y, color.z, intensity));
-				var->pointLightAttenuations.push_back(Vector4f(attenuation.x, attenuation.y, attenuation.z, 0.0f));
-				var->numPointLights++;
+				_pClusteredLighting->AddPointLight(proxy.worldPosition, color, intensity, pLight->GetAttenuation());
 			}
-			else if (lightType == LightType::Spot && var->numSpotLights < MAX_SPOT_LIGHTS)
+			else if (lightType == LightType::Spot)
 			{
-				const Vector3f position = pEntity->GetPosition();
-				const Vector3f direction = pLight->GetDirection();
-				const Vector3f attenuation = pLight->GetAttenuation();
-				const float innerCutoff = pLight->GetInnerCutoff();
-				const float outerCutoff = pLight->GetOuterCutoff();
-				
 				// Convert degrees to radians and then to cosine
-				const float innerRadians = innerCutoff * static_cast<float>(M_PI) / 180.0f;
-				const float outerRadians = outerCutoff * static_cast<float>(M_PI) / 180.0f;
-				const float cosInner = std::cos(innerRadians);
-				const float cosOuter = std::cos(outerRadians);
-
-				var->spotLightPositions.push_back(Vector4f(position.x, position.y, position.z, 0.0f));
-				var->spotLightDirections.push_back(Vector4f(direction.x, direction.y, direction.z, 0.0f));
-				var->spotLightColors.push_back(Vector4f(color.x, color.y, color.z, intensity));
-				var->spotLightAttenuations.push_back(Vector4f(attenuation.x, attenuation.y, attenuation.z, 0.0f));
-				var->spotLightCutoffs.push_back(Vector4f(cosInner, cosOuter, 0.0f, 0.0f));
-				var->numSpotLights++;
+				const float innerRadians = pLight->GetInnerCutoff() * static_cast<float>(M_PI) / 180.0f;
+				const float outerRadians = pLight->GetOuterCutoff() * static_cast<float>(M_PI) / 180.0f;
+
+				_pClusteredLighting->AddSpotLight(proxy.worldPosition, pLight->GetDirection(), color, intensity,
+					pLight->GetAttenuation(), std::cos(innerRadians), std::cos(outerRadians));
 			}
 		}
 
@@ -228,15 +299,9 @@ namespace Ailurus
 		var->dirLightDirections.resize(MAX_DIRECTIONAL_LIGHTS, Vector4f(0.0f, 0.0f, 0.0f, 0.0f));
 		var->dirLightColors.resize(MAX_DIRECTIONAL_LIGHTS, Vector4f(0.0f, 0.0f, 0.0f, 0.0f));
 
-		var->pointLightPositions.resize(MAX_POINT_LIGHTS, Vector4f(0.0f, 0.0f, 0.0f, 0.0f));
-		var->pointLightColors.resize(MAX_POINT_LIGHTS, Vector4f(0.0f, 0.0f, 0.0f, 0.0f));
-		var->pointLightAttenuations.resize(MAX_POINT_LIGHTS, Vector4f(0.0f, 0.0f, 0.0f, 0.0f));
-
-		var->spotLightPositions.resize(MAX_SPOT_LIGHTS, Vector4f(0.0f, 0.0f, 0.0f, 0.0f));
-		var->spotLightDirections.resize(MAX_SPOT_LIGHTS, Vector4f(0.0f, 0.0f, 0.0f, 0.0f));
-		var->spotLightColors.resize(MAX_SPOT_LIGHTS, Vector4f(0.0f, 0.0f, 0.0f, 0.0f));
-		var->spotLightAttenuations.resize(MAX_SPOT_LIGHTS, Vector4f(0.0f, 0.0f, 0.0f, 0.0f));
-		var->spotLightCutoffs.resize(MAX_SPOT_LIGHTS, Vector4f(0.0f, 0.0f, 0.0f, 0.0f));
+		// Bin point and spot lights into the camera's clusters
+		_pClusteredLighting->Build(var->viewMatrix, var->projectionMatrix, _pMainCamera->GetNear(), _pMainCamera->GetFar());
+		_renderStats.localLightCount = _pClusteredLighting->GetLightCount();
 	}
 
 	void RenderSystem::CalculateCascadeShadows()
@@ -251,6 +316,7 @@ namespace Ailurus
 			{
 				var->cascadeViewProjMatrices[i] = Matrix4x4f::Identity;
 				var->cascadeSplitDistances[i] = 0.0f;
+				var->cascadeCullingVolumes[i] = Frustum{};
 			}
 			return;
 		}
@@ -387,12 +453,209 @@ namespace Ailurus
 			
 			// Store the combined light view-projection matrix
 			var->cascadeViewProjMatrices[cascadeIndex] = lightProj * lightView;
+
+			// Caster culling volume is the same light space box in world space. The side facing
+			// the light is left open, a caster anywhere between the light and the cascade can
+			// still throw a shadow into it.
+			const Vector3f lightBack = -lightForward;
+			Frustum& cullingVolume = var->cascadeCullingVolumes[cascadeIndex];
+			cullingVolume.planes[0] = FrustumPlane{ Vector3f(0.0f, 0.0f, 0.0f), 0.0f };
+			cullingVolume.planes[1] = FrustumPlane{ lightBack, lightForward.Dot(lightPos) - minZ };
+			cullingVolume.planes[2] = FrustumPlane{ lightRight, -lightRight.Dot(lightPos) - minX };
+			cullingVolume.planes[3] = FrustumPlane{ -lightRight, lightRight.Dot(lightPos) + maxX };
+			cullingVolume.planes[4] = FrustumPlane{ -lightUp, lightUp.Dot(lightPos) + maxY };
+			cullingVolume.planes[5] = FrustumPlane{ lightUp, -lightUp.Dot(lightPos) - minY };
 			
 			// Update for next cascade
 			prevSplitDist = splitDist;
 		}
 	}
 
+	void RenderSystem::CollectShadowCasters()
+	{
+		auto& var = _pIntermediateVariable;
+		auto& casters = var->shadowCasterMeshes;
+		casters.clear();
+
+		if (var->numDirectionalLights == 0)
+			return;
+
+		auto& meshProxies = _pRenderWorld->GetMeshProxies();
+		auto& casterProxies = var->shadowCasterProxies;
+		auto& casterMasks = var->shadowCasterMasks;
+		casterMasks.assign(meshProxies.size(), 0);
+
+		casterProxies.clear();
+		if (var->gpuDrivenCulling)
+		{
+			// Every caster is tested against every cascade volume by the compute pass
+			constexpr uint32_t ALL_CASCADES_MASK = (1u << RenderIntermediateVariable::CSM_CASCADE_COUNT) - 1;
+			casterProxies.resize(meshProxies.size());
+			std::iota(casterProxies.begin(), casterProxies.end(), 0u);
+			casterMasks.assign(meshProxies.size(), ALL_CASCADES_MASK);
+		}
+		else
+		{
+			// Off screen casters are included, only the cascade volumes matter here
+			auto& cascadeProxies = var->cascadeProxies;
+			for (uint32_t cascadeIndex = 0; cascadeIndex < RenderIntermediateVariable::CSM_CASCADE_COUNT; cascadeIndex++)
+			{
+				cascadeProxies.clear();
+				_pRenderWorld->QueryMeshProxies(var->cascadeCullingVolumes[cascadeIndex], cascadeProxies);
+
+				for (const uint32_t proxyIndex : cascadeProxies)
+				{
+					if (casterMasks[proxyIndex] == 0)
+						casterProxies.push_back(proxyIndex);
+					casterMasks[proxyIndex] |= 1u << cascadeIndex;
+				}
+			}
+		}
+
+		// Shadow maps resolve less detail than the view, casters pick their level with a bias of their own
+		const Vector3f cameraPos = _pMainCamera->GetEntity()->GetPosition();
+		for (const uint32_t proxyIndex : casterProxies)
+		{
+			MeshRenderProxy& proxy = meshProxies[proxyIndex];
+
+			const auto& modelRef = proxy.pMeshRender->GetModelAsset();
+			if (!modelRef)
+				continue;
+
+			const auto& materialInstRef = proxy.pMeshRender->GetMaterialInstanceAsset();
+			if (!materialInstRef)
+				continue;
+
+			const auto* pMaterial = materialInstRef->GetTargetMaterial();
+			if (!pMaterial->HasRenderPass(RenderPassType::Shadow))
+				continue;
+
+			const float screenSize = ProjectedSize(proxy, cameraPos, *var) * _shadowLodBias;
+			proxy.shadowLodIndex = modelRef->SelectLod(screenSize, proxy.shadowLodIndex);
+			const uint32_t lodIndex = proxy.shadowLodIndex;
+
+			for (const auto& pMesh : modelRef->GetMeshes())
+			{
+				// The shadow pass binds nothing per material instance, the cascade mask takes its
+				// field so casters sharing a mesh and a mask can be drawn as one batch
+				const uint64_t vertexLayoutId = pMesh->GetVertexLayoutId();
+				const uint32_t cascadeMask = casterMasks[proxyIndex];
+				casters.push_back(RenderingMesh{
+					pMaterial,
+					materialInstRef.Get(),
+					vertexLayoutId,
+					pMesh.get(),
+					lodIndex,
+					&proxy,
+					cascadeMask,
+					DrawSortKey::Opaque(RenderPassType::Shadow, pMaterial->GetAssetId(), vertexLayoutId, cascadeMask, pMesh.get(), lodIndex, 0.0f) });
+			}
+		}
+
+		SortRenderingMeshes(casters);
+
+		_renderStats.meshCount += static_cast<uint32_t>(casters.size());
+	}
+
+	void RenderSystem::UploadInstanceData(VulkanCommandBuffer* pCommandBuffer, VulkanDescriptorAllocator* pDescriptorAllocator)
+	{
+		auto& var = _pIntermediateVariable;
+		if (var->gpuDrivenCulling)
+		{
+			UploadGpuCullingData(pCommandBuffer, pDescriptorAllocator);
+			return;
+		}
+
+		size_t instanceCount = var->shadowCasterMeshes.size();
+		for (const auto& [passType, meshes] : var->renderingMeshes)
+			instanceCount += meshes.size();
+
+		// Never empty, the descriptor always needs a buffer to point at
+		const size_t dataSize = std::max<size_t>(instanceCount, 1) * sizeof(Matrix4x4f);
+		auto* pModelMatrices = static_cast<Matrix4x4f*>(_pInstanceBuffer->BeginFrame(dataSize));
+		if (pModelMatrices == nullptr)
+			return;
+
+		// Lists are already sorted, so every batch the recorders merge reads a contiguous range
+		uint32_t nextInstance = 0;
+		const auto writeInstances = [&](std::vector<RenderingMesh>& meshes) -> void {
+			for (auto& renderingMesh : meshes)
+			{
+				renderingMesh.instanceIndex = nextInstance;
+				pModelMatrices[nextInstance] = renderingMesh.pProxy->worldMatrix;
+				nextInstance++;
+			}
+		};
+
+		writeInstances(var->shadowCasterMeshes);
+		for (auto& [passType, meshes] : var->renderingMeshes)
+			writeInstances(meshes);
+
+		_pInstanceBuffer->TransitionDataToGpu(pCommandBuffer, vk::PipelineStageFlagBits::eVertexShader);
+	}
+
+	void RenderSystem::UploadGpuCullingData(VulkanCommandBuffer* pCommandBuffer, VulkanDescriptorAllocator* pDescriptorAllocator)
+	{
+		auto& var = _pIntermediateVariable;
+
+		std::array<Frustum, GpuCulling::VIEW_COUNT> views;
+		views[0] = var->cameraFrustum;
+		for (uint32_t i = 0; i < RenderIntermediateVariable::CSM_CASCADE_COUNT; i++)
+			views[1 + i] = var->cascadeCullingVolumes[i];
+
+		_pGpuCulling->BeginFrame(views);
+
+		// Every batch gets one draw command per view it is culled against, each owning as many
+		// instance slots as the batch has draws. Survivors are compacted to the front of the range.
+		// A pass reserves one range of its whole list per view, so the view of an instance follows
+		// from its slot. Consecutive batches one multi-draw can cover share a bucket.
+		uint32_t nextInstance = 0;
+		const auto addBuckets = [&](RenderPassType pass, std::vector<RenderingMesh>& meshes, uint32_t firstView, uint32_t viewCount) -> void {
+			const uint32_t passFirstInstance = nextInstance;
+			const uint32_t viewStride = static_cast<uint32_t>(meshes.size());
+
+			uint32_t bucketIndex = 0;
+			for (size_t begin = 0; begin < meshes.size();)
+			{
+				if (begin == 0 || !IsSameDrawBucket(pass, meshes[begin - 1], meshes[begin]))
+					bucketIndex = _pGpuCulling->AddDrawBucket();
+
+				size_t end = begin + 1;
+				while (end < meshes.size() && IsSameDrawBatch(pass, meshes[begin], meshes[end]))
+					end++;
+
+				for (uint32_t view = 0; view < viewCount; view++)
+				{
+					const uint32_t firstInstance = passFirstInstance + view * viewStride + static_cast<uint32_t>(begin);
+					const uint32_t commandIndex = _pGpuCulling->AddDrawCommand(meshes[begin].pTargetMesh, meshes[begin].lodIndex, firstInstance);
+
+					for (size_t i = begin; i < end; i++)
+						_pGpuCulling->AddObject(meshes[i].pProxy->worldMatrix, meshes[i].pProxy->worldAABB, firstView + view, commandIndex);
+				}
+
+				for (size_t i = begin; i < end; i++)
+					meshes[i].drawBucketIndex = bucketIndex;
+
+				begin = end;
+			}
+
+			nextInstance += viewCount * viewStride;
+		};
+
+		// Shadow casters are culled against each cascade volume, one command per cascade. They take
+		// the front of the instance buffer, the shadow vertex shader derives the cascade from the slot.
+		addBuckets(RenderPassType::Shadow, var->shadowCasterMeshes, 1, RenderIntermediateVariable::CSM_CASCADE_COUNT);
+		for (auto& [passType, meshes] : var->renderingMeshes)
+			addBuckets(passType, meshes, 0, 1);
+
+		// The compute pass fills the instance buffer, nothing is copied from the cpu
+		const size_t dataSize = std::max<size_t>(nextInstance, 1) * sizeof(Matrix4x4f);
+		if (_pInstanceBuffer->BeginFrame(dataSize) == nullptr)
+			return;
+
+		_pGpuCulling->Dispatch(pCommandBuffer, pDescriptorAllocator, _pInstanceBuffer->GetThisFrameDeviceBuffer());
+	}
+
 	void RenderSystem::CreateIntermediateVariable()
 	{
 		_pIntermediateVariable = std::make_unique<RenderIntermediateVariable>();
@@ -531,8 +794,13 @@ namespace Ailurus
 					CollectRenderingContext();
 					CollectLights();
 					CalculateCascadeShadows();
-					UpdateGlobalUniformBuffer(pCommandBuffer, pDescriptorAllocator);
-					UpdateMaterialInstanceUniformBuffer(pCommandBuffer, pDescriptorAllocator);
+					CollectShadowCasters();
+					UploadInstanceData(pCommandBuffer, pDescriptorAllocator);
+					UpdateGlobalUniformBuffer(pCommandBuffer);
+					UpdateMaterialInstanceUniformBuffer();
+
+					// Record all draw lists into secondary command buffers on the job system
+					RecordDrawChunks();
 
 					// Shadow pass
 					RenderShadowPass(pCommandBuffer, pDescriptorAllocator);
@@ -732,152 +1000,95 @@ namespace Ailurus
 			});
 	}
 
-	void RenderSystem::UpdateGlobalUniformBuffer(VulkanCommandBuffer* pCommandBuffer, VulkanDescriptorAllocator* pDescriptorAllocator)
+	void RenderSystem::UpdateGlobalUniformBuffer(VulkanCommandBuffer* pCommandBuffer)
 	{
 		auto& var = _pIntermediateVariable;
+		const auto& handles = _globalUniformHandles;
 
-		_pGlobalUniformMemory->SetUniformValue(
-			{ 0, GetGlobalUniformAccessNameViewProjMat() },
-			var->viewProjectionMatrix);
-
-		_pGlobalUniformMemory->SetUniformValue(
-			{ 0, GetGlobalUniformAccessNameCameraPos() },
-			_pMainCamera->GetEntity()->GetPosition());
-
-		// Set light counts
-		_pGlobalUniformMemory->SetUniformValue(
-			{ 0, GetGlobalUniformAccessNameNumDirLights() },
-			var->numDirectionalLights);
-
-		_pGlobalUniformMemory->SetUniformValue(
-			{ 0, GetGlobalUniformAccessNameNumPointLights() },
-			var->numPointLights);
-
-		_pGlobalUniformMemory->SetUniformValue(
-			{ 0, GetGlobalUniformAccessNameNumSpotLights() },
-			var->numSpotLights);
-
-		// Set directional light arrays
-		for (uint32_t i = 0; i < MAX_DIRECTIONAL_LIGHTS; i++)
-		{
-			_pGlobalUniformMemory->SetUniformValue(
-				0, GetGlobalUniformAccessNameDirLightDirections() + "[" + std::to_string(i) + "]",
-				var->dirLightDirections[i]);
-
-			_pGlobalUniformMemory->SetUniformValue(
-				0, GetGlobalUniformAccessNameDirLightColors() + "[" + std::to_string(i) + "]",
-				var->dirLightColors[i]);
-		}
-
-		// Set point light arrays
-		for (uint32_t i = 0; i < MAX_POINT_LIGHTS; i++)
-		{
-			_pGlobalUniformMemory->SetUniformValue(
-				0, GetGlobalUniformAccessNamePointLightPositions() + "[" + std::to_string(i) + "]",
-				var->pointLightPositions[i]);
-
-			_pGlobalUniformMemory->SetUniformValue(
-				0, GetGlobalUniformAccessNamePointLightColors() + "[" + std::to_string(i) + "]",
-				var->pointLightColors[i]);
+		_pGlobalUniformMemory->Write(handles.viewProjectionMatrix, var->viewProjectionMatrix);
+		_pGlobalUniformMemory->Write(handles.cameraPosition, _pMainCamera->GetEntity()->GetPosition());
 
-			_pGlobalUniformMemory->SetUniformValue(
-				0, GetGlobalUniformAccessNamePointLightAttenuations() + "[" + std::to_string(i) + "]",
-				var->pointLightAttenuations[i]);
-		}
-
-		// Set spot light arrays
-		for (uint32_t i = 0; i < MAX_SPOT_LIGHTS; i++)
-		{
-			_pGlobalUniformMemory->SetUniformValue(
-				0, GetGlobalUniformAccessNameSpotLightPositions() + "[" + std::to_string(i) + "]",
-				var->spotLightPositions[i]);
-
-			_pGlobalUniformMemory->SetUniformValue(
-				0, GetGlobalUniformAccessNameSpotLightDirections() + "[" + std::to_string(i) + "]",
-				var->spotLightDirections[i]);
+		// Set directional lights, the arrays are padded to MAX_DIRECTIONAL_LIGHTS
+		_pGlobalUniformMemory->Write(handles.numDirectionalLights, static_cast<int32_t>(var->numDirectionalLights));
+		_pGlobalUniformMemory->WriteArray(handles.dirLightDirections, var->dirLightDirections.data(), MAX_DIRECTIONAL_LIGHTS);
+		_pGlobalUniformMemory->WriteArray(handles.dirLightColors, var->dirLightColors.data(), MAX_DIRECTIONAL_LIGHTS);
 
-			_pGlobalUniformMemory->SetUniformValue(
-				0, GetGlobalUniformAccessNameSpotLightColors() + "[" + std::to_string(i) + "]",
-				var->spotLightColors[i]);
-
-			_pGlobalUniformMemory->SetUniformValue(
-				0, GetGlobalUniformAccessNameSpotLightAttenuations() + "[" + std::to_string(i) + "]",
-				var->spotLightAttenuations[i]);
-
-			_pGlobalUniformMemory->SetUniformValue(
-				0, GetGlobalUniformAccessNameSpotLightCutoffs() + "[" + std::to_string(i) + "]",
-				var->spotLightCutoffs[i]);
-		}
+		// Set cluster lookup (camera forward for the view depth, x = slice scale, y = slice bias)
+		const Vector3f cameraForward = -Vector3f(var->viewMatrix(2, 0), var->viewMatrix(2, 1), var->viewMatrix(2, 2));
+		_pGlobalUniformMemory->Write(handles.cameraForward, Vector4f(cameraForward.x, cameraForward.y, cameraForward.z, 0.0f));
+		_pGlobalUniformMemory->Write(handles.clusterParams, _pClusteredLighting->GetClusterParams());
 
 		// Set CSM cascade matrices and split distances
-		for (uint32_t i = 0; i < RenderIntermediateVariable::CSM_CASCADE_COUNT; i++)
-		{
-			_pGlobalUniformMemory->SetUniformValue(
-				0, GetGlobalUniformAccessNameCascadeViewProjMatrices() + "[" + std::to_string(i) + "]",
-				var->cascadeViewProjMatrices[i]);
-
-			_pGlobalUniformMemory->SetUniformValue(
-				0, GetGlobalUniformAccessNameCascadeSplitDistances() + "[" + std::to_string(i) + "]",
-				var->cascadeSplitDistances[i]);
-		}
+		_pGlobalUniformMemory->WriteArray(handles.cascadeViewProjMatrices,
+			var->cascadeViewProjMatrices.data(), RenderIntermediateVariable::CSM_CASCADE_COUNT);
+		_pGlobalUniformMemory->WriteArray(handles.cascadeSplitDistances,
+			var->cascadeSplitDistances.data(), RenderIntermediateVariable::CSM_CASCADE_COUNT);
 
 		// Set ambient color (xyz = color, w = strength)
-		Vector4f ambientData(_ambientColor.x, _ambientColor.y, _ambientColor.z, _ambientStrength);
-		_pGlobalUniformMemory->SetUniformValue(
-			0, GetGlobalUniformAccessNameAmbientColor(),
-			ambientData);
+		_pGlobalUniformMemory->Write(handles.ambientColor,
+			Vector4f(_ambientColor.x, _ambientColor.y, _ambientColor.z, _ambientStrength));
 
 		// Set shadow bias params (x = constant, y = slope scale, z = normal offset, w = unused)
-		Vector4f shadowBiasData(_shadowConstantBias, _shadowSlopeScale, _shadowNormalOffset, 0.0f);
-		_pGlobalUniformMemory->SetUniformValue(
-			0, GetGlobalUniformAccessNameShadowBiasParams(),
-			shadowBiasData);
-
-		// Use cache to get or allocate descriptor set
-		// Key: layout only (global uniform always uses same layout)
-		auto globalUniformSetLayout = _pGlobalUniformSet->GetDescriptorSetLayout();
-		
-		VulkanDescriptorAllocator::CacheKey key;
-		key.layout = globalUniformSetLayout->GetDescriptorSetLayout();
-		key.bindingHash = 1; // Fixed hash for global uniform (to distinguish from material)
-		
-		auto globalDescriptorSet = pDescriptorAllocator->AllocateDescriptorSet(globalUniformSetLayout, &key);
+		_pGlobalUniformMemory->Write(handles.shadowBiasParams,
+			Vector4f(_shadowConstantBias, _shadowSlopeScale, _shadowNormalOffset, 0.0f));
+
+		// The global set lives across frames, IMPORTANT: the uniform data still changes every frame
+		auto globalDescriptorSet = _pGlobalUniformMemory->UpdatePersistentDescriptorSet();
+		_renderStats.uniformUploadBytes += _pGlobalUniformMemory->GetLastUploadSize();
+		auto* pPersistentSet = _pGlobalUniformMemory->GetPersistentDescriptorSet();
+		if (!globalDescriptorSet)
+			return;
 
 		// Save set
-		_pIntermediateVariable->renderingDescriptorSets[static_cast<int>(UniformSetUsage::General)] = globalDescriptorSet;
+		_pIntermediateVariable->renderingDescriptorSets[static_cast<int>(UniformSetUsage::General)] = BoundUniformSet{
+			globalDescriptorSet, _pGlobalUniformMemory->GetDynamicOffset(), _pGlobalUniformMemory->GetDynamicOffsetCount() };
 
-		// IMPORTANT: Always update descriptor set data (buffer content changes each frame)
-		_pGlobalUniformMemory->UpdateToDescriptorSet(pCommandBuffer, globalDescriptorSet);
-
-		// Write shadow map image views to the global descriptor set (bindings 1-4)
+		// Write the shadow map array view to the global descriptor set (binding 1), only when it changed
 		if (_shadowSampler != nullptr)
 		{
-			auto* pRenderTargetManager = VulkanContext::GetRenderTargetManager();
-			VulkanDescriptorWriter shadowWriter;
-			for (uint32_t i = 0; i < pRenderTargetManager->GetShadowMapCascadeCount(); i++)
+			vk::ImageView shadowMapView = VulkanContext::GetRenderTargetManager()->GetShadowMapImageView();
+			if (shadowMapView && pPersistentSet->NeedsWrite(GLOBAL_SHADOW_BINDING_GROUP,
+				HashImageBinding(0, shadowMapView, _shadowSampler->GetSampler())))
 			{
-				vk::ImageView shadowMapView = pRenderTargetManager->GetShadowMapImageView(i);
-				if (shadowMapView)
-					shadowWriter.WriteImage(i + 1, shadowMapView, _shadowSampler->GetSampler());
+				VulkanDescriptorWriter shadowWriter;
+				shadowWriter.WriteImage(1, shadowMapView, _shadowSampler->GetSampler());
+				shadowWriter.UpdateSet(globalDescriptorSet);
 			}
-			shadowWriter.UpdateSet(globalDescriptorSet);
 		}
 
-		// Write IBL textures to global descriptor set (bindings 5-7)
+		// Write this frame's instance buffer to the global descriptor set
+		if (auto* pInstanceBuffer = _pInstanceBuffer->GetThisFrameDeviceBuffer())
+		{
+			VulkanDescriptorWriter instanceWriter;
+			instanceWriter.WriteStorageBuffer(INSTANCE_BUFFER_BINDING, pInstanceBuffer->buffer, 0, _pInstanceBuffer->GetDataSize());
+			instanceWriter.UpdateSet(globalDescriptorSet);
+		}
+
+		// Write this frame's clustered lights to the global descriptor set
+		_pClusteredLighting->Upload(pCommandBuffer);
+		_pClusteredLighting->WriteDescriptorSet(globalDescriptorSet);
+
+		// Write IBL textures to global descriptor set (bindings 5-7), only when they changed
 		if (_pIBLManager && _pIBLManager->IsReady())
 		{
-			VulkanDescriptorWriter iblWriter;
-			iblWriter.WriteImage(5, _pIBLManager->GetIrradianceMapView(),
-								 _pIBLManager->GetIrradianceSampler()->GetSampler());
-			iblWriter.WriteImage(6, _pIBLManager->GetPrefilteredMapView(),
-								 _pIBLManager->GetPrefilteredSampler()->GetSampler());
-			iblWriter.WriteImage(7, _pIBLManager->GetBRDFLUTView(),
-								 _pIBLManager->GetBRDFLUTSampler()->GetSampler());
-			iblWriter.UpdateSet(globalDescriptorSet);
+			size_t iblHash = HashImageBinding(0, _pIBLManager->GetIrradianceMapView(), _pIBLManager->GetIrradianceSampler()->GetSampler());
+			iblHash = HashImageBinding(iblHash, _pIBLManager->GetPrefilteredMapView(), _pIBLManager->GetPrefilteredSampler()->GetSampler());
+			iblHash = HashImageBinding(iblHash, _pIBLManager->GetBRDFLUTView(), _pIBLManager->GetBRDFLUTSampler()->GetSampler());
+			if (pPersistentSet->NeedsWrite(GLOBAL_IBL_BINDING_GROUP, iblHash))
+			{
+				VulkanDescriptorWriter iblWriter;
+				iblWriter.WriteImage(5, _pIBLManager->GetIrradianceMapView(),
+									 _pIBLManager->GetIrradianceSampler()->GetSampler());
+				iblWriter.WriteImage(6, _pIBLManager->GetPrefilteredMapView(),
+									 _pIBLManager->GetPrefilteredSampler()->GetSampler());
+				iblWriter.WriteImage(7, _pIBLManager->GetBRDFLUTView(),
+									 _pIBLManager->GetBRDFLUTSampler()->GetSampler());
+				iblWriter.UpdateSet(globalDescriptorSet);
+			}
 		}
 	}
 
-	void RenderSystem::UpdateMaterialInstanceUniformBuffer(VulkanCommandBuffer* pCommandBuffer, VulkanDescriptorAllocator* pDescriptorAllocator)
+	void RenderSystem::UpdateMaterialInstanceUniformBuffer()
 	{
 		auto& opaqueMeshes = _pIntermediateVariable->renderingMeshes;
 		for (auto& [pass, meshes] : opaqueMeshes)
@@ -896,24 +1107,20 @@ namespace Ailurus
 				if (pUniformSet == nullptr)
 					continue;
 
-				// Use cache to get or allocate descriptor set
-				auto* pDescriptorLayout = pUniformSet->GetDescriptorSetLayout();
-				
-				// Create cache key based on layout and material instance
-				VulkanDescriptorAllocator::CacheKey key;
-				key.layout = pDescriptorLayout->GetDescriptorSetLayout();
-				key.bindingHash = reinterpret_cast<size_t>(pMaterialInstance); // Use material instance pointer as hash
-				
-				auto descriptorSet = pDescriptorAllocator->AllocateDescriptorSet(pDescriptorLayout, &key);
-
-				// Update UBO data to descriptor set
-				pMaterialInstance->GetUniformSetMemory(pass)->UpdateToDescriptorSet(pCommandBuffer, descriptorSet);
+				// Update UBO data, unchanged instances upload nothing and keep their descriptor set as is
+				auto* pUniformMemory = pMaterialInstance->GetUniformSetMemory(pass);
+				auto descriptorSet = pUniformMemory->UpdatePersistentDescriptorSet();
+				_renderStats.uniformUploadBytes += pUniformMemory->GetLastUploadSize();
+				if (!descriptorSet)
+					continue;
 
-				// Write material texture bindings separately
+				// Write material texture bindings separately, only when a texture changed. Bindless
+				// passes sample the bindless table instead and their set has no texture bindings.
 				auto* pTexturesMap = pMaterialInstance->GetTextures(pass);
-				if (pTexturesMap != nullptr)
+				if (pTexturesMap != nullptr && !pMaterial->IsPassBindless(pass))
 				{
 					VulkanDescriptorWriter textureWriter;
+					size_t textureHash = 0;
 					for (const auto& [uniformVarName, textureRef] : *pTexturesMap)
 					{
 						auto* pTexture = textureRef.Get();
@@ -927,166 +1134,130 @@ namespace Ailurus
 
 						uint32_t texBindingId = pTexture->GetBindingId();
 						textureWriter.WriteImage(texBindingId, pImage->GetImageView(), pSampler->GetSampler());
+						textureHash = HashImageBinding(textureHash ^ texBindingId, pImage->GetImageView(), pSampler->GetSampler());
 					}
-					textureWriter.UpdateSet(descriptorSet);
+
+					if (pUniformMemory->GetPersistentDescriptorSet()->NeedsWrite(MATERIAL_TEXTURE_BINDING_GROUP, textureHash))
+						textureWriter.UpdateSet(descriptorSet);
 				}
 
 				// Record material instance descriptor set
-				mapInstDescriptorSetMap[pMaterialInstance] = descriptorSet;
+				mapInstDescriptorSetMap[pMaterialInstance] = BoundUniformSet{
+					descriptorSet, pUniformMemory->GetDynamicOffset(), pUniformMemory->GetDynamicOffsetCount() };
 			}
 		}
 	}
 
-	void RenderSystem::RenderShadowPass(VulkanCommandBuffer* pCommandBuffer, VulkanDescriptorAllocator* pDescriptorAllocator)
+	void RenderSystem::RecordDrawChunks()
 	{
-		auto* pRenderTargetManager = VulkanContext::GetRenderTargetManager();
-		const uint32_t cascadeCount = pRenderTargetManager->GetShadowMapCascadeCount();
-		const uint32_t shadowMapSize = 2048;
-
-		auto& shadowMeshes = _pIntermediateVariable->renderingMeshes[RenderPassType::Shadow];
-
-		for (uint32_t cascadeIndex = 0; cascadeIndex < cascadeCount; cascadeIndex++)
-		{
-			vk::Image shadowImage = pRenderTargetManager->GetShadowMapImage(cascadeIndex);
-			vk::ImageView shadowImageView = pRenderTargetManager->GetShadowMapImageView(cascadeIndex);
-
-			if (!shadowImage || !shadowImageView)
-				continue;
-
-			// Transition shadow map to depth attachment optimal
-			pCommandBuffer->ImageMemoryBarrier(
-				shadowImage,
-				vk::ImageLayout::eUndefined,
-				vk::ImageLayout::eDepthStencilAttachmentOptimal,
-				vk::AccessFlags{},
-				vk::AccessFlagBits::eDepthStencilAttachmentWrite,
-				vk::PipelineStageFlagBits::eTopOfPipe,
-				vk::PipelineStageFlagBits::eEarlyFragmentTests,
-				vk::ImageAspectFlagBits::eDepth);
-
-			// Begin depth-only rendering (clears and stores depth)
-			pCommandBuffer->BeginDepthOnlyRendering(shadowImageView, vk::Extent2D{shadowMapSize, shadowMapSize});
-			pCommandBuffer->SetViewportAndScissor(shadowMapSize, shadowMapSize);
-
-			// Render shadow meshes for this cascade
-			VulkanPipeline* pCurrentVkPipeline = nullptr;
-			uint64_t currentVertexLayoutId = 0;
-
-			for (const auto& renderingMesh : shadowMeshes)
+		auto& drawChunks = _pIntermediateVariable->drawChunks;
+		drawChunks.clear();
+
+		auto& renderingMeshes = _pIntermediateVariable->renderingMeshes;
+		const bool gpuDrivenCulling = _pIntermediateVariable->gpuDrivenCulling;
+		auto addChunks = [&](RenderPassType pass, const std::vector<RenderingMesh>& meshes, bool withSkybox) -> void {
+			const uint32_t meshCount = static_cast<uint32_t>(meshes.size());
+			for (uint32_t begin = 0; begin < meshCount;)
 			{
-				if (currentVertexLayoutId != renderingMesh.vertexLayoutId)
-				{
-					currentVertexLayoutId = renderingMesh.vertexLayoutId;
+				// Chunks end on a batch boundary, a batch is always recorded as one draw. With GPU
+				// culling a whole bucket is one multi-draw, so chunks end on a bucket boundary instead.
+				uint32_t end = std::min(meshCount, begin + DRAW_CHUNK_SIZE);
+				while (end < meshCount && (gpuDrivenCulling
+					? IsSameDrawBucket(pass, meshes[end - 1], meshes[end])
+					: IsSameDrawBatch(pass, meshes[end - 1], meshes[end])))
+					end++;
+
+				drawChunks.push_back(DrawChunk{ pass, begin, end, withSkybox && end == meshCount, nullptr, 0, 0 });
+				begin = end;
+			}
 
-					VulkanPipelineEntry pipelineEntry(RenderPassType::Shadow, renderingMesh.pMaterial->GetAssetId(), currentVertexLayoutId);
-					pCurrentVkPipeline = VulkanContext::GetPipelineManager()->GetPipeline(pipelineEntry);
-					if (pCurrentVkPipeline == nullptr)
-					{
-						Logger::LogError("RenderShadowPass: Shadow pipeline not found");
-						continue;
-					}
+			// The skybox still needs a buffer when there is nothing else to draw
+			if (withSkybox && meshCount == 0)
+				drawChunks.push_back(DrawChunk{ pass, 0, 0, true, nullptr, 0, 0 });
+		};
 
-					pCommandBuffer->BindPipeline(pCurrentVkPipeline);
+		static const std::vector<RenderingMesh> EMPTY_MESHES;
+		const auto meshesOf = [&](RenderPassType pass) -> const std::vector<RenderingMesh>& {
+			const auto itr = renderingMeshes.find(pass);
+			return itr == renderingMeshes.end() ? EMPTY_MESHES : itr->second;
+		};
 
-					// Shadow pass only uses the global descriptor set (no material-specific set)
-					std::vector<vk::DescriptorSet> descriptorSets{
-						_pIntermediateVariable->renderingDescriptorSets[static_cast<int>(UniformSetUsage::General)]
-					};
-					pCommandBuffer->BindDescriptorSet(pCurrentVkPipeline->GetPipelineLayout(), descriptorSets);
-				}
+		// All cascades are drawn by the same chunks, instancing fans each draw out to its cascades
+		addChunks(RenderPassType::Shadow, _pIntermediateVariable->shadowCasterMeshes, false);
 
-				if (pCurrentVkPipeline == nullptr)
-					continue;
+		addChunks(RenderPassType::GBuffer, meshesOf(RenderPassType::GBuffer), false);
 
-				// Push model matrix and cascade index
-				pCommandBuffer->PushConstantShadowData(pCurrentVkPipeline, renderingMesh.pEntity->GetModelMatrix(), cascadeIndex);
+		if (!renderingMeshes.empty())
+			addChunks(RenderPassType::Forward, meshesOf(RenderPassType::Forward), true);
 
-				// Bind vertex buffer
-				const auto pVertexBuffer = renderingMesh.pTargetMesh->GetVertexBuffer();
-				pCommandBuffer->BindVertexBuffer(pVertexBuffer);
+		addChunks(RenderPassType::Transparent, meshesOf(RenderPassType::Transparent), false);
 
-				// Draw
-				const auto pIndexBuffer = renderingMesh.pTargetMesh->GetIndexBuffer();
-				if (pIndexBuffer != nullptr)
-				{
-					pCommandBuffer->BindIndexBuffer(pIndexBuffer);
-					pCommandBuffer->DrawIndexed(pIndexBuffer->GetIndexCount());
-				}
-				else
-				{
-					pCommandBuffer->DrawNonIndexed(renderingMesh.pTargetMesh->GetVertexCount());
-				}
-			}
+		if (drawChunks.empty())
+			return;
+
+		// Chunks only read frame data prepared above, each one records into its own secondary command buffer
+		Application::Get<JobSystem>()->ParallelFor(static_cast<uint32_t>(drawChunks.size()), 1,
+			[this, &drawChunks](uint32_t begin, uint32_t end) -> void {
+				for (uint32_t i = begin; i < end; i++)
+					RecordDrawChunk(drawChunks[i]);
+			});
 
-			pCommandBuffer->EndRendering();
-
-			// Transition shadow map to shader read only for sampling in the forward pass
-			pCommandBuffer->ImageMemoryBarrier(
-				shadowImage,
-				vk::ImageLayout::eDepthStencilAttachmentOptimal,
-				vk::ImageLayout::eShaderReadOnlyOptimal,
-				vk::AccessFlagBits::eDepthStencilAttachmentWrite,
-				vk::AccessFlagBits::eShaderRead,
-				vk::PipelineStageFlagBits::eLateFragmentTests,
-				vk::PipelineStageFlagBits::eFragmentShader,
-				vk::ImageAspectFlagBits::eDepth);
+		for (const auto& chunk : drawChunks)
+		{
+			_renderStats.drawCalls += chunk.drawCalls;
+			_renderStats.triangleCount += chunk.triangleCount;
 		}
 	}
 
-	void RenderSystem::RenderPass(RenderPassType pass, VulkanCommandBuffer* pCommandBuffer)
+	void RenderSystem::RecordDrawChunk(DrawChunk& chunk) const
 	{
-		if (_pIntermediateVariable->renderingMeshes.empty())
-			return;
+		const VulkanRenderingInheritance inheritance = GetPassRenderingInheritance(chunk.pass);
 
-		// Get swap chain extent
-		auto pSwapChain = VulkanContext::GetSwapChain();
-		if (pSwapChain == nullptr)
-		{
-			Logger::LogError("SwapChain not found");
-			return;
-		}
+		chunk.pCommandBuffer = VulkanContext::RecordFrameSecondaryCommandBuffer(&inheritance,
+			[this, &chunk](VulkanCommandBuffer* pCommandBuffer) -> void {
+				if (chunk.pass == RenderPassType::Shadow)
+				{
+					const RenderingMesh* pCasters = _pIntermediateVariable->shadowCasterMeshes.data();
+					RecordShadowDraws(pCasters + chunk.begin, pCasters + chunk.end, pCommandBuffer);
+					return;
+				}
 
-		vk::Extent2D extent = pSwapChain->GetConfig().extent;
+				const auto itr = _pIntermediateVariable->renderingMeshes.find(chunk.pass);
+				const RenderingMesh* pMeshes = itr != _pIntermediateVariable->renderingMeshes.end()
+					? itr->second.data()
+					: nullptr;
 
-		// Check if MSAA is enabled
-		bool useMSAA = VulkanContext::GetMSAASamples() != vk::SampleCountFlagBits::e1;
-		auto* pRenderTargetManager = VulkanContext::GetRenderTargetManager();
+				if (chunk.begin != chunk.end)
+					RecordMeshDraws(chunk.pass, pMeshes + chunk.begin, pMeshes + chunk.end, pCommandBuffer, chunk);
 
-		// Offscreen HDR RT is the render target for the forward pass
-		vk::ImageView offscreenColorView = pRenderTargetManager->GetOffscreenColorImageView();
+				// Render skybox after all geometry (depth test ensures it only draws where depth = 1.0)
+				if (chunk.withSkybox)
+					RenderSkybox(pCommandBuffer);
+			});
+	}
 
-		if (useMSAA)
-		{
-			// With MSAA: render to MSAA color attachment and resolve to offscreen HDR RT
-			vk::ImageView msaaColorView = pRenderTargetManager->GetMSAAColorImageView();
-			vk::ImageView msaaDepthView = pRenderTargetManager->GetMSAADepthImageView();
-			vk::ImageView resolvedDepthView = VulkanContext::SupportsMSAADepthResolve()
-				? pRenderTargetManager->GetResolvedMSAADepthImageView()
-				: nullptr;
+	void RenderSystem::RecordMeshDraws(RenderPassType pass, const RenderingMesh* pBegin, const RenderingMesh* pEnd,
+		VulkanCommandBuffer* pCommandBuffer, DrawChunk& chunk) const
+	{
+		// Secondary command buffers inherit no state, every chunk binds from scratch. The
+		// descriptor sets are copied since chunks of the same pass are recorded concurrently.
+		auto descriptorSets = _pIntermediateVariable->renderingDescriptorSets;
 
-			bool clearColor = (pass == RenderPassType::Forward);
-			pCommandBuffer->BeginRendering(msaaColorView, msaaDepthView, offscreenColorView, extent, clearColor, true, _clearColor, resolvedDepthView);
-		}
-		else
-		{
-			// Without MSAA: render directly to offscreen HDR RT
-			vk::ImageView depthImageView = pRenderTargetManager->GetDepthImageView();
+		const auto& allDescriptorsMap = _pIntermediateVariable->materialInstanceDescriptorsMap;
+		const auto descriptorsMapItr = allDescriptorsMap.find(pass);
 
-			// Do not clear color if deferred lighting has already written to the offscreen RT
-			const bool gBufferRendered = !_pIntermediateVariable->renderingMeshes[RenderPassType::GBuffer].empty();
-			bool clearColor = (pass == RenderPassType::Forward) && !gBufferRendered;
-			pCommandBuffer->BeginRendering(offscreenColorView, depthImageView, nullptr, extent, clearColor, true, _clearColor);
-		}
+		const bool gpuDrivenCulling = _pIntermediateVariable->gpuDrivenCulling;
 
-		// Intermediate variables
+		// Intermediate tracking state
 		const Material* pCurrentMaterial = nullptr;
 		const MaterialInstance* pCurrentMaterialInstance = nullptr;
 		uint64_t currentVertexLayoutId = 0;
+		VulkanPipeline* pCurrentVkPipeline = nullptr;
+		const VulkanGeometryArena* pBoundArena = nullptr;
 
-		// Pipeline variables
-		VulkanPipeline* pCurrentVkPipeline;
-		for (const auto& renderingMesh : _pIntermediateVariable->renderingMeshes[pass])
+		for (const RenderingMesh* pRenderingMesh = pBegin; pRenderingMesh != pEnd; ++pRenderingMesh)
 		{
+			const auto& renderingMesh = *pRenderingMesh;
 			if (renderingMesh.pMaterial != pCurrentMaterial)
 			{
 				pCurrentMaterial = renderingMesh.pMaterial;
@@ -1100,8 +1271,19 @@ namespace Ailurus
 			{
 				pCurrentMaterialInstance = renderingMesh.pMaterialInstance;
 
-				_pIntermediateVariable->renderingDescriptorSets[static_cast<int>(UniformSetUsage::MaterialCustom)] =
-					_pIntermediateVariable->materialInstanceDescriptorsMap[pass][pCurrentMaterialInstance];
+				BoundUniformSet materialSet{};
+				if (descriptorsMapItr != allDescriptorsMap.end())
+				{
+					const auto setItr = descriptorsMapItr->second.find(pCurrentMaterialInstance);
+					if (setItr != descriptorsMapItr->second.end())
+						materialSet = setItr->second;
+				}
+
+				descriptorSets[static_cast<int>(UniformSetUsage::MaterialCustom)] = materialSet;
+
+				// Rebind with the new material set if a pipeline is already bound
+				if (pCurrentVkPipeline != nullptr && currentVertexLayoutId == renderingMesh.vertexLayoutId)
+					BindUniformSets(pCommandBuffer, pCurrentVkPipeline->GetPipelineLayout(), descriptorSets.data(), descriptorSets.size());
 			}
 
 			if (currentVertexLayoutId != renderingMesh.vertexLayoutId)
@@ -1113,51 +1295,294 @@ namespace Ailurus
 				pCurrentVkPipeline = VulkanContext::GetPipelineManager()->GetPipeline(pipelineEntry);
 				if (pCurrentVkPipeline == nullptr)
 				{
-					Logger::LogError("Pipeline not found for entry: {}", EnumReflection<RenderPassType>::ToString(pipelineEntry.renderPass));
+					Logger::LogError("Pipeline not found for material {} in pass {}", pCurrentMaterial->GetAssetId(),
+						EnumReflection<RenderPassType>::ToString(pass));
 					continue;
 				}
 
 				pCommandBuffer->BindPipeline(pCurrentVkPipeline);
 				pCommandBuffer->SetViewportAndScissor();
 
-				std::vector<vk::DescriptorSet> descriptorSets(_pIntermediateVariable->renderingDescriptorSets.begin(),
-				                                               _pIntermediateVariable->renderingDescriptorSets.end());
+				BindUniformSets(pCommandBuffer, pCurrentVkPipeline->GetPipelineLayout(), descriptorSets.data(), descriptorSets.size());
 
-				pCommandBuffer->BindDescriptorSet(pCurrentVkPipeline->GetPipelineLayout(), descriptorSets);
+				// Rebinding the uniform sets later leaves the table bound
+				if (pCurrentMaterial->IsPassBindless(pass) && _pBindlessTextures != nullptr)
+				{
+					pCommandBuffer->BindDescriptorSetFrom(pCurrentVkPipeline->GetPipelineLayout(),
+						BindlessTextureTable::SET_ID, { _pBindlessTextures->GetDescriptorSet() });
+				}
 			}
 
-			// Push constant model matrix
-			pCommandBuffer->PushConstantModelMatrix(pCurrentVkPipeline, renderingMesh.pEntity->GetModelMatrix());
+			if (pCurrentVkPipeline == nullptr)
+				continue;
+
+			// Following draws of the same mesh under the same material instance become instances
+			// of this one, their model matrices sit in consecutive instance buffer slots. GPU culled
+			// draws take the whole bucket, whose batches are the commands of one multi-draw.
+			const RenderingMesh* pBatchEnd = pRenderingMesh + 1;
+			while (pBatchEnd != pEnd && (gpuDrivenCulling
+				? IsSameDrawBucket(pass, *(pBatchEnd - 1), *pBatchEnd)
+				: IsSameDrawBatch(pass, renderingMesh, *pBatchEnd)))
+				++pBatchEnd;
 
-			// Bind vertex buffer
-			const auto pVertexBuffer = renderingMesh.pTargetMesh->GetVertexBuffer();
-			pCommandBuffer->BindVertexBuffer(pVertexBuffer);
+			const uint32_t instanceCount = static_cast<uint32_t>(pBatchEnd - pRenderingMesh);
+			pRenderingMesh = pBatchEnd - 1;
 
-			// Bind index buffer and draw
-			const auto pIndexBuffer = renderingMesh.pTargetMesh->GetIndexBuffer();
-			if (pIndexBuffer != nullptr)
+			// Draw from the layout's arena, gl_InstanceIndex starts at the batch's first slot
+			const Mesh* pMesh = renderingMesh.pTargetMesh;
+			const uint32_t lod = renderingMesh.lodIndex;
+			BindGeometryArena(pCommandBuffer, pMesh, pBoundArena);
+
+			if (gpuDrivenCulling)
+			{
+				// Instance count is only known on the GPU, triangles are not counted
+				_pGpuCulling->RecordDraw(pCommandBuffer, renderingMesh.drawBucketIndex, pMesh->HasIndices());
+				chunk.drawCalls++;
+			}
+			else if (pMesh->HasIndices())
 			{
-				pCommandBuffer->BindIndexBuffer(pIndexBuffer);
-				pCommandBuffer->DrawIndexed(pIndexBuffer->GetIndexCount());
-				_renderStats.drawCalls++;
-				_renderStats.triangleCount += static_cast<uint32_t>(pIndexBuffer->GetIndexCount() / 3);
+				pCommandBuffer->DrawIndexed(pMesh->GetIndexCount(lod), instanceCount, renderingMesh.instanceIndex,
+					pMesh->GetFirstIndex(lod), static_cast<int32_t>(pMesh->GetVertexOffset()));
+				chunk.drawCalls++;
+				chunk.triangleCount += pMesh->GetIndexCount(lod) / 3 * instanceCount;
 			}
 			else
 			{
-				pCommandBuffer->DrawNonIndexed(renderingMesh.pTargetMesh->GetVertexCount());
-				_renderStats.drawCalls++;
-				_renderStats.triangleCount += renderingMesh.pTargetMesh->GetVertexCount() / 3;
+				pCommandBuffer->DrawNonIndexed(pMesh->GetVertexCount(), instanceCount, renderingMesh.instanceIndex,
+					pMesh->GetVertexOffset());
+				chunk.drawCalls++;
+				chunk.triangleCount += pMesh->GetVertexCount() / 3 * instanceCount;
+			}
+		}
+	}
+
+	void RenderSystem::RecordShadowDraws(const RenderingMesh* pBegin, const RenderingMesh* pEnd,
+		VulkanCommandBuffer* pCommandBuffer) const
+	{
+		pCommandBuffer->SetViewportAndScissor(SHADOW_MAP_SIZE, SHADOW_MAP_SIZE);
+
+		const bool gpuDrivenCulling = _pIntermediateVariable->gpuDrivenCulling;
+		const Material* pCurrentMaterial = nullptr;
+		VulkanPipeline* pCurrentVkPipeline = nullptr;
+		uint64_t currentVertexLayoutId = 0;
+		const VulkanGeometryArena* pBoundArena = nullptr;
+
+		for (const RenderingMesh* pRenderingMesh = pBegin; pRenderingMesh != pEnd; ++pRenderingMesh)
+		{
+			const auto& renderingMesh = *pRenderingMesh;
+			if (pCurrentMaterial != renderingMesh.pMaterial || currentVertexLayoutId != renderingMesh.vertexLayoutId)
+			{
+				pCurrentMaterial = renderingMesh.pMaterial;
+				currentVertexLayoutId = renderingMesh.vertexLayoutId;
+
+				VulkanPipelineEntry pipelineEntry(RenderPassType::Shadow, renderingMesh.pMaterial->GetAssetId(), currentVertexLayoutId);
+				pCurrentVkPipeline = VulkanContext::GetPipelineManager()->GetPipeline(pipelineEntry);
+				if (pCurrentVkPipeline == nullptr)
+				{
+					Logger::LogError("RenderShadowPass: Shadow pipeline not found");
+					continue;
+				}
+
+				pCommandBuffer->BindPipeline(pCurrentVkPipeline);
+
+				// Shadow pass only uses the global descriptor set (no material-specific set)
+				const BoundUniformSet& globalSet =
+					_pIntermediateVariable->renderingDescriptorSets[static_cast<int>(UniformSetUsage::General)];
+				BindUniformSets(pCommandBuffer, pCurrentVkPipeline->GetPipelineLayout(), &globalSet, 1);
+
+				// GPU culled casters take the front of the instance buffer, one range of the whole caster list per cascade
+				if (gpuDrivenCulling)
+				{
+					const uint32_t cascadeStride = static_cast<uint32_t>(_pIntermediateVariable->shadowCasterMeshes.size());
+					pCommandBuffer->PushConstantShadowData(pCurrentVkPipeline, 0, 0, cascadeStride);
+				}
+			}
+
+			if (pCurrentVkPipeline == nullptr)
+				continue;
+
+			// Casters of the same mesh falling into the same cascades are drawn together, GPU culled
+			// casters of a whole bucket are drawn by one multi-draw covering all cascades
+			const uint32_t cascadeMask = renderingMesh.shadowCascadeMask;
+			const RenderingMesh* pBatchEnd = pRenderingMesh + 1;
+			while (pBatchEnd != pEnd && (gpuDrivenCulling
+				? IsSameDrawBucket(RenderPassType::Shadow, *(pBatchEnd - 1), *pBatchEnd)
+				: IsSameDrawBatch(RenderPassType::Shadow, renderingMesh, *pBatchEnd)))
+				++pBatchEnd;
+
+			const uint32_t casterCount = static_cast<uint32_t>(pBatchEnd - pRenderingMesh);
+			pRenderingMesh = pBatchEnd - 1;
+
+			const Mesh* pMesh = renderingMesh.pTargetMesh;
+			BindGeometryArena(pCommandBuffer, pMesh, pBoundArena);
+
+			if (gpuDrivenCulling)
+			{
+				// One command per batch and cascade, each one's instances start at its own compacted range
+				_pGpuCulling->RecordDraw(pCommandBuffer, renderingMesh.drawBucketIndex, pMesh->HasIndices());
+				continue;
 			}
+
+			// Every caster fans out to one instance per cascade, the vertex shader splits
+			// gl_InstanceIndex back into the caster's instance slot and its cascade layer
+			const uint32_t instanceCount = casterCount * static_cast<uint32_t>(std::popcount(cascadeMask));
+			pCommandBuffer->PushConstantShadowData(pCurrentVkPipeline, renderingMesh.instanceIndex, cascadeMask);
+
+			// Draw
+			if (pMesh->HasIndices())
+			{
+				const uint32_t lod = renderingMesh.lodIndex;
+				pCommandBuffer->DrawIndexed(pMesh->GetIndexCount(lod), instanceCount, 0, pMesh->GetFirstIndex(lod), static_cast<int32_t>(pMesh->GetVertexOffset()));
+			}
+			else
+				pCommandBuffer->DrawNonIndexed(pMesh->GetVertexCount(), instanceCount, 0, pMesh->GetVertexOffset());
 		}
+	}
+
+	auto RenderSystem::GetPassRenderingInheritance(RenderPassType pass) const -> VulkanRenderingInheritance
+	{
+		VulkanRenderingInheritance inheritance;
+		inheritance.depthFormat = RenderTargetManager::GetDepthFormat();
+
+		switch (pass)
+		{
+			case RenderPassType::Shadow:
+				break;
+			case RenderPassType::GBuffer:
+				inheritance.colorFormats = {
+					RenderTargetManager::GetGBufferNormalFormat(),
+					RenderTargetManager::GetGBufferAlbedoFormat(),
+					RenderTargetManager::GetGBufferMetallicFormat()
+				};
+				break;
+			case RenderPassType::Forward:
+				// Forward renders into the MSAA targets when MSAA is enabled
+				inheritance.colorFormats = { RenderTargetManager::GetOffscreenColorFormat() };
+				inheritance.samples = VulkanContext::GetMSAASamples();
+				break;
+			case RenderPassType::Transparent:
+			default:
+				inheritance.colorFormats = { RenderTargetManager::GetOffscreenColorFormat() };
+				break;
+		}
+
+		return inheritance;
+	}
 
-		// Render skybox after all geometry (depth test ensures it only draws where depth = 1.0)
-		if (pass == RenderPassType::Forward)
-			RenderSkybox(pCommandBuffer);
+	auto RenderSystem::GetDrawChunkCommandBuffers(RenderPassType pass) const -> std::vector<VulkanCommandBuffer*>
+	{
+		std::vector<VulkanCommandBuffer*> result;
+		for (const auto& chunk : _pIntermediateVariable->drawChunks)
+		{
+			if (chunk.pass == pass && chunk.pCommandBuffer != nullptr)
+				result.push_back(chunk.pCommandBuffer);
+		}
+
+		return result;
+	}
+
+	void RenderSystem::RenderShadowPass(VulkanCommandBuffer* pCommandBuffer, VulkanDescriptorAllocator* pDescriptorAllocator)
+	{
+		auto* pRenderTargetManager = VulkanContext::GetRenderTargetManager();
+		const uint32_t cascadeCount = pRenderTargetManager->GetShadowMapCascadeCount();
+
+		vk::Image shadowImage = pRenderTargetManager->GetShadowMapImage();
+		vk::ImageView shadowImageView = pRenderTargetManager->GetShadowMapImageView();
+
+		if (!shadowImage || !shadowImageView)
+			return;
+
+		// Transition all cascade layers to depth attachment optimal
+		pCommandBuffer->ImageMemoryBarrier(
+			shadowImage,
+			vk::ImageLayout::eUndefined,
+			vk::ImageLayout::eDepthStencilAttachmentOptimal,
+			vk::AccessFlags{},
+			vk::AccessFlagBits::eDepthStencilAttachmentWrite,
+			vk::PipelineStageFlagBits::eTopOfPipe,
+			vk::PipelineStageFlagBits::eEarlyFragmentTests,
+			vk::ImageAspectFlagBits::eDepth,
+			0, 1, 0, cascadeCount);
+
+		// One layered depth-only pass clears and stores every cascade, draws come from the recorded chunks
+		const auto secondaryCommandBuffers = GetDrawChunkCommandBuffers(RenderPassType::Shadow);
+		pCommandBuffer->BeginDepthOnlyRendering(shadowImageView, vk::Extent2D{SHADOW_MAP_SIZE, SHADOW_MAP_SIZE},
+			cascadeCount, !secondaryCommandBuffers.empty());
+
+		for (const auto pSecondaryCommandBuffer : secondaryCommandBuffers)
+			pCommandBuffer->ExecuteSecondaryCommandBuffer(pSecondaryCommandBuffer);
 
 		pCommandBuffer->EndRendering();
+
+		// Transition shadow map to shader read only for sampling in the forward pass
+		pCommandBuffer->ImageMemoryBarrier(
+			shadowImage,
+			vk::ImageLayout::eDepthStencilAttachmentOptimal,
+			vk::ImageLayout::eShaderReadOnlyOptimal,
+			vk::AccessFlagBits::eDepthStencilAttachmentWrite,
+			vk::AccessFlagBits::eShaderRead,
+			vk::PipelineStageFlagBits::eLateFragmentTests,
+			vk::PipelineStageFlagBits::eFragmentShader,
+			vk::ImageAspectFlagBits::eDepth,
+			0, 1, 0, cascadeCount);
 	}
 
-	void RenderSystem::RenderSkybox(VulkanCommandBuffer* pCommandBuffer)
+	void RenderSystem::RenderPass(RenderPassType pass, VulkanCommandBuffer* pCommandBuffer)
+	{
+		if (_pIntermediateVariable->renderingMeshes.empty())
+			return;
+
+		// Get swap chain extent
+		auto pSwapChain = VulkanContext::GetSwapChain();
+		if (pSwapChain == nullptr)
+		{
+			Logger::LogError("SwapChain not found");
+			return;
+		}
+
+		vk::Extent2D extent = pSwapChain->GetConfig().extent;
+
+		// Check if MSAA is enabled
+		bool useMSAA = VulkanContext::GetMSAASamples() != vk::SampleCountFlagBits::e1;
+		auto* pRenderTargetManager = VulkanContext::GetRenderTargetManager();
+
+		// Offscreen HDR RT is the render target for the forward pass
+		vk::ImageView offscreenColorView = pRenderTargetManager->GetOffscreenColorImageView();
+
+		// Draws (and the skybox) come from the recorded chunks
+		const auto secondaryCommandBuffers = GetDrawChunkCommandBuffers(pass);
+		const bool secondaryContents = !secondaryCommandBuffers.empty();
+
+		if (useMSAA)
+		{
+			// With MSAA: render to MSAA color attachment and resolve to offscreen HDR RT
+			vk::ImageView msaaColorView = pRenderTargetManager->GetMSAAColorImageView();
+			vk::ImageView msaaDepthView = pRenderTargetManager->GetMSAADepthImageView();
+			vk::ImageView resolvedDepthView = VulkanContext::SupportsMSAADepthResolve()
+				? pRenderTargetManager->GetResolvedMSAADepthImageView()
+				: nullptr;
+
+			bool clearColor = (pass == RenderPassType::Forward);
+			pCommandBuffer->BeginRendering(msaaColorView, msaaDepthView, offscreenColorView, extent, clearColor, true, _clearColor, resolvedDepthView, true, secondaryContents);
+		}
+		else
+		{
+			// Without MSAA: render directly to offscreen HDR RT
+			vk::ImageView depthImageView = pRenderTargetManager->GetDepthImageView();
+
+			// Do not clear color if deferred lighting has already written to the offscreen RT
+			const bool gBufferRendered = !_pIntermediateVariable->renderingMeshes[RenderPassType::GBuffer].empty();
+			bool clearColor = (pass == RenderPassType::Forward) && !gBufferRendered;
+			pCommandBuffer->BeginRendering(offscreenColorView, depthImageView, nullptr, extent, clearColor, true, _clearColor, nullptr, true, secondaryContents);
+		}
+
+		for (const auto pSecondaryCommandBuffer : secondaryCommandBuffers)
+			pCommandBuffer->ExecuteSecondaryCommandBuffer(pSecondaryCommandBuffer);
+
+		pCommandBuffer->EndRendering();
+	}
+
+	void RenderSystem::RenderSkybox(VulkanCommandBuffer* pCommandBuffer) const
 	{
 		if (!_skyboxEnabled || !_pSkybox || !_pMainCamera)
 			return;
@@ -1192,71 +1617,11 @@ namespace Ailurus
 		};
 		vk::ImageView depthView = pRTMgr->GetDepthImageView();
 
-		pCommandBuffer->BeginGBufferRendering(gBufferViews, depthView, extent, /*clearColor=*/true);
+		const auto secondaryCommandBuffers = GetDrawChunkCommandBuffers(RenderPassType::GBuffer);
+		pCommandBuffer->BeginGBufferRendering(gBufferViews, depthView, extent, /*clearColor=*/true, !secondaryCommandBuffers.empty());
 
-		// Intermediate tracking state
-		const Material* pCurrentMaterial = nullptr;
-		const MaterialInstance* pCurrentMaterialInstance = nullptr;
-		uint64_t currentVertexLayoutId = 0;
-		VulkanPipeline* pCurrentVkPipeline = nullptr;
-
-		for (const auto& renderingMesh : meshes)
-		{
-			if (renderingMesh.pMaterial != pCurrentMaterial)
-			{
-				pCurrentMaterial = renderingMesh.pMaterial;
-				pCurrentMaterialInstance = nullptr;
-				currentVertexLayoutId = 0;
-			}
-
-			if (renderingMesh.pMaterialInstance != pCurrentMaterialInstance)
-			{
-				pCurrentMaterialInstance = renderingMesh.pMaterialInstance;
-				_pIntermediateVariable->renderingDescriptorSets[static_cast<int>(UniformSetUsage::MaterialCustom)] =
-					_pIntermediateVariable->materialInstanceDescriptorsMap[RenderPassType::GBuffer][pCurrentMaterialInstance];
-			}
-
-			if (currentVertexLayoutId != renderingMesh.vertexLayoutId)
-			{
-				currentVertexLayoutId = renderingMesh.vertexLayoutId;
-
-				VulkanPipelineEntry pipelineEntry(RenderPassType::GBuffer, pCurrentMaterial->GetAssetId(), currentVertexLayoutId);
-				pCurrentVkPipeline = VulkanContext::GetPipelineManager()->GetPipeline(pipelineEntry);
-				if (pCurrentVkPipeline == nullptr)
-				{
-					Logger::LogError("G-Buffer pipeline not found for material {}", pCurrentMaterial->GetAssetId());
-					continue;
-				}
-
-				pCommandBuffer->BindPipeline(pCurrentVkPipeline);
-				pCommandBuffer->SetViewportAndScissor();
-
-				std::vector<vk::DescriptorSet> descriptorSets(
-					_pIntermediateVariable->renderingDescriptorSets.begin(),
-					_pIntermediateVariable->renderingDescriptorSets.end());
-				pCommandBuffer->BindDescriptorSet(pCurrentVkPipeline->GetPipelineLayout(), descriptorSets);
-			}
-
-			pCommandBuffer->PushConstantModelMatrix(pCurrentVkPipeline, renderingMesh.pEntity->GetModelMatrix());
-
-			const auto pVertexBuffer = renderingMesh.pTargetMesh->GetVertexBuffer();
-			pCommandBuffer->BindVertexBuffer(pVertexBuffer);
-
-			const auto pIndexBuffer = renderingMesh.pTargetMesh->GetIndexBuffer();
-			if (pIndexBuffer != nullptr)
-			{
-				pCommandBuffer->BindIndexBuffer(pIndexBuffer);
-				pCommandBuffer->DrawIndexed(pIndexBuffer->GetIndexCount());
-				_renderStats.drawCalls++;
-				_renderStats.triangleCount += static_cast<uint32_t>(pIndexBuffer->GetIndexCount() / 3);
-			}
-			else
-			{
-				pCommandBuffer->DrawNonIndexed(renderingMesh.pTargetMesh->GetVertexCount());
-				_renderStats.drawCalls++;
-				_renderStats.triangleCount += renderingMesh.pTargetMesh->GetVertexCount() / 3;
-			}
-		}
+		for (const auto pSecondaryCommandBuffer : secondaryCommandBuffers)
+			pCommandBuffer->ExecuteSecondaryCommandBuffer(pSecondaryCommandBuffer);
 
 		pCommandBuffer->EndRendering();
 	}
@@ -1279,9 +1644,10 @@ namespace Ailurus
 		_pDeferredLightingEffect->SetDepthImageView(pRTMgr->GetDepthImageView());
 
 		// Pass the global descriptor set (set 0)
-		const vk::DescriptorSet globalSet =
+		const BoundUniformSet& globalSet =
 			_pIntermediateVariable->renderingDescriptorSets[static_cast<int>(UniformSetUsage::General)];
-		_pDeferredLightingEffect->SetGlobalDescriptorSet(globalSet);
+		_pDeferredLightingEffect->SetGlobalDescriptorSet(globalSet.descriptorSet,
+			std::vector<uint32_t>(globalSet.dynamicOffsetCount, globalSet.dynamicOffset));
 
 		// Compute inverse VP for world position reconstruction
 		const Matrix4x4f vpMat = _pIntermediateVariable->viewProjectionMatrix;
@@ -1310,73 +1676,17 @@ namespace Ailurus
 		vk::ImageView offscreenColorView = pRTMgr->GetOffscreenColorImageView();
 		vk::ImageView depthView = pRTMgr->GetDepthImageView();
 
+		// Chunks are recorded in back-to-front order and executed in the same order
+		const auto secondaryCommandBuffers = GetDrawChunkCommandBuffers(RenderPassType::Transparent);
+
 		// Load existing color content (blend on top), depth read-only (no clear)
 		// clearDepth=false: preserve depth from GBuffer pass for correct occlusion
 		pCommandBuffer->BeginRendering(offscreenColorView, depthView, nullptr, extent,
-			/*clearColor=*/false, /*useDepth=*/true, _clearColor, /*depthResolveImageView=*/nullptr, /*clearDepth=*/false);
-
-		const Material* pCurrentMaterial = nullptr;
-		const MaterialInstance* pCurrentMaterialInstance = nullptr;
-		uint64_t currentVertexLayoutId = 0;
-		VulkanPipeline* pCurrentVkPipeline = nullptr;
-
-		for (const auto& renderingMesh : meshes)
-		{
-			if (renderingMesh.pMaterial != pCurrentMaterial)
-			{
-				pCurrentMaterial = renderingMesh.pMaterial;
-				pCurrentMaterialInstance = nullptr;
-				currentVertexLayoutId = 0;
-			}
+			/*clearColor=*/false, /*useDepth=*/true, _clearColor, /*depthResolveImageView=*/nullptr, /*clearDepth=*/false,
+			/*secondaryContents=*/!secondaryCommandBuffers.empty());
 
-			if (renderingMesh.pMaterialInstance != pCurrentMaterialInstance)
-			{
-				pCurrentMaterialInstance = renderingMesh.pMaterialInstance;
-				_pIntermediateVariable->renderingDescriptorSets[static_cast<int>(UniformSetUsage::MaterialCustom)] =
-					_pIntermediateVariable->materialInstanceDescriptorsMap[RenderPassType::Transparent][pCurrentMaterialInstance];
-			}
-
-			if (currentVertexLayoutId != renderingMesh.vertexLayoutId)
-			{
-				currentVertexLayoutId = renderingMesh.vertexLayoutId;
-
-				VulkanPipelineEntry pipelineEntry(RenderPassType::Transparent, pCurrentMaterial->GetAssetId(), currentVertexLayoutId);
-				pCurrentVkPipeline = VulkanContext::GetPipelineManager()->GetPipeline(pipelineEntry);
-				if (pCurrentVkPipeline == nullptr)
-				{
-					Logger::LogError("Transparent pipeline not found for material {}", pCurrentMaterial->GetAssetId());
-					continue;
-				}
-
-				pCommandBuffer->BindPipeline(pCurrentVkPipeline);
-				pCommandBuffer->SetViewportAndScissor();
-
-				std::vector<vk::DescriptorSet> descriptorSets(
-					_pIntermediateVariable->renderingDescriptorSets.begin(),
-					_pIntermediateVariable->renderingDescriptorSets.end());
-				pCommandBuffer->BindDescriptorSet(pCurrentVkPipeline->GetPipelineLayout(), descriptorSets);
-			}
-
-			pCommandBuffer->PushConstantModelMatrix(pCurrentVkPipeline, renderingMesh.pEntity->GetModelMatrix());
-
-			const auto pVertexBuffer = renderingMesh.pTargetMesh->GetVertexBuffer();
-			pCommandBuffer->BindVertexBuffer(pVertexBuffer);
-
-			const auto pIndexBuffer = renderingMesh.pTargetMesh->GetIndexBuffer();
-			if (pIndexBuffer != nullptr)
-			{
-				pCommandBuffer->BindIndexBuffer(pIndexBuffer);
-				pCommandBuffer->DrawIndexed(pIndexBuffer->GetIndexCount());
-				_renderStats.drawCalls++;
-				_renderStats.triangleCount += static_cast<uint32_t>(pIndexBuffer->GetIndexCount() / 3);
-			}
-			else
-			{
-				pCommandBuffer->DrawNonIndexed(renderingMesh.pTargetMesh->GetVertexCount());
-				_renderStats.drawCalls++;
-				_renderStats.triangleCount += renderingMesh.pTargetMesh->GetVertexCount() / 3;
-			}
-		}
+		for (const auto pSecondaryCommandBuffer : secondaryCommandBuffers)
+			pCommandBuffer->ExecuteSecondaryCommandBuffer(pSecondaryCommandBuffer);
 
 		pCommandBuffer->EndRendering();
 	}
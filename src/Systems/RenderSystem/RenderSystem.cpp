@@ -7,16 +7,23 @@
 #include <Ailurus/Systems/RenderSystem/PostProcess/Effects/BloomMipChainEffect.h>
 #include <Ailurus/Systems/RenderSystem/PostProcess/Effects/SSAOEffect.h>
 #include <Ailurus/Systems/RenderSystem/PostProcess/Effects/DeferredLightingEffect.h>
+#include <Ailurus/Systems/RenderSystem/Descriptor/BindlessTextureTable.h>
 #include <VulkanContext/VulkanContext.h>
 #include <VulkanContext/SwapChain/VulkanSwapChain.h>
-#include <VulkanContext/DataBuffer/VulkanUniformBuffer.h>
+#include <VulkanContext/RenderTarget/RenderTargetManager.h>
+#include <VulkanContext/DataBuffer/VulkanStorageBuffer.h>
 #include <VulkanContext/Resource/VulkanResourceManager.h>
 #include <VulkanContext/Resource/Image/VulkanSampler.h>
 #include <VulkanContext/Descriptor/VulkanDescriptorSetLayout.h>
+#include <VulkanContext/Descriptor/VulkanPersistentDescriptorSet.h>
 #include "Ailurus/Utility/Logger.h"
 #include "Detail/RenderIntermediateVariable.h"
 #include "Skybox/Skybox.h"
 #include "IBL/IBLManager.h"
+#include "GpuCulling/GpuCulling.h"
+#include "OcclusionCulling/OcclusionCulling.h"
+#include "ClusteredLighting/ClusteredLighting.h"
+#include "RenderWorld/RenderWorld.h"
 
 #include <cmath>
 
@@ -26,18 +33,10 @@ namespace Ailurus
 	const char* RenderSystem::GLOBAL_UNIFORM_ACCESS_VIEW_PROJ_MAT = "viewProjectionMatrix";
 	const char* RenderSystem::GLOBAL_UNIFORM_ACCESS_CAMERA_POS = "cameraPosition";
 	const char* RenderSystem::GLOBAL_UNIFORM_ACCESS_NUM_DIR_LIGHTS = "numDirectionalLights";
-	const char* RenderSystem::GLOBAL_UNIFORM_ACCESS_NUM_POINT_LIGHTS = "numPointLights";
-	const char* RenderSystem::GLOBAL_UNIFORM_ACCESS_NUM_SPOT_LIGHTS = "numSpotLights";
 	const char* RenderSystem::GLOBAL_UNIFORM_ACCESS_DIR_LIGHT_DIRECTIONS = "dirLightDirections";
 	const char* RenderSystem::GLOBAL_UNIFORM_ACCESS_DIR_LIGHT_COLORS = "dirLightColors";
-	const char* RenderSystem::GLOBAL_UNIFORM_ACCESS_POINT_LIGHT_POSITIONS = "pointLightPositions";
-	const char* RenderSystem::GLOBAL_UNIFORM_ACCESS_POINT_LIGHT_COLORS = "pointLightColors";
-	const char* RenderSystem::GLOBAL_UNIFORM_ACCESS_POINT_LIGHT_ATTENUATIONS = "pointLightAttenuations";
-	const char* RenderSystem::GLOBAL_UNIFORM_ACCESS_SPOT_LIGHT_POSITIONS = "spotLightPositions";
-	const char* RenderSystem::GLOBAL_UNIFORM_ACCESS_SPOT_LIGHT_DIRECTIONS = "spotLightDirections";
-	const char* RenderSystem::GLOBAL_UNIFORM_ACCESS_SPOT_LIGHT_COLORS = "spotLightColors";
-	const char* RenderSystem::GLOBAL_UNIFORM_ACCESS_SPOT_LIGHT_ATTENUATIONS = "spotLightAttenuations";
-	const char* RenderSystem::GLOBAL_UNIFORM_ACCESS_SPOT_LIGHT_CUTOFFS = "spotLightCutoffs";
+	const char* RenderSystem::GLOBAL_UNIFORM_ACCESS_CAMERA_FORWARD = "cameraForward";
+	const char* RenderSystem::GLOBAL_UNIFORM_ACCESS_CLUSTER_PARAMS = "clusterParams";
 	const char* RenderSystem::GLOBAL_UNIFORM_ACCESS_CASCADE_VIEW_PROJ_MATRICES = "cascadeViewProjMatrices";
 	const char* RenderSystem::GLOBAL_UNIFORM_ACCESS_CASCADE_SPLIT_DISTANCES = "cascadeSplitDistances";
 	const char* RenderSystem::GLOBAL_UNIFORM_ACCESS_AMBIENT_COLOR = "ambientColor";
@@ -48,9 +47,15 @@ namespace Ailurus
 	{
 		_pShaderLibrary.reset(new ShaderLibrary());
 
+		_pRenderWorld = std::make_unique<RenderWorld>();
+		_pOcclusionCulling = std::make_unique<OcclusionCulling>(Application::Get<JobSystem>());
+
 		CreateIntermediateVariable();
 		BuildGlobalUniform();
 
+		if (VulkanContext::SupportsBindlessTextures())
+			_pBindlessTextures = std::make_unique<BindlessTextureTable>(VulkanContext::GetMaxBindlessTextures());
+
 		// Initialize post-process chain
 		const auto& swapChainConfig = VulkanContext::GetSwapChain()->GetConfig();
 		_postProcessChain = std::make_unique<PostProcessChain>();
@@ -82,8 +87,8 @@ namespace Ailurus
 		{
 			_pSkybox = std::make_unique<Skybox>();
 			_pSkybox->Init(_pShaderLibrary.get(),
-				vk::Format::eR16G16B16A16Sfloat,
-				vk::Format::eD32Sfloat,
+				RenderTargetManager::GetOffscreenColorFormat(),
+				RenderTargetManager::GetDepthFormat(),
 				skyboxHDRTexturePath);
 
 			// Initialize IBL
@@ -129,6 +134,12 @@ namespace Ailurus
 			_pIBLManager->Shutdown();
 			_pIBLManager.reset();
 		}
+
+		if (_pGpuCulling)
+		{
+			_pGpuCulling->Shutdown();
+			_pGpuCulling.reset();
+		}
 	}
 
 	void RenderSystem::RequestRebuildSwapChain()
@@ -200,6 +211,64 @@ namespace Ailurus
 		return _skyboxEnabled;
 	}
 
+	void RenderSystem::SetGPUDrivenCullingEnabled(bool enabled)
+	{
+		if (_gpuDrivenCullingEnabled == enabled)
+			return;
+
+		if (enabled && !VulkanContext::SupportsDrawIndirectCount())
+		{
+			Logger::LogWarn("GPU driven culling needs draw indirect count, keep culling on the cpu");
+			return;
+		}
+
+		if (enabled && _pGpuCulling == nullptr)
+		{
+			_pGpuCulling = std::make_unique<GpuCulling>();
+			_pGpuCulling->Init(_pShaderLibrary.get());
+		}
+
+		_gpuDrivenCullingEnabled = enabled;
+		NotifyRenderSettingsChanged();
+	}
+
+	bool RenderSystem::IsGPUDrivenCullingEnabled() const
+	{
+		return _gpuDrivenCullingEnabled;
+	}
+
+	void RenderSystem::SetOcclusionCullingEnabled(bool enabled)
+	{
+		if (_occlusionCullingEnabled == enabled)
+			return;
+
+		_occlusionCullingEnabled = enabled;
+		NotifyRenderSettingsChanged();
+	}
+
+	bool RenderSystem::IsOcclusionCullingEnabled() const
+	{
+		return _occlusionCullingEnabled;
+	}
+
+	void RenderSystem::SetLodBias(float bias)
+	{
+		if (_lodBias == bias)
+			return;
+
+		_lodBias = bias;
+		NotifyRenderSettingsChanged();
+	}
+
+	void RenderSystem::SetShadowLodBias(float bias)
+	{
+		if (_shadowLodBias == bias)
+			return;
+
+		_shadowLodBias = bias;
+		NotifyRenderSettingsChanged();
+	}
+
 	void RenderSystem::SetClearColor(float r, float g, float b, float a)
 	{
 		const std::array<float, 4> newColor = {r, g, b, a};
@@ -362,6 +431,13 @@ namespace Ailurus
 
 		_needRebuildSwapChain = false;
 
+		// Render targets were recreated and their views may come back with the same handles
+		if (_pGlobalUniformMemory != nullptr)
+		{
+			if (auto* pGlobalSet = _pGlobalUniformMemory->GetPersistentDescriptorSet())
+				pGlobalSet->Invalidate();
+		}
+
 		// Rebuild post-process chain with new swapchain dimensions
 		if (_postProcessChain)
 		{
@@ -374,7 +450,7 @@ namespace Ailurus
 
 		// Rebuild skybox pipeline (MSAA samples may have changed)
 		if (_pSkybox)
-			_pSkybox->RebuildPipeline(vk::Format::eR16G16B16A16Sfloat, vk::Format::eD32Sfloat);
+			_pSkybox->RebuildPipeline(RenderTargetManager::GetOffscreenColorFormat(), RenderTargetManager::GetDepthFormat());
 
 		// Rebuild deferred lighting pipeline (output format may have changed)
 		if (_pDeferredLightingEffect)
@@ -413,16 +489,10 @@ namespace Ailurus
 			"cameraPosition",
 			std::make_unique<UniformVariableNumeric>(UniformValueType::Vector3));
 
-		// Add light counts
+		// Add directional light count
 		pGlobalUniformStructure->AddMember(
 			"numDirectionalLights",
 			std::make_unique<UniformVariableNumeric>(UniformValueType::Int));
-		pGlobalUniformStructure->AddMember(
-			"numPointLights",
-			std::make_unique<UniformVariableNumeric>(UniformValueType::Int));
-		pGlobalUniformStructure->AddMember(
-			"numSpotLights",
-			std::make_unique<UniformVariableNumeric>(UniformValueType::Int));
 
 		// Add directional light arrays
 		pGlobalUniformStructure->AddMember(
@@ -436,49 +506,13 @@ namespace Ailurus
 				std::make_unique<UniformVariableNumeric>(UniformValueType::Vector4),
 				MAX_DIRECTIONAL_LIGHTS));
 
-		// Add point light arrays
-		pGlobalUniformStructure->AddMember(
-			"pointLightPositions",
-			std::make_unique<UniformVariableArray>(
-				std::make_unique<UniformVariableNumeric>(UniformValueType::Vector4),
-				MAX_POINT_LIGHTS));
-		pGlobalUniformStructure->AddMember(
-			"pointLightColors",
-			std::make_unique<UniformVariableArray>(
-				std::make_unique<UniformVariableNumeric>(UniformValueType::Vector4),
-				MAX_POINT_LIGHTS));
-		pGlobalUniformStructure->AddMember(
-			"pointLightAttenuations",
-			std::make_unique<UniformVariableArray>(
-				std::make_unique<UniformVariableNumeric>(UniformValueType::Vector4),
-				MAX_POINT_LIGHTS));
-
-		// Add spot light arrays
-		pGlobalUniformStructure->AddMember(
-			"spotLightPositions",
-			std::make_unique<UniformVariableArray>(
-				std::make_unique<UniformVariableNumeric>(UniformValueType::Vector4),
-				MAX_SPOT_LIGHTS));
+		// Add cluster lookup, point and spot lights are read from the clustered light buffers
 		pGlobalUniformStructure->AddMember(
-			"spotLightDirections",
-			std::make_unique<UniformVariableArray>(
-				std::make_unique<UniformVariableNumeric>(UniformValueType::Vector4),
-				MAX_SPOT_LIGHTS));
-		pGlobalUniformStructure->AddMember(
-			"spotLightColors",
-			std::make_unique<UniformVariableArray>(
-				std::make_unique<UniformVariableNumeric>(UniformValueType::Vector4),
-				MAX_SPOT_LIGHTS));
-		pGlobalUniformStructure->AddMember(
-			"spotLightAttenuations",
-			std::make_unique<UniformVariableArray>(
-				std::make_unique<UniformVariableNumeric>(UniformValueType::Vector4),
-				MAX_SPOT_LIGHTS));
+			"cameraForward",
+			std::make_unique<UniformVariableNumeric>(UniformValueType::Vector4));
 		pGlobalUniformStructure->AddMember(
-			"spotLightCutoffs",
-			std::make_unique<UniformVariableArray>(
-				std::make_unique<UniformVariableNumeric>(UniformValueType::Vector4),
-				MAX_SPOT_LIGHTS));
+			"clusterParams",
+			std::make_unique<UniformVariableNumeric>(UniformValueType::Vector4));
 
 		// Add CSM cascade matrices and split distances
 		pGlobalUniformStructure->AddMember(
@@ -511,13 +545,12 @@ namespace Ailurus
 		_pGlobalUniformSet->AddBindingPoint(std::move(pBindingPoint));
 		_pGlobalUniformSet->InitUniformBufferInfo();
 
-		// Add shadow map sampler bindings (set=0, bindings 1-4) to the global descriptor layout
+		// Add the shadow map array sampler binding (set=0, binding 1) to the global descriptor layout
 		std::vector<TextureBindingInfo> textureBindings;
-		// Shadow maps (bindings 1-4)
-		for (uint32_t i = 0; i < RenderIntermediateVariable::CSM_CASCADE_COUNT; i++)
+		// Shadow maps, one array layer per cascade (binding 1)
 		{
 			TextureBindingInfo bindingInfo;
-			bindingInfo.bindingId = i + 1;
+			bindingInfo.bindingId = 1;
 			bindingInfo.shaderStages = vk::ShaderStageFlagBits::eFragment;
 			textureBindings.push_back(bindingInfo);
 		}
@@ -529,9 +562,42 @@ namespace Ailurus
 			bindingInfo.shaderStages = vk::ShaderStageFlagBits::eFragment;
 			textureBindings.push_back(bindingInfo);
 		}
-		_pGlobalUniformSet->InitDescriptorSetLayout(textureBindings);
-
-		_pGlobalUniformMemory = std::make_unique<UniformSetMemory>(_pGlobalUniformSet.get());
+		// Instance model matrices (binding 2)
+		std::vector<StorageBufferBindingInfo> storageBufferBindings;
+		{
+			StorageBufferBindingInfo bindingInfo;
+			bindingInfo.bindingId = INSTANCE_BUFFER_BINDING;
+			bindingInfo.shaderStages = vk::ShaderStageFlagBits::eVertex;
+			storageBufferBindings.push_back(bindingInfo);
+		}
+		// Clustered point and spot lights and the per cluster light lists (bindings 3-4)
+		for (const uint32_t binding : { ClusteredLighting::LIGHT_BUFFER_BINDING, ClusteredLighting::CLUSTER_BUFFER_BINDING })
+		{
+			StorageBufferBindingInfo bindingInfo;
+			bindingInfo.bindingId = binding;
+			bindingInfo.shaderStages = vk::ShaderStageFlagBits::eFragment;
+			storageBufferBindings.push_back(bindingInfo);
+		}
+		_pGlobalUniformSet->InitDescriptorSetLayout(textureBindings, storageBufferBindings);
+
+		// Rewritten every frame and never read back, no need to record the values
+		_pGlobalUniformMemory = std::make_unique<UniformSetMemory>(_pGlobalUniformSet.get(), UniformSetMemoryUsage::PerFrame);
+
+		auto& handles = _globalUniformHandles;
+		handles.viewProjectionMatrix = _pGlobalUniformSet->ResolveHandle(0, GetGlobalUniformAccessNameViewProjMat());
+		handles.cameraPosition = _pGlobalUniformSet->ResolveHandle(0, GetGlobalUniformAccessNameCameraPos());
+		handles.numDirectionalLights = _pGlobalUniformSet->ResolveHandle(0, GetGlobalUniformAccessNameNumDirLights());
+		handles.dirLightDirections = _pGlobalUniformSet->ResolveHandle(0, GetGlobalUniformAccessNameDirLightDirections());
+		handles.dirLightColors = _pGlobalUniformSet->ResolveHandle(0, GetGlobalUniformAccessNameDirLightColors());
+		handles.cameraForward = _pGlobalUniformSet->ResolveHandle(0, GetGlobalUniformAccessNameCameraForward());
+		handles.clusterParams = _pGlobalUniformSet->ResolveHandle(0, GetGlobalUniformAccessNameClusterParams());
+		handles.cascadeViewProjMatrices = _pGlobalUniformSet->ResolveHandle(0, GetGlobalUniformAccessNameCascadeViewProjMatrices());
+		handles.cascadeSplitDistances = _pGlobalUniformSet->ResolveHandle(0, GetGlobalUniformAccessNameCascadeSplitDistances());
+		handles.ambientColor = _pGlobalUniformSet->ResolveHandle(0, GetGlobalUniformAccessNameAmbientColor());
+		handles.shadowBiasParams = _pGlobalUniformSet->ResolveHandle(0, GetGlobalUniformAccessNameShadowBiasParams());
+
+		_pInstanceBuffer = std::make_unique<VulkanStorageBuffer>(INSTANCE_BUFFER_INITIAL_CAPACITY);
+		_pClusteredLighting = std::make_unique<ClusteredLighting>();
 
 		// Create shadow map sampler
 		_shadowSampler = VulkanContext::GetResourceManager()->CreateSampler();
@@ -542,6 +608,11 @@ namespace Ailurus
 		return _pGlobalUniformSet.get();
 	}
 
+	auto RenderSystem::GetBindlessTextureTable() const -> BindlessTextureTable*
+	{
+		return _pBindlessTextures.get();
+	}
+
 	auto RenderSystem::GetGlobalUniformAccessNameViewProjMat() -> const std::string&
 	{
 		static std::string value = std::string{ GLOBAL_UNIFORM_SET_NAME } + "." + GLOBAL_UNIFORM_ACCESS_VIEW_PROJ_MAT;
@@ -560,18 +631,6 @@ namespace Ailurus
 		return value;
 	}
 
-	auto RenderSystem::GetGlobalUniformAccessNameNumPointLights() -> const std::string&
-	{
-		static std::string value = std::string{ GLOBAL_UNIFORM_SET_NAME } + "." + GLOBAL_UNIFORM_ACCESS_NUM_POINT_LIGHTS;
-		return value;
-	}
-
-	auto RenderSystem::GetGlobalUniformAccessNameNumSpotLights() -> const std::string&
-	{
-		static std::string value = std::string{ GLOBAL_UNIFORM_SET_NAME } + "." + GLOBAL_UNIFORM_ACCESS_NUM_SPOT_LIGHTS;
-		return value;
-	}
-
 	auto RenderSystem::GetGlobalUniformAccessNameDirLightDirections() -> const std::string&
 	{
 		static std::string value = std::string{ GLOBAL_UNIFORM_SET_NAME } + "." + GLOBAL_UNIFORM_ACCESS_DIR_LIGHT_DIRECTIONS;
@@ -584,51 +643,15 @@ namespace Ailurus
 		return value;
 	}
 
-	auto RenderSystem::GetGlobalUniformAccessNamePointLightPositions() -> const std::string&
-	{
-		static std::string value = std::string{ GLOBAL_UNIFORM_SET_NAME } + "." + GLOBAL_UNIFORM_ACCESS_POINT_LIGHT_POSITIONS;
-		return value;
-	}
-
-	auto RenderSystem::GetGlobalUniformAccessNamePointLightColors() -> const std::string&
-	{
-		static std::string value = std::string{ GLOBAL_UNIFORM_SET_NAME } + "." + GLOBAL_UNIFORM_ACCESS_POINT_LIGHT_COLORS;
-		return value;
-	}
-
-	auto RenderSystem::GetGlobalUniformAccessNamePointLightAttenuations() -> const std::string&
-	{
-		static std::string value = std::string{ GLOBAL_UNIFORM_SET_NAME } + "." + GLOBAL_UNIFORM_ACCESS_POINT_LIGHT_ATTENUATIONS;
-		return value;
-	}
-
-	auto RenderSystem::GetGlobalUniformAccessNameSpotLightPositions() -> const std::string&
-	{
-		static std::string value = std::string{ GLOBAL_UNIFORM_SET_NAME } + "." + GLOBAL_UNIFORM_ACCESS_SPOT_LIGHT_POSITIONS;
-		return value;
-	}
-
-	auto RenderSystem::GetGlobalUniformAccessNameSpotLightDirections() -> const std::string&
-	{
-		static std::string value = std::string{ GLOBAL_UNIFORM_SET_NAME } + "." + GLOBAL_UNIFORM_ACCESS_SPOT_LIGHT_DIRECTIONS;
-		return value;
-	}
-
-	auto RenderSystem::GetGlobalUniformAccessNameSpotLightColors() -> const std::string&
-	{
-		static std::string value = std::string{ GLOBAL_UNIFORM_SET_NAME } + "." + GLOBAL_UNIFORM_ACCESS_SPOT_LIGHT_COLORS;
-		return value;
-	}
-
-	auto RenderSystem::GetGlobalUniformAccessNameSpotLightAttenuations() -> const std::string&
+	auto RenderSystem::GetGlobalUniformAccessNameCameraForward() -> const std::string&
 	{
-		static std::string value = std::string{ GLOBAL_UNIFORM_SET_NAME } + "." + GLOBAL_UNIFORM_ACCESS_SPOT_LIGHT_ATTENUATIONS;
+		static std::string value = std::string{ GLOBAL_UNIFORM_SET_NAME } + "." + GLOBAL_UNIFORM_ACCESS_CAMERA_FORWARD;
 		return value;
 	}
 
-	auto RenderSystem::GetGlobalUniformAccessNameSpotLightCutoffs() -> const std::string&
+	auto RenderSystem::GetGlobalUniformAccessNameClusterParams() -> const std::string&
 	{
-		static std::string value = std::string{ GLOBAL_UNIFORM_SET_NAME } + "." + GLOBAL_UNIFORM_ACCESS_SPOT_LIGHT_CUTOFFS;
+		static std::string value = std::string{ GLOBAL_UNIFORM_SET_NAME } + "." + GLOBAL_UNIFORM_ACCESS_CLUSTER_PARAMS;
 		return value;
 	}
 
@@ -0,0 +1,275 @@
+#include "RenderWorld.h"
+#include <Ailurus/Application.h>
+#include <Ailurus/Utility/Logger.h>
+#include <Ailurus/Systems/SceneSystem/Component/CompStaticMeshRender.h>
+#include <Ailurus/Systems/SceneSystem/Component/CompLight.h>
+#include <Ailurus/Systems/AssetsSystem/Material/MaterialInstance.h>
+#include <VulkanContext/VulkanContext.h>
+#include <VulkanContext/Pipeline/VulkanPipelineManager.h>
+
+namespace Ailurus
+{
+	RenderWorld::RenderWorld()
+	{
+		auto* pSceneSystem = Application::Get<SceneSystem>();
+		if (pSceneSystem == nullptr)
+		{
+			Logger::LogError("RenderWorld created without scene system");
+			return;
+		}
+
+		pSceneSystem->AddObserver(this, this);
+	}
+
+	RenderWorld::~RenderWorld()
+	{
+		// Scene system may already be gone during application shutdown
+		if (auto* pSceneSystem = Application::Get<SceneSystem>())
+			pSceneSystem->RemoveObserver(this);
+	}
+
+	void RenderWorld::Update()
+	{
+		for (const Entity* pEntity : _dirtyEntities)
+		{
+			auto itr = _entityProxies.find(pEntity);
+			if (itr == _entityProxies.end() || !itr->second.dirty)
+				continue;
+
+			RefreshEntity(*pEntity, itr->second);
+			itr->second.dirty = false;
+		}
+
+		_dirtyEntities.clear();
+	}
+
+	auto RenderWorld::GetMeshProxies() const -> const std::vector<MeshRenderProxy>&
+	{
+		return _meshProxies;
+	}
+
+	auto RenderWorld::GetMeshProxies() -> std::vector<MeshRenderProxy>&
+	{
+		return _meshProxies;
+	}
+
+	auto RenderWorld::GetLightProxies() const -> const std::vector<LightProxy>&
+	{
+		return _lightProxies;
+	}
+
+	void RenderWorld::QueryMeshProxies(const Frustum& frustum, std::vector<uint32_t>& outIndices)
+	{
+		_queryCandidates.clear();
+		_queryBoxes.Clear();
+		_meshBVH.Query(frustum, [this](uint32_t index) -> void {
+			_queryCandidates.push_back(index);
+			_queryBoxes.Add(_meshProxies[index].worldAABB);
+		});
+
+		// Tree leaves are fattened, recheck the tight boxes of all candidates at once
+		Math::CullBoundingBoxes(frustum, _queryBoxes, _queryVisibilityMask);
+		for (uint32_t i = 0; i < _queryBoxes.Size(); i++)
+		{
+			if (Math::IsVisible(_queryVisibilityMask, i))
+				outIndices.push_back(_queryCandidates[i]);
+		}
+	}
+
+	void RenderWorld::QueryMeshProxies(const AABBf& aabb, std::vector<uint32_t>& outIndices) const
+	{
+		_meshBVH.Query(aabb, [this, &aabb, &outIndices](uint32_t index) -> void {
+			if (aabb.Intersects(_meshProxies[index].worldAABB))
+				outIndices.push_back(index);
+		});
+	}
+
+	void RenderWorld::OnEntityDestroyed(const Entity& entity)
+	{
+		auto itr = _entityProxies.find(&entity);
+		if (itr == _entityProxies.end())
+			return;
+
+		const EntityProxies proxies = itr->second;
+		if (proxies.meshProxyIndex != INVALID_PROXY_INDEX)
+			RemoveMeshProxy(proxies.meshProxyIndex);
+
+		if (proxies.lightProxyIndex != INVALID_PROXY_INDEX)
+			RemoveLightProxy(proxies.lightProxyIndex);
+
+		_entityProxies.erase(&entity);
+	}
+
+	void RenderWorld::OnEntityParentChanged(const Entity& entity)
+	{
+		MarkHierarchyDirty(entity);
+	}
+
+	void RenderWorld::OnEntityTransformChanged(const Entity& entity)
+	{
+		MarkHierarchyDirty(entity);
+	}
+
+	void RenderWorld::OnComponentAttached(const Entity& entity, const Component& component)
+	{
+		const ComponentType type = component.GetType();
+		if (type != ComponentType::StaticMeshRender && type != ComponentType::Light)
+			return;
+
+		EntityProxies& proxies = _entityProxies[&entity];
+		if (type == ComponentType::StaticMeshRender)
+		{
+			const auto* pMeshRender = static_cast<const CompStaticMeshRender*>(&component);
+			if (proxies.meshProxyIndex == INVALID_PROXY_INDEX)
+			{
+				proxies.meshProxyIndex = static_cast<uint32_t>(_meshProxies.size());
+				_meshProxies.push_back(MeshRenderProxy{ &entity, pMeshRender });
+			}
+			else
+				_meshProxies[proxies.meshProxyIndex].pMeshRender = pMeshRender;
+
+			WarmUpPipelines(*pMeshRender);
+		}
+		else
+		{
+			const auto* pLight = static_cast<const CompLight*>(&component);
+			if (proxies.lightProxyIndex == INVALID_PROXY_INDEX)
+			{
+				proxies.lightProxyIndex = static_cast<uint32_t>(_lightProxies.size());
+				_lightProxies.push_back(LightProxy{ &entity, pLight });
+			}
+			else
+				_lightProxies[proxies.lightProxyIndex].pLight = pLight;
+		}
+
+		// World data is filled by the next Update, components are usually attached
+		// before the entity is positioned
+		if (!proxies.dirty)
+		{
+			proxies.dirty = true;
+			_dirtyEntities.push_back(&entity);
+		}
+	}
+
+	void RenderWorld::WarmUpPipelines(const CompStaticMeshRender& meshRender)
+	{
+		// The component pairs the material with the vertex layouts of the model's meshes,
+		// their pipelines are compiled now rather than in the first frame drawing them
+		const auto& modelRef = meshRender.GetModelAsset();
+		const auto& materialInstRef = meshRender.GetMaterialInstanceAsset();
+		if (!modelRef || !materialInstRef || materialInstRef->GetTargetMaterial() == nullptr)
+			return;
+
+		auto* pPipelineManager = VulkanContext::GetPipelineManager();
+		if (pPipelineManager == nullptr)
+			return;
+
+		for (const auto& pMesh : modelRef->GetMeshes())
+			pPipelineManager->WarmUp(*materialInstRef->GetTargetMaterial(), pMesh->GetVertexLayoutId());
+	}
+
+	void RenderWorld::OnComponentDetached(const Entity& entity, const Component& component)
+	{
+		auto itr = _entityProxies.find(&entity);
+		if (itr == _entityProxies.end())
+			return;
+
+		EntityProxies& proxies = itr->second;
+		const ComponentType type = component.GetType();
+		if (type == ComponentType::StaticMeshRender && proxies.meshProxyIndex != INVALID_PROXY_INDEX
+			&& _meshProxies[proxies.meshProxyIndex].pMeshRender == &component)
+		{
+			const uint32_t index = proxies.meshProxyIndex;
+			proxies.meshProxyIndex = INVALID_PROXY_INDEX;
+			RemoveMeshProxy(index);
+		}
+		else if (type == ComponentType::Light && proxies.lightProxyIndex != INVALID_PROXY_INDEX
+			&& _lightProxies[proxies.lightProxyIndex].pLight == &component)
+		{
+			const uint32_t index = proxies.lightProxyIndex;
+			proxies.lightProxyIndex = INVALID_PROXY_INDEX;
+			RemoveLightProxy(index);
+		}
+
+		EraseIfEmpty(entity);
+	}
+
+	void RenderWorld::MarkHierarchyDirty(const Entity& entity)
+	{
+		// Children inherit the world transform, so they are stale as well
+		if (auto itr = _entityProxies.find(&entity); itr != _entityProxies.end() && !itr->second.dirty)
+		{
+			itr->second.dirty = true;
+			_dirtyEntities.push_back(&entity);
+		}
+
+		for (const Entity* pChild : entity.GetChildren())
+			MarkHierarchyDirty(*pChild);
+	}
+
+	void RenderWorld::RefreshEntity(const Entity& entity, const EntityProxies& proxies)
+	{
+		const Matrix4x4f worldMatrix = entity.GetModelMatrix();
+		const Vector4f translation = worldMatrix.GetCol(3);
+		const Vector3f worldPosition(translation.x, translation.y, translation.z);
+
+		if (proxies.meshProxyIndex != INVALID_PROXY_INDEX)
+		{
+			MeshRenderProxy& proxy = _meshProxies[proxies.meshProxyIndex];
+			proxy.worldMatrix = worldMatrix;
+			proxy.worldPosition = worldPosition;
+
+			const auto& modelRef = proxy.pMeshRender->GetModelAsset();
+			proxy.worldAABB = modelRef ? modelRef->GetLocalAABB().Transform(worldMatrix) : AABBf(worldPosition, worldPosition);
+
+			if (proxy.bvhNodeId == DynamicBVH::NULL_NODE)
+				proxy.bvhNodeId = _meshBVH.Insert(proxy.worldAABB, proxies.meshProxyIndex);
+			else
+				_meshBVH.Move(proxy.bvhNodeId, proxy.worldAABB);
+		}
+
+		if (proxies.lightProxyIndex != INVALID_PROXY_INDEX)
+			_lightProxies[proxies.lightProxyIndex].worldPosition = worldPosition;
+	}
+
+	void RenderWorld::RemoveMeshProxy(uint32_t index)
+	{
+		if (_meshProxies[index].bvhNodeId != DynamicBVH::NULL_NODE)
+			_meshBVH.Remove(_meshProxies[index].bvhNodeId);
+
+		// Swap with the last one to keep the array dense
+		const uint32_t lastIndex = static_cast<uint32_t>(_meshProxies.size()) - 1;
+		if (index != lastIndex)
+		{
+			_meshProxies[index] = _meshProxies[lastIndex];
+			_entityProxies[_meshProxies[index].pEntity].meshProxyIndex = index;
+
+			if (_meshProxies[index].bvhNodeId != DynamicBVH::NULL_NODE)
+				_meshBVH.SetUserData(_meshProxies[index].bvhNodeId, index);
+		}
+
+		_meshProxies.pop_back();
+	}
+
+	void RenderWorld::RemoveLightProxy(uint32_t index)
+	{
+		const uint32_t lastIndex = static_cast<uint32_t>(_lightProxies.size()) - 1;
+		if (index != lastIndex)
+		{
+			_lightProxies[index] = _lightProxies[lastIndex];
+			_entityProxies[_lightProxies[index].pEntity].lightProxyIndex = index;
+		}
+
+		_lightProxies.pop_back();
+	}
+
+	void RenderWorld::EraseIfEmpty(const Entity& entity)
+	{
+		auto itr = _entityProxies.find(&entity);
+		if (itr == _entityProxies.end())
+			return;
+
+		if (itr->second.meshProxyIndex == INVALID_PROXY_INDEX && itr->second.lightProxyIndex == INVALID_PROXY_INDEX)
+			_entityProxies.erase(itr);
+	}
+} // namespace Ailurus
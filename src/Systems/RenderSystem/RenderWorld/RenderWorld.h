@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+#include <Ailurus/Math/Matrix4x4.hpp>
+#include <Ailurus/Math/Vector3.hpp>
+#include <Ailurus/Math/AABB.hpp>
+#include <Ailurus/Math/Frustum.hpp>
+#include <Ailurus/Math/FrustumCulling.hpp>
+#include <Ailurus/Container/DynamicBVH.hpp>
+#include <Ailurus/Utility/NonCopyable.h>
+#include <Ailurus/Utility/NonMovable.h>
+#include <Ailurus/Systems/SceneSystem/SceneSystem.h>
+
+namespace Ailurus
+{
+	class CompStaticMeshRender;
+	class CompLight;
+
+	struct MeshRenderProxy
+	{
+		const Entity* pEntity;
+		const CompStaticMeshRender* pMeshRender;
+
+		// Cached world space data, refreshed only when the entity or an ancestor moves
+		Matrix4x4f worldMatrix;
+		AABBf worldAABB;
+		Vector3f worldPosition;
+
+		// Leaf in the spatial index, inserted on first refresh
+		int32_t bvhNodeId = DynamicBVH::NULL_NODE;
+
+		// Levels of detail drawn last frame, selection only moves away from them past a margin
+		uint32_t lodIndex = 0;
+		uint32_t shadowLodIndex = 0;
+	};
+
+	struct LightProxy
+	{
+		const Entity* pEntity;
+		const CompLight* pLight;
+
+		// Cached world space position, refreshed only when the entity or an ancestor moves
+		Vector3f worldPosition;
+	};
+
+	/// Render side mirror of the scene. Keeps dense proxy arrays for mesh renders and
+	/// lights, maintained incrementally from scene notifications, so that collecting
+	/// the frame does not walk every entity.
+	class RenderWorld : public SceneObserver, public NonCopyable, public NonMovable
+	{
+	public:
+		RenderWorld();
+		~RenderWorld() override;
+
+	public:
+		/// Refresh the cached world data of proxies whose transform changed since last call.
+		void Update();
+
+		auto GetMeshProxies() const -> const std::vector<MeshRenderProxy>&;
+		auto GetMeshProxies() -> std::vector<MeshRenderProxy>&;
+		auto GetLightProxies() const -> const std::vector<LightProxy>&;
+
+		/// Indices of mesh proxies whose world AABB intersects the frustum, appended to outIndices.
+		/// Whole subtrees of the spatial index are rejected or accepted at once, the tight boxes of
+		/// the reported leaves are then tested in one batch.
+		void QueryMeshProxies(const Frustum& frustum, std::vector<uint32_t>& outIndices);
+
+		/// Indices of mesh proxies whose world AABB intersects the box, appended to outIndices.
+		void QueryMeshProxies(const AABBf& aabb, std::vector<uint32_t>& outIndices) const;
+
+		void OnEntityDestroyed(const Entity& entity) override;
+		void OnEntityParentChanged(const Entity& entity) override;
+		void OnEntityTransformChanged(const Entity& entity) override;
+		void OnComponentAttached(const Entity& entity, const Component& component) override;
+		void OnComponentDetached(const Entity& entity, const Component& component) override;
+
+	private:
+		static constexpr uint32_t INVALID_PROXY_INDEX = UINT32_MAX;
+
+		/// Proxy slots owned by one entity
+		struct EntityProxies
+		{
+			uint32_t meshProxyIndex = INVALID_PROXY_INDEX;
+			uint32_t lightProxyIndex = INVALID_PROXY_INDEX;
+			bool dirty = false;
+		};
+
+		void MarkHierarchyDirty(const Entity& entity);
+		void WarmUpPipelines(const CompStaticMeshRender& meshRender);
+		void RefreshEntity(const Entity& entity, const EntityProxies& proxies);
+		void RemoveMeshProxy(uint32_t index);
+		void RemoveLightProxy(uint32_t index);
+		void EraseIfEmpty(const Entity& entity);
+
+	private:
+		std::vector<MeshRenderProxy> _meshProxies;
+		std::vector<LightProxy> _lightProxies;
+		DynamicBVH _meshBVH;
+		std::unordered_map<const Entity*, EntityProxies> _entityProxies;
+		std::vector<const Entity*> _dirtyEntities;
+
+		// Query scratch
+		std::vector<uint32_t> _queryCandidates;
+		BoundingBoxArray _queryBoxes;
+		std::vector<uint64_t> _queryVisibilityMask;
+	};
+} // namespace Ailurus
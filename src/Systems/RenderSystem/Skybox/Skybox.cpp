@@ -373,7 +373,7 @@ namespace Ailurus
 		pCmdBuffer->BindDescriptorSet(_pPipeline->GetPipelineLayout(), descriptorSets);
 
 		// Push inverse view-projection matrix
-		pCmdBuffer->PushConstantModelMatrix(_pPipeline.get(), inverseVP);
+		pCmdBuffer->PushConstantSkyboxMatrix(_pPipeline.get(), inverseVP);
 
 		// Draw fullscreen triangle
 		pCmdBuffer->DrawNonIndexed(3);
@@ -35,7 +35,7 @@ namespace Ailurus
 	}
 
 	static void PopulateUniformOffsets(UniformVariable* pUniform, const std::string& prefix,
-		uint32_t& currentOffset, std::unordered_map<std::string, uint32_t>& offsetMap, bool isTopLevel = true)
+		uint32_t& currentOffset, std::unordered_map<std::string, UniformAccessLayout>& layoutMap, bool isTopLevel = true)
 	{
 		switch (pUniform->VariableType())
 		{
@@ -46,8 +46,12 @@ namespace Ailurus
 				uint32_t alignment = UniformLayoutHelper::GetStd140BaseAlignment(pNumericUniform->ValueType());
 				currentOffset = UniformLayoutHelper::AlignOffset(currentOffset, alignment);
 				
-				offsetMap[prefix] = currentOffset;
-				currentOffset += UniformValue::GetSize(pNumericUniform->ValueType());
+				UniformAccessLayout& layout = layoutMap[prefix];
+				layout.variableType = UniformVariableType::Numeric;
+				layout.valueType = pNumericUniform->ValueType();
+				layout.offset = currentOffset;
+				layout.size = UniformValue::GetSize(pNumericUniform->ValueType());
+				currentOffset += layout.size;
 				break;
 			}
 			case UniformVariableType::Structure:
@@ -59,11 +63,12 @@ namespace Ailurus
 					uint32_t structAlignment = GetStd140BaseAlignment(pUniform);
 					currentOffset = UniformLayoutHelper::AlignOffset(currentOffset, structAlignment);
 				}
-				
+
+				const uint32_t structBegin = currentOffset;
 				for (const auto& [name, pChildUniform] : pStructureUniform->GetMembers())
 				{
 					std::string memberName = prefix + "." + name;
-					PopulateUniformOffsets(pChildUniform.get(), memberName, currentOffset, offsetMap, false);
+					PopulateUniformOffsets(pChildUniform.get(), memberName, currentOffset, layoutMap, false);
 				}
 				
 				// Align structure size to its base alignment at the end
@@ -72,6 +77,12 @@ namespace Ailurus
 					uint32_t structAlignment = GetStd140BaseAlignment(pUniform);
 					currentOffset = UniformLayoutHelper::AlignOffset(currentOffset, structAlignment);
 				}
+
+				// The whole structure, for block writes
+				UniformAccessLayout& layout = layoutMap[prefix];
+				layout.variableType = UniformVariableType::Structure;
+				layout.offset = structBegin;
+				layout.size = currentOffset - structBegin;
 				break;
 			}
 			case UniformVariableType::Array:
@@ -96,9 +107,22 @@ namespace Ailurus
 					{
 						std::string elementName = prefix + "[" + std::to_string(i) + "]";
 						uint32_t elementOffset = currentOffset + (i * arrayStride);
-						offsetMap[elementName] = elementOffset;
+						UniformAccessLayout& elementLayout = layoutMap[elementName];
+						elementLayout.variableType = UniformVariableType::Numeric;
+						elementLayout.valueType = elementType;
+						elementLayout.offset = elementOffset;
+						elementLayout.size = UniformValue::GetSize(elementType);
 					}
-					
+
+					// The array name itself addresses all elements at once
+					UniformAccessLayout& layout = layoutMap[prefix];
+					layout.variableType = UniformVariableType::Array;
+					layout.valueType = elementType;
+					layout.offset = currentOffset;
+					layout.size = static_cast<uint32_t>(members.size()) * arrayStride;
+					layout.arrayStride = arrayStride;
+					layout.arrayCount = static_cast<uint32_t>(members.size());
+
 					// Move past the entire array
 					currentOffset += members.size() * arrayStride;
 				}
@@ -117,7 +141,7 @@ namespace Ailurus
 		, _pUniformVariable(std::move(pUniform))
 	{
 		uint32_t offset = 0;
-		PopulateUniformOffsets(_pUniformVariable.get(), _bindingPointName, offset, _accessNameToBufferOffsetMap);
+		PopulateUniformOffsets(_pUniformVariable.get(), _bindingPointName, offset, _accessNameToLayoutMap);
 		_totalSize = offset;
 	}
 
@@ -150,8 +174,17 @@ namespace Ailurus
 
 	std::optional<uint32_t> UniformBindingPoint::GetAccessOffset(const std::string& accessName) const
 	{
-		auto it = _accessNameToBufferOffsetMap.find(accessName);
-		if (it != _accessNameToBufferOffsetMap.end())
+		const auto layout = GetAccessLayout(accessName);
+		if (!layout.has_value())
+			return std::nullopt;
+
+		return layout->offset;
+	}
+
+	std::optional<UniformAccessLayout> UniformBindingPoint::GetAccessLayout(const std::string& accessName) const
+	{
+		auto it = _accessNameToLayoutMap.find(accessName);
+		if (it != _accessNameToLayoutMap.end())
 			return it->second;
 
 		Logger::LogError("Access name '{}' not found in binding point {}.", accessName, _bindingPoint);
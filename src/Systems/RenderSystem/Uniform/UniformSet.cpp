@@ -1,7 +1,7 @@
 #include <Ailurus/Systems/RenderSystem/Uniform/UniformSet.h>
 #include <Ailurus/Systems/RenderSystem/Uniform/UniformLayoutHelper.h>
 #include <Ailurus/Utility/Logger.h>
-#include <VulkanContext/DataBuffer/VulkanUniformBuffer.h>
+#include <VulkanContext/DataBuffer/VulkanUniformRingBuffer.h>
 #include <VulkanContext/Descriptor/VulkanDescriptorSetLayout.h>
 
 namespace Ailurus
@@ -32,11 +32,14 @@ namespace Ailurus
 
 	void UniformSet::InitUniformBufferInfo()
 	{
+		// Every binding point is bound at its own offset into the set's ring slice, which the
+		// device requires to be a multiple of the uniform offset alignment (itself 16 or more for std140)
+		const uint32_t bindingAlignment = VulkanUniformRingBuffer::GetOffsetAlignment();
+
 		uint32_t offset = 0;
 		for (const auto& [bindingId, pBindingPoint] : _bindingPoints)
 		{
-			// Align each binding point to 16-byte boundary for std140 compatibility
-			offset = UniformLayoutHelper::AlignOffset(offset, 16);
+			offset = UniformLayoutHelper::AlignOffset(offset, bindingAlignment);
 			_bindingPointOffsetInUniformBufferMap[bindingId] = offset;
 			offset += pBindingPoint->GetTotalSize();
 		}
@@ -54,6 +57,12 @@ void UniformSet::InitDescriptorSetLayout()
 void UniformSet::InitDescriptorSetLayout(const std::vector<TextureBindingInfo>& textureBindings)
 {
 	_pDescriptorSetLayout = std::make_unique<VulkanDescriptorSetLayout>(this, textureBindings);
+}
+
+void UniformSet::InitDescriptorSetLayout(const std::vector<TextureBindingInfo>& textureBindings,
+	const std::vector<StorageBufferBindingInfo>& storageBufferBindings)
+{
+	_pDescriptorSetLayout = std::make_unique<VulkanDescriptorSetLayout>(this, textureBindings, storageBufferBindings);
 }	const UniformSet::BindingPointMap& UniformSet::GetAllBindingPoints() const
 	{
 		return _bindingPoints;
@@ -85,4 +94,29 @@ void UniformSet::InitDescriptorSetLayout(const std::vector<TextureBindingInfo>&
 			return itr->second;
 		return 0;
 	}
+
+	auto UniformSet::ResolveHandle(uint32_t bindingPoint, const std::string& access) const -> UniformHandle
+	{
+		UniformHandle handle;
+
+		const auto* pBindingPoint = GetBindingPoint(bindingPoint);
+		if (pBindingPoint == nullptr)
+		{
+			Logger::LogError("Uniform does not have binding point {}", bindingPoint);
+			return handle;
+		}
+
+		const auto layout = pBindingPoint->GetAccessLayout(access);
+		if (!layout.has_value())
+			return handle;
+
+		handle.bindingId = bindingPoint;
+		handle.offset = GetBindingPointOffsetInUniformBuffer(bindingPoint) + layout->offset;
+		handle.layout = *layout;
+		handle.valid = handle.offset + layout->size <= _uniformBufferSize;
+		if (!handle.valid)
+			Logger::LogError("Access '{}' of binding point {} lies outside the uniform buffer", access, bindingPoint);
+
+		return handle;
+	}
 } // namespace Ailurus
\ No newline at end of file
@@ -8,21 +8,33 @@
 #include "VulkanContext/Resource/Image/VulkanImage.h"
 #include "VulkanContext/Resource/Image/VulkanSampler.h"
 #include "Ailurus/Utility/Logger.h"
-#include <VulkanContext/DataBuffer/VulkanUniformBuffer.h>
-#include <VulkanContext/Resource/DataBuffer/VulkanDeviceBuffer.h>
+#include <algorithm>
+#include <cstring>
+#include <VulkanContext/DataBuffer/VulkanUniformRingBuffer.h>
+#include <VulkanContext/Resource/DataBuffer/VulkanHostBuffer.h>
+#include <VulkanContext/Resource/VulkanResourceManager.h>
 #include <VulkanContext/Descriptor/VulkanDescriptorSet.h>
+#include <VulkanContext/Descriptor/VulkanPersistentDescriptorSet.h>
 
 namespace Ailurus
 {
-    UniformSetMemory::UniformSetMemory(const UniformSet* pTargetUniformSet)
+    UniformSetMemory::UniformSetMemory(const UniformSet* pTargetUniformSet, UniformSetMemoryUsage usage)
 		: _pTargetUniformSet(pTargetUniformSet)
+		, _usage(usage)
+		, _data(pTargetUniformSet->GetUniformBufferSize(), 0)
 	{
-		auto uniformBufferSize = pTargetUniformSet->GetUniformBufferSize();
-		_pUniformBuffer = std::make_unique<VulkanUniformBuffer>(uniformBufferSize);
+		// Every copy starts out needing the whole set
+		if (_usage == UniformSetMemoryUsage::Static)
+			_frameCopies.resize(VulkanContext::GetParallelFrameCount(), FrameCopy{ nullptr, 0, 0, static_cast<uint32_t>(_data.size()) });
 	}
 
 	UniformSetMemory::~UniformSetMemory()
 	{
+		for (const auto& copy : _frameCopies)
+		{
+			if (copy.pBuffer != nullptr)
+				copy.pBuffer->MarkDelete();
+		}
 	}
 
 	void UniformSetMemory::SetUniformValue(uint32_t bindingId, const std::string& access, const UniformValue& value)
@@ -33,13 +45,6 @@ namespace Ailurus
 
 	void UniformSetMemory::SetUniformValue(const UniformAccess& entry, const UniformValue& value)
 	{
-		// Check uniform buffer initialization
-		if (_pUniformBuffer == nullptr)
-		{
-			Logger::LogError("Uniform buffer not initialized for UniformSet");
-			return;
-		}
-
 		// Get access offset
 		const auto* pBindingPoint = _pTargetUniformSet->GetBindingPoint(entry.bindingId);
     	if (pBindingPoint == nullptr)
@@ -60,56 +65,241 @@ namespace Ailurus
 
 		// Check if access offset is valid
 		uint32_t offset = bindingOffset + *accessOffset;
-		if (offset >= _pUniformBuffer->GetBufferSize())
+		if (offset + value.GetSize() > _data.size())
 		{
 			Logger::LogError("Access offset out of range for binding ID: {}, access: {}, uniform buffer size: {}, binding offset: {}, access offset: {}",
-				entry.bindingId, entry.access, _pUniformBuffer->GetBufferSize(), bindingOffset, *accessOffset);
+				entry.bindingId, entry.access, _data.size(), bindingOffset, *accessOffset);
 			return;
 		}
 
 		// Write value to uniform buffer
-		_pUniformBuffer->WriteData(offset, value);
+		WriteBytes(offset, value.GetDataPointer(), value.GetSize());
 		
 		// Record uniform value
-		_uniformValueMap[entry] = value;
+		if (_usage == UniformSetMemoryUsage::Static)
+			_uniformValueMap[entry] = value;
+	}
+
+	void UniformSetMemory::WriteBlock(const UniformHandle& handle, const void* pData, uint32_t size)
+	{
+		if (!handle.IsValid())
+			return;
+
+		if (size > handle.layout.size)
+		{
+			Logger::LogError("Block of {} bytes does not fit uniform access of {} bytes in binding point {}",
+				size, handle.layout.size, handle.bindingId);
+			return;
+		}
+
+		WriteBytes(handle.offset, pData, size);
+	}
+
+	void UniformSetMemory::WriteValue(const UniformHandle& handle, UniformValueType type, const void* pData, uint32_t size)
+	{
+		if (!handle.IsValid())
+			return;
+
+		if (handle.layout.variableType != UniformVariableType::Numeric || handle.layout.valueType != type)
+		{
+			Logger::LogError("Uniform handle in binding point {} does not hold a {}",
+				handle.bindingId, EnumReflection<UniformValueType>::ToString(type));
+			return;
+		}
+
+		WriteBytes(handle.offset, pData, size);
 	}
 
-	void UniformSetMemory::UpdateToDescriptorSet(VulkanCommandBuffer* pCommandBuffer, VulkanDescriptorSet descriptorSet) const
+	void UniformSetMemory::WriteElements(const UniformHandle& handle, UniformValueType type, const void* pElements,
+		uint32_t elementSize, uint32_t count, uint32_t firstElement)
 	{
-		TransitionDataToGpu(pCommandBuffer);
+		if (!handle.IsValid())
+			return;
+
+		const auto& layout = handle.layout;
+		if (layout.variableType != UniformVariableType::Array || layout.valueType != type)
+		{
+			Logger::LogError("Uniform handle in binding point {} is not an array of {}",
+				handle.bindingId, EnumReflection<UniformValueType>::ToString(type));
+			return;
+		}
 
-		VulkanDescriptorWriter writer;
-		WriteBindings(writer);
-		writer.UpdateSet(descriptorSet);
+		if (firstElement + count > layout.arrayCount)
+		{
+			Logger::LogError("Writing elements [{}, {}) of a uniform array of {} in binding point {}",
+				firstElement, firstElement + count, layout.arrayCount, handle.bindingId);
+			return;
+		}
+
+		// Tightly packed source, one copy
+		const uint32_t offset = handle.offset + firstElement * layout.arrayStride;
+		if (elementSize == layout.arrayStride)
+		{
+			WriteBytes(offset, pElements, elementSize * count);
+			return;
+		}
+
+		const auto* pSource = static_cast<const uint8_t*>(pElements);
+		for (uint32_t i = 0; i < count; i++)
+			WriteBytes(offset + i * layout.arrayStride, pSource + i * elementSize, elementSize);
 	}
 
-	void UniformSetMemory::PrepareGpuData(VulkanCommandBuffer* pCmdBuffer)
+	void UniformSetMemory::WriteBytes(uint32_t offset, const void* pData, uint32_t size)
 	{
-		TransitionDataToGpu(pCmdBuffer);
+		if (static_cast<size_t>(offset) + size > _data.size())
+		{
+			Logger::LogError("Write size {} at offset {} exceeds uniform set size {}", size, offset, _data.size());
+			return;
+		}
+
+		// Unchanged bytes need no upload
+		uint8_t* pTarget = _data.data() + offset;
+		if (std::memcmp(pTarget, pData, size) == 0)
+			return;
+
+		std::memcpy(pTarget, pData, size);
+		_version++;
+
+		for (auto& copy : _frameCopies)
+		{
+			if (copy.dirtyBegin == copy.dirtyEnd)
+			{
+				copy.dirtyBegin = offset;
+				copy.dirtyEnd = offset + size;
+			}
+			else
+			{
+				copy.dirtyBegin = std::min(copy.dirtyBegin, offset);
+				copy.dirtyEnd = std::max(copy.dirtyEnd, offset + size);
+			}
+		}
+	}
+
+	auto UniformSetMemory::UpdatePersistentDescriptorSet() -> VulkanDescriptorSet
+	{
+		Upload();
+
+		if (_pPersistentSet == nullptr)
+			_pPersistentSet = std::make_unique<VulkanPersistentDescriptorSet>(_pTargetUniformSet->GetDescriptorSetLayout());
+
+		const auto descriptorSet = _pPersistentSet->Acquire();
+		if (descriptorSet && _pPersistentSet->NeedsWrite(UNIFORM_BINDING_GROUP, ComputeBindingHash()))
+		{
+			VulkanDescriptorWriter writer;
+			WriteBindings(writer);
+			writer.UpdateSet(descriptorSet);
+		}
+
+		return descriptorSet;
+	}
+
+	auto UniformSetMemory::GetPersistentDescriptorSet() const -> VulkanPersistentDescriptorSet*
+	{
+		return _pPersistentSet.get();
+	}
+
+	auto UniformSetMemory::GetDynamicOffset() const -> uint32_t
+	{
+		return _frameOffset;
+	}
+
+	auto UniformSetMemory::GetDynamicOffsetCount() const -> uint32_t
+	{
+		return static_cast<uint32_t>(_pTargetUniformSet->GetAllBindingPoints().size());
+	}
+
+	auto UniformSetMemory::GetVersion() const -> uint64_t
+	{
+		return _version;
+	}
+
+	auto UniformSetMemory::GetLastUploadSize() const -> uint32_t
+	{
+		return _lastUploadSize;
+	}
+
+	void UniformSetMemory::PrepareGpuData(VulkanCommandBuffer* /*pCmdBuffer*/)
+	{
+		Upload();
 	}
 
 	void UniformSetMemory::WriteBindings(VulkanDescriptorWriter& writer) const
 	{
+		if (_pFrameBuffer == nullptr)
+			return;
+
+		// Binding offsets are relative to the slice, the slice itself is the dynamic offset
 		auto& allBindingPoints = _pTargetUniformSet->GetAllBindingPoints();
 		for (auto& [bindingId, pBindingPoint] : allBindingPoints)
 		{
 			auto offset = _pTargetUniformSet->GetBindingPointOffsetInUniformBuffer(bindingId);
 			auto range = pBindingPoint->GetTotalSize();
-			auto buffer = _pUniformBuffer->GetThisFrameDeviceBuffer()->buffer;
 
-			writer.WriteBuffer(bindingId, buffer, offset, range);
+			writer.WriteDynamicBuffer(bindingId, _pFrameBuffer->buffer, offset, range);
 		}
 	}
 
 	auto UniformSetMemory::ComputeBindingHash() const -> size_t
 	{
-		return reinterpret_cast<size_t>(this);
+		// The ring slice moves every frame but the descriptor only sees the buffer
+		const auto buffer = _pFrameBuffer != nullptr ? _pFrameBuffer->buffer : vk::Buffer{};
+		return reinterpret_cast<size_t>(this) ^ (std::hash<VkBuffer>{}(static_cast<VkBuffer>(buffer)) << 1);
+	}
+
+	auto UniformSetMemory::Upload() -> void
+	{
+		_pFrameBuffer = nullptr;
+		_frameOffset = 0;
+		_lastUploadSize = 0;
+		if (_data.empty())
+			return;
+
+		if (_usage == UniformSetMemoryUsage::Static)
+			UploadToFrameCopy();
+		else
+			UploadToFrameRing();
+	}
+
+	auto UniformSetMemory::UploadToFrameRing() -> void
+	{
+		const auto allocation = VulkanContext::GetFrameUniformRing()->Allocate(static_cast<uint32_t>(_data.size()));
+		if (allocation.pData == nullptr)
+			return;
+
+		std::memcpy(allocation.pData, _data.data(), _data.size());
+		_pFrameBuffer = allocation.pBuffer;
+		_frameOffset = allocation.offset;
+		_lastUploadSize = static_cast<uint32_t>(_data.size());
 	}
 
-	auto UniformSetMemory::TransitionDataToGpu(VulkanCommandBuffer* pCommandBuffer) const -> void
+	auto UniformSetMemory::UploadToFrameCopy() -> void
 	{
-		if (_pUniformBuffer)
-			_pUniformBuffer->TransitionDataToGpu(pCommandBuffer);
+		// The frame that last used this copy has finished, it is safe to overwrite
+		auto& copy = _frameCopies[VulkanContext::GetCurrentParallelFrameIndex()];
+		if (copy.pBuffer == nullptr)
+		{
+			copy.pBuffer = VulkanContext::GetResourceManager()->CreateHostBuffer(_data.size(), HostBufferUsage::Uniform);
+			if (copy.pBuffer == nullptr)
+			{
+				Logger::LogError("Failed to create uniform buffer of {} bytes", _data.size());
+				return;
+			}
+
+			copy.dirtyBegin = 0;
+			copy.dirtyEnd = static_cast<uint32_t>(_data.size());
+		}
+
+		if (copy.version != _version || copy.dirtyBegin != copy.dirtyEnd)
+		{
+			const uint32_t size = copy.dirtyEnd - copy.dirtyBegin;
+			std::memcpy(static_cast<uint8_t*>(copy.pBuffer->mappedAddr) + copy.dirtyBegin, _data.data() + copy.dirtyBegin, size);
+			copy.version = _version;
+			copy.dirtyBegin = 0;
+			copy.dirtyEnd = 0;
+			_lastUploadSize = size;
+		}
+
+		_pFrameBuffer = copy.pBuffer;
 	}
 
 	auto UniformSetMemory::GetUniformValueMap() const -> const UniformValueMap&
@@ -30,6 +30,26 @@ namespace Ailurus
 		return _modelAsset->GetLocalAABB().Transform(GetEntity()->GetModelMatrix());
 	}
 
+	void CompStaticMeshRender::SetOccluder(bool isOccluder)
+	{
+		_isOccluder = isOccluder;
+	}
+
+	bool CompStaticMeshRender::IsOccluder() const
+	{
+		return _isOccluder;
+	}
+
+	void CompStaticMeshRender::SetOccluderBounds(const AABBf& localBounds)
+	{
+		_occluderBounds = localBounds;
+	}
+
+	const std::optional<AABBf>& CompStaticMeshRender::GetOccluderBounds() const
+	{
+		return _occluderBounds;
+	}
+
 	nlohmann::json CompStaticMeshRender::Serialize() const
 	{
 		nlohmann::json j;
@@ -41,6 +61,14 @@ namespace Ailurus
 		if (_materialAsset)
 			j["materialPath"] = pAssetsSystem->GetAssetPath(_materialAsset.Get()->GetAssetId());
 
+		if (_isOccluder)
+			j["occluder"] = true;
+		if (_occluderBounds.has_value())
+		{
+			j["occluderBoundsMin"] = { _occluderBounds->min.x, _occluderBounds->min.y, _occluderBounds->min.z };
+			j["occluderBoundsMax"] = { _occluderBounds->max.x, _occluderBounds->max.y, _occluderBounds->max.z };
+		}
+
 		return j;
 	}
 } // namespace Ailurus
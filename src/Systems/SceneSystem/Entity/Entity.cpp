@@ -71,8 +71,13 @@ namespace Ailurus
 		if (_parent != nullptr)
 			_parent->_children.push_back(this);
 
+		MarkWorldMatrixDirty();
+
 		if (_sceneSystem != nullptr)
+		{
+			_sceneSystem->MarkHierarchyDirty();
 			_sceneSystem->NotifyEntityParentChanged(*this);
+		}
 	}
 
 	const std::vector<Entity*>& Entity::GetChildren() const
@@ -91,8 +96,7 @@ namespace Ailurus
 			return;
 
 		_position = position;
-		if (_sceneSystem != nullptr)
-			_sceneSystem->NotifyEntityTransformChanged(*this);
+		MarkLocalMatrixDirty();
 	}
 
 	Quaternionf Entity::GetRotation() const
@@ -106,8 +110,7 @@ namespace Ailurus
 			return;
 
 		_rotation = rotation;
-		if (_sceneSystem != nullptr)
-			_sceneSystem->NotifyEntityTransformChanged(*this);
+		MarkLocalMatrixDirty();
 	}
 
 	Vector3f Entity::GetScale() const
@@ -120,9 +123,8 @@ namespace Ailurus
 		if (_scale == scale)
 			return;
 
-    	_scale = scale;
-		if (_sceneSystem != nullptr)
-			_sceneSystem->NotifyEntityTransformChanged(*this);
+		_scale = scale;
+		MarkLocalMatrixDirty();
 	}
 
 	Component* Entity::GetComponent(ComponentType type) const
@@ -152,7 +154,7 @@ namespace Ailurus
 			if (!it->second.empty())
 			{
 				for (auto& pComp : it->second)
-					pComp->OnDetach();
+					OnComponentDetached(pComp.get());
 				hasRemoved = true;
 			}
 			_components.erase(it);
@@ -166,7 +168,7 @@ namespace Ailurus
 				if (!it->second.empty())
 				{
 					for (auto& pComp : it->second)
-						pComp->OnDetach();
+						OnComponentDetached(pComp.get());
 					hasRemoved = true;
 				}
 				it = _components.erase(it);
@@ -180,16 +182,69 @@ namespace Ailurus
 		return hasRemoved;
 	}
 
-	Matrix4x4f Entity::GetModelMatrix() const
+	void Entity::OnComponentAttached(Component* pComp)
+	{
+		pComp->OnAttach();
+		if (_sceneSystem != nullptr)
+			_sceneSystem->NotifyComponentAttached(*this, *pComp);
+	}
+
+	void Entity::OnComponentDetached(Component* pComp)
+	{
+		pComp->OnDetach();
+		if (_sceneSystem != nullptr)
+			_sceneSystem->NotifyComponentDetached(*this, *pComp);
+	}
+
+	void Entity::MarkLocalMatrixDirty()
 	{
-		Matrix4x4f localMatrix = Math::TranslateMatrix(GetPosition())
-			* Math::QuaternionToRotateMatrix(GetRotation())
-			* Math::ScaleMatrix(GetScale());
+		_localMatrixDirty = true;
+		MarkWorldMatrixDirty();
 
-		if (_parent != nullptr)
-			return _parent->GetModelMatrix() * localMatrix;
+		if (_sceneSystem != nullptr)
+		{
+			_sceneSystem->MarkTransformDirty(*this);
+			_sceneSystem->NotifyEntityTransformChanged(*this);
+		}
+	}
+
+	void Entity::MarkWorldMatrixDirty()
+	{
+		// Already dirty means the whole subtree is already dirty
+		if (_worldMatrixDirty)
+			return;
+
+		_worldMatrixDirty = true;
+		for (Entity* child : _children)
+			child->MarkWorldMatrixDirty();
+	}
+
+	const Matrix4x4f& Entity::GetLocalMatrix() const
+	{
+		if (_localMatrixDirty)
+		{
+			_localMatrix = Math::TranslateMatrix(_position)
+				* Math::QuaternionToRotateMatrix(_rotation)
+				* Math::ScaleMatrix(_scale);
+			_localMatrixDirty = false;
+		}
+
+		return _localMatrix;
+	}
+
+	const Matrix4x4f& Entity::GetModelMatrix() const
+	{
+		if (_worldMatrixDirty)
+		{
+			if (_parent != nullptr)
+				_worldMatrix = _parent->GetModelMatrix() * GetLocalMatrix();
+			else
+				_worldMatrix = GetLocalMatrix();
+
+			_worldMatrixDirty = false;
+		}
 
-		return localMatrix;
+		return _worldMatrix;
 	}
 
 	Entity::Entity(uint32_t guid)
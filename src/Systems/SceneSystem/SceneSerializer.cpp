@@ -130,8 +130,22 @@ namespace Ailurus
 		auto modelRef = assets.LoadModel(modelPath);
 		auto materialRef = assets.LoadMaterial(materialPath);
 
-		if (modelRef && materialRef)
-			pEntity->AddComponent<CompStaticMeshRender>(modelRef, materialRef);
+		if (!modelRef || !materialRef)
+			return;
+
+		auto* pMeshRender = pEntity->AddComponent<CompStaticMeshRender>(modelRef, materialRef);
+		if (pMeshRender == nullptr)
+			return;
+
+		pMeshRender->SetOccluder(compJson.value("occluder", false));
+		if (compJson.contains("occluderBoundsMin") && compJson.contains("occluderBoundsMax"))
+		{
+			const auto& mn = compJson["occluderBoundsMin"];
+			const auto& mx = compJson["occluderBoundsMax"];
+			pMeshRender->SetOccluderBounds(AABBf(
+				{ mn[0].get<float>(), mn[1].get<float>(), mn[2].get<float>() },
+				{ mx[0].get<float>(), mx[1].get<float>(), mx[2].get<float>() }));
+		}
 	}
 
 	void SceneSerializer::DeserializeScene(SceneSystem& scene, AssetsSystem& assets, const nlohmann::json& json)
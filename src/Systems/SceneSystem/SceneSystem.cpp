@@ -2,6 +2,7 @@
 #include "Ailurus/Systems/SceneSystem/SceneSerializer.h"
 #include "Ailurus/Application.h"
 #include "Ailurus/Systems/AssetsSystem/AssetsSystem.h"
+#include "Ailurus/Systems/JobSystem/JobSystem.h"
 
 namespace Ailurus
 {
@@ -26,6 +27,7 @@ namespace Ailurus
 		auto pEntity = std::make_shared<Entity>(_entityIdCounter);
 		pEntity->_sceneSystem = this;
 		_entityMap[_entityIdCounter] = pEntity;
+		MarkHierarchyDirty();
 		NotifyEntityCreated(*pEntity);
 		return pEntity;
 	}
@@ -62,6 +64,7 @@ namespace Ailurus
 		pEntity->_sceneSystem = nullptr;
 
 		_entityMap.erase(it);
+		MarkHierarchyDirty();
 		return true;
 	}
 
@@ -137,6 +140,139 @@ namespace Ailurus
 		}
 	}
 
+	void SceneSystem::NotifyComponentAttached(const Entity& entity, const Component& component)
+	{
+		for (const auto& [key, observer] : _observers)
+		{
+			(void)key;
+			if (observer != nullptr)
+				observer->OnComponentAttached(entity, component);
+		}
+	}
+
+	void SceneSystem::NotifyComponentDetached(const Entity& entity, const Component& component)
+	{
+		for (const auto& [key, observer] : _observers)
+		{
+			(void)key;
+			if (observer != nullptr)
+				observer->OnComponentDetached(entity, component);
+		}
+	}
+
+	void SceneSystem::MarkTransformDirty(const Entity& entity)
+	{
+		// Everything is updated after a rebuild anyway
+		if (_hierarchyNeedRebuild)
+			return;
+
+		const uint32_t rootIndex = entity._hierarchyRootIndex;
+		if (_hierarchyDirtyRoots[rootIndex] != 0)
+			return;
+
+		_hierarchyDirtyRoots[rootIndex] = 1;
+		_dirtyRootIndices.push_back(rootIndex);
+	}
+
+	void SceneSystem::MarkHierarchyDirty()
+	{
+		_hierarchyNeedRebuild = true;
+	}
+
+	void SceneSystem::RebuildHierarchy()
+	{
+		_hierarchyEntities.clear();
+		_hierarchyParentIndices.clear();
+		_hierarchyRootBegins.clear();
+
+		std::vector<std::pair<Entity*, uint32_t>> stack;
+		for (const auto& [guid, pEntity] : _entityMap)
+		{
+			(void)guid;
+			if (pEntity->GetParent() != nullptr)
+				continue;
+
+			const uint32_t rootIndex = static_cast<uint32_t>(_hierarchyRootBegins.size());
+			_hierarchyRootBegins.push_back(static_cast<uint32_t>(_hierarchyEntities.size()));
+
+			// Pre-order walk, a parent always lands before its children
+			stack.emplace_back(pEntity.get(), INVALID_HIERARCHY_INDEX);
+			while (!stack.empty())
+			{
+				auto [pCurrent, parentIndex] = stack.back();
+				stack.pop_back();
+
+				const uint32_t index = static_cast<uint32_t>(_hierarchyEntities.size());
+				_hierarchyEntities.push_back(pCurrent);
+				_hierarchyParentIndices.push_back(parentIndex);
+				pCurrent->_hierarchyRootIndex = rootIndex;
+
+				for (Entity* pChild : pCurrent->_children)
+					stack.emplace_back(pChild, index);
+			}
+		}
+
+		const uint32_t rootCount = static_cast<uint32_t>(_hierarchyRootBegins.size());
+		_hierarchyRootBegins.push_back(static_cast<uint32_t>(_hierarchyEntities.size()));
+
+		// Entities are not tracked while a rebuild is pending, so visit every root once
+		_hierarchyDirtyRoots.assign(rootCount, 1);
+		_dirtyRootIndices.resize(rootCount);
+		for (uint32_t i = 0; i < rootCount; i++)
+			_dirtyRootIndices[i] = i;
+
+		_hierarchyNeedRebuild = false;
+	}
+
+	void SceneSystem::UpdateHierarchyRange(uint32_t begin, uint32_t end)
+	{
+		for (uint32_t i = begin; i < end; i++)
+		{
+			Entity* pEntity = _hierarchyEntities[i];
+			if (!pEntity->_worldMatrixDirty)
+				continue;
+
+			// Parent was visited earlier in this range, its world matrix is up to date
+			const Matrix4x4f& localMatrix = pEntity->GetLocalMatrix();
+			const uint32_t parentIndex = _hierarchyParentIndices[i];
+			if (parentIndex == INVALID_HIERARCHY_INDEX)
+				pEntity->_worldMatrix = localMatrix;
+			else
+				pEntity->_worldMatrix = _hierarchyEntities[parentIndex]->_worldMatrix * localMatrix;
+
+			pEntity->_worldMatrixDirty = false;
+		}
+	}
+
+	void SceneSystem::UpdateTransforms()
+	{
+		if (_hierarchyNeedRebuild)
+			RebuildHierarchy();
+
+		if (_dirtyRootIndices.empty())
+			return;
+
+		const auto updateRoots = [this](uint32_t begin, uint32_t end) -> void {
+			for (uint32_t i = begin; i < end; i++)
+			{
+				const uint32_t rootIndex = _dirtyRootIndices[i];
+				UpdateHierarchyRange(_hierarchyRootBegins[rootIndex], _hierarchyRootBegins[rootIndex + 1]);
+			}
+		};
+
+		// Root subtrees are disjoint, each one is updated by a single job
+		const uint32_t dirtyRootCount = static_cast<uint32_t>(_dirtyRootIndices.size());
+		if (auto* pJobSystem = Application::Get<JobSystem>())
+			pJobSystem->ParallelFor(dirtyRootCount, HIERARCHY_ROOTS_PER_JOB, updateRoots);
+		else
+			updateRoots(0, dirtyRootCount);
+
+		for (const uint32_t rootIndex : _dirtyRootIndices)
+			_hierarchyDirtyRoots[rootIndex] = 0;
+
+		_dirtyRootIndices.clear();
+	}
+
 	void SceneSystem::UpdateAllComponents(float deltaTime)
 	{
 		for (const auto& [guid, pEntity] : _entityMap)
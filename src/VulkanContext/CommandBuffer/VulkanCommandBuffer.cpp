@@ -2,23 +2,29 @@
 #include "Ailurus/Utility/Logger.h"
 #include "VulkanContext/VulkanContext.h"
 #include "VulkanContext/Pipeline/VulkanPipeline.h"
-#include "VulkanContext/DataBuffer/VulkanVertexBuffer.h"
-#include "VulkanContext/DataBuffer/VulkanIndexBuffer.h"
+#include "VulkanContext/Pipeline/VulkanComputePipeline.h"
 #include "VulkanContext/Resource/DataBuffer/VulkanDataBuffer.h"
 #include "VulkanContext/Resource/DataBuffer/VulkanDeviceBuffer.h"
+#include "VulkanContext/Resource/Image/VulkanImage.h"
 #include "VulkanContext/SwapChain/VulkanSwapChain.h"
 
 namespace Ailurus
 {
 	VulkanCommandBuffer::VulkanCommandBuffer(bool isPrimary)
-		: _isPrimary(isPrimary)
+		: VulkanCommandBuffer(isPrimary, VulkanContext::GetCommandPool())
+	{
+	}
+
+	VulkanCommandBuffer::VulkanCommandBuffer(bool isPrimary, vk::CommandPool commandPool)
+		: _commandPool(commandPool)
+		, _isPrimary(isPrimary)
 	{
 		vk::CommandBufferLevel level = _isPrimary
 			? vk::CommandBufferLevel::ePrimary
 			: vk::CommandBufferLevel::eSecondary;
 
 		vk::CommandBufferAllocateInfo allocInfo;
-		allocInfo.setCommandPool(VulkanContext::GetCommandPool())
+		allocInfo.setCommandPool(_commandPool)
 			.setLevel(level)
 			.setCommandBufferCount(1);
 
@@ -39,11 +45,8 @@ namespace Ailurus
 		{
 			_buffer.reset(vk::CommandBufferResetFlagBits::eReleaseResources);
 
-			// Release resources
-			ClearResourceReferences();
-
 			// Recycle command buffer
-			VulkanContext::GetDevice().freeCommandBuffers(VulkanContext::GetCommandPool(), _buffer);
+			VulkanContext::GetDevice().freeCommandBuffers(_commandPool, _buffer);
 		}
 		catch (const vk::SystemError& e)
 		{
@@ -61,14 +64,6 @@ namespace Ailurus
 		return _isRecording;
 	}
 
-	void VulkanCommandBuffer::ClearResourceReferences()
-	{
-		for (auto& vulkanResource : _referencedResources)
-			vulkanResource->RemoveRef(*this);
-
-		_referencedResources.clear();
-	}
-
 	void VulkanCommandBuffer::Begin()
 	{
 		vk::CommandBufferBeginInfo beginInfo;
@@ -92,6 +87,39 @@ namespace Ailurus
 		_isRecording = true;
 	}
 
+	void VulkanCommandBuffer::Begin(const VulkanRenderingInheritance& inheritance)
+	{
+		if (_isPrimary)
+		{
+			Logger::LogError("VulkanCommandBuffer::Begin: Rendering inheritance is only valid for secondary command buffers");
+			return;
+		}
+
+		vk::CommandBufferInheritanceRenderingInfo renderingInfo;
+		renderingInfo.setColorAttachmentFormats(inheritance.colorFormats)
+			.setDepthAttachmentFormat(inheritance.depthFormat)
+			.setStencilAttachmentFormat(vk::Format::eUndefined)
+			.setRasterizationSamples(inheritance.samples);
+
+		vk::CommandBufferInheritanceInfo inheritanceInfo;
+		inheritanceInfo.setPNext(&renderingInfo);
+
+		vk::CommandBufferBeginInfo beginInfo;
+		beginInfo.setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit | vk::CommandBufferUsageFlagBits::eRenderPassContinue)
+			.setPInheritanceInfo(&inheritanceInfo);
+
+		try
+		{
+			_buffer.begin(beginInfo);
+		}
+		catch (const vk::SystemError& e)
+		{
+			Logger::LogError("Failed to begin command buffer: {}", e.what());
+		}
+
+		_isRecording = true;
+	}
+
 	void VulkanCommandBuffer::End()
 	{
 		try
@@ -106,7 +134,8 @@ namespace Ailurus
 		_isRecording = false;
 	}
 
-	void VulkanCommandBuffer::CopyBuffer(VulkanDataBuffer* pSrcBuffer, VulkanDataBuffer* pDstBuffer, vk::DeviceSize size)
+	void VulkanCommandBuffer::CopyBuffer(VulkanDataBuffer* pSrcBuffer, VulkanDataBuffer* pDstBuffer, vk::DeviceSize size,
+		vk::DeviceSize srcOffset, vk::DeviceSize dstOffset)
 	{
 		if (pSrcBuffer == nullptr || pDstBuffer == nullptr)
 		{
@@ -114,31 +143,33 @@ namespace Ailurus
 			return;
 		}
 
-		// Record resources
-		pSrcBuffer->AddRef(*this);
-		_referencedResources.insert(pSrcBuffer);
-
-		pDstBuffer->AddRef(*this);
-		_referencedResources.insert(pDstBuffer);
-
 		// Record command
 		vk::BufferCopy copyRegion;
 		copyRegion.setSize(size)
-			.setSrcOffset(0)
-			.setDstOffset(0);
+			.setSrcOffset(srcOffset)
+			.setDstOffset(dstOffset);
 
 		_buffer.copyBuffer(pSrcBuffer->buffer, pDstBuffer->buffer, 1, &copyRegion);
 	}
 
+	void VulkanCommandBuffer::CopyBufferToImage(VulkanDataBuffer* pSrcBuffer, VulkanImage* pDstImage,
+		const std::vector<vk::BufferImageCopy>& regions)
+	{
+		if (pSrcBuffer == nullptr || pDstImage == nullptr)
+		{
+			Logger::LogError("VulkanCommandBuffer::CopyBufferToImage: Source buffer or destination image is nullptr");
+			return;
+		}
+
+		// Record command
+		_buffer.copyBufferToImage(pSrcBuffer->buffer, pDstImage->GetImage(), vk::ImageLayout::eTransferDstOptimal, regions);
+	}
+
 	void VulkanCommandBuffer::BufferMemoryBarrier(VulkanDataBuffer* pBuffer, vk::AccessFlags srcAccessMask, vk::AccessFlags dstAccessMask, vk::PipelineStageFlags srcStageMask, vk::PipelineStageFlags dstStageMask)
 	{
 		if (pBuffer == nullptr)
 			return;
 
-		// Record resources
-		pBuffer->AddRef(*this);
-		_referencedResources.insert(pBuffer);
-
 		// Record command
 		vk::BufferMemoryBarrier barrier;
 		barrier.setBuffer(pBuffer->buffer)
@@ -184,7 +215,7 @@ namespace Ailurus
 	}
 
 	void VulkanCommandBuffer::BeginRendering(vk::ImageView colorImageView, vk::ImageView depthImageView, vk::ImageView resolveImageView,
-		vk::Extent2D extent, bool clearColor, bool useDepth, std::array<float, 4> clearColorValue, vk::ImageView depthResolveImageView, bool clearDepth)
+		vk::Extent2D extent, bool clearColor, bool useDepth, std::array<float, 4> clearColorValue, vk::ImageView depthResolveImageView, bool clearDepth, bool secondaryContents)
 	{
 		// Color attachment
 		vk::RenderingAttachmentInfo colorAttachment;
@@ -208,6 +239,9 @@ namespace Ailurus
 			.setLayerCount(1)
 			.setColorAttachments(colorAttachment);
 
+		if (secondaryContents)
+			renderingInfo.setFlags(vk::RenderingFlagBits::eContentsSecondaryCommandBuffers);
+
 		// Only add depth attachment if requested
 		if (useDepth && depthImageView)
 		{
@@ -231,7 +265,7 @@ namespace Ailurus
 		_buffer.beginRenderingKHR(renderingInfo);
 	}
 
-	void VulkanCommandBuffer::BeginDepthOnlyRendering(vk::ImageView depthImageView, vk::Extent2D extent)
+	void VulkanCommandBuffer::BeginDepthOnlyRendering(vk::ImageView depthImageView, vk::Extent2D extent, uint32_t layerCount, bool secondaryContents)
 	{
 		vk::RenderingAttachmentInfo depthAttachment;
 		depthAttachment.setImageView(depthImageView)
@@ -242,13 +276,16 @@ namespace Ailurus
 
 		vk::RenderingInfo renderingInfo;
 		renderingInfo.setRenderArea(vk::Rect2D{{0, 0}, extent})
-			.setLayerCount(1)
+			.setLayerCount(layerCount)
 			.setPDepthAttachment(&depthAttachment);
 
+		if (secondaryContents)
+			renderingInfo.setFlags(vk::RenderingFlagBits::eContentsSecondaryCommandBuffers);
+
 		_buffer.beginRenderingKHR(renderingInfo);
 	}
 
-	void VulkanCommandBuffer::BeginGBufferRendering(const std::vector<vk::ImageView>& colorImageViews, vk::ImageView depthImageView, vk::Extent2D extent, bool clearColor)
+	void VulkanCommandBuffer::BeginGBufferRendering(const std::vector<vk::ImageView>& colorImageViews, vk::ImageView depthImageView, vk::Extent2D extent, bool clearColor, bool secondaryContents)
 	{
 		std::vector<vk::RenderingAttachmentInfo> colorAttachments;
 		colorAttachments.reserve(colorImageViews.size());
@@ -277,6 +314,9 @@ namespace Ailurus
 			.setColorAttachments(colorAttachments)
 			.setPDepthAttachment(&depthAttachment);
 
+		if (secondaryContents)
+			renderingInfo.setFlags(vk::RenderingFlagBits::eContentsSecondaryCommandBuffers);
+
 		_buffer.beginRenderingKHR(renderingInfo);
 	}
 
@@ -310,7 +350,7 @@ namespace Ailurus
 		_buffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pPipeline->GetPipeline());
 	}
 
-	void VulkanCommandBuffer::BindVertexBuffer(const VulkanVertexBuffer* pVertexBuffer)
+	void VulkanCommandBuffer::BindVertexBuffer(VulkanDataBuffer* pVertexBuffer)
 	{
 		if (pVertexBuffer == nullptr)
 		{
@@ -318,17 +358,12 @@ namespace Ailurus
 			return;
 		}
 
-		// Record resources
-		auto* pInternalBuffer = pVertexBuffer->GetBuffer();
-		pInternalBuffer->AddRef(*this);
-		_referencedResources.insert(pInternalBuffer);
-
 		// Record command
 		const vk::DeviceSize offset = 0;
-		_buffer.bindVertexBuffers(0, 1, &pInternalBuffer->buffer, &offset);
+		_buffer.bindVertexBuffers(0, 1, &pVertexBuffer->buffer, &offset);
 	}
 
-	void VulkanCommandBuffer::BindIndexBuffer(const VulkanIndexBuffer* pIndexBuffer)
+	void VulkanCommandBuffer::BindIndexBuffer(VulkanDataBuffer* pIndexBuffer, vk::IndexType indexType)
 	{
 		if (pIndexBuffer == nullptr)
 		{
@@ -336,14 +371,9 @@ namespace Ailurus
 			return;
 		}
 
-		// Record resources
-		auto* pInternalBuffer = pIndexBuffer->GetBuffer();
-		pInternalBuffer->AddRef(*this);
-		_referencedResources.insert(pInternalBuffer);
-
 		// Record command
 		const vk::DeviceSize offset = 0;
-		_buffer.bindIndexBuffer(pInternalBuffer->buffer, offset, pIndexBuffer->GetIndexType());
+		_buffer.bindIndexBuffer(pIndexBuffer->buffer, offset, indexType);
 	}
 
 	void VulkanCommandBuffer::BindDescriptorSet(vk::PipelineLayout layout, const std::vector<vk::DescriptorSet>& descriptorSets)
@@ -351,21 +381,79 @@ namespace Ailurus
 		_buffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, layout, 0, descriptorSets, nullptr);
 	}
 
-	void VulkanCommandBuffer::DrawIndexed(uint32_t indexCount)
+	void VulkanCommandBuffer::BindDescriptorSet(vk::PipelineLayout layout, const std::vector<vk::DescriptorSet>& descriptorSets,
+		const std::vector<uint32_t>& dynamicOffsets)
 	{
-		_buffer.drawIndexed(indexCount, 1, 0, 0, 0);
+		_buffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, layout, 0, descriptorSets, dynamicOffsets);
 	}
 
-	void VulkanCommandBuffer::DrawNonIndexed(uint32_t vertexCount)
+	void VulkanCommandBuffer::BindDescriptorSetFrom(vk::PipelineLayout layout, uint32_t firstSet,
+		const std::vector<vk::DescriptorSet>& descriptorSets)
 	{
-		_buffer.draw(vertexCount, 1, 0, 0);
+		_buffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, layout, firstSet, descriptorSets, nullptr);
 	}
 
-	void VulkanCommandBuffer::PushConstantModelMatrix(const VulkanPipeline* pPipeline, const Matrix4x4f& modelMatrix)
+	void VulkanCommandBuffer::DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstInstance,
+		uint32_t firstIndex, int32_t vertexOffset)
+	{
+		_buffer.drawIndexed(indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+	}
+
+	void VulkanCommandBuffer::DrawNonIndexed(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstInstance,
+		uint32_t firstVertex)
+	{
+		_buffer.draw(vertexCount, instanceCount, firstVertex, firstInstance);
+	}
+
+	void VulkanCommandBuffer::DrawIndexedIndirectCount(VulkanDataBuffer* pArgsBuffer, vk::DeviceSize argsOffset,
+		VulkanDataBuffer* pCountBuffer, vk::DeviceSize countOffset, uint32_t maxDrawCount, uint32_t stride)
+	{
+		if (pArgsBuffer == nullptr || pCountBuffer == nullptr)
+		{
+			Logger::LogError("VulkanCommandBuffer::DrawIndexedIndirectCount: Argument or count buffer is nullptr");
+			return;
+		}
+
+		// Record command
+		_buffer.drawIndexedIndirectCount(pArgsBuffer->buffer, argsOffset, pCountBuffer->buffer, countOffset, maxDrawCount, stride);
+	}
+
+	void VulkanCommandBuffer::DrawIndirectCount(VulkanDataBuffer* pArgsBuffer, vk::DeviceSize argsOffset,
+		VulkanDataBuffer* pCountBuffer, vk::DeviceSize countOffset, uint32_t maxDrawCount, uint32_t stride)
+	{
+		if (pArgsBuffer == nullptr || pCountBuffer == nullptr)
+		{
+			Logger::LogError("VulkanCommandBuffer::DrawIndirectCount: Argument or count buffer is nullptr");
+			return;
+		}
+
+		// Record command
+		_buffer.drawIndirectCount(pArgsBuffer->buffer, argsOffset, pCountBuffer->buffer, countOffset, maxDrawCount, stride);
+	}
+
+	void VulkanCommandBuffer::BindComputePipeline(const VulkanComputePipeline* pPipeline)
+	{
+		if (pPipeline == nullptr)
+			return;
+
+		_buffer.bindPipeline(vk::PipelineBindPoint::eCompute, pPipeline->GetPipeline());
+	}
+
+	void VulkanCommandBuffer::BindComputeDescriptorSet(vk::PipelineLayout layout, const std::vector<vk::DescriptorSet>& descriptorSets)
+	{
+		_buffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute, layout, 0, descriptorSets, nullptr);
+	}
+
+	void VulkanCommandBuffer::Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+	{
+		_buffer.dispatch(groupCountX, groupCountY, groupCountZ);
+	}
+
+	void VulkanCommandBuffer::PushConstantSkyboxMatrix(const VulkanPipeline* pPipeline, const Matrix4x4f& inverseViewProj)
 	{
 		if (pPipeline == nullptr)
 		{
-			Logger::LogError("VulkanCommandBuffer::PushConstantModelMatrix: Pipeline is nullptr");
+			Logger::LogError("VulkanCommandBuffer::PushConstantSkyboxMatrix: Pipeline is nullptr");
 			return;
 		}
 
@@ -374,10 +462,11 @@ namespace Ailurus
 			vk::ShaderStageFlagBits::eVertex, 
 			0, 
 			sizeof(Matrix4x4f), 
-			&modelMatrix);
+			&inverseViewProj);
 	}
 
-	void VulkanCommandBuffer::PushConstantShadowData(const VulkanPipeline* pPipeline, const Matrix4x4f& modelMatrix, uint32_t cascadeIndex)
+	void VulkanCommandBuffer::PushConstantShadowData(const VulkanPipeline* pPipeline, uint32_t firstInstance, uint32_t cascadeMask,
+		uint32_t cascadeStride)
 	{
 		if (pPipeline == nullptr)
 		{
@@ -385,17 +474,12 @@ namespace Ailurus
 			return;
 		}
 
+		const std::array<uint32_t, 3> shadowData{ firstInstance, cascadeMask, cascadeStride };
 		_buffer.pushConstants(pPipeline->GetPipelineLayout(),
 			vk::ShaderStageFlagBits::eVertex,
 			0,
-			sizeof(Matrix4x4f),
-			&modelMatrix);
-
-		_buffer.pushConstants(pPipeline->GetPipelineLayout(),
-			vk::ShaderStageFlagBits::eVertex,
-			sizeof(Matrix4x4f),
-			sizeof(uint32_t),
-			&cascadeIndex);
+			sizeof(shadowData),
+			shadowData.data());
 	}
 
 	void VulkanCommandBuffer::PushConstants(const VulkanPipeline* pPipeline, vk::ShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const void* pData)
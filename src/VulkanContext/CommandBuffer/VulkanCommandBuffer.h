@@ -1,7 +1,7 @@
 #pragma once
 
 #include <array>
-#include <unordered_set>
+#include <vector>
 #include <vulkan/vulkan.hpp>
 #include <Ailurus/Utility/NonCopyable.h>
 #include <Ailurus/Math/Matrix4x4.hpp>
@@ -9,18 +9,30 @@
 namespace Ailurus
 {
 	class VulkanCommandBuffer;
-	class VulkanResource;
 	class VulkanDataBuffer;
+	class VulkanImage;
 	class VulkanPipeline;
-	class VulkanVertexBuffer;
-	class VulkanIndexBuffer;
+	class VulkanComputePipeline;
+
+	/// @brief Attachment state a secondary command buffer inherits from the dynamic rendering scope it is executed in
+	struct VulkanRenderingInheritance
+	{
+		std::vector<vk::Format> colorFormats;
+		vk::Format depthFormat = vk::Format::eUndefined;
+		vk::SampleCountFlagBits samples = vk::SampleCountFlagBits::e1;
+	};
 
 	class VulkanCommandBuffer : public NonCopyable
 	{
 	public:
-		/// @brief Construct a command buffer
+		/// @brief Construct a command buffer from the context's graphic command pool
 		/// @param isPrimary True for primary command buffer, false for secondary
 		explicit VulkanCommandBuffer(bool isPrimary);
+
+		/// @brief Construct a command buffer from a specific command pool
+		/// @param isPrimary True for primary command buffer, false for secondary
+		/// @param commandPool Pool to allocate from, must outlive this command buffer
+		VulkanCommandBuffer(bool isPrimary, vk::CommandPool commandPool);
 		virtual ~VulkanCommandBuffer();
 
 	public:
@@ -32,11 +44,12 @@ namespace Ailurus
 		/// @return True if recording, false otherwise
 		bool IsRecording() const;
 		
-		/// @brief Clear all resource references tracked by this command buffer
-		void ClearResourceReferences();
-
 		/// @brief Begin recording commands into this command buffer
 		void Begin();
+
+		/// @brief Begin recording a secondary command buffer that continues a dynamic rendering scope
+		/// @param inheritance Attachment formats and sample count of the rendering scope
+		void Begin(const VulkanRenderingInheritance& inheritance);
 		
 		/// @brief End recording commands
 		void End();
@@ -45,8 +58,17 @@ namespace Ailurus
 		/// @param pSrcBuffer Source buffer to copy from
 		/// @param pDstBuffer Destination buffer to copy to
 		/// @param size Size in bytes to copy
-		void CopyBuffer(VulkanDataBuffer* pSrcBuffer, VulkanDataBuffer* pDstBuffer, vk::DeviceSize size);
+		/// @param srcOffset Byte offset into the source buffer
+		/// @param dstOffset Byte offset into the destination buffer
+		void CopyBuffer(VulkanDataBuffer* pSrcBuffer, VulkanDataBuffer* pDstBuffer, vk::DeviceSize size,
+			vk::DeviceSize srcOffset = 0, vk::DeviceSize dstOffset = 0);
 		
+		/// @brief Copy data from a buffer into an image in eTransferDstOptimal layout
+		/// @param pSrcBuffer Source buffer to copy from
+		/// @param pDstImage Destination image to copy to
+		/// @param regions Buffer ranges and image subresources to copy
+		void CopyBufferToImage(VulkanDataBuffer* pSrcBuffer, VulkanImage* pDstImage, const std::vector<vk::BufferImageCopy>& regions);
+
 		/// @brief Insert a buffer memory barrier for synchronization
 		/// @param pBuffer Buffer to apply barrier to
 		/// @param srcAccessMask Source access mask
@@ -90,19 +112,23 @@ namespace Ailurus
 		/// @param useDepth If true, use depth attachment; if false, render without depth
 		/// @param clearDepth If true, clear the depth attachment; if false, load existing depth
 		/// @param depthResolveImageView Optional single-sampled depth resolve target for MSAA depth
-		void BeginRendering(vk::ImageView colorImageView, vk::ImageView depthImageView, vk::ImageView resolveImageView, vk::Extent2D extent, bool clearColor = true, bool useDepth = true, std::array<float, 4> clearColorValue = {0.0f, 0.0f, 0.0f, 1.0f}, vk::ImageView depthResolveImageView = nullptr, bool clearDepth = true);
+		/// @param secondaryContents If true, the scope contents are recorded in secondary command buffers
+		void BeginRendering(vk::ImageView colorImageView, vk::ImageView depthImageView, vk::ImageView resolveImageView, vk::Extent2D extent, bool clearColor = true, bool useDepth = true, std::array<float, 4> clearColorValue = {0.0f, 0.0f, 0.0f, 1.0f}, vk::ImageView depthResolveImageView = nullptr, bool clearDepth = true, bool secondaryContents = false);
 		
 		/// @brief Begin dynamic rendering for depth-only pass (shadow map rendering)
 		/// @param depthImageView Depth attachment image view
 		/// @param extent Rendering area extent
-		void BeginDepthOnlyRendering(vk::ImageView depthImageView, vk::Extent2D extent);
+		/// @param layerCount Number of layers rendered, shaders select the layer through gl_Layer
+		/// @param secondaryContents If true, the scope contents are recorded in secondary command buffers
+		void BeginDepthOnlyRendering(vk::ImageView depthImageView, vk::Extent2D extent, uint32_t layerCount = 1, bool secondaryContents = false);
 
 		/// @brief Begin dynamic rendering for the G-Buffer pass (multiple color attachments + depth)
 		/// @param colorImageViews List of color attachment image views (one per G-Buffer output)
 		/// @param depthImageView Depth attachment image view
 		/// @param extent Rendering area extent
 		/// @param clearColor If true, clear all color attachments
-		void BeginGBufferRendering(const std::vector<vk::ImageView>& colorImageViews, vk::ImageView depthImageView, vk::Extent2D extent, bool clearColor = true);
+		/// @param secondaryContents If true, the scope contents are recorded in secondary command buffers
+		void BeginGBufferRendering(const std::vector<vk::ImageView>& colorImageViews, vk::ImageView depthImageView, vk::Extent2D extent, bool clearColor = true, bool secondaryContents = false);
 
 		/// @brief End dynamic rendering
 		void EndRendering();
@@ -121,35 +147,94 @@ namespace Ailurus
 		
 		/// @brief Bind a vertex buffer
 		/// @param pVertexBuffer Vertex buffer to bind
-		void BindVertexBuffer(const VulkanVertexBuffer* pVertexBuffer);
+		void BindVertexBuffer(VulkanDataBuffer* pVertexBuffer);
 		
 		/// @brief Bind an index buffer
 		/// @param pIndexBuffer Index buffer to bind
-		void BindIndexBuffer(const VulkanIndexBuffer* pIndexBuffer);
+		/// @param indexType Type of the indices in the buffer
+		void BindIndexBuffer(VulkanDataBuffer* pIndexBuffer, vk::IndexType indexType);
 		
 		/// @brief Bind descriptor sets
 		/// @param layout Pipeline layout
 		/// @param descriptorSets Array of descriptor sets to bind
 		void BindDescriptorSet(vk::PipelineLayout layout, const std::vector<vk::DescriptorSet>& descriptorSets);
+
+		/// @brief Bind descriptor sets with dynamic buffer bindings
+		/// @param layout Pipeline layout
+		/// @param descriptorSets Array of descriptor sets to bind
+		/// @param dynamicOffsets One offset per dynamic binding, in set then binding order
+		void BindDescriptorSet(vk::PipelineLayout layout, const std::vector<vk::DescriptorSet>& descriptorSets,
+			const std::vector<uint32_t>& dynamicOffsets);
+
+		/// @brief Bind descriptor sets starting at a set index, lower sets stay bound
+		/// @param layout Pipeline layout
+		/// @param firstSet Set index of the first descriptor set
+		/// @param descriptorSets Array of descriptor sets to bind
+		void BindDescriptorSetFrom(vk::PipelineLayout layout, uint32_t firstSet, const std::vector<vk::DescriptorSet>& descriptorSets);
 		
 		/// @brief Execute an indexed draw call
 		/// @param indexCount Number of indices to draw
-		void DrawIndexed(uint32_t indexCount);
+		/// @param instanceCount Number of instances to draw
+		/// @param firstInstance Instance index of the first instance, offsets gl_InstanceIndex
+		/// @param firstIndex First index to read from the bound index buffer
+		/// @param vertexOffset Value added to each index before fetching the vertex
+		void DrawIndexed(uint32_t indexCount, uint32_t instanceCount = 1, uint32_t firstInstance = 0,
+			uint32_t firstIndex = 0, int32_t vertexOffset = 0);
 		
 		/// @brief Execute a non-indexed draw call
 		/// @param vertexCount Number of vertices to draw
-		void DrawNonIndexed(uint32_t vertexCount);
+		/// @param instanceCount Number of instances to draw
+		/// @param firstInstance Instance index of the first instance, offsets gl_InstanceIndex
+		/// @param firstVertex First vertex to read from the bound vertex buffer
+		void DrawNonIndexed(uint32_t vertexCount, uint32_t instanceCount = 1, uint32_t firstInstance = 0,
+			uint32_t firstVertex = 0);
+
+		/// @brief Execute indexed draws whose arguments and draw count are read from buffers
+		/// @param pArgsBuffer Buffer holding VkDrawIndexedIndirectCommand records
+		/// @param argsOffset Byte offset of the first record
+		/// @param pCountBuffer Buffer holding the draw count
+		/// @param countOffset Byte offset of the draw count
+		/// @param maxDrawCount Upper bound of the draw count
+		/// @param stride Byte stride between records
+		void DrawIndexedIndirectCount(VulkanDataBuffer* pArgsBuffer, vk::DeviceSize argsOffset, VulkanDataBuffer* pCountBuffer, vk::DeviceSize countOffset, uint32_t maxDrawCount, uint32_t stride);
+
+		/// @brief Execute non-indexed draws whose arguments and draw count are read from buffers
+		/// @param pArgsBuffer Buffer holding VkDrawIndirectCommand records
+		/// @param argsOffset Byte offset of the first record
+		/// @param pCountBuffer Buffer holding the draw count
+		/// @param countOffset Byte offset of the draw count
+		/// @param maxDrawCount Upper bound of the draw count
+		/// @param stride Byte stride between records
+		void DrawIndirectCount(VulkanDataBuffer* pArgsBuffer, vk::DeviceSize argsOffset, VulkanDataBuffer* pCountBuffer, vk::DeviceSize countOffset, uint32_t maxDrawCount, uint32_t stride);
+
+		/// @brief Bind a compute pipeline
+		/// @param pPipeline Pipeline to bind
+		void BindComputePipeline(const VulkanComputePipeline* pPipeline);
+
+		/// @brief Bind descriptor sets to the compute bind point
+		/// @param layout Compute pipeline layout
+		/// @param descriptorSets Array of descriptor sets to bind
+		void BindComputeDescriptorSet(vk::PipelineLayout layout, const std::vector<vk::DescriptorSet>& descriptorSets);
+
+		/// @brief Dispatch compute work groups
+		/// @param groupCountX Number of work groups in X
+		/// @param groupCountY Number of work groups in Y
+		/// @param groupCountZ Number of work groups in Z
+		void Dispatch(uint32_t groupCountX, uint32_t groupCountY = 1, uint32_t groupCountZ = 1);
 		
-		/// @brief Push model matrix constant to shader
-		/// @param pPipeline Pipeline containing push constant layout
-		/// @param mvpMatrix Model matrix to push
-		void PushConstantModelMatrix(const VulkanPipeline* pPipeline, const Matrix4x4f& mvpMatrix);
+		/// @brief Push the skybox inverse view-projection matrix to the vertex shader
+		/// @param pPipeline Skybox pipeline containing push constant layout
+		/// @param inverseViewProj Inverse view-projection matrix to push
+		void PushConstantSkyboxMatrix(const VulkanPipeline* pPipeline, const Matrix4x4f& inverseViewProj);
 
-		/// @brief Push shadow pass constants (model matrix + cascade index)
+		/// @brief Push shadow pass constants (instance buffer offset + cascade mask + cascade stride)
 		/// @param pPipeline Shadow pipeline containing push constant layout
-		/// @param modelMatrix Model matrix to push
-		/// @param cascadeIndex CSM cascade index to push
-		void PushConstantShadowData(const VulkanPipeline* pPipeline, const Matrix4x4f& modelMatrix, uint32_t cascadeIndex);
+		/// @param firstInstance Instance buffer slot of the batch's first caster
+		/// @param cascadeMask Bit i set when the batch casts into CSM cascade i, one instance per caster and set bit
+		/// @param cascadeStride GPU culled draws only, instances of cascade i start at firstInstance + i * cascadeStride.
+		/// Zero selects the cascade mask fan out.
+		void PushConstantShadowData(const VulkanPipeline* pPipeline, uint32_t firstInstance, uint32_t cascadeMask,
+			uint32_t cascadeStride = 0);
 
 		/// @brief Push arbitrary constants to shader stages
 		/// @param pPipeline Pipeline containing push constant layout
@@ -164,9 +249,9 @@ namespace Ailurus
 		void ExecuteSecondaryCommandBuffer(const VulkanCommandBuffer* pSecondaryCommandBuffer);
 
 	protected:
+		vk::CommandPool _commandPool;
 		vk::CommandBuffer _buffer;
 		bool _isPrimary;
 		bool _isRecording;
-		std::unordered_set<VulkanResource*> _referencedResources;
 	};
 } // namespace Ailurus
\ No newline at end of file
@@ -1,24 +0,0 @@
-#pragma once
-
-#include "VulkanContext/VulkanPch.h"
-#include <Ailurus/Systems/RenderSystem/Vertex/IndexBufferFormat.h>
-
-namespace Ailurus
-{
-	class VulkanIndexBuffer
-	{
-	public:
-		VulkanIndexBuffer(IndexBufferFormat format, const void* indexData, size_t sizeInBytes);
-		~VulkanIndexBuffer();
-
-		vk::IndexType GetIndexType() const;
-		class VulkanDeviceBuffer* GetBuffer() const;
-		size_t GetIndexCount() const;
-
-	private:
-		vk::IndexType _indexType;
-		size_t _indexCount;
-		size_t _sizeInBytes;
-		VulkanDeviceBuffer* _buffer;
-	};
-} // namespace Ailurus
@@ -0,0 +1,109 @@
+#include "VulkanStorageBuffer.h"
+#include "Ailurus/Utility/Logger.h"
+#include "VulkanContext/VulkanContext.h"
+#include "VulkanContext/Resource/VulkanResourceManager.h"
+#include "VulkanContext/Resource/DataBuffer/VulkanDeviceBuffer.h"
+#include "VulkanContext/Resource/DataBuffer/VulkanHostBuffer.h"
+#include "VulkanContext/CommandBuffer/VulkanCommandBuffer.h"
+
+namespace Ailurus
+{
+	VulkanStorageBuffer::VulkanStorageBuffer(size_t initialCapacity, DeviceBufferUsage usage)
+		: _initialCapacity(initialCapacity)
+		, _usage(usage)
+	{
+		for (auto i = 0; i < VulkanContext::GetParallelFrameCount(); i++)
+			_backgroundBuffer.emplace_back(CreateBufferPair(_initialCapacity));
+	}
+
+	VulkanStorageBuffer::~VulkanStorageBuffer()
+	{
+		if (_currentBuffer.has_value())
+			DestroyBufferPair(*_currentBuffer);
+
+		for (const auto& bufferPair : _backgroundBuffer)
+			DestroyBufferPair(bufferPair);
+	}
+
+	void* VulkanStorageBuffer::BeginFrame(size_t dataSize)
+	{
+		// Last frame's pair stays queued until the frame using it has finished
+		if (_currentBuffer.has_value())
+		{
+			_backgroundBuffer.push_back(*_currentBuffer);
+			_currentBuffer.reset();
+		}
+
+		auto& oldestBuffer = _backgroundBuffer.front();
+		if (oldestBuffer.lastUsedFrame <= VulkanContext::GetCompletedFrameNumber())
+		{
+			_currentBuffer = oldestBuffer;
+			_backgroundBuffer.pop_front();
+
+			if (_currentBuffer->capacity < dataSize)
+			{
+				DestroyBufferPair(*_currentBuffer);
+				_currentBuffer.reset();
+			}
+		}
+
+		if (!_currentBuffer.has_value())
+		{
+			// Grow geometrically so a slowly increasing scene does not reallocate every frame
+			size_t capacity = _initialCapacity;
+			while (capacity < dataSize)
+				capacity *= 2;
+
+			_currentBuffer = CreateBufferPair(capacity);
+		}
+
+		if (_currentBuffer->cpuBuffer == nullptr || _currentBuffer->gpuBuffer == nullptr)
+		{
+			Logger::LogError("Failed to create storage buffer of {} bytes", _currentBuffer->capacity);
+			_dataSize = 0;
+			return nullptr;
+		}
+
+		_currentBuffer->lastUsedFrame = VulkanContext::GetFrameNumber();
+		_dataSize = dataSize;
+		return _currentBuffer->cpuBuffer->mappedAddr;
+	}
+
+	void VulkanStorageBuffer::TransitionDataToGpu(VulkanCommandBuffer* pCommandBuffer, vk::PipelineStageFlags dstStageMask,
+		vk::AccessFlags dstAccessMask)
+	{
+		if (!_currentBuffer.has_value() || _dataSize == 0)
+			return;
+
+		pCommandBuffer->CopyBuffer(_currentBuffer->cpuBuffer, _currentBuffer->gpuBuffer, _dataSize);
+		pCommandBuffer->BufferMemoryBarrier(_currentBuffer->gpuBuffer, vk::AccessFlagBits::eTransferWrite,
+			dstAccessMask, vk::PipelineStageFlagBits::eTransfer, dstStageMask);
+	}
+
+	VulkanDeviceBuffer* VulkanStorageBuffer::GetThisFrameDeviceBuffer() const
+	{
+		return _currentBuffer.has_value() ? _currentBuffer->gpuBuffer : nullptr;
+	}
+
+	size_t VulkanStorageBuffer::GetDataSize() const
+	{
+		return _dataSize;
+	}
+
+	VulkanStorageBuffer::BufferPair VulkanStorageBuffer::CreateBufferPair(size_t capacity) const
+	{
+		auto pVkResMgr = VulkanContext::GetResourceManager();
+		auto cpuBuffer = pVkResMgr->CreateHostBuffer(capacity, HostBufferUsage::TransferSrc);
+		auto gpuBuffer = pVkResMgr->CreateDeviceBuffer(capacity, _usage);
+		return { cpuBuffer, gpuBuffer, capacity, 0 };
+	}
+
+	void VulkanStorageBuffer::DestroyBufferPair(const BufferPair& bufferPair)
+	{
+		if (bufferPair.cpuBuffer != nullptr)
+			bufferPair.cpuBuffer->MarkDelete();
+
+		if (bufferPair.gpuBuffer != nullptr)
+			bufferPair.gpuBuffer->MarkDelete();
+	}
+} // namespace Ailurus
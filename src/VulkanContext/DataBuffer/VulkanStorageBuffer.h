@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include "VulkanContext/VulkanPch.h"
+#include "VulkanContext/Resource/DataBuffer/DeviceBufferUsage.h"
+
+namespace Ailurus
+{
+	class VulkanHostBuffer;
+	class VulkanDeviceBuffer;
+	class VulkanCommandBuffer;
+
+	/// Per frame storage buffer written by the cpu and copied to device memory before use.
+	/// Buffer pairs are recycled once the frame that last used them has finished and grow on demand.
+	class VulkanStorageBuffer
+	{
+		struct BufferPair
+		{
+			VulkanHostBuffer* cpuBuffer;
+			VulkanDeviceBuffer* gpuBuffer;
+			size_t capacity;
+			uint64_t lastUsedFrame;
+		};
+
+	public:
+		explicit VulkanStorageBuffer(size_t initialCapacity, DeviceBufferUsage usage = DeviceBufferUsage::Storage);
+		~VulkanStorageBuffer();
+
+	public:
+		/// Switch to a free buffer pair of at least dataSize bytes and return its mapped memory
+		void* BeginFrame(size_t dataSize);
+		void TransitionDataToGpu(VulkanCommandBuffer* pCommandBuffer, vk::PipelineStageFlags dstStageMask,
+			vk::AccessFlags dstAccessMask = vk::AccessFlagBits::eShaderRead);
+		VulkanDeviceBuffer* GetThisFrameDeviceBuffer() const;
+		size_t GetDataSize() const;
+
+	private:
+		BufferPair CreateBufferPair(size_t capacity) const;
+		static void DestroyBufferPair(const BufferPair& bufferPair);
+
+	private:
+		size_t _initialCapacity;
+		DeviceBufferUsage _usage;
+		size_t _dataSize = 0;
+		std::optional<BufferPair> _currentBuffer;
+		std::deque<BufferPair> _backgroundBuffer;
+	};
+} // namespace Ailurus
@@ -0,0 +1,96 @@
+#include "VulkanUniformRingBuffer.h"
+#include <algorithm>
+#include "Ailurus/Utility/Logger.h"
+#include "VulkanContext/VulkanContext.h"
+#include "VulkanContext/Resource/VulkanResourceManager.h"
+#include "VulkanContext/Resource/DataBuffer/VulkanHostBuffer.h"
+
+namespace Ailurus
+{
+	static size_t AlignUp(size_t value, size_t alignment)
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	VulkanUniformRingBuffer::VulkanUniformRingBuffer(size_t initialCapacity)
+	{
+		_blocks.push_back(CreateBlock(initialCapacity));
+	}
+
+	VulkanUniformRingBuffer::~VulkanUniformRingBuffer()
+	{
+		for (const auto& block : _blocks)
+			DestroyBlock(block);
+	}
+
+	void VulkanUniformRingBuffer::Reset()
+	{
+		// Last frame overflowed, size the ring for all of it
+		if (_blocks.size() > 1)
+		{
+			size_t capacity = 0;
+			for (const auto& block : _blocks)
+			{
+				capacity += block.capacity;
+				DestroyBlock(block);
+			}
+
+			_blocks.clear();
+			_blocks.push_back(CreateBlock(capacity));
+		}
+
+		_blocks.front().used = 0;
+		_usedSize = 0;
+	}
+
+	VulkanUniformRingBuffer::Allocation VulkanUniformRingBuffer::Allocate(uint32_t size)
+	{
+		const size_t alignment = GetOffsetAlignment();
+
+		Block* pBlock = &_blocks.back();
+		size_t offset = AlignUp(pBlock->used, alignment);
+		if (pBlock->pBuffer == nullptr || offset + size > pBlock->capacity)
+		{
+			// Slices already handed out stay where they are, continue in a new block
+			_blocks.push_back(CreateBlock(std::max(pBlock->capacity * 2, AlignUp(size, alignment))));
+			pBlock = &_blocks.back();
+			offset = 0;
+		}
+
+		if (pBlock->pBuffer == nullptr)
+		{
+			Logger::LogError("Failed to allocate {} bytes of uniform ring memory", size);
+			return {};
+		}
+
+		_usedSize += offset + size - pBlock->used;
+		pBlock->used = offset + size;
+
+		return Allocation{ pBlock->pBuffer, static_cast<uint32_t>(offset),
+			static_cast<uint8_t*>(pBlock->pBuffer->mappedAddr) + offset };
+	}
+
+	size_t VulkanUniformRingBuffer::GetUsedSize() const
+	{
+		return _usedSize;
+	}
+
+	uint32_t VulkanUniformRingBuffer::GetOffsetAlignment()
+	{
+		static const uint32_t alignment = std::max<uint32_t>(16,
+			static_cast<uint32_t>(VulkanContext::GetPhysicalDevice().getProperties().limits.minUniformBufferOffsetAlignment));
+		return alignment;
+	}
+
+	VulkanUniformRingBuffer::Block VulkanUniformRingBuffer::CreateBlock(size_t capacity)
+	{
+		auto* pBuffer = VulkanContext::GetResourceManager()->CreateHostBuffer(capacity, HostBufferUsage::Uniform);
+		return Block{ pBuffer, capacity, 0 };
+	}
+
+	void VulkanUniformRingBuffer::DestroyBlock(const Block& block)
+	{
+		if (block.pBuffer != nullptr)
+			block.pBuffer->MarkDelete();
+	}
+} // namespace Ailurus
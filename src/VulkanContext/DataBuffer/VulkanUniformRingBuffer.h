@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "VulkanContext/VulkanPch.h"
+#include "Ailurus/Utility/NonCopyable.h"
+#include "Ailurus/Utility/NonMovable.h"
+
+namespace Ailurus
+{
+	class VulkanHostBuffer;
+
+	/// Linear allocator over persistently mapped uniform memory, one per frame in flight. Slices
+	/// are bound through dynamic uniform buffer offsets and written in place, so uniform data needs
+	/// no copy commands or barriers. The memory is device local when the device exposes host visible
+	/// device local memory. A frame that runs out continues in an extra block, and the next Reset
+	/// folds all blocks into one large enough for the whole frame.
+	class VulkanUniformRingBuffer : public NonCopyable, public NonMovable
+	{
+	public:
+		struct Allocation
+		{
+			VulkanHostBuffer* pBuffer = nullptr;
+			uint32_t offset = 0;		// Dynamic offset of the slice in pBuffer
+			void* pData = nullptr;		// Mapped address of the slice, nullptr when the allocation failed
+		};
+
+	public:
+		explicit VulkanUniformRingBuffer(size_t initialCapacity);
+		~VulkanUniformRingBuffer();
+
+	public:
+		/// Start over, only once the GPU has finished the frame that last used this ring
+		void Reset();
+
+		/// Slice of size bytes aligned for a dynamic uniform buffer offset
+		Allocation Allocate(uint32_t size);
+
+		/// Bytes handed out this frame, alignment padding included
+		size_t GetUsedSize() const;
+
+		/// minUniformBufferOffsetAlignment of the device, at least 16 for std140
+		static uint32_t GetOffsetAlignment();
+
+	private:
+		struct Block
+		{
+			VulkanHostBuffer* pBuffer;
+			size_t capacity;
+			size_t used;
+		};
+
+		static Block CreateBlock(size_t capacity);
+		static void DestroyBlock(const Block& block);
+
+	private:
+		// The first block is the ring's own memory, the others only live until the next Reset
+		std::vector<Block> _blocks;
+		size_t _usedSize = 0;
+	};
+} // namespace Ailurus
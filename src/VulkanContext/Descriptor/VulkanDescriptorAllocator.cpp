@@ -9,8 +9,10 @@ namespace Ailurus
 		PoolCapacity capacity;
 		capacity.setsNum = 200;
 		capacity.SetCount(vk::DescriptorType::eUniformBuffer, 400);
+		capacity.SetCount(vk::DescriptorType::eUniformBufferDynamic, 400);
 		capacity.SetCount(vk::DescriptorType::eSampledImage, 400);
 		capacity.SetCount(vk::DescriptorType::eCombinedImageSampler, 400);
+		capacity.SetCount(vk::DescriptorType::eStorageBuffer, 200);
 		return capacity;
 	}();
 
@@ -7,7 +7,8 @@
 
 namespace Ailurus
 {
-	VulkanDescriptorSetLayout::VulkanDescriptorSetLayout(UniformSet* pUniformSet, const std::vector<TextureBindingInfo>& textureBindings)
+	VulkanDescriptorSetLayout::VulkanDescriptorSetLayout(UniformSet* pUniformSet, const std::vector<TextureBindingInfo>& textureBindings,
+		const std::vector<StorageBufferBindingInfo>& storageBufferBindings)
 	{
 		std::vector<vk::DescriptorSetLayoutBinding> layoutBindings;
 
@@ -15,7 +16,7 @@ namespace Ailurus
 		const auto& allBindingPoints = pUniformSet->GetAllBindingPoints();
 		for (const auto& [bindingId, pBindingPoint]: allBindingPoints)
 		{
-			_requirement[vk::DescriptorType::eUniformBuffer]++;
+			_requirement[vk::DescriptorType::eUniformBufferDynamic]++;
 
 			vk::ShaderStageFlags usedShaderStage;
 			const auto& shaderStages = pBindingPoint->GetUsingStages();
@@ -26,7 +27,7 @@ namespace Ailurus
 			bindingInfo.setBinding(bindingId)
 				.setStageFlags(usedShaderStage)
 				.setDescriptorCount(1)	// Uniform buffers count (always one because we use dynamic offset)
-				.setDescriptorType(vk::DescriptorType::eUniformBuffer);
+				.setDescriptorType(vk::DescriptorType::eUniformBufferDynamic);
 
 			layoutBindings.push_back(bindingInfo);
 		}
@@ -45,6 +46,20 @@ namespace Ailurus
 			layoutBindings.push_back(bindingInfo);
 		}
 
+		// Add storage buffer bindings
+		for (const auto& storageBufferBinding : storageBufferBindings)
+		{
+			_requirement[vk::DescriptorType::eStorageBuffer]++;
+
+			vk::DescriptorSetLayoutBinding bindingInfo;
+			bindingInfo.setBinding(storageBufferBinding.bindingId)
+				.setStageFlags(storageBufferBinding.shaderStages)
+				.setDescriptorCount(1)
+				.setDescriptorType(vk::DescriptorType::eStorageBuffer);
+
+			layoutBindings.push_back(bindingInfo);
+		}
+
 		vk::DescriptorSetLayoutCreateInfo layoutInfo;
 		layoutInfo.setBindings(layoutBindings);
 
@@ -88,6 +103,30 @@ namespace Ailurus
 		}
 	}
 
+	VulkanDescriptorSetLayout::VulkanDescriptorSetLayout(const std::vector<vk::DescriptorSetLayoutBinding>& bindings,
+		const std::vector<vk::DescriptorBindingFlags>& bindingFlags, vk::DescriptorSetLayoutCreateFlags createFlags)
+	{
+		for (const auto& binding : bindings)
+			_requirement[binding.descriptorType] += binding.descriptorCount;
+
+		vk::DescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo;
+		bindingFlagsInfo.setBindingFlags(bindingFlags);
+
+		vk::DescriptorSetLayoutCreateInfo layoutInfo;
+		layoutInfo.setBindings(bindings)
+			.setFlags(createFlags)
+			.setPNext(&bindingFlagsInfo);
+
+		try
+		{
+			_descriptorSetLayout = VulkanContext::GetDevice().createDescriptorSetLayout(layoutInfo);
+		}
+		catch (const vk::SystemError& e)
+		{
+			Logger::LogError("Failed to create descriptor set layout: {}", e.what());
+		}
+	}
+
 	vk::DescriptorSetLayout VulkanDescriptorSetLayout::GetDescriptorSetLayout() const
 	{
 		return _descriptorSetLayout;
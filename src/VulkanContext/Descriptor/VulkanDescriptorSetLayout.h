@@ -15,11 +15,22 @@ namespace Ailurus
 		vk::ShaderStageFlags shaderStages;
 	};
 
+	// Structure to hold storage buffer binding information
+	struct StorageBufferBindingInfo
+	{
+		uint32_t bindingId;
+		vk::ShaderStageFlags shaderStages;
+	};
+
 	class VulkanDescriptorSetLayout: public NonCopyable, public NonMovable
 	{
 	public:
-		explicit VulkanDescriptorSetLayout(class UniformSet* pUniformSet, const std::vector<TextureBindingInfo>& textureBindings = {});
+		explicit VulkanDescriptorSetLayout(class UniformSet* pUniformSet, const std::vector<TextureBindingInfo>& textureBindings = {},
+			const std::vector<StorageBufferBindingInfo>& storageBufferBindings = {});
 		explicit VulkanDescriptorSetLayout(const std::vector<vk::DescriptorSetLayoutBinding>& bindings);
+		// Descriptor indexing layouts, bindingFlags has one entry per binding
+		VulkanDescriptorSetLayout(const std::vector<vk::DescriptorSetLayoutBinding>& bindings,
+			const std::vector<vk::DescriptorBindingFlags>& bindingFlags, vk::DescriptorSetLayoutCreateFlags createFlags);
 		~VulkanDescriptorSetLayout();
 
 	public:
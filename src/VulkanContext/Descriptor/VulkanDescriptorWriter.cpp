@@ -47,6 +47,11 @@ namespace Ailurus
 	}
 
 	VulkanDescriptorWriter& VulkanDescriptorWriter::WriteImage(uint32_t binding, vk::ImageView imageView, vk::Sampler sampler, vk::ImageLayout imageLayout)
+	{
+		return WriteImageArrayElement(binding, 0, imageView, sampler, imageLayout);
+	}
+
+	VulkanDescriptorWriter& VulkanDescriptorWriter::WriteImageArrayElement(uint32_t binding, uint32_t arrayElement, vk::ImageView imageView, vk::Sampler sampler, vk::ImageLayout imageLayout)
 	{
 		vk::DescriptorImageInfo imageInfo;
 		imageInfo.setImageView(imageView)
@@ -57,7 +62,7 @@ namespace Ailurus
 
 		vk::WriteDescriptorSet write;
 		write.setDstBinding(binding)
-			.setDstArrayElement(0)
+			.setDstArrayElement(arrayElement)
 			.setDescriptorType(vk::DescriptorType::eCombinedImageSampler)
 			.setDescriptorCount(1)
 			.setImageInfo(_imageInfos.back());
@@ -35,6 +35,14 @@ namespace Ailurus
 		/// @param imageLayout Layout of the image
 		auto WriteImage(uint32_t binding, vk::ImageView imageView, vk::Sampler sampler, vk::ImageLayout imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal) -> VulkanDescriptorWriter&;
 
+		/// @brief Write one element of a combined image sampler array binding
+		/// @param binding Binding point in the descriptor set
+		/// @param arrayElement Index into the array of the binding
+		/// @param imageView Image view to bind
+		/// @param sampler Sampler to use
+		/// @param imageLayout Layout of the image
+		auto WriteImageArrayElement(uint32_t binding, uint32_t arrayElement, vk::ImageView imageView, vk::Sampler sampler, vk::ImageLayout imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal) -> VulkanDescriptorWriter&;
+
 		/// @brief Write a storage buffer binding
 		/// @param binding Binding point in the descriptor set
 		/// @param buffer Vulkan buffer handle
@@ -0,0 +1,124 @@
+#include "VulkanPersistentDescriptorAllocator.h"
+#include <array>
+#include <algorithm>
+#include "VulkanDescriptorSetLayout.h"
+#include "VulkanContext/VulkanContext.h"
+#include "Ailurus/Utility/Logger.h"
+
+namespace Ailurus
+{
+	VulkanPersistentDescriptorAllocator::VulkanPersistentDescriptorAllocator() = default;
+
+	VulkanPersistentDescriptorAllocator::~VulkanPersistentDescriptorAllocator()
+	{
+		// Destroying a pool frees its sets
+		for (const auto pool : _pools)
+			VulkanContext::GetDevice().destroyDescriptorPool(pool);
+	}
+
+	auto VulkanPersistentDescriptorAllocator::Allocate(const VulkanDescriptorSetLayout* pSetLayout) -> Allocation
+	{
+		const vk::DescriptorSetLayout layout = pSetLayout->GetDescriptorSetLayout();
+
+		// Newest pools are the most likely to have room
+		for (size_t i = _pools.size(); i > 0; i--)
+		{
+			if (const auto set = TryAllocate(_pools[i - 1], layout))
+			{
+				_liveSetCount++;
+				return Allocation{ set, static_cast<uint32_t>(i - 1) };
+			}
+		}
+
+		const auto pool = CreatePool();
+		if (!pool)
+			return {};
+
+		_pools.push_back(pool);
+		const auto set = TryAllocate(pool, layout);
+		if (!set)
+		{
+			Logger::LogError("Failed to allocate a persistent descriptor set from a new pool");
+			return {};
+		}
+
+		_liveSetCount++;
+		return Allocation{ set, static_cast<uint32_t>(_pools.size() - 1) };
+	}
+
+	auto VulkanPersistentDescriptorAllocator::Free(const Allocation& allocation) -> void
+	{
+		if (!allocation.set)
+			return;
+
+		_pendingFrees.push_back(PendingFree{ allocation, VulkanContext::GetFrameNumber() });
+	}
+
+	auto VulkanPersistentDescriptorAllocator::GarbageCollect() -> void
+	{
+		const uint64_t completedFrame = VulkanContext::GetCompletedFrameNumber();
+		std::erase_if(_pendingFrees, [this, completedFrame](const PendingFree& pending) -> bool {
+			if (pending.retireFrame > completedFrame)
+				return false;
+
+			try
+			{
+				VulkanContext::GetDevice().freeDescriptorSets(_pools[pending.allocation.poolIndex], pending.allocation.set);
+			}
+			catch (const vk::SystemError& e)
+			{
+				Logger::LogError("Failed to free persistent descriptor set: {}", e.what());
+			}
+
+			_liveSetCount--;
+			return true;
+		});
+	}
+
+	auto VulkanPersistentDescriptorAllocator::GetLiveSetCount() const -> size_t
+	{
+		return _liveSetCount;
+	}
+
+	auto VulkanPersistentDescriptorAllocator::CreatePool() -> vk::DescriptorPool
+	{
+		const std::array poolSizes = {
+			vk::DescriptorPoolSize(vk::DescriptorType::eUniformBufferDynamic, POOL_MAX_SETS),
+			vk::DescriptorPoolSize(vk::DescriptorType::eStorageBuffer, POOL_MAX_SETS),
+			vk::DescriptorPoolSize(vk::DescriptorType::eCombinedImageSampler, POOL_MAX_SETS * 4),
+		};
+
+		vk::DescriptorPoolCreateInfo poolCreateInfo;
+		poolCreateInfo.setPoolSizes(poolSizes)
+			.setMaxSets(POOL_MAX_SETS)
+			.setFlags(vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet);
+
+		try
+		{
+			return VulkanContext::GetDevice().createDescriptorPool(poolCreateInfo);
+		}
+		catch (const vk::SystemError& e)
+		{
+			Logger::LogError("Failed to create persistent descriptor pool: {}", e.what());
+			return nullptr;
+		}
+	}
+
+	auto VulkanPersistentDescriptorAllocator::TryAllocate(vk::DescriptorPool pool, vk::DescriptorSetLayout layout) -> vk::DescriptorSet
+	{
+		vk::DescriptorSetAllocateInfo allocateInfo;
+		allocateInfo.setDescriptorPool(pool)
+			.setDescriptorSetCount(1)
+			.setSetLayouts(layout);
+
+		// Out of pool memory or fragmented, the caller moves on to another pool
+		try
+		{
+			return VulkanContext::GetDevice().allocateDescriptorSets(allocateInfo)[0];
+		}
+		catch (const vk::SystemError&)
+		{
+			return nullptr;
+		}
+	}
+} // namespace Ailurus
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "VulkanContext/VulkanPch.h"
+#include <Ailurus/Utility/NonCopyable.h>
+#include <Ailurus/Utility/NonMovable.h>
+
+namespace Ailurus
+{
+	class VulkanDescriptorSetLayout;
+
+	/// Long lived descriptor sets, never reset with the frame. Sets are freed one by one, and
+	/// only once every frame in flight that may have bound them has finished.
+	class VulkanPersistentDescriptorAllocator : public NonCopyable, public NonMovable
+	{
+	public:
+		struct Allocation
+		{
+			vk::DescriptorSet set = nullptr;
+			uint32_t poolIndex = 0;
+		};
+
+	public:
+		VulkanPersistentDescriptorAllocator();
+		~VulkanPersistentDescriptorAllocator();
+
+	public:
+		auto Allocate(const VulkanDescriptorSetLayout* pSetLayout) -> Allocation;
+		auto Free(const Allocation& allocation) -> void;
+
+		/// Return the sets freed before the last completed frame to their pools
+		auto GarbageCollect() -> void;
+
+		auto GetLiveSetCount() const -> size_t;
+
+	private:
+		static auto CreatePool() -> vk::DescriptorPool;
+		static auto TryAllocate(vk::DescriptorPool pool, vk::DescriptorSetLayout layout) -> vk::DescriptorSet;
+
+	private:
+		static constexpr uint32_t POOL_MAX_SETS = 256;
+
+		struct PendingFree
+		{
+			Allocation allocation;
+			uint64_t retireFrame;
+		};
+
+		std::vector<vk::DescriptorPool> _pools;
+		std::vector<PendingFree> _pendingFrees;
+		size_t _liveSetCount = 0;
+	};
+} // namespace Ailurus
@@ -0,0 +1,57 @@
+#include "VulkanPersistentDescriptorSet.h"
+#include "VulkanContext/VulkanContext.h"
+#include "Ailurus/Utility/Logger.h"
+
+namespace Ailurus
+{
+	VulkanPersistentDescriptorSet::VulkanPersistentDescriptorSet(const VulkanDescriptorSetLayout* pSetLayout)
+		: _pSetLayout(pSetLayout)
+		, _frameSets(VulkanContext::GetParallelFrameCount())
+	{
+	}
+
+	VulkanPersistentDescriptorSet::~VulkanPersistentDescriptorSet()
+	{
+		// The allocator is gone with the context, and its pools with every set
+		auto* pAllocator = VulkanContext::GetPersistentDescriptorAllocator();
+		if (pAllocator == nullptr)
+			return;
+
+		for (const auto& frameSet : _frameSets)
+			pAllocator->Free(frameSet.allocation);
+	}
+
+	auto VulkanPersistentDescriptorSet::Acquire() -> VulkanDescriptorSet
+	{
+		auto& frameSet = _frameSets[VulkanContext::GetCurrentParallelFrameIndex()];
+		if (!frameSet.allocation.set)
+		{
+			frameSet.allocation = VulkanContext::GetPersistentDescriptorAllocator()->Allocate(_pSetLayout);
+			frameSet.groupHashes.fill(std::nullopt);
+		}
+
+		return frameSet.allocation.set;
+	}
+
+	auto VulkanPersistentDescriptorSet::NeedsWrite(uint32_t group, size_t bindingHash) -> bool
+	{
+		if (group >= MAX_BINDING_GROUPS)
+		{
+			Logger::LogError("Descriptor binding group {} exceeds the limit of {}", group, MAX_BINDING_GROUPS);
+			return true;
+		}
+
+		auto& groupHash = _frameSets[VulkanContext::GetCurrentParallelFrameIndex()].groupHashes[group];
+		if (groupHash == bindingHash)
+			return false;
+
+		groupHash = bindingHash;
+		return true;
+	}
+
+	auto VulkanPersistentDescriptorSet::Invalidate() -> void
+	{
+		for (auto& frameSet : _frameSets)
+			frameSet.groupHashes.fill(std::nullopt);
+	}
+} // namespace Ailurus
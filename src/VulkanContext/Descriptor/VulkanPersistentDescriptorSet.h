@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "VulkanDescriptorSet.h"
+#include "VulkanPersistentDescriptorAllocator.h"
+#include <Ailurus/Utility/NonCopyable.h>
+#include <Ailurus/Utility/NonMovable.h>
+
+namespace Ailurus
+{
+	class VulkanDescriptorSetLayout;
+
+	/// A descriptor set kept across frames, one per frame in flight so a set is never written while
+	/// the GPU may still read it. Bindings are written in groups: the owner hashes the resources of
+	/// a group and only writes it when the hash differs from what that frame's set holds.
+	class VulkanPersistentDescriptorSet : public NonCopyable, public NonMovable
+	{
+	public:
+		static constexpr uint32_t MAX_BINDING_GROUPS = 8;
+
+		explicit VulkanPersistentDescriptorSet(const VulkanDescriptorSetLayout* pSetLayout);
+		~VulkanPersistentDescriptorSet();
+
+	public:
+		/// Set of the frame being recorded, allocated the first time
+		auto Acquire() -> VulkanDescriptorSet;
+
+		/// Whether the bindings of the group in this frame's set have to be written for the resources
+		/// hashed to bindingHash. The hash is taken as written, the caller writes the group right away.
+		auto NeedsWrite(uint32_t group, size_t bindingHash) -> bool;
+
+		/// Rewrite every group of every frame's set, for a bound resource recreated behind the same hash
+		auto Invalidate() -> void;
+
+	private:
+		struct FrameSet
+		{
+			VulkanPersistentDescriptorAllocator::Allocation allocation;
+			std::array<std::optional<size_t>, MAX_BINDING_GROUPS> groupHashes;
+		};
+
+		const VulkanDescriptorSetLayout* _pSetLayout;
+		std::vector<FrameSet> _frameSets;
+	};
+} // namespace Ailurus
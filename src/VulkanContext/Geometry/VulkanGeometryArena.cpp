@@ -0,0 +1,160 @@
+#include <algorithm>
+#include "VulkanGeometryArena.h"
+#include "Ailurus/Utility/Logger.h"
+#include "VulkanContext/VulkanContext.h"
+#include "VulkanContext/Resource/VulkanResourceManager.h"
+#include "VulkanContext/Resource/DataBuffer/VulkanDeviceBuffer.h"
+#include "VulkanContext/Upload/VulkanUploadManager.h"
+
+namespace Ailurus
+{
+	VulkanGeometryArena::VulkanGeometryArena(uint32_t vertexStride)
+		: _vertexStride(vertexStride)
+	{
+		_vertexRegion.elementSize = vertexStride;
+		_vertexRegion.usage = DeviceBufferUsage::Vertex;
+
+		_indexRegion.elementSize = sizeof(uint32_t);
+		_indexRegion.usage = DeviceBufferUsage::Index;
+	}
+
+	VulkanGeometryArena::~VulkanGeometryArena()
+	{
+		if (_vertexRegion.pBuffer != nullptr)
+			_vertexRegion.pBuffer->MarkDelete();
+
+		if (_indexRegion.pBuffer != nullptr)
+			_indexRegion.pBuffer->MarkDelete();
+	}
+
+	uint32_t VulkanGeometryArena::AllocateVertices(const void* vertexData, uint32_t vertexCount)
+	{
+		return Allocate(_vertexRegion, vertexData, vertexCount);
+	}
+
+	uint32_t VulkanGeometryArena::AllocateIndices(IndexBufferFormat format, const void* indexData, uint32_t indexCount)
+	{
+		if (format == IndexBufferFormat::UInt32)
+			return Allocate(_indexRegion, indexData, indexCount);
+
+		if (format != IndexBufferFormat::UInt16)
+		{
+			Logger::LogError("Index buffer type {} does not have related vulkan type",
+				EnumReflection<IndexBufferFormat>::ToString(format));
+			return RangeAllocator::INVALID_OFFSET;
+		}
+
+		// Widen to the arena's index type
+		const auto* pSource = static_cast<const uint16_t*>(indexData);
+		std::vector<uint32_t> widened(pSource, pSource + indexCount);
+		return Allocate(_indexRegion, widened.data(), indexCount);
+	}
+
+	void VulkanGeometryArena::FreeVertices(uint32_t vertexOffset, uint32_t vertexCount)
+	{
+		Free(_vertexRegion, vertexOffset, vertexCount);
+	}
+
+	void VulkanGeometryArena::FreeIndices(uint32_t firstIndex, uint32_t indexCount)
+	{
+		Free(_indexRegion, firstIndex, indexCount);
+	}
+
+	void VulkanGeometryArena::GarbageCollect()
+	{
+		const uint64_t completedFrame = VulkanContext::GetCompletedFrameNumber();
+		std::erase_if(_pendingFrees, [completedFrame](const PendingFree& pending) -> bool {
+			if (pending.retireFrame > completedFrame)
+				return false;
+
+			pending.pRegion->allocator.Free(pending.offset, pending.size);
+			return true;
+		});
+	}
+
+	uint32_t VulkanGeometryArena::GetVertexStride() const
+	{
+		return _vertexStride;
+	}
+
+	VulkanDeviceBuffer* VulkanGeometryArena::GetVertexBuffer() const
+	{
+		return _vertexRegion.pBuffer;
+	}
+
+	VulkanDeviceBuffer* VulkanGeometryArena::GetIndexBuffer() const
+	{
+		return _indexRegion.pBuffer;
+	}
+
+	uint32_t VulkanGeometryArena::Allocate(Region& region, const void* data, uint32_t count)
+	{
+		if (data == nullptr || count == 0)
+			return RangeAllocator::INVALID_OFFSET;
+
+		uint32_t offset = region.allocator.Allocate(count);
+		if (offset == RangeAllocator::INVALID_OFFSET)
+		{
+			if (!Grow(region, region.allocator.GetCapacity() + count))
+				return RangeAllocator::INVALID_OFFSET;
+
+			offset = region.allocator.Allocate(count);
+			if (offset == RangeAllocator::INVALID_OFFSET)
+				return RangeAllocator::INVALID_OFFSET;
+		}
+
+		const vk::DeviceSize sizeInBytes = static_cast<vk::DeviceSize>(count) * region.elementSize;
+		const vk::DeviceSize offsetInBytes = static_cast<vk::DeviceSize>(offset) * region.elementSize;
+
+		// Staged and copied by the transfer queue, the next frame waits for it
+		if (VulkanContext::GetUploadManager()->UploadBuffer(region.pBuffer, offsetInBytes, data, sizeInBytes) == 0)
+		{
+			region.allocator.Free(offset, count);
+			return RangeAllocator::INVALID_OFFSET;
+		}
+
+		return offset;
+	}
+
+	bool VulkanGeometryArena::Grow(Region& region, uint32_t minCapacity)
+	{
+		const uint32_t initialCapacity = region.usage == DeviceBufferUsage::Vertex
+			? INITIAL_VERTEX_CAPACITY : INITIAL_INDEX_CAPACITY;
+
+		const uint32_t oldCapacity = region.allocator.GetCapacity();
+		const uint32_t newCapacity = std::max({ minCapacity, oldCapacity * 2, initialCapacity });
+
+		auto pNewBuffer = VulkanContext::GetResourceManager()->CreateDeviceBuffer(
+			static_cast<vk::DeviceSize>(newCapacity) * region.elementSize, region.usage);
+		if (pNewBuffer == nullptr)
+		{
+			Logger::LogError("VulkanGeometryArena: Failed to grow buffer to {} elements", newCapacity);
+			return false;
+		}
+
+		// Live ranges keep their offsets, carry the old content over. The copy goes through the
+		// upload batch, so it lands after earlier uploads into the old buffer and before later ones.
+		if (region.pBuffer != nullptr)
+		{
+			auto pOldBuffer = region.pBuffer;
+			VulkanContext::GetUploadManager()->CopyBuffer(pOldBuffer, pNewBuffer,
+				static_cast<vk::DeviceSize>(oldCapacity) * region.elementSize);
+
+			// Frames in flight and the copy above still hold references
+			pOldBuffer->MarkDelete();
+		}
+
+		region.pBuffer = pNewBuffer;
+		region.allocator.Grow(newCapacity);
+		return true;
+	}
+
+	void VulkanGeometryArena::Free(Region& region, uint32_t offset, uint32_t size)
+	{
+		if (offset == RangeAllocator::INVALID_OFFSET || size == 0)
+			return;
+
+		// The frame being recorded may draw from this range, an upload into it must wait until that frame completed
+		_pendingFrees.push_back(PendingFree{ &region, offset, size, VulkanContext::GetFrameNumber() });
+	}
+} // namespace Ailurus
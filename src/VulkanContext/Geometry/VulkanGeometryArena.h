@@ -0,0 +1,79 @@
+#pragma once
+
+#include <vector>
+#include "VulkanContext/VulkanPch.h"
+#include <Ailurus/Utility/NonCopyable.h>
+#include <Ailurus/Utility/NonMovable.h>
+#include <Ailurus/Container/RangeAllocator.hpp>
+#include <Ailurus/Systems/RenderSystem/Vertex/IndexBufferFormat.h>
+#include "VulkanContext/Resource/DataBuffer/DeviceBufferUsage.h"
+
+namespace Ailurus
+{
+	class VulkanDeviceBuffer;
+
+	/// @brief Shared vertex and index storage of all meshes using one vertex layout
+	///
+	/// Meshes get a range of the arena instead of buffers of their own, so a pass binds geometry
+	/// once per layout and draws each mesh with its vertex offset and first index. Indices are
+	/// always stored as uint32, 16-bit index data is widened on upload. Buffers grow by doubling,
+	/// existing ranges are copied over and keep their offsets.
+	class VulkanGeometryArena : public NonCopyable, public NonMovable
+	{
+	public:
+		explicit VulkanGeometryArena(uint32_t vertexStride);
+		~VulkanGeometryArena();
+
+	public:
+		/// @brief Upload vertices into the arena
+		/// @return Offset in vertices, RangeAllocator::INVALID_OFFSET on failure
+		uint32_t AllocateVertices(const void* vertexData, uint32_t vertexCount);
+
+		/// @brief Upload indices into the arena, they stay relative to the mesh's own vertices
+		/// @return Offset in indices, RangeAllocator::INVALID_OFFSET on failure
+		uint32_t AllocateIndices(IndexBufferFormat format, const void* indexData, uint32_t indexCount);
+
+		/// @brief Release ranges once frames in flight can no longer read them
+		void FreeVertices(uint32_t vertexOffset, uint32_t vertexCount);
+		void FreeIndices(uint32_t firstIndex, uint32_t indexCount);
+
+		/// @brief Return released ranges whose last reader has retired, called once per frame
+		void GarbageCollect();
+
+		uint32_t GetVertexStride() const;
+		VulkanDeviceBuffer* GetVertexBuffer() const;
+		VulkanDeviceBuffer* GetIndexBuffer() const;
+		static constexpr vk::IndexType GetIndexType() { return vk::IndexType::eUint32; }
+
+	private:
+		struct Region
+		{
+			RangeAllocator allocator;
+			VulkanDeviceBuffer* pBuffer = nullptr;
+			uint32_t elementSize;
+			DeviceBufferUsage usage;
+		};
+
+		struct PendingFree
+		{
+			Region* pRegion;
+			uint32_t offset;
+			uint32_t size;
+			uint64_t retireFrame;
+		};
+
+		uint32_t Allocate(Region& region, const void* data, uint32_t count);
+		bool Grow(Region& region, uint32_t minCapacity);
+		void Free(Region& region, uint32_t offset, uint32_t size);
+
+	private:
+		static constexpr uint32_t INITIAL_VERTEX_CAPACITY = 1 << 16;
+		static constexpr uint32_t INITIAL_INDEX_CAPACITY = 1 << 18;
+
+		uint32_t _vertexStride;
+		Region _vertexRegion;
+		Region _indexRegion;
+
+		std::vector<PendingFree> _pendingFrees;
+	};
+} // namespace Ailurus
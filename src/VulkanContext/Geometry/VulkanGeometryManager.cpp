@@ -0,0 +1,30 @@
+#include "VulkanGeometryManager.h"
+#include "Ailurus/Utility/Logger.h"
+#include "VulkanContext/VulkanContext.h"
+#include "VulkanContext/Vertex/VulkanVertexLayoutManager.h"
+
+namespace Ailurus
+{
+	VulkanGeometryArena* VulkanGeometryManager::GetArena(uint64_t layoutId)
+	{
+		const auto it = _arenaMap.find(layoutId);
+		if (it != _arenaMap.end())
+			return it->second.get();
+
+		const auto pLayout = VulkanContext::GetVertexLayoutManager()->GetLayout(layoutId);
+		if (pLayout == nullptr)
+		{
+			Logger::LogError("VulkanGeometryManager: Vertex layout {} not found", layoutId);
+			return nullptr;
+		}
+
+		auto [newIt, _] = _arenaMap.emplace(layoutId, std::make_unique<VulkanGeometryArena>(pLayout->GetStride()));
+		return newIt->second.get();
+	}
+
+	void VulkanGeometryManager::GarbageCollect()
+	{
+		for (auto& [layoutId, pArena] : _arenaMap)
+			pArena->GarbageCollect();
+	}
+} // namespace Ailurus
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "VulkanContext/VulkanPch.h"
+#include <unordered_map>
+#include <memory>
+#include <Ailurus/Utility/NonCopyable.h>
+#include <Ailurus/Utility/NonMovable.h>
+#include "VulkanGeometryArena.h"
+
+namespace Ailurus
+{
+	class VulkanGeometryManager : public NonCopyable, public NonMovable
+	{
+	public:
+		/// @brief Get the arena of a vertex layout, created on first use
+		VulkanGeometryArena* GetArena(uint64_t layoutId);
+
+		void GarbageCollect();
+
+	private:
+		std::unordered_map<uint64_t, std::unique_ptr<VulkanGeometryArena>> _arenaMap;
+	};
+} // namespace Ailurus
@@ -118,6 +118,9 @@ namespace Ailurus
 			case ShaderStage::Fragment:
 				vkStage = vk::ShaderStageFlagBits::eFragment;
 				break;
+			case ShaderStage::Compute:
+				vkStage = vk::ShaderStageFlagBits::eCompute;
+				break;
 		}
 
 		return vkStage;
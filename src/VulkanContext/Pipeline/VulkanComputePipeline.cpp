@@ -0,0 +1,87 @@
+#include "VulkanComputePipeline.h"
+#include "Ailurus/Utility/Logger.h"
+#include "Ailurus/Systems/RenderSystem/Shader/Shader.h"
+#include "VulkanContext/VulkanContext.h"
+#include "VulkanContext/Shader/VulkanShader.h"
+
+namespace Ailurus
+{
+	VulkanComputePipeline::VulkanComputePipeline(
+		const Shader* pShader,
+		const std::vector<vk::DescriptorSetLayout>& descriptorSetLayouts,
+		uint32_t pushConstantSize)
+	{
+		const auto* pRHIShader = pShader != nullptr ? pShader->GetImpl() : nullptr;
+		if (pRHIShader == nullptr || !pRHIShader->IsValid())
+		{
+			Logger::LogError("Invalid shader module for compute pipeline");
+			return;
+		}
+
+		// Push constant range
+		vk::PushConstantRange pushConstantRange;
+		pushConstantRange.setStageFlags(vk::ShaderStageFlagBits::eCompute)
+			.setOffset(0)
+			.setSize(pushConstantSize);
+
+		// Create pipeline layout
+		vk::PipelineLayoutCreateInfo pipelineLayoutInfo;
+		pipelineLayoutInfo.setSetLayouts(descriptorSetLayouts);
+		if (pushConstantSize > 0)
+			pipelineLayoutInfo.setPushConstantRanges(pushConstantRange);
+
+		try
+		{
+			_vkPipelineLayout = VulkanContext::GetDevice().createPipelineLayout(pipelineLayoutInfo);
+		}
+		catch (const vk::SystemError& e)
+		{
+			Logger::LogError("Failed to create compute pipeline layout: {}", e.what());
+			return;
+		}
+
+		// Create the pipeline
+		vk::ComputePipelineCreateInfo pipelineInfo;
+		pipelineInfo.setStage(pRHIShader->GeneratePipelineCreateInfo(ShaderStage::Compute))
+			.setLayout(_vkPipelineLayout);
+
+		try
+		{
+			auto pipelineCreateResult = VulkanContext::GetDevice().createComputePipeline(VulkanContext::GetPipelineCache(), pipelineInfo);
+			if (pipelineCreateResult.result == vk::Result::eSuccess)
+				_vkPipeline = pipelineCreateResult.value;
+			else
+				Logger::LogError("Failed to create compute pipeline");
+		}
+		catch (const vk::SystemError& e)
+		{
+			Logger::LogError("Failed to create compute pipeline: {}", e.what());
+		}
+	}
+
+	VulkanComputePipeline::~VulkanComputePipeline()
+	{
+		try
+		{
+			if (_vkPipeline)
+				VulkanContext::GetDevice().destroyPipeline(_vkPipeline);
+
+			if (_vkPipelineLayout)
+				VulkanContext::GetDevice().destroyPipelineLayout(_vkPipelineLayout);
+		}
+		catch (const vk::SystemError& e)
+		{
+			Logger::LogError("Failed to destroy compute pipeline: {}", e.what());
+		}
+	}
+
+	vk::Pipeline VulkanComputePipeline::GetPipeline() const
+	{
+		return _vkPipeline;
+	}
+
+	vk::PipelineLayout VulkanComputePipeline::GetPipelineLayout() const
+	{
+		return _vkPipelineLayout;
+	}
+} // namespace Ailurus
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "VulkanContext/VulkanPch.h"
+
+namespace Ailurus
+{
+	class Shader;
+
+	class VulkanComputePipeline
+	{
+	public:
+		// Compute pipeline constructor: single compute stage, push constants visible to the compute stage
+		VulkanComputePipeline(const Shader* pShader, const std::vector<vk::DescriptorSetLayout>& descriptorSetLayouts,
+			uint32_t pushConstantSize = 0);
+		~VulkanComputePipeline();
+
+	public:
+		vk::Pipeline GetPipeline() const;
+		vk::PipelineLayout GetPipelineLayout() const;
+
+	private:
+		vk::PipelineLayout _vkPipelineLayout;
+		vk::Pipeline _vkPipeline;
+	};
+} // namespace Ailurus
@@ -2,7 +2,7 @@
 #include "Ailurus/Utility/Logger.h"
 #include "Ailurus/Application.h"
 #include "Ailurus/Systems/RenderSystem/Shader/Shader.h"
-#include "Ailurus/Systems/RenderSystem/Uniform/UniformSet.h"
+#include "Ailurus/Systems/RenderSystem/Descriptor/DescriptorSetSchema.h"
 #include "VulkanContext/VulkanContext.h"
 #include "VulkanContext/Shader/VulkanShader.h"
 #include "VulkanContext/Vertex/VulkanVertexLayout.h"
@@ -15,7 +15,7 @@ namespace Ailurus
 		vk::Format depthFormat,
 		const StageShaderArray& shaderArray,
 		const VulkanVertexLayout* pVertexLayout,
-		const std::vector<const UniformSet*>& uniformSets,
+		const std::vector<const DescriptorSetSchema*>& descriptorSetSchemas,
 		uint32_t pushConstantSize,
 		bool blendEnabled,
 		bool depthWriteEnabled)
@@ -47,13 +47,14 @@ namespace Ailurus
 
 		// Descriptor set layouts
 		std::vector<vk::DescriptorSetLayout> descriptorSetLayouts;
-		for (const auto* pUniformSet: uniformSets)
-			descriptorSetLayouts.push_back(pUniformSet->GetDescriptorSetLayout()->GetDescriptorSetLayout());
+		for (const auto* pSchema : descriptorSetSchemas)
+			descriptorSetLayouts.push_back(pSchema->GetDescriptorSetLayout()->GetDescriptorSetLayout());
 
 		// Create pipeline layout
 		vk::PipelineLayoutCreateInfo pipelineLayoutInfo;
-		pipelineLayoutInfo.setSetLayouts(descriptorSetLayouts)
-			.setPushConstantRanges(pushConstantRange);
+		pipelineLayoutInfo.setSetLayouts(descriptorSetLayouts);
+		if (pushConstantSize > 0)
+			pipelineLayoutInfo.setPushConstantRanges(pushConstantRange);
 		try
 		{
 			_vkPipelineLayout = VulkanContext::GetDevice().createPipelineLayout(pipelineLayoutInfo);
@@ -178,7 +179,7 @@ namespace Ailurus
 
 		try
 		{
-			auto pipelineCreateResult = VulkanContext::GetDevice().createGraphicsPipeline(nullptr, pipelineInfo);
+			auto pipelineCreateResult = VulkanContext::GetDevice().createGraphicsPipeline(VulkanContext::GetPipelineCache(), pipelineInfo);
 			if (pipelineCreateResult.result == vk::Result::eSuccess)
 				_vkPipeline = pipelineCreateResult.value;
 			else
@@ -208,7 +209,7 @@ namespace Ailurus
 		vk::Format depthFormat,
 		const StageShaderArray& shaderArray,
 		const VulkanVertexLayout* pVertexLayout,
-		const std::vector<const UniformSet*>& uniformSets,
+		const std::vector<const DescriptorSetSchema*>& descriptorSetSchemas,
 		uint32_t pushConstantSize)
 	{
 		// Shader stages
@@ -237,13 +238,14 @@ namespace Ailurus
 
 		// Descriptor set layouts
 		std::vector<vk::DescriptorSetLayout> descriptorSetLayouts;
-		for (const auto* pUniformSet: uniformSets)
-			descriptorSetLayouts.push_back(pUniformSet->GetDescriptorSetLayout()->GetDescriptorSetLayout());
+		for (const auto* pSchema : descriptorSetSchemas)
+			descriptorSetLayouts.push_back(pSchema->GetDescriptorSetLayout()->GetDescriptorSetLayout());
 
 		// Create pipeline layout
 		vk::PipelineLayoutCreateInfo pipelineLayoutInfo;
-		pipelineLayoutInfo.setSetLayouts(descriptorSetLayouts)
-			.setPushConstantRanges(pushConstantRange);
+		pipelineLayoutInfo.setSetLayouts(descriptorSetLayouts);
+		if (pushConstantSize > 0)
+			pipelineLayoutInfo.setPushConstantRanges(pushConstantRange);
 		try
 		{
 			_vkPipelineLayout = VulkanContext::GetDevice().createPipelineLayout(pipelineLayoutInfo);
@@ -351,7 +353,7 @@ namespace Ailurus
 
 		try
 		{
-			auto pipelineCreateResult = VulkanContext::GetDevice().createGraphicsPipeline(nullptr, pipelineInfo);
+			auto pipelineCreateResult = VulkanContext::GetDevice().createGraphicsPipeline(VulkanContext::GetPipelineCache(), pipelineInfo);
 			if (pipelineCreateResult.result == vk::Result::eSuccess)
 				_vkPipeline = pipelineCreateResult.value;
 			else
@@ -505,7 +507,7 @@ namespace Ailurus
 
 		try
 		{
-			auto pipelineCreateResult = VulkanContext::GetDevice().createGraphicsPipeline(nullptr, pipelineInfo);
+			auto pipelineCreateResult = VulkanContext::GetDevice().createGraphicsPipeline(VulkanContext::GetPipelineCache(), pipelineInfo);
 			if (pipelineCreateResult.result == vk::Result::eSuccess)
 				_vkPipeline = pipelineCreateResult.value;
 			else
@@ -659,7 +661,7 @@ namespace Ailurus
 
 		try
 		{
-			auto pipelineCreateResult = VulkanContext::GetDevice().createGraphicsPipeline(nullptr, pipelineInfo);
+			auto pipelineCreateResult = VulkanContext::GetDevice().createGraphicsPipeline(VulkanContext::GetPipelineCache(), pipelineInfo);
 			if (pipelineCreateResult.result == vk::Result::eSuccess)
 				_vkPipeline = pipelineCreateResult.value;
 			else
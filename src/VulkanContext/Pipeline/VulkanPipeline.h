@@ -7,7 +7,7 @@ namespace Ailurus
 {
 	struct StageShaderArray;
 	class VulkanVertexLayout;
-	class UniformSet;
+	class DescriptorSetSchema;
 
 	class VulkanPipeline
 	{
@@ -15,16 +15,16 @@ namespace Ailurus
 		// Standard scene pipeline constructor (opaque geometry: depth write, no blending)
 		// Pass blendEnabled=true and depthWriteEnabled=false for transparent geometry
 		VulkanPipeline(vk::Format colorFormat, vk::Format depthFormat, const StageShaderArray& shaderArray,
-			const VulkanVertexLayout* pVertexLayout, const std::vector<const UniformSet*>& uniformSets,
-			uint32_t pushConstantSize = sizeof(Matrix4x4f),
+			const VulkanVertexLayout* pVertexLayout, const std::vector<const DescriptorSetSchema*>& descriptorSetSchemas,
+			uint32_t pushConstantSize = 0,
 			bool blendEnabled = false,
 			bool depthWriteEnabled = true);
 
 		// G-Buffer pipeline constructor: multiple color attachments, depth write, no blending
 		VulkanPipeline(const std::vector<vk::Format>& colorFormats, vk::Format depthFormat,
 			const StageShaderArray& shaderArray,
-			const VulkanVertexLayout* pVertexLayout, const std::vector<const UniformSet*>& uniformSets,
-			uint32_t pushConstantSize = sizeof(Matrix4x4f));
+			const VulkanVertexLayout* pVertexLayout, const std::vector<const DescriptorSetSchema*>& descriptorSetSchemas,
+			uint32_t pushConstantSize = 0);
 
 		// Post-process pipeline constructor: no vertex input, no depth, single sample, fragment push constants
 		VulkanPipeline(vk::Format colorFormat, const StageShaderArray& shaderArray,
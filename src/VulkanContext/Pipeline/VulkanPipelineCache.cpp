@@ -0,0 +1,143 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include "VulkanPipelineCache.h"
+#include "Ailurus/Utility/File.h"
+#include "Ailurus/Utility/Logger.h"
+#include "VulkanContext/VulkanContext.h"
+
+namespace Ailurus
+{
+	VulkanPipelineCache::VulkanPipelineCache(const std::string& filePath)
+		: _filePath(filePath)
+		, _deviceProperties(VulkanContext::GetPhysicalDevice().getProperties())
+	{
+		const std::vector<char> initialData = LoadInitialData();
+
+		vk::PipelineCacheCreateInfo createInfo;
+		createInfo.setInitialDataSize(initialData.size())
+			.setPInitialData(initialData.empty() ? nullptr : initialData.data());
+
+		try
+		{
+			_vkPipelineCache = VulkanContext::GetDevice().createPipelineCache(createInfo);
+		}
+		catch (const vk::SystemError& e)
+		{
+			Logger::LogError("Failed to create pipeline cache: {}", e.what());
+			return;
+		}
+
+		if (!initialData.empty())
+			Logger::LogInfo("Pipeline cache loaded {} bytes from {}", initialData.size(), _filePath);
+	}
+
+	VulkanPipelineCache::~VulkanPipelineCache()
+	{
+		if (!_vkPipelineCache)
+			return;
+
+		Save();
+		VulkanContext::GetDevice().destroyPipelineCache(_vkPipelineCache);
+	}
+
+	auto VulkanPipelineCache::GetPipelineCache() const -> vk::PipelineCache
+	{
+		return _vkPipelineCache;
+	}
+
+	auto VulkanPipelineCache::Save() const -> bool
+	{
+		if (!_vkPipelineCache)
+			return false;
+
+		std::vector<uint8_t> data;
+		try
+		{
+			data = VulkanContext::GetDevice().getPipelineCacheData(_vkPipelineCache);
+		}
+		catch (const vk::SystemError& e)
+		{
+			Logger::LogError("Failed to get pipeline cache data: {}", e.what());
+			return false;
+		}
+
+		if (data.empty())
+			return false;
+
+		const FileHeader header = MakeFileHeader(data.size());
+
+		// Write next to the file and swap, a crash mid write must not leave a truncated cache behind
+		File::EnsureDirectoryExist(_filePath);
+		const std::string tempPath = _filePath + ".tmp";
+		{
+			std::ofstream fileStream(tempPath, std::ios::binary | std::ios::trunc);
+			if (!fileStream.is_open())
+			{
+				Logger::LogWarn("Failed to open pipeline cache file for writing: {}", tempPath);
+				return false;
+			}
+
+			fileStream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			fileStream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+			if (!fileStream.good())
+			{
+				Logger::LogWarn("Failed to write pipeline cache file: {}", tempPath);
+				return false;
+			}
+		}
+
+		std::error_code error;
+		std::filesystem::rename(tempPath, _filePath, error);
+		if (error)
+		{
+			Logger::LogWarn("Failed to replace pipeline cache file {}: {}", _filePath, error.message());
+			return false;
+		}
+
+		return true;
+	}
+
+	auto VulkanPipelineCache::MakeFileHeader(uint64_t dataSize) const -> FileHeader
+	{
+		FileHeader header{};
+		header.magic = FILE_MAGIC;
+		header.version = FILE_VERSION;
+		header.vendorId = _deviceProperties.vendorID;
+		header.deviceId = _deviceProperties.deviceID;
+		header.driverVersion = _deviceProperties.driverVersion;
+		std::memcpy(header.pipelineCacheUUID, _deviceProperties.pipelineCacheUUID.data(), VK_UUID_SIZE);
+		header.dataSize = dataSize;
+		return header;
+	}
+
+	auto VulkanPipelineCache::LoadInitialData() const -> std::vector<char>
+	{
+		auto fileContent = File::LoadBinary(_filePath);
+		if (!fileContent.has_value())
+			return {};
+
+		if (fileContent->size() < sizeof(FileHeader))
+		{
+			Logger::LogWarn("Pipeline cache file is truncated, starting empty: {}", _filePath);
+			return {};
+		}
+
+		FileHeader header;
+		std::memcpy(&header, fileContent->data(), sizeof(FileHeader));
+
+		// A driver update or another GPU invalidates the content, the driver could reject or misuse it
+		const FileHeader expected = MakeFileHeader(fileContent->size() - sizeof(FileHeader));
+		if (header.magic != expected.magic || header.version != expected.version
+			|| header.vendorId != expected.vendorId || header.deviceId != expected.deviceId
+			|| header.driverVersion != expected.driverVersion
+			|| std::memcmp(header.pipelineCacheUUID, expected.pipelineCacheUUID, VK_UUID_SIZE) != 0
+			|| header.dataSize != expected.dataSize)
+		{
+			Logger::LogInfo("Pipeline cache file was written for another device or driver, starting empty: {}", _filePath);
+			return {};
+		}
+
+		return std::vector<char>(fileContent->begin() + sizeof(FileHeader), fileContent->end());
+	}
+} // namespace Ailurus
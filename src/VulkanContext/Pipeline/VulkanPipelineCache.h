@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string>
+#include "VulkanContext/VulkanPch.h"
+#include <Ailurus/Utility/NonCopyable.h>
+#include <Ailurus/Utility/NonMovable.h>
+
+namespace Ailurus
+{
+	/// vk::PipelineCache persisted to disk across runs. The file is only used when it was written
+	/// for the same physical device and driver version, a stale or broken file starts an empty cache.
+	class VulkanPipelineCache : public NonCopyable, public NonMovable
+	{
+	public:
+		explicit VulkanPipelineCache(const std::string& filePath);
+		~VulkanPipelineCache();
+
+	public:
+		auto GetPipelineCache() const -> vk::PipelineCache;
+
+		/// Write the cache content to disk, also done on destruction
+		auto Save() const -> bool;
+
+	private:
+		struct FileHeader
+		{
+			uint32_t magic;
+			uint32_t version;
+			uint32_t vendorId;
+			uint32_t deviceId;
+			uint32_t driverVersion;
+			uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+			uint64_t dataSize;
+		};
+
+		auto MakeFileHeader(uint64_t dataSize) const -> FileHeader;
+		auto LoadInitialData() const -> std::vector<char>;
+
+	private:
+		static constexpr uint32_t FILE_MAGIC = 0x43505641; // "AVPC"
+		static constexpr uint32_t FILE_VERSION = 1;
+
+		std::string _filePath;
+		vk::PhysicalDeviceProperties _deviceProperties;
+		vk::PipelineCache _vkPipelineCache = nullptr;
+	};
+} // namespace Ailurus
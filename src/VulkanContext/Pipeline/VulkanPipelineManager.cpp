@@ -1,23 +1,106 @@
+#include <algorithm>
+#include <filesystem>
 #include <Ailurus/Utility/Logger.h>
+#include <Ailurus/OS/System.h>
 #include <Ailurus/Application.h>
 #include <Ailurus/Systems/RenderSystem/RenderSystem.h>
 #include <Ailurus/Systems/AssetsSystem/AssetsSystem.h>
 #include <Ailurus/Systems/AssetsSystem/Material/Material.h>
+#include <Ailurus/Systems/RenderSystem/Shader/Shader.h>
+#include <Ailurus/Systems/RenderSystem/Descriptor/BindlessTextureTable.h>
 #include <Ailurus/Math/Matrix4x4.hpp>
 #include "VulkanPipelineManager.h"
 #include "VulkanContext/VulkanContext.h"
 #include "VulkanContext/Vertex/VulkanVertexLayoutManager.h"
+#include "VulkanContext/Shader/VulkanShader.h"
 #include "VulkanContext/SwapChain/VulkanSwapChain.h"
 #include "VulkanContext/RenderTarget/RenderTargetManager.h"
 
 namespace Ailurus
 {
+	VulkanPipelineManager::VulkanPipelineManager()
+	{
+		// Temp directory is writable on every platform, unlike the resource folder of app bundles
+		const auto cachePath = std::filesystem::path(System::GetTempDirectory()) / "AilurusPipelineCache.bin";
+		_pPipelineCache = std::make_unique<VulkanPipelineCache>(cachePath.string());
+	}
+
+	VulkanPipelineManager::~VulkanPipelineManager()
+	{
+		// Pipelines go before the cache is written out and destroyed
+		_pipelinesMap.clear();
+		_pPipelineCache.reset();
+	}
+
+	auto VulkanPipelineManager::GetPipelineCache() const -> vk::PipelineCache
+	{
+		return _pPipelineCache != nullptr ? _pPipelineCache->GetPipelineCache() : nullptr;
+	}
+
+	/// Whether the layout feeds every input attribute the vertex shader of the pass reads
+	static bool ProvidesVertexInputs(const StageShaderArray& shaderArray, const VulkanVertexLayout& vertexLayout)
+	{
+		const Shader* pVertexShader = shaderArray[ShaderStage::Vertex];
+		if (pVertexShader == nullptr || pVertexShader->GetImpl() == nullptr)
+			return false;
+
+		const auto& attributes = vertexLayout.GetVulkanAttributeDescription();
+		for (const uint32_t location : pVertexShader->GetImpl()->GetInputLocations())
+		{
+			const bool provided = std::any_of(attributes.begin(), attributes.end(),
+				[location](const vk::VertexInputAttributeDescription& attribute) { return attribute.location == location; });
+			if (!provided)
+				return false;
+		}
+
+		return true;
+	}
+
+	void VulkanPipelineManager::WarmUp(const Material& material, uint64_t vertexLayoutId)
+	{
+		if (!_warmedUpPairs.emplace(material.GetAssetId(), vertexLayoutId).second)
+			return;
+
+		const auto* pVertexLayout = VulkanContext::GetVertexLayoutManager()->GetLayout(vertexLayoutId);
+		if (pVertexLayout == nullptr)
+			return;
+
+		for (const auto pass : EnumReflection<RenderPassType>::GetEnumArray())
+		{
+			// Post process pipelines belong to the effects, not to materials
+			if (pass == RenderPassType::PostProcess || !material.HasRenderPass(pass))
+				continue;
+
+			const auto* pShaderArray = material.GetPassShaderArray(pass);
+			if (pShaderArray == nullptr || !ProvidesVertexInputs(*pShaderArray, *pVertexLayout))
+				continue;
+
+			// Failures are logged by GetPipeline, the draw retries the same entry later
+			GetPipeline(VulkanPipelineEntry(pass, material.GetAssetId(), vertexLayoutId));
+		}
+	}
+
 	auto VulkanPipelineManager::GetPipeline(const VulkanPipelineEntry& entry) -> VulkanPipeline*
 	{
+		{
+			std::shared_lock lock(_pipelinesMutex);
+			const auto it = _pipelinesMap.find(entry);
+			if (it != _pipelinesMap.end())
+				return it->second.get();
+		}
+
+		std::unique_lock lock(_pipelinesMutex);
+
+		// Another thread may have created it while we were waiting
 		const auto it = _pipelinesMap.find(entry);
 		if (it != _pipelinesMap.end())
 			return it->second.get();
 
+		return CreatePipeline(entry);
+	}
+
+	auto VulkanPipelineManager::CreatePipeline(const VulkanPipelineEntry& entry) -> VulkanPipeline*
+	{
 		// Get formats from swap chain
 		auto pSwapChain = VulkanContext::GetSwapChain();
 		if (pSwapChain == nullptr)
@@ -30,7 +113,7 @@ namespace Ailurus
 		const bool isGBufferPass  = (entry.renderPass == RenderPassType::GBuffer);
 		const bool isTransparent  = (entry.renderPass == RenderPassType::Transparent);
 
-		const vk::Format depthFormat = vk::Format::eD32Sfloat;
+		const vk::Format depthFormat = RenderTargetManager::GetDepthFormat();
 
 		auto refMaterial = Application::Get<AssetsSystem>()->GetAsset<Material>(entry.materialAssetId);
 		if (!refMaterial)
@@ -54,13 +137,27 @@ namespace Ailurus
 			return nullptr;
 		}
 
-		// Collect uniform sets
-		std::vector<const UniformSet*> uniformSets;
-		uniformSets.push_back(Application::Get<RenderSystem>()->GetGlobalUniformSet());
+		// Collect descriptor set layouts, global set 0, material set 1 and the bindless table as set 2
+		auto* pRenderSystem = Application::Get<RenderSystem>();
+		std::vector<const DescriptorSetSchema*> descriptorSetSchemas;
+		descriptorSetSchemas.push_back(pRenderSystem->GetGlobalUniformSet());
 
 		auto* materialUniformSet = refMaterial->GetUniformSet(entry.renderPass);
 		if (materialUniformSet != nullptr)
-			uniformSets.push_back(materialUniformSet);
+			descriptorSetSchemas.push_back(materialUniformSet);
+
+		if (refMaterial->IsPassBindless(entry.renderPass))
+		{
+			auto* pBindlessTextures = pRenderSystem->GetBindlessTextureTable();
+			if (pBindlessTextures == nullptr || materialUniformSet == nullptr)
+			{
+				Logger::LogError("VulkanPipelineManager::GetPipeline: Bindless material {} needs descriptor indexing and a material uniform set",
+					entry.materialAssetId);
+				return nullptr;
+			}
+
+			descriptorSetSchemas.push_back(pBindlessTextures);
+		}
 
 		VulkanPipeline* pPipeline = nullptr;
 
@@ -72,20 +169,21 @@ namespace Ailurus
 				RenderTargetManager::GetGBufferAlbedoFormat(),
 				RenderTargetManager::GetGBufferMetallicFormat()
 			};
-			pPipeline = new VulkanPipeline(colorFormats, depthFormat, *pShaderArray, pVertexLayout, uniformSets);
+			pPipeline = new VulkanPipeline(colorFormats, depthFormat, *pShaderArray, pVertexLayout, descriptorSetSchemas);
 		}
 		else if (isShadowPass)
 		{
 			// Depth-only pipeline
-			const uint32_t pushConstantSize = static_cast<uint32_t>(sizeof(Matrix4x4f) + sizeof(uint32_t));
-			pPipeline = new VulkanPipeline(vk::Format::eUndefined, depthFormat, *pShaderArray, pVertexLayout, uniformSets, pushConstantSize);
+			// Instance buffer offset + cascade mask + cascade stride
+			const uint32_t pushConstantSize = static_cast<uint32_t>(sizeof(uint32_t) * 3);
+			pPipeline = new VulkanPipeline(vk::Format::eUndefined, depthFormat, *pShaderArray, pVertexLayout, descriptorSetSchemas, pushConstantSize);
 		}
 		else if (isTransparent)
 		{
 			// Transparent pipeline: alpha blending, depth test (read-only)
 			const vk::Format colorFormat = vk::Format::eR16G16B16A16Sfloat;
-			pPipeline = new VulkanPipeline(colorFormat, depthFormat, *pShaderArray, pVertexLayout, uniformSets,
-				static_cast<uint32_t>(sizeof(Matrix4x4f)),
+			pPipeline = new VulkanPipeline(colorFormat, depthFormat, *pShaderArray, pVertexLayout, descriptorSetSchemas,
+				/*pushConstantSize=*/0,
 				/*blendEnabled=*/true,
 				/*depthWriteEnabled=*/false);
 		}
@@ -93,7 +191,7 @@ namespace Ailurus
 		{
 			// Standard forward pass pipeline
 			const vk::Format colorFormat = vk::Format::eR16G16B16A16Sfloat;
-			pPipeline = new VulkanPipeline(colorFormat, depthFormat, *pShaderArray, pVertexLayout, uniformSets);
+			pPipeline = new VulkanPipeline(colorFormat, depthFormat, *pShaderArray, pVertexLayout, descriptorSetSchemas);
 		}
 
 		_pipelinesMap[entry] = std::unique_ptr<VulkanPipeline>(pPipeline);
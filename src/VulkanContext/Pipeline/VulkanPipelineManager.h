@@ -2,22 +2,50 @@
 
 #include "VulkanContext/VulkanPch.h"
 #include <memory>
+#include <set>
+#include <shared_mutex>
 #include <unordered_map>
+#include <utility>
 #include <Ailurus/Utility/NonCopyable.h>
 #include <Ailurus/Utility/NonMovable.h>
 #include "VulkanPipelineEntry.h"
 #include "VulkanPipeline.h"
+#include "VulkanPipelineCache.h"
 
 namespace Ailurus
 {
+    class Material;
+
     class VulkanPipelineManager : public NonCopyable, public NonMovable
     {
         using PipelineMap = std::unordered_map<VulkanPipelineEntry, std::unique_ptr<VulkanPipeline>, 
             VulkanPipelineEntryHash, VulkanPipelineEntryEqual>;
+    public:
+		VulkanPipelineManager();
+		~VulkanPipelineManager();
+
     public:
 		auto GetPipeline(const VulkanPipelineEntry& entry) -> VulkanPipeline*;
 
+		/// Create the pipelines of every pass of the material for a vertex layout it is drawn with, so
+		/// the first frame drawing them does not stall on pipeline compilation. Passes whose vertex
+		/// shader reads attributes the layout lacks are skipped, each pair is warmed up once.
+		void WarmUp(const Material& material, uint64_t vertexLayoutId);
+
+		/// Shared by every pipeline the engine creates, persisted to disk on shutdown
+		auto GetPipelineCache() const -> vk::PipelineCache;
+
     private:
+        auto CreatePipeline(const VulkanPipelineEntry& entry) -> VulkanPipeline*;
+
+    private:
+        std::unique_ptr<VulkanPipelineCache> _pPipelineCache;
+
+        // Pipelines are looked up from parallel command recording, creation takes the exclusive lock
+        std::shared_mutex _pipelinesMutex;
         PipelineMap _pipelinesMap;
+
+        // Material asset id and vertex layout pairs already warmed up
+        std::set<std::pair<uint32_t, uint64_t>> _warmedUpPairs;
     };
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "RenderTarget.h"
 #include "VulkanContext/VulkanContext.h"
+#include "VulkanContext/Resource/VulkanResourceManager.h"
 #include "Ailurus/Utility/Logger.h"
 
 namespace Ailurus
@@ -28,10 +29,10 @@ namespace Ailurus
 				_image = nullptr;
 			}
 
-			if (_memory != nullptr)
+			if (_memory.memory != nullptr)
 			{
-				VulkanContext::GetDevice().freeMemory(_memory);
-				_memory = nullptr;
+				VulkanContext::GetResourceManager()->GetMemoryAllocator()->Free(_memory);
+				_memory = VulkanMemoryAllocation{};
 			}
 		}
 		catch (const vk::SystemError& e)
@@ -79,38 +80,34 @@ namespace Ailurus
 			return;
 
 		vk::MemoryRequirements memRequirements = VulkanContext::GetDevice().getImageMemoryRequirements(_image);
-		
-		vk::MemoryPropertyFlags properties = vk::MemoryPropertyFlagBits::eDeviceLocal;
-		
+		auto* pMemoryAllocator = VulkanContext::GetResourceManager()->GetMemoryAllocator();
+
 		// For transient attachments, prefer lazily allocated memory if available
+		vk::MemoryPropertyFlags preferred = {};
 		if (_config.transient && _config.samples != vk::SampleCountFlagBits::e1)
+			preferred = vk::MemoryPropertyFlagBits::eLazilyAllocated;
+
+		const std::optional<uint32_t> memoryTypeIndex = pMemoryAllocator->FindMemoryType(
+			memRequirements.memoryTypeBits, vk::MemoryPropertyFlagBits::eDeviceLocal, preferred);
+		if (!memoryTypeIndex.has_value())
 		{
-			properties |= vk::MemoryPropertyFlagBits::eLazilyAllocated;
-			
-			// Try to find lazy allocated memory first
-			uint32_t memoryTypeIndex = FindMemoryType(memRequirements.memoryTypeBits, properties);
-			if (memoryTypeIndex == UINT32_MAX)
-			{
-				// Fallback to device local only
-				properties = vk::MemoryPropertyFlagBits::eDeviceLocal;
-			}
+			Logger::LogError("Failed to find suitable memory type for render target");
+			return;
 		}
 
-		uint32_t memoryTypeIndex = FindMemoryType(memRequirements.memoryTypeBits, properties);
-		if (memoryTypeIndex == UINT32_MAX)
+		const std::optional<VulkanMemoryAllocation> memory = pMemoryAllocator->Allocate(
+			memRequirements, *memoryTypeIndex, VulkanMemoryTiling::Optimal);
+		if (!memory.has_value())
 		{
-			Logger::LogError("Failed to find suitable memory type for render target");
+			Logger::LogError("Failed to allocate render target memory");
 			return;
 		}
 
-		vk::MemoryAllocateInfo allocInfo;
-		allocInfo.setAllocationSize(memRequirements.size)
-			.setMemoryTypeIndex(memoryTypeIndex);
+		_memory = *memory;
 
 		try
 		{
-			_memory = VulkanContext::GetDevice().allocateMemory(allocInfo);
-			VulkanContext::GetDevice().bindImageMemory(_image, _memory, 0);
+			VulkanContext::GetDevice().bindImageMemory(_image, _memory.memory, _memory.offset);
 		}
 		catch (const vk::SystemError& e)
 		{
@@ -144,22 +141,6 @@ namespace Ailurus
 		}
 	}
 
-	uint32_t RenderTarget::FindMemoryType(uint32_t typeFilter, vk::MemoryPropertyFlags properties) const
-	{
-		vk::PhysicalDeviceMemoryProperties memProperties = VulkanContext::GetPhysicalDevice().getMemoryProperties();
-		
-		for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++)
-		{
-			if ((typeFilter & (1 << i)) &&
-				(memProperties.memoryTypes[i].propertyFlags & properties) == properties)
-			{
-				return i;
-			}
-		}
-		
-		return UINT32_MAX;
-	}
-
 	vk::Image RenderTarget::GetImage() const
 	{
 		return _image;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vulkan/vulkan.hpp>
+#include "VulkanContext/Resource/Memory/VulkanMemoryAllocator.h"
 #include <Ailurus/Utility/NonCopyable.h>
 #include <Ailurus/Utility/NonMovable.h>
 
@@ -38,7 +39,6 @@ namespace Ailurus
 		void CreateImage();
 		void AllocateMemory();
 		void CreateImageView();
-		uint32_t FindMemoryType(uint32_t typeFilter, vk::MemoryPropertyFlags properties) const;
 
 	public:
 		// Create a 2D ImageView for a specific layer and mip level (for rendering to individual cubemap faces)
@@ -49,6 +49,6 @@ namespace Ailurus
 		RenderTargetConfig _config;
 		vk::Image _image = nullptr;
 		vk::ImageView _imageView = nullptr;
-		vk::DeviceMemory _memory = nullptr;
+		VulkanMemoryAllocation _memory;
 	};
 } // namespace Ailurus
@@ -34,7 +34,7 @@ namespace Ailurus
 		    CreateMSAATargets(width, height);
 
 		// Create CSM shadow maps
-		CreateShadowMapTargets();
+		CreateShadowMapTarget();
 
 		// Create G-Buffer targets
 		CreateGBufferTargets(width, height);
@@ -95,18 +95,14 @@ namespace Ailurus
 		return SHADOW_MAP_CASCADE_COUNT;
 	}
 
-	vk::ImageView RenderTargetManager::GetShadowMapImageView(uint32_t cascadeIndex) const
+	vk::ImageView RenderTargetManager::GetShadowMapImageView() const
 	{
-		if (cascadeIndex >= _shadowMapTargets.size())
-			return nullptr;
-		return _shadowMapTargets[cascadeIndex] ? _shadowMapTargets[cascadeIndex]->GetImageView() : nullptr;
+		return _shadowMapTarget ? _shadowMapTarget->GetImageView() : nullptr;
 	}
 
-	vk::Image RenderTargetManager::GetShadowMapImage(uint32_t cascadeIndex) const
+	vk::Image RenderTargetManager::GetShadowMapImage() const
 	{
-		if (cascadeIndex >= _shadowMapTargets.size())
-			return nullptr;
-		return _shadowMapTargets[cascadeIndex] ? _shadowMapTargets[cascadeIndex]->GetImage() : nullptr;
+		return _shadowMapTarget ? _shadowMapTarget->GetImage() : nullptr;
 	}
 
     void RenderTargetManager::Clear()
@@ -116,7 +112,7 @@ namespace Ailurus
 		_msaaDepthTarget = nullptr;
 		_resolvedMSAADepthTarget = nullptr;
 		_offscreenColorTarget = nullptr;
-		_shadowMapTargets.clear();
+		_shadowMapTarget = nullptr;
 		_gBufferNormalTarget = nullptr;
 		_gBufferAlbedoTarget = nullptr;
 		_gBufferMetallicTarget = nullptr;
@@ -127,7 +123,7 @@ namespace Ailurus
 		RenderTargetConfig config;
 		config.width = width;
 		config.height = height;
-		config.format = vk::Format::eD32Sfloat;
+		config.format = DEPTH_FORMAT;
 		config.samples = vk::SampleCountFlagBits::e1; // Non-MSAA depth
 		config.usage = vk::ImageUsageFlagBits::eDepthStencilAttachment | vk::ImageUsageFlagBits::eSampled;
 		config.aspectMask = vk::ImageAspectFlagBits::eDepth;
@@ -178,7 +174,7 @@ namespace Ailurus
 			RenderTargetConfig config;
 			config.width = width;
 			config.height = height;
-			config.format = vk::Format::eD32Sfloat;
+			config.format = DEPTH_FORMAT;
 			config.samples = msaaSamples;
 			config.usage = vk::ImageUsageFlagBits::eDepthStencilAttachment;
 			config.aspectMask = vk::ImageAspectFlagBits::eDepth;
@@ -202,7 +198,7 @@ namespace Ailurus
 			RenderTargetConfig config;
 			config.width = width;
 			config.height = height;
-			config.format = vk::Format::eD32Sfloat;
+			config.format = DEPTH_FORMAT;
 			config.samples = vk::SampleCountFlagBits::e1;
 			config.usage = vk::ImageUsageFlagBits::eDepthStencilAttachment | vk::ImageUsageFlagBits::eSampled;
 			config.aspectMask = vk::ImageAspectFlagBits::eDepth;
@@ -243,32 +239,29 @@ namespace Ailurus
 		}
 	}
 
-	void RenderTargetManager::CreateShadowMapTargets()
+	void RenderTargetManager::CreateShadowMapTarget()
 	{
-		_shadowMapTargets.clear();
-		_shadowMapTargets.reserve(SHADOW_MAP_CASCADE_COUNT);
+		RenderTargetConfig config;
+		config.width = SHADOW_MAP_RESOLUTION;
+		config.height = SHADOW_MAP_RESOLUTION;
+		config.format = DEPTH_FORMAT;
+		config.samples = vk::SampleCountFlagBits::e1;
+		config.usage = vk::ImageUsageFlagBits::eDepthStencilAttachment | vk::ImageUsageFlagBits::eSampled;
+		config.aspectMask = vk::ImageAspectFlagBits::eDepth;
+		config.transient = false;
+		config.arrayLayers = SHADOW_MAP_CASCADE_COUNT;
+		config.viewType = vk::ImageViewType::e2DArray;
 
-		for (uint32_t i = 0; i < SHADOW_MAP_CASCADE_COUNT; i++)
+		try
 		{
-			RenderTargetConfig config;
-			config.width = SHADOW_MAP_RESOLUTION;
-			config.height = SHADOW_MAP_RESOLUTION;
-			config.format = vk::Format::eD32Sfloat;
-			config.samples = vk::SampleCountFlagBits::e1;
-			config.usage = vk::ImageUsageFlagBits::eDepthStencilAttachment | vk::ImageUsageFlagBits::eSampled;
-			config.aspectMask = vk::ImageAspectFlagBits::eDepth;
-			config.transient = false;
-
-			try
-			{
-				_shadowMapTargets.push_back(std::make_unique<RenderTarget>(config));
-				Logger::LogInfo("Created shadow map cascade {}: {}x{}", i, SHADOW_MAP_RESOLUTION, SHADOW_MAP_RESOLUTION);
-			}
-			catch (const std::exception& e)
-			{
-				Logger::LogError("Failed to create shadow map cascade {}: {}", i, e.what());
-				_shadowMapTargets.push_back(nullptr);
-			}
+			_shadowMapTarget = std::make_unique<RenderTarget>(config);
+			Logger::LogInfo("Created shadow map array: {}x{} x {} cascades",
+				SHADOW_MAP_RESOLUTION, SHADOW_MAP_RESOLUTION, SHADOW_MAP_CASCADE_COUNT);
+		}
+		catch (const std::exception& e)
+		{
+			Logger::LogError("Failed to create shadow map array: {}", e.what());
+			_shadowMapTarget = nullptr;
 		}
 	}
 
@@ -31,10 +31,10 @@ namespace Ailurus
 		vk::Image GetOffscreenColorImage() const;
 		vk::ImageView GetOffscreenColorImageView() const;
 
-		// CSM shadow maps
+		// CSM shadow maps, one array layer per cascade
 		uint32_t GetShadowMapCascadeCount() const;
-		vk::ImageView GetShadowMapImageView(uint32_t cascadeIndex) const;
-		vk::Image GetShadowMapImage(uint32_t cascadeIndex) const;
+		vk::ImageView GetShadowMapImageView() const;
+		vk::Image GetShadowMapImage() const;
 
 		// G-Buffer targets (for deferred rendering)
 		vk::Image GetGBufferNormalImage() const;
@@ -44,6 +44,8 @@ namespace Ailurus
 		vk::Image GetGBufferMetallicImage() const;
 		vk::ImageView GetGBufferMetallicImageView() const;
 
+		static constexpr vk::Format GetOffscreenColorFormat()  { return OFFSCREEN_COLOR_FORMAT; }
+		static constexpr vk::Format GetDepthFormat()           { return DEPTH_FORMAT; }
 		static constexpr vk::Format GetGBufferNormalFormat()   { return GBUFFER_NORMAL_FORMAT; }
 		static constexpr vk::Format GetGBufferAlbedoFormat()   { return GBUFFER_ALBEDO_FORMAT; }
 		static constexpr vk::Format GetGBufferMetallicFormat() { return GBUFFER_METALLIC_FORMAT; }
@@ -53,10 +55,13 @@ namespace Ailurus
 		void CreateDepthTarget(uint32_t width, uint32_t height);
 		void CreateMSAATargets(uint32_t width, uint32_t height);
 		void CreateOffscreenColorTarget(uint32_t width, uint32_t height);
-		void CreateShadowMapTargets();
+		void CreateShadowMapTarget();
 		void CreateGBufferTargets(uint32_t width, uint32_t height);
 
 	private:
+		// All depth targets (scene, MSAA, shadow maps) share one format
+		static constexpr vk::Format DEPTH_FORMAT = vk::Format::eD32Sfloat;
+
 		// Standard depth buffer (for non-MSAA or as resolve target)
 		std::unique_ptr<RenderTarget> _depthTarget = nullptr;
 
@@ -71,10 +76,10 @@ namespace Ailurus
 		static constexpr vk::Format OFFSCREEN_COLOR_FORMAT = vk::Format::eR16G16B16A16Sfloat;
 		std::unique_ptr<RenderTarget> _offscreenColorTarget = nullptr;
 
-		// CSM shadow maps (one per cascade)
+		// CSM shadow maps (2D array, one layer per cascade, rendered in a single layered pass)
 		static constexpr uint32_t SHADOW_MAP_CASCADE_COUNT = 4;
 		static constexpr uint32_t SHADOW_MAP_RESOLUTION = 2048;
-		std::vector<std::unique_ptr<RenderTarget>> _shadowMapTargets;
+		std::unique_ptr<RenderTarget> _shadowMapTarget = nullptr;
 
 		// G-Buffer targets for deferred rendering
 		// GBuffer0: World Normal (XYZ) + AO (W) — R16G16B16A16_SFLOAT
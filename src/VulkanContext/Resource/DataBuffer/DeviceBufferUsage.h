@@ -7,5 +7,7 @@ namespace Ailurus
     REFLECTION_ENUM(DeviceBufferUsage,
 		Vertex,
 		Index,
-		Uniform)
+		Uniform,
+		Storage,
+		Indirect)
 }
\ No newline at end of file
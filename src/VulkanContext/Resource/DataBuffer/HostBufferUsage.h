@@ -5,5 +5,6 @@
 namespace Ailurus
 {
     REFLECTION_ENUM(HostBufferUsage,
-		TransferSrc)
+		TransferSrc,
+		Uniform)
 }
\ No newline at end of file
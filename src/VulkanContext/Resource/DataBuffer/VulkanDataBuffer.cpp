@@ -1,26 +1,36 @@
+#include <array>
 #include "VulkanDataBuffer.h"
 #include "VulkanContext/VulkanContext.h"
+#include "VulkanContext/Resource/VulkanResourceManager.h"
 #include "Ailurus/Utility/Logger.h"
 
 namespace Ailurus
 {
-    std::optional<VulkanDataBuffer::BufferMemoryRequirement>
-	VulkanDataBuffer::GetBufferMemoryRequirement(vk::Buffer buffer, vk::MemoryPropertyFlags propertyFlag)
+	void VulkanDataBuffer::DestroyBuffer(const VulkanDataBuffer* pBuffer)
 	{
-		vk::MemoryRequirements memRequirements = VulkanContext::GetDevice().getBufferMemoryRequirements(buffer);
+		try
+		{
+			// Destroy buffer first, then give its memory back
+			if (pBuffer->buffer != nullptr)
+				VulkanContext::GetDevice().destroyBuffer(pBuffer->buffer);
 
-		// Find a memory type
-		std::optional<uint32_t> memoryTypeIndex = std::nullopt;
-		vk::PhysicalDeviceMemoryProperties memProperties = VulkanContext::GetPhysicalDevice().getMemoryProperties();
-		for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++)
+			VulkanContext::GetResourceManager()->GetMemoryAllocator()->Free(pBuffer->memory);
+		}
+		catch (const vk::SystemError& e)
 		{
-			if ((memRequirements.memoryTypeBits & (1 << i))
-				&& (memProperties.memoryTypes[i].propertyFlags & propertyFlag) == propertyFlag)
-			{
-				memoryTypeIndex = i;
-				break;
-			}
+			Logger::LogError("Failed to delete buffer resource: {}", e.what());
 		}
+	}
+
+    std::optional<VulkanDataBuffer::BufferMemoryRequirement>
+	VulkanDataBuffer::GetBufferMemoryRequirement(vk::Buffer buffer, vk::MemoryPropertyFlags propertyFlag,
+		vk::MemoryPropertyFlags preferredFlag)
+	{
+		vk::MemoryRequirements memRequirements = VulkanContext::GetDevice().getBufferMemoryRequirements(buffer);
+
+		// Find a memory type, one that also has the preferred properties first
+		const std::optional<uint32_t> memoryTypeIndex = VulkanContext::GetResourceManager()->GetMemoryAllocator()
+			->FindMemoryType(memRequirements.memoryTypeBits, propertyFlag, preferredFlag);
 
 		if (memoryTypeIndex.has_value())
 			return BufferMemoryRequirement{ memRequirements, *memoryTypeIndex };
@@ -29,7 +39,8 @@ namespace Ailurus
 	}
 
     std::optional<VulkanDataBuffer::CreatedBuffer>
-	VulkanDataBuffer::CreateBuffer(vk::DeviceSize size, vk::BufferUsageFlags usageFlag, vk::MemoryPropertyFlags propertyFlag)
+	VulkanDataBuffer::CreateBuffer(vk::DeviceSize size, vk::BufferUsageFlags usageFlag, vk::MemoryPropertyFlags propertyFlag,
+		vk::MemoryPropertyFlags preferredFlag)
 	{
 		const auto device = VulkanContext::GetDevice();
 
@@ -39,12 +50,21 @@ namespace Ailurus
 			.setUsage(usageFlag)
 			.setSharingMode(vk::SharingMode::eExclusive);
 
+		// Written by a dedicated transfer queue and read by the graphics queue, shared instead of
+		// handed over, the geometry arena copies its live ranges on the transfer queue when growing
+		const std::array<uint32_t, 2> queueFamilies{ VulkanContext::GetGraphicQueueIndex(), VulkanContext::GetTransferQueueIndex() };
+		if ((usageFlag & vk::BufferUsageFlagBits::eTransferDst) && queueFamilies[0] != queueFamilies[1])
+		{
+			bufferInfo.setSharingMode(vk::SharingMode::eConcurrent)
+				.setQueueFamilyIndices(queueFamilies);
+		}
+
 		try
 		{
 			const vk::Buffer buffer = device.createBuffer(bufferInfo);
 
 			// Get gpu memory requirement
-			const std::optional<BufferMemoryRequirement> memoryRequirement = GetBufferMemoryRequirement(buffer, propertyFlag);
+			const std::optional<BufferMemoryRequirement> memoryRequirement = GetBufferMemoryRequirement(buffer, propertyFlag, preferredFlag);
 			if (!memoryRequirement.has_value())
 			{
 				device.destroyBuffer(buffer);
@@ -52,15 +72,20 @@ namespace Ailurus
 				return std::nullopt;
 			}
 
-			// Alloc memory
-			vk::MemoryAllocateInfo allocInfo;
-			allocInfo.setAllocationSize(memoryRequirement->requirements.size)
-				.setMemoryTypeIndex(memoryRequirement->memTypeIndex);
+			// Sub-allocate memory
+			auto* pMemoryAllocator = VulkanContext::GetResourceManager()->GetMemoryAllocator();
+			const std::optional<VulkanMemoryAllocation> memory = pMemoryAllocator->Allocate(
+				memoryRequirement->requirements, memoryRequirement->memTypeIndex, VulkanMemoryTiling::Linear);
+			if (!memory.has_value())
+			{
+				device.destroyBuffer(buffer);
+				Logger::LogError("Failed to allocate memory when creating buffer.");
+				return std::nullopt;
+			}
 
-			const vk::DeviceMemory deviceMem = device.allocateMemory(allocInfo);
-			device.bindBufferMemory(buffer, deviceMem, 0);
+			device.bindBufferMemory(buffer, memory->memory, memory->offset);
 
-			return CreatedBuffer{ memoryRequirement->requirements.size, buffer, deviceMem };
+			return CreatedBuffer{ memoryRequirement->requirements.size, buffer, *memory };
 		}
 		catch (const vk::SystemError& e)
 		{
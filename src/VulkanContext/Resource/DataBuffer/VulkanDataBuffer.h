@@ -4,6 +4,7 @@
 #include "HostBufferUsage.h"
 #include "DeviceBufferUsage.h"
 #include "VulkanContext/Resource/VulkanResource.h"
+#include "VulkanContext/Resource/Memory/VulkanMemoryAllocator.h"
 
 namespace Ailurus
 {
@@ -20,22 +21,28 @@ namespace Ailurus
 	    {
 	    	vk::DeviceSize realSize;
 	    	vk::Buffer buffer;
-	    	vk::DeviceMemory deviceMem;
+	    	VulkanMemoryAllocation memory;
 	    };
 
 	public:
-		VulkanDataBuffer(vk::DeviceSize size, vk::Buffer buf, vk::DeviceMemory mem)
-            : realSize(size), buffer(buf), deviceMemory(mem)
+		VulkanDataBuffer(vk::DeviceSize size, vk::Buffer buf, const VulkanMemoryAllocation& mem)
+            : realSize(size), buffer(buf), memory(mem)
 	    {
 	    }
 
 	public:
 		const vk::DeviceSize realSize;
 		const vk::Buffer buffer;
-		const vk::DeviceMemory deviceMemory;
+		const VulkanMemoryAllocation memory; // Sub-allocation of a block shared with other resources
+
+    public:
+        /// Destroy the buffer and give its memory back to the allocator, for the resource deleters
+        static auto DestroyBuffer(const VulkanDataBuffer* pBuffer) -> void;
 
     protected:
-        static auto GetBufferMemoryRequirement(vk::Buffer buffer, vk::MemoryPropertyFlags propertyFlag) -> std::optional<BufferMemoryRequirement>;
-        static auto CreateBuffer(vk::DeviceSize size, vk::BufferUsageFlags usageFlag, vk::MemoryPropertyFlags propertyFlag) -> std::optional<CreatedBuffer>;
+        static auto GetBufferMemoryRequirement(vk::Buffer buffer, vk::MemoryPropertyFlags propertyFlag,
+            vk::MemoryPropertyFlags preferredFlag = {}) -> std::optional<BufferMemoryRequirement>;
+        static auto CreateBuffer(vk::DeviceSize size, vk::BufferUsageFlags usageFlag, vk::MemoryPropertyFlags propertyFlag,
+            vk::MemoryPropertyFlags preferredFlag = {}) -> std::optional<CreatedBuffer>;
 	};
 }
\ No newline at end of file
@@ -7,29 +7,15 @@ namespace Ailurus
     static void DeviceBufferDeleter(VulkanResource* pResource)
 	{
 		auto ptr = static_cast<VulkanDeviceBuffer*>(pResource);
-		const auto device = VulkanContext::GetDevice();
-
-		try
-		{
-			// Destroy buffer first, then device memory.
-			if (ptr->buffer != nullptr)
-				device.destroyBuffer(ptr->buffer);
-
-			if (ptr->deviceMemory != nullptr)
-				device.freeMemory(ptr->deviceMemory);
-		}
-		catch (const vk::SystemError& e)
-		{
-			Logger::LogError("Failed to delete device buffer resource: {}", e.what());
-		}
-
+		DestroyBuffer(ptr);
 		delete ptr;
 	}
 
     VulkanResourcePtr VulkanDeviceBuffer::Create(vk::DeviceSize size, DeviceBufferUsage usage)
     {
         vk::BufferUsageFlags usageFlag;
-		usageFlag |= vk::BufferUsageFlagBits::eTransferDst;
+		// Transfer source too, so a buffer can be copied into a larger one when it grows
+		usageFlag |= vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eTransferSrc;
 		switch (usage)
 		{
 			case DeviceBufferUsage::Vertex:
@@ -41,6 +27,13 @@ namespace Ailurus
 			case DeviceBufferUsage::Uniform:
 				usageFlag |= vk::BufferUsageFlagBits::eUniformBuffer;
 				break;
+			case DeviceBufferUsage::Storage:
+				usageFlag |= vk::BufferUsageFlagBits::eStorageBuffer;
+				break;
+			case DeviceBufferUsage::Indirect:
+				// Draw arguments written by compute shaders
+				usageFlag |= vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer;
+				break;
 			default:
 				Logger::LogError("Unknown gpu buffer usage type: {}", EnumReflection<DeviceBufferUsage>::ToString(usage));
 				return nullptr;
@@ -51,7 +44,7 @@ namespace Ailurus
 		if (!bufferRet.has_value())
 			return nullptr;
 
-		VulkanDeviceBuffer* pBufferRaw = new VulkanDeviceBuffer(bufferRet->realSize, bufferRet->buffer, bufferRet->deviceMem);
+		VulkanDeviceBuffer* pBufferRaw = new VulkanDeviceBuffer(bufferRet->realSize, bufferRet->buffer, bufferRet->memory);
         return VulkanResourcePtr(pBufferRaw, &DeviceBufferDeleter);
     }
 }
\ No newline at end of file
@@ -7,7 +7,7 @@ namespace Ailurus
     class VulkanDeviceBuffer : public VulkanDataBuffer
 	{
 	public:
-		VulkanDeviceBuffer(vk::DeviceSize size, vk::Buffer buf, vk::DeviceMemory mem)
+		VulkanDeviceBuffer(vk::DeviceSize size, vk::Buffer buf, const VulkanMemoryAllocation& mem)
             : VulkanDataBuffer(size, buf, mem)
 	    {
 	    }
@@ -6,37 +6,26 @@ namespace Ailurus
 {
     static void HostBufferDeleter(VulkanResource* pResource)
 	{
+		// The block stays mapped while other buffers live in it
 		auto ptr = static_cast<VulkanHostBuffer*>(pResource);
-		const auto device = VulkanContext::GetDevice();
-
-		try
-		{
-			if (ptr->mappedAddr != nullptr)
-				device.unmapMemory(ptr->deviceMemory);
-
-			// Destroy buffer first, then device memory.
-			if (ptr->buffer != nullptr)
-				device.destroyBuffer(ptr->buffer);
-
-			if (ptr->deviceMemory != nullptr)
-				device.freeMemory(ptr->deviceMemory);
-		}
-		catch (const vk::SystemError& e)
-		{
-			Logger::LogError("Failed to delete host buffer resource: {}", e.what());
-		}
-
+		DestroyBuffer(ptr);
 		delete ptr;
 	}
 
     VulkanResourcePtr VulkanHostBuffer::Create(vk::DeviceSize size, HostBufferUsage usage, bool coherentWithGpu)
     {
         vk::BufferUsageFlags usageFlag;
+		vk::MemoryPropertyFlags preferredFlag;
 		switch (usage)
 		{
 			case HostBufferUsage::TransferSrc:
 				usageFlag |= vk::BufferUsageFlagBits::eTransferSrc;
 				break;
+			case HostBufferUsage::Uniform:
+				// Read by shaders in place, device local when the device exposes such host visible memory
+				usageFlag |= vk::BufferUsageFlagBits::eUniformBuffer;
+				preferredFlag |= vk::MemoryPropertyFlagBits::eDeviceLocal;
+				break;
 			default:
 				Logger::LogError("Unknown cpu buffer usage type: {}", EnumReflection<HostBufferUsage>::ToString(usage));
 				return nullptr;
@@ -46,21 +35,13 @@ namespace Ailurus
 		if (coherentWithGpu)
 			propertyFlag |= vk::MemoryPropertyFlagBits::eHostCoherent;
 
-		const std::optional<CreatedBuffer> bufferRet = CreateBuffer(size, usageFlag, propertyFlag);
+		const std::optional<CreatedBuffer> bufferRet = CreateBuffer(size, usageFlag, propertyFlag, preferredFlag);
 		if (!bufferRet.has_value())
 			return nullptr;
 
-		// Map memory
-		try
-		{
-			void* mappedAddr = VulkanContext::GetDevice().mapMemory(bufferRet->deviceMem, 0, size, {});
-			VulkanHostBuffer* pBufferRaw = new VulkanHostBuffer(bufferRet->realSize, bufferRet->buffer, bufferRet->deviceMem, mappedAddr);
-            return VulkanResourcePtr(pBufferRaw, &HostBufferDeleter);
-		}
-		catch (const vk::SystemError& e)
-		{
-			Logger::LogError("Failed to map memory: {}", e.what());
-			return nullptr;
-		}
+		// Host visible blocks are mapped once by the memory allocator
+		VulkanHostBuffer* pBufferRaw = new VulkanHostBuffer(bufferRet->realSize, bufferRet->buffer,
+			bufferRet->memory, bufferRet->memory.mappedAddr);
+		return VulkanResourcePtr(pBufferRaw, &HostBufferDeleter);
     }
 }
\ No newline at end of file
@@ -7,7 +7,7 @@ namespace Ailurus
     class VulkanHostBuffer : public VulkanDataBuffer
 	{
 	public:
-		VulkanHostBuffer(vk::DeviceSize size, vk::Buffer buf, vk::DeviceMemory mem, void* addr)
+		VulkanHostBuffer(vk::DeviceSize size, vk::Buffer buf, const VulkanMemoryAllocation& mem, void* addr)
             : VulkanDataBuffer(size, buf, mem), mappedAddr(addr)
 	    {
 	    }
@@ -3,7 +3,7 @@
 #include "Ailurus/Utility/Logger.h"
 #include "Ailurus/Utility/Image.h"
 #include "VulkanContext/Resource/VulkanResourceManager.h"
-#include "VulkanContext/Resource/DataBuffer/VulkanHostBuffer.h"
+#include "VulkanContext/Upload/VulkanUploadManager.h"
 
 namespace Ailurus
 {
@@ -20,13 +20,11 @@ namespace Ailurus
 		if (image)
 			device.destroyImage(image);
 
-		auto memory = ptr->GetMemory();
-		if (memory)
-			device.freeMemory(memory);
+		VulkanContext::GetResourceManager()->GetMemoryAllocator()->Free(ptr->GetMemory());
 	}
 
 	VulkanImage::VulkanImage(uint32_t width, uint32_t height, vk::Format format,
-		vk::Image image, vk::DeviceMemory memory, vk::ImageView imageView,
+		vk::Image image, const VulkanMemoryAllocation& memory, vk::ImageView imageView,
 		uint32_t mipLevels, uint32_t arrayLayers, vk::ImageViewType viewType)
 		: _width(width)
 		, _height(height)
@@ -66,113 +64,27 @@ namespace Ailurus
 
 			// Allocate memory
 			vk::MemoryRequirements memRequirements = device.getImageMemoryRequirements(vkImage);
-			vk::PhysicalDeviceMemoryProperties memProperties = VulkanContext::GetPhysicalDevice().getMemoryProperties();
+			auto* pMemoryAllocator = pVulkanResManager->GetMemoryAllocator();
 
-			uint32_t memoryTypeIndex = UINT32_MAX;
-			for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++)
-			{
-				if ((memRequirements.memoryTypeBits & (1 << i)) &&
-					(memProperties.memoryTypes[i].propertyFlags & vk::MemoryPropertyFlagBits::eDeviceLocal))
-				{
-					memoryTypeIndex = i;
-					break;
-				}
-			}
-
-			if (memoryTypeIndex == UINT32_MAX)
+			const std::optional<uint32_t> memoryTypeIndex = pMemoryAllocator->FindMemoryType(
+				memRequirements.memoryTypeBits, vk::MemoryPropertyFlagBits::eDeviceLocal);
+			if (!memoryTypeIndex.has_value())
 			{
 				device.destroyImage(vkImage);
 				Logger::LogError("Failed to find suitable memory type for image");
 				return nullptr;
 			}
 
-			vk::MemoryAllocateInfo allocInfo;
-			allocInfo.setAllocationSize(memRequirements.size)
-				.setMemoryTypeIndex(memoryTypeIndex);
-
-			vk::DeviceMemory imageMemory = device.allocateMemory(allocInfo);
-			device.bindImageMemory(vkImage, imageMemory, 0);
-
-			// Create staging buffer
-			const size_t imageSize = width * height * 4;
-			VulkanHostBuffer* stagingBuffer = pVulkanResManager->CreateHostBuffer(imageSize, HostBufferUsage::TransferSrc);
-			if (!stagingBuffer)
+			const std::optional<VulkanMemoryAllocation> imageMemory = pMemoryAllocator->Allocate(
+				memRequirements, *memoryTypeIndex, VulkanMemoryTiling::Optimal);
+			if (!imageMemory.has_value())
 			{
 				device.destroyImage(vkImage);
-				device.freeMemory(imageMemory);
-				Logger::LogError("Failed to create staging buffer for image");
+				Logger::LogError("Failed to allocate memory for image");
 				return nullptr;
 			}
 
-			// Copy image data to staging buffer
-			std::memcpy(stagingBuffer->mappedAddr, image.GetBytesData(), imageSize);
-
-			// Create command buffer for transfer
-			vk::CommandPoolCreateInfo poolInfo;
-			poolInfo.setQueueFamilyIndex(VulkanContext::GetGraphicQueueIndex());
-			vk::CommandPool commandPool = device.createCommandPool(poolInfo);
-
-			vk::CommandBufferAllocateInfo allocInfo2;
-			allocInfo2.setCommandPool(commandPool)
-				.setLevel(vk::CommandBufferLevel::ePrimary)
-				.setCommandBufferCount(1);
-
-			vk::CommandBuffer commandBuffer = device.allocateCommandBuffers(allocInfo2)[0];
-
-			// Begin command buffer
-			vk::CommandBufferBeginInfo beginInfo;
-			beginInfo.setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
-			commandBuffer.begin(beginInfo);
-
-			// Transition image layout to transfer dst
-			vk::ImageMemoryBarrier barrier;
-			barrier.setOldLayout(vk::ImageLayout::eUndefined)
-				.setNewLayout(vk::ImageLayout::eTransferDstOptimal)
-				.setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
-				.setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
-				.setImage(vkImage)
-				.setSubresourceRange(vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1))
-				.setSrcAccessMask(vk::AccessFlagBits::eNone)
-				.setDstAccessMask(vk::AccessFlagBits::eTransferWrite);
-
-			commandBuffer.pipelineBarrier(
-				vk::PipelineStageFlagBits::eTopOfPipe,
-				vk::PipelineStageFlagBits::eTransfer,
-				{}, {}, {}, barrier);
-
-			// Copy buffer to image
-			vk::BufferImageCopy region;
-			region.setBufferOffset(0)
-				.setBufferRowLength(0)
-				.setBufferImageHeight(0)
-				.setImageSubresource(vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, 0, 0, 1))
-				.setImageOffset(vk::Offset3D(0, 0, 0))
-				.setImageExtent(vk::Extent3D(width, height, 1));
-
-			commandBuffer.copyBufferToImage(stagingBuffer->buffer, vkImage, vk::ImageLayout::eTransferDstOptimal, region);
-
-			// Transition image layout to shader read only
-			barrier.setOldLayout(vk::ImageLayout::eTransferDstOptimal)
-				.setNewLayout(vk::ImageLayout::eShaderReadOnlyOptimal)
-				.setSrcAccessMask(vk::AccessFlagBits::eTransferWrite)
-				.setDstAccessMask(vk::AccessFlagBits::eShaderRead);
-
-			commandBuffer.pipelineBarrier(
-				vk::PipelineStageFlagBits::eTransfer,
-				vk::PipelineStageFlagBits::eFragmentShader,
-				{}, {}, {}, barrier);
-
-			commandBuffer.end();
-
-			// Submit command buffer
-			vk::SubmitInfo submitInfo;
-			submitInfo.setCommandBuffers(commandBuffer);
-			VulkanContext::GetGraphicQueue().submit(submitInfo);
-			VulkanContext::GetGraphicQueue().waitIdle();
-
-			// Cleanup
-			device.destroyCommandPool(commandPool);
-			stagingBuffer->MarkDelete();
+			device.bindImageMemory(vkImage, imageMemory->memory, imageMemory->offset);
 
 			// Create image view
 			vk::ImageViewCreateInfo viewInfo;
@@ -183,8 +95,28 @@ namespace Ailurus
 
 			vk::ImageView imageView = device.createImageView(viewInfo);
 
-			VulkanImage* pImageRaw = new VulkanImage(width, height, format, vkImage, imageMemory, imageView);
-			return VulkanResourcePtr(pImageRaw, &ImageDeleter);
+			VulkanImage* pImageRaw = new VulkanImage(width, height, format, vkImage, *imageMemory, imageView);
+			VulkanResourcePtr pImage(pImageRaw, &ImageDeleter);
+
+			// Pixels reach the image through the upload batch, the frame sampling it waits for the batch
+			VulkanImageUpload upload;
+			upload.pImage = pImageRaw;
+			upload.regions.push_back(vk::BufferImageCopy()
+				.setBufferOffset(0)
+				.setBufferRowLength(0)
+				.setBufferImageHeight(0)
+				.setImageSubresource(vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, 0, 0, 1))
+				.setImageOffset(vk::Offset3D(0, 0, 0))
+				.setImageExtent(vk::Extent3D(width, height, 1)));
+
+			const size_t imageSize = width * height * 4;
+			if (VulkanContext::GetUploadManager()->UploadImage(upload, image.GetBytesData(), imageSize) == 0)
+			{
+				Logger::LogError("Failed to upload image data");
+				return nullptr;
+			}
+
+			return pImage;
 		}
 		catch (const vk::SystemError& e)
 		{
@@ -219,135 +151,28 @@ namespace Ailurus
 
 			// Allocate memory
 			vk::MemoryRequirements memRequirements = device.getImageMemoryRequirements(vkImage);
-			vk::PhysicalDeviceMemoryProperties memProperties = VulkanContext::GetPhysicalDevice().getMemoryProperties();
+			auto* pMemoryAllocator = pVulkanResManager->GetMemoryAllocator();
 
-			uint32_t memoryTypeIndex = UINT32_MAX;
-			for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++)
-			{
-				if ((memRequirements.memoryTypeBits & (1 << i)) &&
-					(memProperties.memoryTypes[i].propertyFlags & vk::MemoryPropertyFlagBits::eDeviceLocal))
-				{
-					memoryTypeIndex = i;
-					break;
-				}
-			}
-
-			if (memoryTypeIndex == UINT32_MAX)
+			const std::optional<uint32_t> memoryTypeIndex = pMemoryAllocator->FindMemoryType(
+				memRequirements.memoryTypeBits, vk::MemoryPropertyFlagBits::eDeviceLocal);
+			if (!memoryTypeIndex.has_value())
 			{
 				device.destroyImage(vkImage);
 				Logger::LogError("Failed to find suitable memory type for image");
 				return nullptr;
 			}
 
-			vk::MemoryAllocateInfo allocInfo;
-			allocInfo.setAllocationSize(memRequirements.size)
-				.setMemoryTypeIndex(memoryTypeIndex);
-
-			vk::DeviceMemory imageMemory = device.allocateMemory(allocInfo);
-			device.bindImageMemory(vkImage, imageMemory, 0);
-
-			// Upload pixel data if provided
-			if (pixelData != nullptr && dataSize > 0)
+			const std::optional<VulkanMemoryAllocation> imageMemory = pMemoryAllocator->Allocate(
+				memRequirements, *memoryTypeIndex, VulkanMemoryTiling::Optimal);
+			if (!imageMemory.has_value())
 			{
-				VulkanHostBuffer* stagingBuffer = pVulkanResManager->CreateHostBuffer(dataSize, HostBufferUsage::TransferSrc);
-				if (!stagingBuffer)
-				{
-					device.destroyImage(vkImage);
-					device.freeMemory(imageMemory);
-					Logger::LogError("Failed to create staging buffer for image");
-					return nullptr;
-				}
-
-				std::memcpy(stagingBuffer->mappedAddr, pixelData, dataSize);
-
-				// Create command buffer for transfer
-				vk::CommandPoolCreateInfo poolInfo;
-				poolInfo.setQueueFamilyIndex(VulkanContext::GetGraphicQueueIndex());
-				vk::CommandPool commandPool = device.createCommandPool(poolInfo);
-
-				vk::CommandBufferAllocateInfo allocInfo2;
-				allocInfo2.setCommandPool(commandPool)
-					.setLevel(vk::CommandBufferLevel::ePrimary)
-					.setCommandBufferCount(1);
-
-				vk::CommandBuffer commandBuffer = device.allocateCommandBuffers(allocInfo2)[0];
-
-				vk::CommandBufferBeginInfo beginInfo;
-				beginInfo.setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
-				commandBuffer.begin(beginInfo);
-
-				// Transition image layout to transfer dst (all mips and layers)
-				vk::ImageMemoryBarrier barrier;
-				barrier.setOldLayout(vk::ImageLayout::eUndefined)
-					.setNewLayout(vk::ImageLayout::eTransferDstOptimal)
-					.setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
-					.setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
-					.setImage(vkImage)
-					.setSubresourceRange(vk::ImageSubresourceRange(
-						config.aspectMask, 0, config.mipLevels, 0, config.arrayLayers))
-					.setSrcAccessMask(vk::AccessFlagBits::eNone)
-					.setDstAccessMask(vk::AccessFlagBits::eTransferWrite);
-
-				commandBuffer.pipelineBarrier(
-					vk::PipelineStageFlagBits::eTopOfPipe,
-					vk::PipelineStageFlagBits::eTransfer,
-					{}, {}, {}, barrier);
-
-				// Copy buffer to image — handle multi-layer (cubemap) upload
-				if (config.arrayLayers > 1)
-				{
-					const size_t faceSize = dataSize / config.arrayLayers;
-					std::vector<vk::BufferImageCopy> regions(config.arrayLayers);
-					for (uint32_t i = 0; i < config.arrayLayers; i++)
-					{
-						regions[i].setBufferOffset(i * faceSize)
-							.setBufferRowLength(0)
-							.setBufferImageHeight(0)
-							.setImageSubresource(vk::ImageSubresourceLayers(
-								config.aspectMask, 0, i, 1))
-							.setImageOffset(vk::Offset3D(0, 0, 0))
-							.setImageExtent(vk::Extent3D(config.width, config.height, 1));
-					}
-					commandBuffer.copyBufferToImage(stagingBuffer->buffer, vkImage,
-						vk::ImageLayout::eTransferDstOptimal, regions);
-				}
-				else
-				{
-					vk::BufferImageCopy region;
-					region.setBufferOffset(0)
-						.setBufferRowLength(0)
-						.setBufferImageHeight(0)
-						.setImageSubresource(vk::ImageSubresourceLayers(
-							config.aspectMask, 0, 0, 1))
-						.setImageOffset(vk::Offset3D(0, 0, 0))
-						.setImageExtent(vk::Extent3D(config.width, config.height, 1));
-
-					commandBuffer.copyBufferToImage(stagingBuffer->buffer, vkImage,
-						vk::ImageLayout::eTransferDstOptimal, region);
-				}
-
-				// Transition image layout to shader read only
-				barrier.setOldLayout(vk::ImageLayout::eTransferDstOptimal)
-					.setNewLayout(vk::ImageLayout::eShaderReadOnlyOptimal)
-					.setSrcAccessMask(vk::AccessFlagBits::eTransferWrite)
-					.setDstAccessMask(vk::AccessFlagBits::eShaderRead);
-
-				commandBuffer.pipelineBarrier(
-					vk::PipelineStageFlagBits::eTransfer,
-					vk::PipelineStageFlagBits::eFragmentShader,
-					{}, {}, {}, barrier);
-
-				commandBuffer.end();
-
-				vk::SubmitInfo submitInfo;
-				submitInfo.setCommandBuffers(commandBuffer);
-				VulkanContext::GetGraphicQueue().submit(submitInfo);
-				VulkanContext::GetGraphicQueue().waitIdle();
-
-				device.destroyCommandPool(commandPool);
-				stagingBuffer->MarkDelete();
+				device.destroyImage(vkImage);
+				Logger::LogError("Failed to allocate memory for image");
+				return nullptr;
 			}
 
+			device.bindImageMemory(vkImage, imageMemory->memory, imageMemory->offset);
+
 			// Create image view
 			vk::ImageViewCreateInfo viewInfo;
 			viewInfo.setImage(vkImage)
@@ -359,8 +184,38 @@ namespace Ailurus
 			vk::ImageView imageView = device.createImageView(viewInfo);
 
 			VulkanImage* pImageRaw = new VulkanImage(config.width, config.height, config.format,
-				vkImage, imageMemory, imageView, config.mipLevels, config.arrayLayers, config.viewType);
-			return VulkanResourcePtr(pImageRaw, &ImageDeleter);
+				vkImage, *imageMemory, imageView, config.mipLevels, config.arrayLayers, config.viewType);
+			VulkanResourcePtr pImage(pImageRaw, &ImageDeleter);
+
+			// Upload pixel data if provided, one region per layer (cubemap faces) into mip 0
+			if (pixelData != nullptr && dataSize > 0)
+			{
+				VulkanImageUpload upload;
+				upload.pImage = pImageRaw;
+				upload.aspectMask = config.aspectMask;
+				upload.mipLevels = config.mipLevels;
+				upload.arrayLayers = config.arrayLayers;
+
+				const size_t layerSize = dataSize / config.arrayLayers;
+				for (uint32_t i = 0; i < config.arrayLayers; i++)
+				{
+					upload.regions.push_back(vk::BufferImageCopy()
+						.setBufferOffset(i * layerSize)
+						.setBufferRowLength(0)
+						.setBufferImageHeight(0)
+						.setImageSubresource(vk::ImageSubresourceLayers(config.aspectMask, 0, i, 1))
+						.setImageOffset(vk::Offset3D(0, 0, 0))
+						.setImageExtent(vk::Extent3D(config.width, config.height, 1)));
+				}
+
+				if (VulkanContext::GetUploadManager()->UploadImage(upload, pixelData, dataSize) == 0)
+				{
+					Logger::LogError("Failed to upload image data");
+					return nullptr;
+				}
+			}
+
+			return pImage;
 		}
 		catch (const vk::SystemError& e)
 		{
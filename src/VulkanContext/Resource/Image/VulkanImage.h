@@ -3,6 +3,7 @@
 #include <cstdint>
 #include "VulkanContext/VulkanPch.h"
 #include "VulkanContext/Resource/VulkanResource.h"
+#include "VulkanContext/Resource/Memory/VulkanMemoryAllocator.h"
 
 namespace Ailurus
 {
@@ -28,7 +29,7 @@ namespace Ailurus
 
 	public:
 		VulkanImage(uint32_t width, uint32_t height, vk::Format format,
-			vk::Image image, vk::DeviceMemory memory, vk::ImageView imageView,
+			vk::Image image, const VulkanMemoryAllocation& memory, vk::ImageView imageView,
 			uint32_t mipLevels = 1, uint32_t arrayLayers = 1,
 			vk::ImageViewType viewType = vk::ImageViewType::e2D);
 
@@ -38,7 +39,7 @@ namespace Ailurus
 		auto GetFormat() const -> vk::Format { return _format; }
 		auto GetImage() const -> vk::Image { return _image; }
 		auto GetImageView() const -> vk::ImageView { return _imageView; }
-		auto GetMemory() const -> vk::DeviceMemory { return _memory; }
+		auto GetMemory() const -> const VulkanMemoryAllocation& { return _memory; }
 		auto GetMipLevels() const -> uint32_t { return _mipLevels; }
 		auto GetArrayLayers() const -> uint32_t { return _arrayLayers; }
 		auto GetViewType() const -> vk::ImageViewType { return _viewType; }
@@ -48,7 +49,7 @@ namespace Ailurus
 		uint32_t _height;
 		vk::Format _format;
 		vk::Image _image;
-		vk::DeviceMemory _memory;
+		VulkanMemoryAllocation _memory;
 		vk::ImageView _imageView;
 		uint32_t _mipLevels = 1;
 		uint32_t _arrayLayers = 1;
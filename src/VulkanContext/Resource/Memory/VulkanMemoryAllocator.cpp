@@ -0,0 +1,294 @@
+#include "VulkanMemoryAllocator.h"
+#include <algorithm>
+#include "VulkanContext/VulkanContext.h"
+#include "Ailurus/Utility/Logger.h"
+
+namespace Ailurus
+{
+	VulkanMemoryAllocator::VulkanMemoryAllocator()
+	{
+		const auto physicalDevice = VulkanContext::GetPhysicalDevice();
+		_memoryProperties = physicalDevice.getMemoryProperties();
+
+		const vk::PhysicalDeviceLimits limits = physicalDevice.getProperties().limits;
+		_bufferImageGranularity = std::max<vk::DeviceSize>(limits.bufferImageGranularity, 1);
+		_nonCoherentAtomSize = std::max<vk::DeviceSize>(limits.nonCoherentAtomSize, 1);
+
+		// Linear and optimal resources only need pools of their own when they could share a page
+		_poolBlocks.resize(_memoryProperties.memoryTypeCount * 2);
+
+		_heapStats.resize(_memoryProperties.memoryHeapCount);
+		for (uint32_t i = 0; i < _memoryProperties.memoryHeapCount; i++)
+			_heapStats[i].heapSize = _memoryProperties.memoryHeaps[i].size;
+	}
+
+	VulkanMemoryAllocator::~VulkanMemoryAllocator()
+	{
+		for (uint32_t i = 0; i < _blocks.size(); i++)
+		{
+			if (_blocks[i] == nullptr)
+				continue;
+
+			if (!_blocks[i]->pRanges->IsEmpty())
+			{
+				Logger::LogWarn("Device memory block of type {} still has {} allocations when destroyed",
+					_blocks[i]->memoryTypeIndex, _blocks[i]->pRanges->GetAllocationCount());
+			}
+
+			ReleaseBlock(i);
+		}
+	}
+
+	auto VulkanMemoryAllocator::FindMemoryType(uint32_t typeBits, vk::MemoryPropertyFlags required,
+		vk::MemoryPropertyFlags preferred) const -> std::optional<uint32_t>
+	{
+		for (const vk::MemoryPropertyFlags wantedFlag : { required | preferred, required })
+		{
+			for (uint32_t i = 0; i < _memoryProperties.memoryTypeCount; i++)
+			{
+				if ((typeBits & (1 << i)) && (_memoryProperties.memoryTypes[i].propertyFlags & wantedFlag) == wantedFlag)
+					return i;
+			}
+		}
+
+		return std::nullopt;
+	}
+
+	auto VulkanMemoryAllocator::Allocate(const vk::MemoryRequirements& requirements, uint32_t memoryTypeIndex,
+		VulkanMemoryTiling tiling) -> std::optional<VulkanMemoryAllocation>
+	{
+		std::lock_guard lock(_mutex);
+
+		const vk::DeviceSize blockSize = GetBlockSize(memoryTypeIndex);
+		if (requirements.size > blockSize / 2)
+			return AllocateDedicated(requirements.size, memoryTypeIndex);
+
+		// Flushes of non coherent memory work on whole atoms, an allocation must not share one
+		vk::DeviceSize alignment = std::max<vk::DeviceSize>(requirements.alignment, 1);
+		vk::DeviceSize size = requirements.size;
+		const auto propertyFlags = _memoryProperties.memoryTypes[memoryTypeIndex].propertyFlags;
+		if ((propertyFlags & vk::MemoryPropertyFlagBits::eHostVisible)
+			&& !(propertyFlags & vk::MemoryPropertyFlagBits::eHostCoherent))
+		{
+			alignment = std::max(alignment, _nonCoherentAtomSize);
+			size = (size + _nonCoherentAtomSize - 1) / _nonCoherentAtomSize * _nonCoherentAtomSize;
+		}
+
+		const uint32_t poolIndex = GetPoolIndex(memoryTypeIndex, tiling);
+		auto& poolBlocks = _poolBlocks[poolIndex];
+
+		TlsfRangeAllocator::Allocation range;
+		uint32_t blockIndex = UINT32_MAX;
+		for (const uint32_t index : poolBlocks)
+		{
+			range = _blocks[index]->pRanges->Allocate(size, alignment);
+			if (range.node != TlsfRangeAllocator::INVALID_NODE)
+			{
+				blockIndex = index;
+				break;
+			}
+		}
+
+		if (blockIndex == UINT32_MAX)
+		{
+			blockIndex = CreateBlock(memoryTypeIndex, poolIndex);
+			if (blockIndex == UINT32_MAX)
+				return std::nullopt;
+
+			range = _blocks[blockIndex]->pRanges->Allocate(size, alignment);
+			if (range.node == TlsfRangeAllocator::INVALID_NODE)
+				return std::nullopt;
+		}
+
+		const Block& block = *_blocks[blockIndex];
+
+		auto& heapStats = _heapStats[_memoryProperties.memoryTypes[memoryTypeIndex].heapIndex];
+		heapStats.usedBytes += size;
+		heapStats.allocationCount++;
+
+		VulkanMemoryAllocation allocation;
+		allocation.memory = block.memory;
+		allocation.offset = range.offset;
+		allocation.size = size;
+		allocation.mappedAddr = block.mappedAddr != nullptr ? static_cast<uint8_t*>(block.mappedAddr) + range.offset : nullptr;
+		allocation.memoryTypeIndex = memoryTypeIndex;
+		allocation.blockIndex = blockIndex;
+		allocation.node = range.node;
+		return allocation;
+	}
+
+	auto VulkanMemoryAllocator::Free(const VulkanMemoryAllocation& allocation) -> void
+	{
+		if (!allocation.memory)
+			return;
+
+		std::lock_guard lock(_mutex);
+
+		auto& heapStats = _heapStats[_memoryProperties.memoryTypes[allocation.memoryTypeIndex].heapIndex];
+		heapStats.usedBytes -= allocation.size;
+		heapStats.allocationCount--;
+
+		if (allocation.blockIndex == UINT32_MAX)
+		{
+			// Freeing a mapped memory unmaps it
+			VulkanContext::GetDevice().freeMemory(allocation.memory);
+			heapStats.blockBytes -= allocation.size;
+			heapStats.dedicatedCount--;
+			return;
+		}
+
+		Block& block = *_blocks[allocation.blockIndex];
+		block.pRanges->Free(allocation.node);
+		if (!block.pRanges->IsEmpty())
+			return;
+
+		// Keep one empty block per pool so a resource freed and created every frame does not
+		// allocate device memory every frame
+		auto& poolBlocks = _poolBlocks[block.poolIndex];
+		const bool hasOtherEmptyBlock = std::any_of(poolBlocks.begin(), poolBlocks.end(), [&](uint32_t index) -> bool {
+			return index != allocation.blockIndex && _blocks[index]->pRanges->IsEmpty();
+		});
+
+		if (hasOtherEmptyBlock)
+			ReleaseBlock(allocation.blockIndex);
+	}
+
+	auto VulkanMemoryAllocator::GetHeapStats() const -> std::vector<VulkanMemoryHeapStats>
+	{
+		std::lock_guard lock(_mutex);
+		return _heapStats;
+	}
+
+	auto VulkanMemoryAllocator::LogHeapStats() const -> void
+	{
+		const auto heapStats = GetHeapStats();
+		for (size_t i = 0; i < heapStats.size(); i++)
+		{
+			const auto& stats = heapStats[i];
+			Logger::LogInfo("Memory heap {}: {} / {} MiB used in {} blocks and {} dedicated, {} allocations, heap {} MiB",
+				i, stats.usedBytes >> 20, stats.blockBytes >> 20, stats.blockCount, stats.dedicatedCount,
+				stats.allocationCount, stats.heapSize >> 20);
+		}
+	}
+
+	auto VulkanMemoryAllocator::GetPoolIndex(uint32_t memoryTypeIndex, VulkanMemoryTiling tiling) const -> uint32_t
+	{
+		const bool separateTiling = _bufferImageGranularity > 1 && tiling == VulkanMemoryTiling::Optimal;
+		return memoryTypeIndex * 2 + (separateTiling ? 1 : 0);
+	}
+
+	auto VulkanMemoryAllocator::GetBlockSize(uint32_t memoryTypeIndex) const -> vk::DeviceSize
+	{
+		// Small heaps (integrated or host visible device local) get blocks of an eighth of the heap
+		const uint32_t heapIndex = _memoryProperties.memoryTypes[memoryTypeIndex].heapIndex;
+		const vk::DeviceSize heapSize = _memoryProperties.memoryHeaps[heapIndex].size;
+		if (heapSize <= SMALL_HEAP_SIZE)
+			return std::min(PREFERRED_BLOCK_SIZE, heapSize / 8);
+
+		return PREFERRED_BLOCK_SIZE;
+	}
+
+	auto VulkanMemoryAllocator::AllocateDeviceMemory(vk::DeviceSize size, uint32_t memoryTypeIndex,
+		void** ppMappedAddr) -> vk::DeviceMemory
+	{
+		const auto device = VulkanContext::GetDevice();
+
+		vk::MemoryAllocateInfo allocInfo;
+		allocInfo.setAllocationSize(size)
+			.setMemoryTypeIndex(memoryTypeIndex);
+
+		try
+		{
+			const vk::DeviceMemory memory = device.allocateMemory(allocInfo);
+
+			*ppMappedAddr = nullptr;
+			if (_memoryProperties.memoryTypes[memoryTypeIndex].propertyFlags & vk::MemoryPropertyFlagBits::eHostVisible)
+				*ppMappedAddr = device.mapMemory(memory, 0, VK_WHOLE_SIZE, {});
+
+			return memory;
+		}
+		catch (const vk::SystemError& e)
+		{
+			Logger::LogError("Failed to allocate {} bytes of device memory of type {}: {}", size, memoryTypeIndex, e.what());
+			return nullptr;
+		}
+	}
+
+	auto VulkanMemoryAllocator::AllocateDedicated(vk::DeviceSize size, uint32_t memoryTypeIndex) -> std::optional<VulkanMemoryAllocation>
+	{
+		void* mappedAddr = nullptr;
+		const vk::DeviceMemory memory = AllocateDeviceMemory(size, memoryTypeIndex, &mappedAddr);
+		if (!memory)
+			return std::nullopt;
+
+		auto& heapStats = _heapStats[_memoryProperties.memoryTypes[memoryTypeIndex].heapIndex];
+		heapStats.blockBytes += size;
+		heapStats.usedBytes += size;
+		heapStats.dedicatedCount++;
+		heapStats.allocationCount++;
+
+		VulkanMemoryAllocation allocation;
+		allocation.memory = memory;
+		allocation.size = size;
+		allocation.mappedAddr = mappedAddr;
+		allocation.memoryTypeIndex = memoryTypeIndex;
+		return allocation;
+	}
+
+	auto VulkanMemoryAllocator::CreateBlock(uint32_t memoryTypeIndex, uint32_t poolIndex) -> uint32_t
+	{
+		const vk::DeviceSize blockSize = GetBlockSize(memoryTypeIndex);
+
+		auto pBlock = std::make_unique<Block>();
+		pBlock->memory = AllocateDeviceMemory(blockSize, memoryTypeIndex, &pBlock->mappedAddr);
+		if (!pBlock->memory)
+			return UINT32_MAX;
+
+		pBlock->memoryTypeIndex = memoryTypeIndex;
+		pBlock->poolIndex = poolIndex;
+		pBlock->pRanges = std::make_unique<TlsfRangeAllocator>(blockSize);
+
+		uint32_t blockIndex;
+		if (!_freeBlockSlots.empty())
+		{
+			blockIndex = _freeBlockSlots.back();
+			_freeBlockSlots.pop_back();
+			_blocks[blockIndex] = std::move(pBlock);
+		}
+		else
+		{
+			blockIndex = static_cast<uint32_t>(_blocks.size());
+			_blocks.push_back(std::move(pBlock));
+		}
+
+		_poolBlocks[poolIndex].push_back(blockIndex);
+
+		auto& heapStats = _heapStats[_memoryProperties.memoryTypes[memoryTypeIndex].heapIndex];
+		heapStats.blockBytes += blockSize;
+		heapStats.blockCount++;
+
+		return blockIndex;
+	}
+
+	auto VulkanMemoryAllocator::ReleaseBlock(uint32_t blockIndex) -> void
+	{
+		const Block& block = *_blocks[blockIndex];
+
+		try
+		{
+			VulkanContext::GetDevice().freeMemory(block.memory);
+		}
+		catch (const vk::SystemError& e)
+		{
+			Logger::LogError("Failed to free device memory block: {}", e.what());
+		}
+
+		auto& heapStats = _heapStats[_memoryProperties.memoryTypes[block.memoryTypeIndex].heapIndex];
+		heapStats.blockBytes -= block.pRanges->GetCapacity();
+		heapStats.blockCount--;
+
+		std::erase(_poolBlocks[block.poolIndex], blockIndex);
+		_blocks[blockIndex] = nullptr;
+		_freeBlockSlots.push_back(blockIndex);
+	}
+} // namespace Ailurus
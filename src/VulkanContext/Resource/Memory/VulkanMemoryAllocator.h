@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+#include "VulkanContext/VulkanPch.h"
+#include <Ailurus/Container/TlsfRangeAllocator.hpp>
+#include <Ailurus/Utility/NonCopyable.h>
+#include <Ailurus/Utility/NonMovable.h>
+
+namespace Ailurus
+{
+	/// Tiling of the resource bound to an allocation. Linear (buffers) and optimal (images)
+	/// resources are kept in different blocks when bufferImageGranularity could make them alias.
+	enum class VulkanMemoryTiling
+	{
+		Linear,
+		Optimal
+	};
+
+	struct VulkanMemoryAllocation
+	{
+		vk::DeviceMemory memory = nullptr;
+		vk::DeviceSize offset = 0;
+		vk::DeviceSize size = 0;
+		void* mappedAddr = nullptr; // Start of the allocation when the memory is host visible
+		uint32_t memoryTypeIndex = 0;
+		uint32_t blockIndex = UINT32_MAX; // UINT32_MAX for a dedicated device memory
+		uint32_t node = TlsfRangeAllocator::INVALID_NODE;
+	};
+
+	struct VulkanMemoryHeapStats
+	{
+		vk::DeviceSize heapSize = 0;
+		vk::DeviceSize blockBytes = 0; // Device memory allocated from the heap
+		vk::DeviceSize usedBytes = 0; // Handed out to resources
+		uint32_t blockCount = 0;
+		uint32_t dedicatedCount = 0;
+		uint32_t allocationCount = 0;
+	};
+
+	/// Carves large device memory blocks per memory type into sub-allocations, so resources do
+	/// not each cost a vkAllocateMemory against maxMemoryAllocationCount. Host visible blocks are
+	/// mapped once for their whole lifetime. Requests larger than half a block get their own memory.
+	class VulkanMemoryAllocator : public NonCopyable, public NonMovable
+	{
+	public:
+		VulkanMemoryAllocator();
+		~VulkanMemoryAllocator();
+
+	public:
+		/// Memory type in typeBits with the required properties, one with the preferred ones too first
+		auto FindMemoryType(uint32_t typeBits, vk::MemoryPropertyFlags required,
+			vk::MemoryPropertyFlags preferred = {}) const -> std::optional<uint32_t>;
+
+		auto Allocate(const vk::MemoryRequirements& requirements, uint32_t memoryTypeIndex,
+			VulkanMemoryTiling tiling) -> std::optional<VulkanMemoryAllocation>;
+		auto Free(const VulkanMemoryAllocation& allocation) -> void;
+
+		/// One entry per memory heap of the physical device
+		auto GetHeapStats() const -> std::vector<VulkanMemoryHeapStats>;
+		auto LogHeapStats() const -> void;
+
+	private:
+		struct Block
+		{
+			vk::DeviceMemory memory = nullptr;
+			void* mappedAddr = nullptr;
+			uint32_t memoryTypeIndex = 0;
+			uint32_t poolIndex = 0;
+			std::unique_ptr<TlsfRangeAllocator> pRanges;
+		};
+
+		auto GetPoolIndex(uint32_t memoryTypeIndex, VulkanMemoryTiling tiling) const -> uint32_t;
+		auto GetBlockSize(uint32_t memoryTypeIndex) const -> vk::DeviceSize;
+		auto AllocateDeviceMemory(vk::DeviceSize size, uint32_t memoryTypeIndex, void** ppMappedAddr) -> vk::DeviceMemory;
+		auto AllocateDedicated(vk::DeviceSize size, uint32_t memoryTypeIndex) -> std::optional<VulkanMemoryAllocation>;
+		auto CreateBlock(uint32_t memoryTypeIndex, uint32_t poolIndex) -> uint32_t;
+		auto ReleaseBlock(uint32_t blockIndex) -> void;
+
+	private:
+		static constexpr vk::DeviceSize PREFERRED_BLOCK_SIZE = 64 * 1024 * 1024;
+		static constexpr vk::DeviceSize SMALL_HEAP_SIZE = 1024 * 1024 * 1024;
+
+		vk::PhysicalDeviceMemoryProperties _memoryProperties;
+		vk::DeviceSize _bufferImageGranularity = 1;
+		vk::DeviceSize _nonCoherentAtomSize = 1;
+
+		mutable std::mutex _mutex;
+		std::vector<std::unique_ptr<Block>> _blocks; // Released blocks leave a nullptr slot
+		std::vector<uint32_t> _freeBlockSlots;
+		std::vector<std::vector<uint32_t>> _poolBlocks; // Block indices per memory type and tiling
+		std::vector<VulkanMemoryHeapStats> _heapStats;
+	};
+} // namespace Ailurus
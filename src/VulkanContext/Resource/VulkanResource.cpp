@@ -1,7 +1,6 @@
-#include <vulkan/vulkan_hash.hpp>
 #include "VulkanResource.h"
-#include "Ailurus/Utility/Logger.h"
-#include "VulkanContext/CommandBuffer/VulkanCommandBuffer.h"
+#include "VulkanContext/VulkanContext.h"
+#include "VulkanContext/Resource/VulkanResourceManager.h"
 
 namespace Ailurus
 {
@@ -9,26 +8,17 @@ namespace Ailurus
 	{
 	}
 
-    VulkanResource::~VulkanResource()
-    {
-        if (!_referencedCommandBuffer.empty())
-            Logger::LogError("VulkanResource has non-zero reference count on destruction: " + std::to_string(_referencedCommandBuffer.size()));
-    }
-
-	void VulkanResource::AddRef(const VulkanCommandBuffer& pCommandBuffer)
-	{
-		_referencedCommandBuffer.insert(pCommandBuffer.GetBuffer());
-	}
-
-	void VulkanResource::RemoveRef(const VulkanCommandBuffer& pCommandBuffer)
+	VulkanResource::~VulkanResource()
 	{
-		_referencedCommandBuffer.erase(pCommandBuffer.GetBuffer());
 	}
 
 	void VulkanResource::MarkDelete()
 	{
+		if (_markDeleted)
+			return;
 
 		_markDeleted = true;
+		VulkanContext::GetResourceManager()->EnqueueDelete(this);
 	}
 
 	bool VulkanResource::IsMarkDeleted() const
@@ -36,8 +26,8 @@ namespace Ailurus
 		return _markDeleted;
 	}
 
-	size_t VulkanResource::GetRefCount() const
+	VulkanResourceHandle VulkanResource::GetHandle() const
 	{
-		return _referencedCommandBuffer.size();
+		return _handle;
 	}
-} // namespace Ailurus
\ No newline at end of file
+} // namespace Ailurus
@@ -1,32 +1,37 @@
 #pragma once
 
 #include "VulkanContext/VulkanPch.h"
-#include <cstdint>
-#include <unordered_set>
+#include <memory>
 #include <functional>
 #include "Ailurus/Utility/NonCopyable.h"
 #include "Ailurus/Utility/NonMovable.h"
-#include "VulkanContext/Helper/HashHelper.hpp"
+#include "Ailurus/Container/SlotMap.hpp"
 
 namespace Ailurus
 {
+	using VulkanResourceHandle = SlotMapHandle;
+
 	class VulkanResource: public NonCopyable, public NonMovable
 	{
+		friend class VulkanResourceManager;
+
 	public:
 		VulkanResource();
 		virtual ~VulkanResource();
 
 	public:
-		void AddRef(const class VulkanCommandBuffer& pCommandBuffer);
-		void RemoveRef(const class VulkanCommandBuffer& pCommandBuffer);
-		size_t GetRefCount() const;
+		/// Queue the resource for deletion, it is freed once the frame being recorded and the
+		/// uploads recorded so far have finished on the GPU. Must not be used in later frames.
 		void MarkDelete();
 		bool IsMarkDeleted() const;
 
+		/// Slot in the resource manager, resolves to nullptr once the resource has been freed
+		VulkanResourceHandle GetHandle() const;
+
 	private:
 		bool _markDeleted = false;
-		VkObjectSet<vk::CommandBuffer> _referencedCommandBuffer;
+		VulkanResourceHandle _handle;
 	};
 
 	using VulkanResourcePtr = std::unique_ptr<VulkanResource, std::function<void(VulkanResource*)>>;
-} // namespace Ailurus
\ No newline at end of file
+} // namespace Ailurus
@@ -5,112 +5,102 @@
 #include "VulkanContext/Resource/VulkanResource.h"
 #include "VulkanContext/Resource/Image/VulkanImage.h"
 #include "VulkanContext/Resource/Image/VulkanSampler.h"
+#include "VulkanContext/Resource/Memory/VulkanMemoryAllocator.h"
 #include "VulkanContext/VulkanContext.h"
+#include "VulkanContext/Upload/VulkanUploadManager.h"
 
 namespace Ailurus
 {
-	VulkanResourceManager::~VulkanResourceManager()
+	VulkanResourceManager::VulkanResourceManager()
+		: _pMemoryAllocator(std::make_unique<VulkanMemoryAllocator>())
 	{
 	}
 
-	VulkanDeviceBuffer* VulkanResourceManager::CreateDeviceBuffer(vk::DeviceSize size, DeviceBufferUsage usage)
+	VulkanResourceManager::~VulkanResourceManager()
 	{
-		auto ptr = VulkanDeviceBuffer::Create(size, usage);
-		if (ptr == nullptr)
-			return nullptr;
+		// Device is idle, whatever is still queued goes now, before the memory allocator
+		_pendingDeletes.clear();
+		_resources.Clear();
+	}
 
-		VulkanDeviceBuffer* pBufferRaw = static_cast<VulkanDeviceBuffer*>(ptr.get());
-		_resources.push_back(std::move(ptr));
+	VulkanMemoryAllocator* VulkanResourceManager::GetMemoryAllocator() const
+	{
+		return _pMemoryAllocator.get();
+	}
 
-		return pBufferRaw;
+	VulkanDeviceBuffer* VulkanResourceManager::CreateDeviceBuffer(vk::DeviceSize size, DeviceBufferUsage usage)
+	{
+		return Register<VulkanDeviceBuffer>(VulkanDeviceBuffer::Create(size, usage));
 	}
 
 	VulkanHostBuffer* VulkanResourceManager::CreateHostBuffer(vk::DeviceSize size, HostBufferUsage usage, bool coherentWithGpu)
 	{
-		auto ptr = VulkanHostBuffer::Create(size, usage, coherentWithGpu);
-		if (ptr == nullptr)
-			return nullptr;
-
-		VulkanHostBuffer* pBufferRaw = static_cast<VulkanHostBuffer*>(ptr.get());
-		_resources.push_back(std::move(ptr));
-
-		return pBufferRaw;
+		return Register<VulkanHostBuffer>(VulkanHostBuffer::Create(size, usage, coherentWithGpu));
 	}
 
 	VulkanImage* VulkanResourceManager::CreateImage(const Image& image)
 	{
-		auto ptr = VulkanImage::Create(image);
-		if (ptr == nullptr)
-			return nullptr;
-
-		VulkanImage* pImageRaw = static_cast<VulkanImage*>(ptr.get());
-		_resources.push_back(std::move(ptr));
-
-		return pImageRaw;
+		return Register<VulkanImage>(VulkanImage::Create(image));
 	}
 
 	VulkanImage* VulkanResourceManager::CreateImageFromConfig(const VulkanImageCreateConfig& config,
 		const void* pixelData, size_t dataSize)
 	{
-		auto ptr = VulkanImage::CreateFromConfig(config, pixelData, dataSize);
-		if (ptr == nullptr)
-			return nullptr;
-
-		VulkanImage* pImageRaw = static_cast<VulkanImage*>(ptr.get());
-		_resources.push_back(std::move(ptr));
-
-		return pImageRaw;
+		return Register<VulkanImage>(VulkanImage::CreateFromConfig(config, pixelData, dataSize));
 	}
 
 	VulkanSampler* VulkanResourceManager::CreateSampler()
 	{
-		auto ptr = VulkanSampler::Create();
-		if (ptr == nullptr)
-			return nullptr;
+		return Register<VulkanSampler>(VulkanSampler::Create());
+	}
+
+	VulkanSampler* VulkanResourceManager::CreateSampler(const VulkanSamplerCreateConfig& config)
+	{
+		return Register<VulkanSampler>(VulkanSampler::CreateFromConfig(config));
+	}
 
-		VulkanSampler* pSamplerRaw = static_cast<VulkanSampler*>(ptr.get());
-		_resources.push_back(std::move(ptr));
+	void VulkanResourceManager::EnqueueDelete(VulkanResource* pResource)
+	{
+		// Copies into or out of the resource may still sit in an upload batch the frame does not wait for
+		const auto pUploadManager = VulkanContext::GetUploadManager();
+		const uint64_t uploadValue = pUploadManager != nullptr ? pUploadManager->GetRecordedValue() : 0;
 
-		return pSamplerRaw;
+		_pendingDeletes.push_back(PendingDelete{ pResource->GetHandle(), VulkanContext::GetFrameNumber(), uploadValue });
 	}
 
-	VulkanSampler* VulkanResourceManager::CreateSampler(const VulkanSamplerCreateConfig& config)
+	bool VulkanResourceManager::IsAlive(VulkanResourceHandle handle) const
 	{
-		auto ptr = VulkanSampler::CreateFromConfig(config);
-		if (ptr == nullptr)
-			return nullptr;
+		return _resources.Contains(handle);
+	}
 
-		VulkanSampler* pSamplerRaw = static_cast<VulkanSampler*>(ptr.get());
-		_resources.push_back(std::move(ptr));
+	size_t VulkanResourceManager::GetResourceCount() const
+	{
+		return _resources.Size();
+	}
 
-		return pSamplerRaw;
+	size_t VulkanResourceManager::GetPendingDeleteCount() const
+	{
+		return _pendingDeletes.size();
 	}
 
-	void VulkanResourceManager::GarbageCollect()
+	void VulkanResourceManager::GarbageCollect(uint32_t budget)
 	{
-		// Mark
-		static std::vector<uint64_t> needDeletedResourceIndex;
-		needDeletedResourceIndex.clear();
-		for (auto i = 0; i < _resources.size(); i++)
-		{
-			if (_resources[i]->IsMarkDeleted() && _resources[i]->GetRefCount() == 0)
-				needDeletedResourceIndex.push_back(i);
-		}
+		if (_pendingDeletes.empty())
+			return;
 
-		// Release
-		for (auto index : needDeletedResourceIndex)
-			_resources[index] = nullptr;
+		const uint64_t completedFrame = VulkanContext::GetCompletedFrameNumber();
+		const auto pUploadManager = VulkanContext::GetUploadManager();
+		const uint64_t completedUploadValue = pUploadManager != nullptr ? pUploadManager->GetCompletedValue() : UINT64_MAX;
 
-		// Clean up
-		static std::vector<VulkanResourcePtr> resourcesBuffer;
-		resourcesBuffer.clear();
-		for (auto i = 0; i < _resources.size(); i++)
+		// Only retired entries at the front are visited, the resources still alive are never touched
+		for (uint32_t freed = 0; freed < budget && !_pendingDeletes.empty(); freed++)
 		{
-			if (_resources[i] != nullptr)
-				resourcesBuffer.push_back(std::move(_resources[i]));
-		}
+			const PendingDelete& pending = _pendingDeletes.front();
+			if (pending.retireFrame > completedFrame || pending.retireUploadValue > completedUploadValue)
+				break;
 
-		std::swap(_resources, resourcesBuffer);
+			_resources.Remove(pending.handle);
+			_pendingDeletes.pop_front();
+		}
 	}
-
-} // namespace Ailurus
\ No newline at end of file
+} // namespace Ailurus
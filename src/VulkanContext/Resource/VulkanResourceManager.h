@@ -1,6 +1,7 @@
 #pragma once
 
-#include <vector>
+#include <cstdint>
+#include <deque>
 #include <memory>
 #include <functional>
 #include <Ailurus/Utility/NonCopyable.h>
@@ -18,10 +19,12 @@ namespace Ailurus
 	class Image;
 	class VulkanDeviceBuffer;
 	class VulkanHostBuffer;
+	class VulkanMemoryAllocator;
 
 	class VulkanResourceManager : public NonCopyable, public NonMovable
 	{
 	public:
+		VulkanResourceManager();
 		~VulkanResourceManager();
 
 	public:
@@ -32,10 +35,57 @@ namespace Ailurus
 			const void* pixelData, size_t dataSize);
 		VulkanSampler* CreateSampler();
 		VulkanSampler* CreateSampler(const VulkanSamplerCreateConfig& config);
-		void GarbageCollect();
+
+		/// Free at most budget resources whose retirement has passed, the rest wait for the next call
+		void GarbageCollect(uint32_t budget = GC_BUDGET_PER_FRAME);
+
+		/// Called by VulkanResource::MarkDelete, stamps the resource with the frame and upload batch it retires after
+		void EnqueueDelete(VulkanResource* pResource);
+
+		/// Resource of handle, nullptr once it has been freed
+		template <typename T>
+		T* Get(VulkanResourceHandle handle) const
+		{
+			const VulkanResourcePtr* ppResource = _resources.Get(handle);
+			return ppResource != nullptr ? static_cast<T*>(ppResource->get()) : nullptr;
+		}
+
+		bool IsAlive(VulkanResourceHandle handle) const;
+		size_t GetResourceCount() const;
+		size_t GetPendingDeleteCount() const;
+
+		// Device memory of buffers, images and render targets
+		VulkanMemoryAllocator* GetMemoryAllocator() const;
+
+	private:
+		template <typename T>
+		T* Register(VulkanResourcePtr&& ptr)
+		{
+			if (ptr == nullptr)
+				return nullptr;
+
+			VulkanResource* pResource = ptr.get();
+			pResource->_handle = _resources.Insert(std::move(ptr));
+			return static_cast<T*>(pResource);
+		}
 
 	private:
-		// Command buffer resources
-		std::vector<VulkanResourcePtr> _resources;
+		static constexpr uint32_t GC_BUDGET_PER_FRAME = 256;
+
+		// Outlives the resources, which free their memory through it
+		std::unique_ptr<VulkanMemoryAllocator> _pMemoryAllocator;
+
+		struct PendingDelete
+		{
+			VulkanResourceHandle handle;
+			uint64_t retireFrame;
+			uint64_t retireUploadValue;
+		};
+
+		// Freed slots are reused, handles of freed resources turn stale
+		SlotMap<VulkanResourcePtr> _resources;
+
+		// In retirement order, frame numbers and upload timeline values both only grow
+		std::deque<PendingDelete> _pendingDeletes;
 	};
 } // namespace Ailurus
\ No newline at end of file
@@ -4,9 +4,22 @@
 #include "VulkanContext/VulkanContext.h"
 #include "VulkanContext/Helper/VulkanHelper.h"
 #include "Ailurus/Utility/Logger.h"
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
 
 namespace Ailurus
 {
+    namespace
+    {
+        constexpr uint32_t SPIRV_MAGIC_NUMBER = 0x07230203;
+        constexpr uint32_t SPIRV_HEADER_WORD_COUNT = 5;
+        constexpr uint32_t SPIRV_OP_VARIABLE = 59;
+        constexpr uint32_t SPIRV_OP_DECORATE = 71;
+        constexpr uint32_t SPIRV_DECORATION_LOCATION = 30;
+        constexpr uint32_t SPIRV_STORAGE_CLASS_INPUT = 1;
+    }
+
     VulkanShader::VulkanShader(const std::string& path)
     {
         auto binaryFile = File::LoadBinary(path);
@@ -43,6 +56,11 @@ namespace Ailurus
         return _vkShaderModule != vk::ShaderModule{};
     }
 
+    const std::vector<uint32_t>& VulkanShader::GetInputLocations() const
+    {
+        return _inputLocations;
+    }
+
     vk::PipelineShaderStageCreateInfo VulkanShader::GeneratePipelineCreateInfo(ShaderStage stage) const
     {
         vk::PipelineShaderStageCreateInfo createInfo;
@@ -66,6 +84,44 @@ namespace Ailurus
         catch (const vk::SystemError& e)
         {
             Logger::LogError("Failed to create shader module: {}", e.what());
+            return;
+        }
+
+        ReadInputLocations(binaryData, size);
+    }
+
+    void VulkanShader::ReadInputLocations(const char* binaryData, size_t size)
+    {
+        // Words are copied out, the file buffer carries no alignment guarantee
+        std::vector<uint32_t> words(size / sizeof(uint32_t));
+        std::memcpy(words.data(), binaryData, words.size() * sizeof(uint32_t));
+        if (words.size() < SPIRV_HEADER_WORD_COUNT || words[0] != SPIRV_MAGIC_NUMBER)
+        {
+            Logger::LogError("Shader binary is not SPIR-V, its inputs are unknown");
+            return;
         }
+
+        // Location decorations come before the variables they decorate, built-ins have none
+        std::unordered_map<uint32_t, uint32_t> locations;
+        for (size_t i = SPIRV_HEADER_WORD_COUNT; i < words.size();)
+        {
+            const uint32_t wordCount = words[i] >> 16;
+            const uint32_t opcode = words[i] & 0xFFFF;
+            if (wordCount == 0 || i + wordCount > words.size())
+                break;
+
+            if (opcode == SPIRV_OP_DECORATE && wordCount >= 4 && words[i + 2] == SPIRV_DECORATION_LOCATION)
+                locations[words[i + 1]] = words[i + 3];
+            else if (opcode == SPIRV_OP_VARIABLE && wordCount >= 4 && words[i + 3] == SPIRV_STORAGE_CLASS_INPUT)
+            {
+                const auto itr = locations.find(words[i + 2]);
+                if (itr != locations.end())
+                    _inputLocations.push_back(itr->second);
+            }
+
+            i += wordCount;
+        }
+
+        std::sort(_inputLocations.begin(), _inputLocations.end());
     }
 }
@@ -17,11 +17,16 @@ namespace Ailurus
         bool IsValid() const;
         vk::PipelineShaderStageCreateInfo GeneratePipelineCreateInfo(ShaderStage stage) const;
 
+        /// Locations of the stage's user defined input variables, vertex attributes for a vertex shader
+        const std::vector<uint32_t>& GetInputLocations() const;
+
     private:
         void CreateShaderModule(const char* binaryData, size_t size);
+        void ReadInputLocations(const char* binaryData, size_t size);
 
     private:
         vk::ShaderModule _vkShaderModule = nullptr;
+        std::vector<uint32_t> _inputLocations;
     };
 
 }
\ No newline at end of file
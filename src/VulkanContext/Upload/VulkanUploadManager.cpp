@@ -0,0 +1,468 @@
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include "VulkanUploadManager.h"
+#include "Ailurus/Utility/Logger.h"
+#include "VulkanContext/VulkanContext.h"
+#include "VulkanContext/CommandBuffer/VulkanCommandBuffer.h"
+#include "VulkanContext/Resource/VulkanResourceManager.h"
+#include "VulkanContext/Resource/DataBuffer/VulkanHostBuffer.h"
+#include "VulkanContext/Resource/DataBuffer/VulkanDeviceBuffer.h"
+#include "VulkanContext/Resource/Image/VulkanImage.h"
+
+namespace Ailurus
+{
+	// Stages the graphics queue samples uploaded images in
+	static constexpr vk::PipelineStageFlags IMAGE_READ_STAGES = vk::PipelineStageFlagBits::eFragmentShader
+		| vk::PipelineStageFlagBits::eComputeShader;
+
+	VulkanUploadManager::VulkanUploadManager()
+		: _queueFamilyIndex(VulkanContext::GetTransferQueueIndex())
+		, _queue(VulkanContext::GetTransferQueue())
+	{
+		const auto device = VulkanContext::GetDevice();
+
+		try
+		{
+			vk::CommandPoolCreateInfo poolInfo;
+			poolInfo.setFlags(vk::CommandPoolCreateFlagBits::eResetCommandBuffer)
+				.setQueueFamilyIndex(_queueFamilyIndex);
+
+			_commandPool = device.createCommandPool(poolInfo);
+
+			vk::SemaphoreTypeCreateInfo semaphoreTypeInfo;
+			semaphoreTypeInfo.setSemaphoreType(vk::SemaphoreType::eTimeline)
+				.setInitialValue(0);
+
+			vk::SemaphoreCreateInfo semaphoreInfo;
+			semaphoreInfo.setPNext(&semaphoreTypeInfo);
+
+			_timelineSemaphore = device.createSemaphore(semaphoreInfo);
+		}
+		catch (const vk::SystemError& e)
+		{
+			Logger::LogError("Failed to create upload manager: {}", e.what());
+		}
+
+		_pStagingRing = VulkanContext::GetResourceManager()->CreateHostBuffer(STAGING_RING_CAPACITY, HostBufferUsage::TransferSrc);
+		if (_pStagingRing == nullptr)
+			Logger::LogError("Failed to create upload staging ring of {} bytes", STAGING_RING_CAPACITY);
+
+		Logger::LogInfo("Uploads use queue family {}, {}", _queueFamilyIndex,
+			IsOwnershipTransferNeeded() ? "a dedicated transfer queue" : "the graphics queue");
+	}
+
+	VulkanUploadManager::~VulkanUploadManager()
+	{
+		// The device is idle, command buffers go back to the pool before it is destroyed
+		_openBatch.reset();
+		_submittedBatches.clear();
+		_freeCommandBuffers.clear();
+
+		if (_pStagingRing != nullptr)
+			_pStagingRing->MarkDelete();
+
+		const auto device = VulkanContext::GetDevice();
+		if (_timelineSemaphore)
+			device.destroySemaphore(_timelineSemaphore);
+
+		if (_commandPool)
+			device.destroyCommandPool(_commandPool);
+	}
+
+	auto VulkanUploadManager::UploadBuffer(VulkanDeviceBuffer* pDst, vk::DeviceSize dstOffset, const void* pData,
+		vk::DeviceSize size) -> uint64_t
+	{
+		if (pDst == nullptr || pData == nullptr || size == 0)
+			return 0;
+
+		const StagingSlice staging = AllocateStaging(pData, size);
+		if (staging.pBuffer == nullptr)
+			return 0;
+
+		Batch& batch = GetOpenBatch();
+		batch.pCommandBuffer->CopyBuffer(staging.pBuffer, pDst, size, staging.offset, dstOffset);
+
+		// Oversized uploads get a buffer of their own, it is deleted once the batch has finished
+		if (staging.pBuffer != _pStagingRing)
+			staging.pBuffer->MarkDelete();
+
+		return _nextTimelineValue;
+	}
+
+	auto VulkanUploadManager::CopyBuffer(VulkanDeviceBuffer* pSrc, VulkanDeviceBuffer* pDst, vk::DeviceSize size) -> uint64_t
+	{
+		if (pSrc == nullptr || pDst == nullptr || size == 0)
+			return 0;
+
+		Batch& batch = GetOpenBatch();
+		batch.pCommandBuffer->BufferMemoryBarrier(pSrc, vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eTransferRead,
+			vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eTransfer);
+		batch.pCommandBuffer->CopyBuffer(pSrc, pDst, size);
+
+		// Uploads recorded later may land inside the copied range
+		batch.pCommandBuffer->BufferMemoryBarrier(pDst, vk::AccessFlagBits::eTransferWrite,
+			vk::AccessFlagBits::eTransferWrite | vk::AccessFlagBits::eTransferRead,
+			vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eTransfer);
+
+		return _nextTimelineValue;
+	}
+
+	auto VulkanUploadManager::UploadImage(const VulkanImageUpload& upload, const void* pData, vk::DeviceSize dataSize) -> uint64_t
+	{
+		if (upload.pImage == nullptr || pData == nullptr || dataSize == 0 || upload.regions.empty())
+			return 0;
+
+		const StagingSlice staging = AllocateStaging(pData, dataSize);
+		if (staging.pBuffer == nullptr)
+			return 0;
+
+		Batch& batch = GetOpenBatch();
+		const vk::Image image = upload.pImage->GetImage();
+		const vk::ImageSubresourceRange range(upload.aspectMask, 0, upload.mipLevels, 0, upload.arrayLayers);
+
+		batch.pCommandBuffer->ImageMemoryBarrier(image,
+			vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal,
+			vk::AccessFlagBits::eNone, vk::AccessFlagBits::eTransferWrite,
+			vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eTransfer,
+			upload.aspectMask, 0, upload.mipLevels, 0, upload.arrayLayers);
+
+		std::vector<vk::BufferImageCopy> regions = upload.regions;
+		for (auto& region : regions)
+			region.setBufferOffset(region.bufferOffset + staging.offset);
+
+		batch.pCommandBuffer->CopyBufferToImage(staging.pBuffer, upload.pImage, regions);
+
+		if (IsOwnershipTransferNeeded())
+		{
+			// Release to the graphics family, which acquires with the same layout transition
+			vk::ImageMemoryBarrier release;
+			release.setOldLayout(vk::ImageLayout::eTransferDstOptimal)
+				.setNewLayout(vk::ImageLayout::eShaderReadOnlyOptimal)
+				.setSrcQueueFamilyIndex(_queueFamilyIndex)
+				.setDstQueueFamilyIndex(VulkanContext::GetGraphicQueueIndex())
+				.setImage(image)
+				.setSubresourceRange(range)
+				.setSrcAccessMask(vk::AccessFlagBits::eTransferWrite)
+				.setDstAccessMask(vk::AccessFlagBits::eNone);
+
+			batch.pCommandBuffer->GetBuffer().pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+				vk::PipelineStageFlagBits::eBottomOfPipe, {}, nullptr, nullptr, release);
+
+			vk::ImageMemoryBarrier acquire = release;
+			acquire.setSrcAccessMask(vk::AccessFlagBits::eNone)
+				.setDstAccessMask(vk::AccessFlagBits::eShaderRead);
+			_openBatchAcquires.push_back(acquire);
+		}
+		else
+		{
+			batch.pCommandBuffer->ImageMemoryBarrier(image,
+				vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eShaderReadOnlyOptimal,
+				vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eShaderRead,
+				vk::PipelineStageFlagBits::eTransfer, IMAGE_READ_STAGES,
+				upload.aspectMask, 0, upload.mipLevels, 0, upload.arrayLayers);
+		}
+
+		if (staging.pBuffer != _pStagingRing)
+			staging.pBuffer->MarkDelete();
+
+		return _nextTimelineValue;
+	}
+
+	void VulkanUploadManager::Flush()
+	{
+		if (!_openBatch.has_value())
+			return;
+
+		Batch batch = std::move(*_openBatch);
+		_openBatch.reset();
+
+		batch.pCommandBuffer->End();
+		batch.timelineValue = _nextTimelineValue++;
+		batch.ringEnd = _ringHead;
+
+		vk::TimelineSemaphoreSubmitInfo timelineInfo;
+		timelineInfo.setSignalSemaphoreValues(batch.timelineValue);
+
+		vk::SubmitInfo submitInfo;
+		submitInfo.setCommandBuffers(batch.pCommandBuffer->GetBuffer())
+			.setSignalSemaphores(_timelineSemaphore)
+			.setPNext(&timelineInfo);
+
+		try
+		{
+			_queue.submit(submitInfo);
+		}
+		catch (const vk::SystemError& e)
+		{
+			Logger::LogError("Failed to submit upload batch: {}", e.what());
+
+			// Nothing of the batch reaches the GPU, signal from the host so no one waits forever
+			vk::SemaphoreSignalInfo signalInfo;
+			signalInfo.setSemaphore(_timelineSemaphore)
+				.setValue(batch.timelineValue);
+			VulkanContext::GetDevice().signalSemaphore(signalInfo);
+		}
+
+		_lastSubmittedValue = batch.timelineValue;
+		_submittedBatches.push_back(std::move(batch));
+
+		_pendingAcquires.insert(_pendingAcquires.end(), _openBatchAcquires.begin(), _openBatchAcquires.end());
+		_openBatchAcquires.clear();
+	}
+
+	auto VulkanUploadManager::RecordAcquireBarriers(VulkanCommandBuffer* pCommandBuffer) -> uint64_t
+	{
+		if (!_pendingAcquires.empty())
+		{
+			pCommandBuffer->GetBuffer().pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe, IMAGE_READ_STAGES,
+				{}, nullptr, nullptr, _pendingAcquires);
+			_pendingAcquires.clear();
+		}
+
+		// Waiting for a value already reached costs nothing, but skip it when it is known
+		if (_lastSubmittedValue == 0 || IsComplete(_lastSubmittedValue))
+			return 0;
+
+		return _lastSubmittedValue;
+	}
+
+	void VulkanUploadManager::FlushAndWait()
+	{
+		Flush();
+
+		if (_pendingAcquires.empty())
+		{
+			WaitTimeline(_lastSubmittedValue);
+			Collect();
+			return;
+		}
+
+		// Released images still need their acquire on the graphics queue
+		VulkanCommandBuffer commandBuffer(true);
+		commandBuffer.Begin();
+		const uint64_t waitValue = RecordAcquireBarriers(&commandBuffer);
+		commandBuffer.End();
+
+		const vk::PipelineStageFlags waitStage = vk::PipelineStageFlagBits::eAllCommands;
+		vk::TimelineSemaphoreSubmitInfo timelineInfo;
+		timelineInfo.setWaitSemaphoreValues(waitValue);
+
+		vk::SubmitInfo submitInfo;
+		submitInfo.setCommandBuffers(commandBuffer.GetBuffer());
+		if (waitValue != 0)
+		{
+			submitInfo.setWaitSemaphores(_timelineSemaphore)
+				.setWaitDstStageMask(waitStage)
+				.setPNext(&timelineInfo);
+		}
+
+		try
+		{
+			VulkanContext::GetGraphicQueue().submit(submitInfo);
+			VulkanContext::GetGraphicQueue().waitIdle();
+		}
+		catch (const vk::SystemError& e)
+		{
+			Logger::LogError("Failed to acquire uploaded images: {}", e.what());
+		}
+
+		Collect();
+	}
+
+	void VulkanUploadManager::Collect()
+	{
+		if (_submittedBatches.empty())
+			return;
+
+		const uint64_t completedValue = GetCompletedValue();
+
+		// Batches complete in submission order
+		while (!_submittedBatches.empty() && _submittedBatches.front().timelineValue <= completedValue)
+		{
+			Batch& batch = _submittedBatches.front();
+			_freeCommandBuffers.push_back(std::move(batch.pCommandBuffer));
+
+			_ringTail = batch.ringEnd;
+			_ringUsed -= batch.ringBytes;
+			_submittedBatches.pop_front();
+		}
+	}
+
+	auto VulkanUploadManager::IsComplete(uint64_t timelineValue) const -> bool
+	{
+		return GetCompletedValue() >= timelineValue;
+	}
+
+	auto VulkanUploadManager::GetRecordedValue() const -> uint64_t
+	{
+		return _openBatch.has_value() ? _nextTimelineValue : _lastSubmittedValue;
+	}
+
+	auto VulkanUploadManager::GetCompletedValue() const -> uint64_t
+	{
+		try
+		{
+			return VulkanContext::GetDevice().getSemaphoreCounterValue(_timelineSemaphore);
+		}
+		catch (const vk::SystemError& e)
+		{
+			Logger::LogError("Failed to read upload timeline: {}", e.what());
+			return 0;
+		}
+	}
+
+	auto VulkanUploadManager::GetTimelineSemaphore() const -> vk::Semaphore
+	{
+		return _timelineSemaphore;
+	}
+
+	auto VulkanUploadManager::GetQueueFamilyIndex() const -> uint32_t
+	{
+		return _queueFamilyIndex;
+	}
+
+	auto VulkanUploadManager::GetStagingUsedSize() const -> vk::DeviceSize
+	{
+		return _ringUsed;
+	}
+
+	auto VulkanUploadManager::GetOpenBatch() -> Batch&
+	{
+		if (_openBatch.has_value())
+			return *_openBatch;
+
+		_openBatch.emplace();
+		if (!_freeCommandBuffers.empty())
+		{
+			_openBatch->pCommandBuffer = std::move(_freeCommandBuffers.back());
+			_freeCommandBuffers.pop_back();
+		}
+		else
+			_openBatch->pCommandBuffer = std::make_unique<VulkanCommandBuffer>(true, _commandPool);
+
+		_openBatch->pCommandBuffer->Begin();
+		return *_openBatch;
+	}
+
+	auto VulkanUploadManager::AllocateStaging(const void* pData, vk::DeviceSize size) -> StagingSlice
+	{
+		StagingSlice staging;
+
+		// Large uploads would hold most of the ring on their own
+		if (_pStagingRing == nullptr || size > STAGING_RING_CAPACITY / 2)
+		{
+			staging.pBuffer = VulkanContext::GetResourceManager()->CreateHostBuffer(size, HostBufferUsage::TransferSrc);
+			if (staging.pBuffer == nullptr)
+			{
+				Logger::LogError("Failed to create staging buffer of {} bytes", size);
+				return staging;
+			}
+
+			std::memcpy(staging.pBuffer->mappedAddr, pData, size);
+			return staging;
+		}
+
+		std::optional<vk::DeviceSize> offset = TryAllocateRing(size);
+		while (!offset.has_value())
+		{
+			// Ring is full of batches in flight, submit the open one too so its space comes back
+			Flush();
+			if (!WaitOldestBatch())
+			{
+				Logger::LogError("Upload staging ring has no room for {} bytes", size);
+				return staging;
+			}
+
+			offset = TryAllocateRing(size);
+		}
+
+		staging.pBuffer = _pStagingRing;
+		staging.offset = *offset;
+		std::memcpy(static_cast<uint8_t*>(_pStagingRing->mappedAddr) + staging.offset, pData, size);
+		return staging;
+	}
+
+	auto VulkanUploadManager::TryAllocateRing(vk::DeviceSize size) -> std::optional<vk::DeviceSize>
+	{
+		if (_ringUsed == 0)
+		{
+			_ringHead = 0;
+			_ringTail = 0;
+		}
+
+		const vk::DeviceSize alignedHead = (_ringHead + STAGING_ALIGNMENT - 1) / STAGING_ALIGNMENT * STAGING_ALIGNMENT;
+
+		vk::DeviceSize offset;
+		vk::DeviceSize consumed;
+		if (_ringUsed == 0 || _ringHead > _ringTail)
+		{
+			// Free space behind the head up to the end, then in front of the tail
+			if (alignedHead + size <= STAGING_RING_CAPACITY)
+			{
+				offset = alignedHead;
+				consumed = alignedHead + size - _ringHead;
+			}
+			else if (size <= _ringTail)
+			{
+				// The end of the ring is skipped and counts as used until the batch retires
+				offset = 0;
+				consumed = STAGING_RING_CAPACITY - _ringHead + size;
+			}
+			else
+				return std::nullopt;
+		}
+		else
+		{
+			// Head has wrapped, free space lies between head and tail
+			if (alignedHead + size > _ringTail)
+				return std::nullopt;
+
+			offset = alignedHead;
+			consumed = alignedHead + size - _ringHead;
+		}
+
+		_ringHead = offset + size;
+		_ringUsed += consumed;
+		GetOpenBatch().ringBytes += consumed;
+		return offset;
+	}
+
+	auto VulkanUploadManager::WaitOldestBatch() -> bool
+	{
+		if (_submittedBatches.empty())
+			return false;
+
+		if (!WaitTimeline(_submittedBatches.front().timelineValue))
+			return false;
+
+		Collect();
+		return true;
+	}
+
+	auto VulkanUploadManager::WaitTimeline(uint64_t timelineValue) const -> bool
+	{
+		if (timelineValue == 0)
+			return true;
+
+		vk::SemaphoreWaitInfo waitInfo;
+		waitInfo.setSemaphores(_timelineSemaphore)
+			.setValues(timelineValue);
+
+		try
+		{
+			const vk::Result result = VulkanContext::GetDevice().waitSemaphores(waitInfo, std::numeric_limits<uint64_t>::max());
+			return result == vk::Result::eSuccess;
+		}
+		catch (const vk::SystemError& e)
+		{
+			Logger::LogError("Failed to wait for uploads: {}", e.what());
+			return false;
+		}
+	}
+
+	auto VulkanUploadManager::IsOwnershipTransferNeeded() const -> bool
+	{
+		return _queueFamilyIndex != VulkanContext::GetGraphicQueueIndex();
+	}
+} // namespace Ailurus
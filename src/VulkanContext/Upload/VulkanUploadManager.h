@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <vector>
+#include "VulkanContext/VulkanPch.h"
+#include <Ailurus/Utility/NonCopyable.h>
+#include <Ailurus/Utility/NonMovable.h>
+
+namespace Ailurus
+{
+	class VulkanCommandBuffer;
+	class VulkanHostBuffer;
+	class VulkanDeviceBuffer;
+	class VulkanImage;
+
+	/// Copy of pixel data into an image, left in eShaderReadOnlyOptimal for the graphics queue
+	struct VulkanImageUpload
+	{
+		VulkanImage* pImage = nullptr;
+		vk::ImageAspectFlags aspectMask = vk::ImageAspectFlagBits::eColor;
+		uint32_t mipLevels = 1;				// Levels transitioned, only the copied ones get content
+		uint32_t arrayLayers = 1;
+		std::vector<vk::BufferImageCopy> regions; // Buffer offsets are relative to the uploaded data
+	};
+
+	/// Streams buffer and image content to the GPU through a persistently mapped staging ring.
+	/// Copies are batched into one command buffer, submitted once per frame on the dedicated
+	/// transfer queue when the device has one and on the graphics queue otherwise. Each batch
+	/// signals a timeline semaphore, the frame drawing the uploaded content waits for it and
+	/// acquires images released by the transfer queue. Buffers the transfer queue writes are
+	/// shared with it concurrently. Main thread only.
+	class VulkanUploadManager : public NonCopyable, public NonMovable
+	{
+	public:
+		VulkanUploadManager();
+		~VulkanUploadManager();
+
+	public:
+		/// Copy size bytes of pData into pDst at dstOffset
+		/// @return Timeline value the batch signals, 0 when nothing was recorded
+		auto UploadBuffer(VulkanDeviceBuffer* pDst, vk::DeviceSize dstOffset, const void* pData,
+			vk::DeviceSize size) -> uint64_t;
+
+		/// Copy the first size bytes of pSrc into pDst, ordered after earlier uploads into pSrc
+		auto CopyBuffer(VulkanDeviceBuffer* pSrc, VulkanDeviceBuffer* pDst, vk::DeviceSize size) -> uint64_t;
+
+		/// Fill an image with dataSize bytes of pData and make it readable by shaders
+		auto UploadImage(const VulkanImageUpload& upload, const void* pData, vk::DeviceSize dataSize) -> uint64_t;
+
+		/// Submit the batch recorded so far, a no-op when it is empty
+		void Flush();
+
+		/// Record the acquire barriers of flushed batches into a graphics command buffer
+		/// @return Timeline value its submit must wait for, 0 when there is nothing to wait for
+		auto RecordAcquireBarriers(VulkanCommandBuffer* pCommandBuffer) -> uint64_t;
+
+		/// Flush and block until the graphics queue can read every upload, for setup work
+		/// submitted outside the frame loop
+		void FlushAndWait();
+
+		/// Recycle batches the GPU has finished and release their staging memory
+		void Collect();
+
+		auto IsComplete(uint64_t timelineValue) const -> bool;
+
+		/// Timeline value reached once every copy recorded so far has finished
+		auto GetRecordedValue() const -> uint64_t;
+
+		/// Timeline value the GPU has reached
+		auto GetCompletedValue() const -> uint64_t;
+
+		auto GetTimelineSemaphore() const -> vk::Semaphore;
+		auto GetQueueFamilyIndex() const -> uint32_t;
+
+		/// Staging ring bytes in use by batches not yet finished
+		auto GetStagingUsedSize() const -> vk::DeviceSize;
+
+	private:
+		struct Batch
+		{
+			std::unique_ptr<VulkanCommandBuffer> pCommandBuffer;
+			uint64_t timelineValue = 0;
+			vk::DeviceSize ringEnd = 0;
+			vk::DeviceSize ringBytes = 0;
+		};
+
+		struct StagingSlice
+		{
+			VulkanHostBuffer* pBuffer = nullptr;
+			vk::DeviceSize offset = 0;
+		};
+
+		auto GetOpenBatch() -> Batch&;
+		auto AllocateStaging(const void* pData, vk::DeviceSize size) -> StagingSlice;
+		auto TryAllocateRing(vk::DeviceSize size) -> std::optional<vk::DeviceSize>;
+		auto WaitOldestBatch() -> bool;
+		auto WaitTimeline(uint64_t timelineValue) const -> bool;
+		auto IsOwnershipTransferNeeded() const -> bool;
+
+	private:
+		static constexpr vk::DeviceSize STAGING_RING_CAPACITY = 32 * 1024 * 1024;
+		static constexpr vk::DeviceSize STAGING_ALIGNMENT = 16; // Texel size of the widest format, a multiple of 4
+
+		uint32_t _queueFamilyIndex;
+		vk::Queue _queue;
+		vk::CommandPool _commandPool = nullptr;
+		vk::Semaphore _timelineSemaphore = nullptr;
+		uint64_t _nextTimelineValue = 1;
+		uint64_t _lastSubmittedValue = 0;
+
+		// Staging ring, head is where the open batch writes next, tail where the oldest batch in flight starts
+		VulkanHostBuffer* _pStagingRing = nullptr;
+		vk::DeviceSize _ringHead = 0;
+		vk::DeviceSize _ringTail = 0;
+		vk::DeviceSize _ringUsed = 0;
+
+		std::optional<Batch> _openBatch;
+		std::deque<Batch> _submittedBatches;
+		std::vector<std::unique_ptr<VulkanCommandBuffer>> _freeCommandBuffers;
+
+		// Graphics side halves of the ownership transfers of flushed batches
+		std::vector<vk::ImageMemoryBarrier> _pendingAcquires;
+		std::vector<vk::ImageMemoryBarrier> _openBatchAcquires;
+	};
+} // namespace Ailurus
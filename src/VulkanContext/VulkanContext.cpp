@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cstdlib>
 #include <memory>
 #include <optional>
@@ -11,9 +12,13 @@
 #include "Helper/VulkanHelper.h"
 #include "Resource/VulkanResourceManager.h"
 #include "Vertex/VulkanVertexLayoutManager.h"
+#include "Geometry/VulkanGeometryManager.h"
 #include "Pipeline/VulkanPipelineManager.h"
 #include "Fence/VulkanFence.h"
 #include "Descriptor/VulkanDescriptorAllocator.h"
+#include "Descriptor/VulkanPersistentDescriptorAllocator.h"
+#include "DataBuffer/VulkanUniformRingBuffer.h"
+#include "Upload/VulkanUploadManager.h"
 
 VULKAN_HPP_DEFAULT_DISPATCH_LOADER_DYNAMIC_STORAGE
 
@@ -31,23 +36,32 @@ namespace Ailurus
 	uint32_t 									VulkanContext::_presentQueueIndex = 0;
 	uint32_t 									VulkanContext::_graphicQueueIndex = 0;
 	uint32_t 									VulkanContext::_computeQueueIndex = 0;
+	uint32_t 									VulkanContext::_transferQueueIndex = 0;
 	vk::Queue 									VulkanContext::_vkPresentQueue = nullptr;
 	vk::Queue 									VulkanContext::_vkGraphicQueue = nullptr;
 	vk::Queue 									VulkanContext::_vkComputeQueue = nullptr;
+	vk::Queue 									VulkanContext::_vkTransferQueue = nullptr;
 	vk::CommandPool 							VulkanContext::_vkGraphicCommandPool = nullptr;
 
 	std::unique_ptr<VulkanSwapChain> 			VulkanContext::_pSwapChain = nullptr;
 	bool 										VulkanContext::_vsyncEnabled = true;
 	vk::SampleCountFlagBits 					VulkanContext::_msaaSamples = vk::SampleCountFlagBits::e4;
 	bool 										VulkanContext::_supportsMSAADepthResolve = false;
+	bool 										VulkanContext::_supportsDrawIndirectCount = false;
+	uint32_t 									VulkanContext::_maxBindlessTextures = 0;
 	vk::ResolveModeFlagBits 					VulkanContext::_msaaDepthResolveMode = vk::ResolveModeFlagBits::eNone;
 
 	std::unique_ptr<RenderTargetManager>		VulkanContext::_pRenderTargetManager = nullptr;
 	std::unique_ptr<VulkanResourceManager> 		VulkanContext::_resourceManager = nullptr;
 	std::unique_ptr<VulkanVertexLayoutManager> 	VulkanContext::_vertexLayoutManager = nullptr;
+	std::unique_ptr<VulkanGeometryManager> 		VulkanContext::_geometryManager = nullptr;
+	std::unique_ptr<VulkanPersistentDescriptorAllocator> VulkanContext::_persistentDescriptorAllocator = nullptr;
 	std::unique_ptr<VulkanPipelineManager> 		VulkanContext::_pipelineManager = nullptr;
+	std::unique_ptr<VulkanUploadManager> 		VulkanContext::_pUploadManager = nullptr;
 
 	uint32_t									VulkanContext::_currentFrameIndex = 0;
+	uint64_t									VulkanContext::_frameNumber = 1;
+	uint64_t									VulkanContext::_completedFrameNumber = 0;
 	std::vector<VulkanContext::FrameContext>	VulkanContext::_frameContext;
 
 	std::vector<std::unique_ptr<VulkanCommandBuffer>>	VulkanContext::_recordedSecondaryCommandBuffers;
@@ -113,18 +127,45 @@ namespace Ailurus
 
 		// Create managers
 		_resourceManager = std::make_unique<VulkanResourceManager>();
+		_pUploadManager = std::make_unique<VulkanUploadManager>();
 		_vertexLayoutManager = std::make_unique<VulkanVertexLayoutManager>();
+		_geometryManager = std::make_unique<VulkanGeometryManager>();
+		_persistentDescriptorAllocator = std::make_unique<VulkanPersistentDescriptorAllocator>();
 		_pRenderTargetManager = std::make_unique<RenderTargetManager>();
 		_pipelineManager = std::make_unique<VulkanPipelineManager>();
 
+		// One recording context per job system thread (main thread included)
+		const auto pJobSystem = Application::Get<JobSystem>();
+		const uint32_t recordThreadCount = pJobSystem != nullptr ? pJobSystem->GetThreadCount() : 1;
+
 		// Create frame context
 		_currentFrameIndex = 0;
+		_frameNumber = 1;
+		_completedFrameNumber = 0;
 		for (auto i = 0; i < _parallelFrameCount; ++i)
 		{
 			FrameContext frameContext;
 			frameContext.onAirInfo = std::nullopt; // Not in flight
+			frameContext.threadRecordContexts.resize(recordThreadCount);
+			for (auto& threadContext : frameContext.threadRecordContexts)
+			{
+				try
+				{
+					vk::CommandPoolCreateInfo poolInfo;
+					poolInfo.setFlags(vk::CommandPoolCreateFlagBits::eTransient | vk::CommandPoolCreateFlagBits::eResetCommandBuffer)
+						.setQueueFamilyIndex(GetGraphicQueueIndex());
+
+					threadContext.commandPool = _vkDevice.createCommandPool(poolInfo);
+				}
+				catch (const vk::SystemError& e)
+				{
+					Logger::LogError("Create thread command pool failed: {}", e.what());
+				}
+			}
+
 			frameContext.pRenderingCommandBuffer = std::make_unique<VulkanCommandBuffer>(true);
 			frameContext.pFrameDescriptorAllocator = std::make_unique<VulkanDescriptorAllocator>();
+			frameContext.pFrameUniformRing = std::make_unique<VulkanUniformRingBuffer>(FRAME_UNIFORM_RING_CAPACITY);
 			frameContext.imageReadySemaphore = std::make_unique<VulkanSemaphore>();
 			frameContext.renderFinishSemaphore = std::make_unique<VulkanSemaphore>();
 			frameContext.renderFinishFence = std::make_unique<VulkanFence>(false);
@@ -149,12 +190,24 @@ namespace Ailurus
 		// Destroy frame context
 		_recordedSecondaryCommandBuffers.clear();
 		_secondaryCommandBufferPool.clear();
+		for (auto& frameContext : _frameContext)
+		{
+			for (auto& threadContext : frameContext.threadRecordContexts)
+			{
+				threadContext.secondaryCommandBuffers.clear();
+				if (threadContext.commandPool)
+					_vkDevice.destroyCommandPool(threadContext.commandPool);
+			}
+		}
 		_frameContext.clear();
 		_currentFrameIndex = 0;
 
 		// Destroy managers
+		_pUploadManager.reset();
 		_pipelineManager.reset();
 		_pRenderTargetManager.reset();
+		_geometryManager.reset();
+		_persistentDescriptorAllocator.reset();
 		_vertexLayoutManager.reset();
 		_resourceManager.reset();
 
@@ -246,6 +299,16 @@ namespace Ailurus
 		return _vkComputeQueue;
 	}
 
+	uint32_t VulkanContext::GetTransferQueueIndex()
+	{
+		return _transferQueueIndex;
+	}
+
+	vk::Queue VulkanContext::GetTransferQueue()
+	{
+		return _vkTransferQueue;
+	}
+
 	vk::CommandPool VulkanContext::GetCommandPool()
 	{
 		return _vkGraphicCommandPool;
@@ -261,11 +324,41 @@ namespace Ailurus
 		return _vertexLayoutManager.get();
 	}
 
+	VulkanGeometryManager* VulkanContext::GetGeometryManager()
+	{
+		return _geometryManager.get();
+	}
+
+	VulkanPersistentDescriptorAllocator* VulkanContext::GetPersistentDescriptorAllocator()
+	{
+		return _persistentDescriptorAllocator.get();
+	}
+
+	VulkanUploadManager* VulkanContext::GetUploadManager()
+	{
+		return _pUploadManager.get();
+	}
+
 	uint32_t VulkanContext::GetParallelFrameCount()
 	{
 		return _parallelFrameCount;
 	}
 
+	uint32_t VulkanContext::GetCurrentParallelFrameIndex()
+	{
+		return _currentFrameIndex;
+	}
+
+	uint64_t VulkanContext::GetFrameNumber()
+	{
+		return _frameNumber;
+	}
+
+	uint64_t VulkanContext::GetCompletedFrameNumber()
+	{
+		return _completedFrameNumber;
+	}
+
 	void VulkanContext::RebuildSwapChain()
 	{
 		if (!_initialized)
@@ -313,6 +406,21 @@ namespace Ailurus
 		return _supportsMSAADepthResolve;
 	}
 
+	bool VulkanContext::SupportsDrawIndirectCount()
+	{
+		return _supportsDrawIndirectCount;
+	}
+
+	bool VulkanContext::SupportsBindlessTextures()
+	{
+		return _maxBindlessTextures > 0;
+	}
+
+	uint32_t VulkanContext::GetMaxBindlessTextures()
+	{
+		return _maxBindlessTextures;
+	}
+
 	vk::ResolveModeFlagBits VulkanContext::GetMSAADepthResolveMode()
 	{
 		return _msaaDepthResolveMode;
@@ -340,17 +448,71 @@ namespace Ailurus
 		_recordedSecondaryCommandBuffers.push_back(std::move(pSecondaryCommandBuffer));
 	}
 
+	VulkanCommandBuffer* VulkanContext::RecordFrameSecondaryCommandBuffer(const VulkanRenderingInheritance* pInheritance,
+		const RecordSecondaryCommandBufferFunction& recordFunction)
+	{
+		if (recordFunction == nullptr)
+			return nullptr;
+
+		const auto pJobSystem = Application::Get<JobSystem>();
+		const uint32_t threadIndex = pJobSystem != nullptr ? pJobSystem->GetCurrentThreadIndex() : JobSystem::MAIN_THREAD_INDEX;
+
+		auto& frameContext = _frameContext[_currentFrameIndex];
+		if (threadIndex >= frameContext.threadRecordContexts.size())
+		{
+			Logger::LogError("VulkanContext::RecordFrameSecondaryCommandBuffer: Called from a thread not owned by job system");
+			return nullptr;
+		}
+
+		// Only the calling thread touches its own context, no lock needed
+		auto& threadContext = frameContext.threadRecordContexts[threadIndex];
+		if (threadContext.usedCount == threadContext.secondaryCommandBuffers.size())
+			threadContext.secondaryCommandBuffers.push_back(std::make_unique<VulkanCommandBuffer>(false, threadContext.commandPool));
+
+		VulkanCommandBuffer* pSecondaryCommandBuffer = threadContext.secondaryCommandBuffers[threadContext.usedCount].get();
+		threadContext.usedCount++;
+
+		if (pInheritance != nullptr)
+			pSecondaryCommandBuffer->Begin(*pInheritance);
+		else
+			pSecondaryCommandBuffer->Begin();
+
+		recordFunction(pSecondaryCommandBuffer);
+		pSecondaryCommandBuffer->End();
+
+		return pSecondaryCommandBuffer;
+	}
+
 	VulkanPipelineManager* VulkanContext::GetPipelineManager()
 	{
 		return _pipelineManager.get();
 	}
 
+	vk::PipelineCache VulkanContext::GetPipelineCache()
+	{
+		return _pipelineManager != nullptr ? _pipelineManager->GetPipelineCache() : nullptr;
+	}
+
+	VulkanUniformRingBuffer* VulkanContext::GetFrameUniformRing()
+	{
+		return _frameContext[_currentFrameIndex].pFrameUniformRing.get();
+	}
+
 	void VulkanContext::RenderFrame(bool* needRebuildSwapChain, const RenderFunction& recordCmdBufFunc)
 	{
 		// Fence frame context
 		WaitFrameFinish(_currentFrameIndex);
 		auto& frameContext = _frameContext[_currentFrameIndex];
 
+		// Frame was recorded but never submitted last time (e.g. submit failed)
+		RecycleFrameSecondaryCommandBuffers(_currentFrameIndex);
+
+		// The GPU is done with this frame's uniform slices, or they were never submitted
+		frameContext.pFrameUniformRing->Reset();
+
+		// Uploads recorded since the last frame go out ahead of the frame drawing them
+		_pUploadManager->Flush();
+
 		// Acquire next image
 		//  - Image ready semaphore will **NOT** be signaled when the result of AcquireNextImageKHR is not eSuccess
 		//    or eSuboptimalKHR, so it is safe to recycle the semaphore.
@@ -362,6 +524,7 @@ namespace Ailurus
 
 		// Record
 		frameContext.pRenderingCommandBuffer->Begin();
+		const uint64_t uploadWaitValue = _pUploadManager->RecordAcquireBarriers(frameContext.pRenderingCommandBuffer.get());
 		{
 			// Record secondary
 			for (auto& pSecondaryCmdBuffer : _recordedSecondaryCommandBuffers)
@@ -373,15 +536,27 @@ namespace Ailurus
 		}
 		frameContext.pRenderingCommandBuffer->End();
 
+		// Wait stages, values only matter for the upload timeline
+		std::vector<vk::Semaphore> waitSemaphores{ frameContext.imageReadySemaphore->GetSemaphore() };
+		std::vector<vk::PipelineStageFlags> waitStages{ vk::PipelineStageFlagBits::eColorAttachmentOutput };
+		std::vector<uint64_t> waitValues{ 0 };
+		if (uploadWaitValue != 0)
+		{
+			waitSemaphores.push_back(_pUploadManager->GetTimelineSemaphore());
+			waitStages.push_back(vk::PipelineStageFlagBits::eAllCommands);
+			waitValues.push_back(uploadWaitValue);
+		}
+
+		vk::TimelineSemaphoreSubmitInfo timelineSubmitInfo;
+		timelineSubmitInfo.setWaitSemaphoreValues(waitValues);
+
 		// Do submit
 		vk::SubmitInfo submitInfo;
 		submitInfo.setCommandBuffers(frameContext.pRenderingCommandBuffer->GetBuffer())
 			.setSignalSemaphores(frameContext.renderFinishSemaphore->GetSemaphore())
-			.setWaitSemaphores(frameContext.imageReadySemaphore->GetSemaphore());
-
-		// Wait stages
-		std::vector<vk::PipelineStageFlags> waitStages{ vk::PipelineStageFlagBits::eColorAttachmentOutput };
-		submitInfo.setWaitDstStageMask(waitStages);
+			.setWaitSemaphores(waitSemaphores)
+			.setWaitDstStageMask(waitStages)
+			.setPNext(&timelineSubmitInfo);
 
 		// Submit
 		try
@@ -397,9 +572,13 @@ namespace Ailurus
 		// Set this frame on air
 		frameContext.onAirInfo = OnAirInfo{
 			.frameCount = Application::Get<TimeSystem>()->FrameCount(),
+			.frameNumber = _frameNumber,
 			.secondaryCommandBuffers = std::move(_recordedSecondaryCommandBuffers)
 		};
 
+		// Resources marked for deletion from now on may be used by the next frame
+		_frameNumber++;
+
 		// Present
 		vk::PresentInfoKHR presentInfo;
 		presentInfo.setWaitSemaphores(frameContext.renderFinishSemaphore->GetSemaphore())
@@ -585,6 +764,8 @@ namespace Ailurus
 	bool VulkanContext::CreateLogicalDevice()
 	{
 		_supportsMSAADepthResolve = false;
+		_supportsDrawIndirectCount = false;
+		_maxBindlessTextures = 0;
 		_msaaDepthResolveMode = vk::ResolveModeFlagBits::eNone;
 
 		// Find graphic queue and present queue.
@@ -618,6 +799,22 @@ namespace Ailurus
 		_graphicQueueIndex = *optGraphicQueue;
 		_computeQueueIndex = *optComputeQueue;
 
+		// Uploads prefer a transfer only family, its copy engine runs beside rendering. Without one
+		// they share the graphics queue.
+		std::optional<uint32_t> optTransferQueue = std::nullopt;
+		for (const vk::QueueFlags excludedFlags : { vk::QueueFlagBits::eGraphics | vk::QueueFlagBits::eCompute,
+				vk::QueueFlags{ vk::QueueFlagBits::eGraphics } })
+		{
+			for (std::size_t i = 0; i < queueFamilyProperties.size() && !optTransferQueue.has_value(); ++i)
+			{
+				const vk::QueueFlags queueFlags = queueFamilyProperties[i].queueFlags;
+				if ((queueFlags & vk::QueueFlagBits::eTransfer) && !(queueFlags & excludedFlags))
+					optTransferQueue = static_cast<uint32_t>(i);
+			}
+		}
+
+		_transferQueueIndex = optTransferQueue.value_or(_graphicQueueIndex);
+
 		// Queue create info
 		const float queuePriority = 1.0f;
 		std::vector<vk::DeviceQueueCreateInfo> queueCreateInfoList;
@@ -642,13 +839,27 @@ namespace Ailurus
 				.setQueueFamilyIndex(_computeQueueIndex);
 		}
 
-		// Check dynamic rendering support
+		if (_transferQueueIndex != _presentQueueIndex && _transferQueueIndex != _graphicQueueIndex
+			&& _transferQueueIndex != _computeQueueIndex)
+		{
+			queueCreateInfoList.emplace_back();
+			queueCreateInfoList.back()
+				.setQueueCount(1)
+				.setQueuePriorities(queuePriority)
+				.setQueueFamilyIndex(_transferQueueIndex);
+		}
+
+		// Check dynamic rendering and vertex shader layer output support
+		vk::PhysicalDeviceVulkan12Features vulkan12Features;
 		vk::PhysicalDeviceDynamicRenderingFeatures dynamicRenderingFeatures;
+		dynamicRenderingFeatures.setPNext(&vulkan12Features);
 		vk::PhysicalDeviceFeatures2 features2;
 		features2.setPNext(&dynamicRenderingFeatures);
 		_vkPhysicalDevice.getFeatures2(&features2);
 
+		vk::PhysicalDeviceDescriptorIndexingProperties descriptorIndexingProperties;
 		vk::PhysicalDeviceDepthStencilResolveProperties depthResolveProperties;
+		depthResolveProperties.pNext = &descriptorIndexingProperties;
 		vk::PhysicalDeviceProperties2 properties2;
 		properties2.pNext = &depthResolveProperties;
 		_vkPhysicalDevice.getProperties2(&properties2);
@@ -686,14 +897,61 @@ namespace Ailurus
 			std::abort();
 		}
 
+		// Cascaded shadow maps are rendered in one layered pass, the shadow vertex shader writes gl_Layer
+		if (!vulkan12Features.shaderOutputLayer)
+		{
+			Logger::LogError("Shader output layer is not supported by this device. Aborting.");
+			std::abort();
+		}
+
+		// Upload batches signal a timeline semaphore the frames wait on
+		if (!vulkan12Features.timelineSemaphore)
+		{
+			Logger::LogError("Timeline semaphores are not supported by this device. Aborting.");
+			std::abort();
+		}
+
+		// GPU driven culling draws with a GPU written draw count, optional
+		_supportsDrawIndirectCount = vulkan12Features.drawIndirectCount && features2.features.multiDrawIndirect;
+		if (!_supportsDrawIndirectCount)
+			Logger::LogWarn("Draw indirect count is not supported, GPU driven culling is unavailable");
+
+		// Bindless material textures, optional
+		const bool supportsBindless = vulkan12Features.runtimeDescriptorArray
+			&& vulkan12Features.descriptorBindingPartiallyBound
+			&& vulkan12Features.descriptorBindingSampledImageUpdateAfterBind
+			&& vulkan12Features.shaderSampledImageArrayNonUniformIndexing;
+		if (supportsBindless)
+		{
+			_maxBindlessTextures = std::min({ MAX_BINDLESS_TEXTURES,
+				descriptorIndexingProperties.maxDescriptorSetUpdateAfterBindSampledImages,
+				descriptorIndexingProperties.maxDescriptorSetUpdateAfterBindSamplers,
+				descriptorIndexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+				descriptorIndexingProperties.maxPerStageDescriptorUpdateAfterBindSamplers });
+		}
+		else
+			Logger::LogWarn("Descriptor indexing is not supported, bindless materials are unavailable");
+
 		// Features
 		vk::PhysicalDeviceFeatures physicalDeviceFeatures;
-		physicalDeviceFeatures.setSamplerAnisotropy(true);
+		physicalDeviceFeatures.setSamplerAnisotropy(true)
+			.setMultiDrawIndirect(_supportsDrawIndirectCount);
 
 		// Enable dynamic rendering
 		vk::PhysicalDeviceDynamicRenderingFeatures enableDynamicRendering;
 		enableDynamicRendering.setDynamicRendering(true);
 
+		// Enable layer output from vertex shaders
+		vk::PhysicalDeviceVulkan12Features enableVulkan12Features;
+		enableVulkan12Features.setShaderOutputLayer(true)
+			.setTimelineSemaphore(true)
+			.setDrawIndirectCount(_supportsDrawIndirectCount)
+			.setRuntimeDescriptorArray(supportsBindless)
+			.setDescriptorBindingPartiallyBound(supportsBindless)
+			.setDescriptorBindingSampledImageUpdateAfterBind(supportsBindless)
+			.setShaderSampledImageArrayNonUniformIndexing(supportsBindless);
+		enableDynamicRendering.setPNext(&enableVulkan12Features);
+
 		vk::PhysicalDeviceFeatures2 features2Chain;
 		features2Chain.setFeatures(physicalDeviceFeatures)
 			.setPNext(&enableDynamicRendering);
@@ -723,6 +981,7 @@ namespace Ailurus
 		_vkPresentQueue = _vkDevice.getQueue(_presentQueueIndex, 0);
 		_vkGraphicQueue = _vkDevice.getQueue(_graphicQueueIndex, 0);
 		_vkComputeQueue = _vkDevice.getQueue(_computeQueueIndex, 0);
+		_vkTransferQueue = _vkDevice.getQueue(_transferQueueIndex, 0);
 	}
 
 	bool VulkanContext::CreateCommandPool()
@@ -762,8 +1021,8 @@ namespace Ailurus
 
 		// Reset frame resource
 		context.renderFinishFence->Reset();
-		context.pRenderingCommandBuffer->ClearResourceReferences();
-		
+		_completedFrameNumber = std::max(_completedFrameNumber, context.onAirInfo->frameNumber);
+
 		// Reset pools
 		context.pFrameDescriptorAllocator->ResetPools();
 
@@ -772,18 +1031,43 @@ namespace Ailurus
 		{
 			auto& vec = context.onAirInfo->secondaryCommandBuffers;
 			for (size_t i = 0; i < vec.size(); i++)
-			{
-				vec[i]->ClearResourceReferences();
 				_secondaryCommandBufferPool.push_back(std::move(vec[i]));
-			}
 		}
 
+		// Recycle per-thread secondary command buffers
+		RecycleFrameSecondaryCommandBuffers(index);
+
 		// Reset on air info
 		context.onAirInfo = std::nullopt;
 
 		// Resource GC
+		_pUploadManager->Collect();
+		_geometryManager->GarbageCollect();
+		_persistentDescriptorAllocator->GarbageCollect();
 		_resourceManager->GarbageCollect();
 
 		return true;
 	}
-} // namespace Ailurus
\ No newline at end of file
+
+	void VulkanContext::RecycleFrameSecondaryCommandBuffers(uint32_t index)
+	{
+		auto& context = _frameContext[index];
+		for (auto& threadContext : context.threadRecordContexts)
+		{
+			if (threadContext.usedCount == 0)
+				continue;
+
+			threadContext.usedCount = 0;
+
+			// Resetting the whole pool is cheaper than resetting buffers one by one
+			try
+			{
+				_vkDevice.resetCommandPool(threadContext.commandPool);
+			}
+			catch (const vk::SystemError& e)
+			{
+				Logger::LogError("Fail to reset thread command pool: {}", e.what());
+			}
+		}
+	}
+} // namespace Ailurus
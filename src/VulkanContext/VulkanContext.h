@@ -11,15 +11,20 @@
 namespace Ailurus
 {
 	class VulkanDescriptorAllocator;
+	class VulkanUniformRingBuffer;
 	class VulkanSwapChain;
 	class VulkanCommandBuffer;
 	class VulkanVertexLayoutManager;
+	class VulkanGeometryManager;
+	class VulkanPersistentDescriptorAllocator;
 	class VulkanPipelineManager;
 	class VulkanResourceManager;
 	class VulkanFlightManager;
 	class VulkanSemaphore;
 	class VulkanFence;
+	class VulkanUploadManager;
 	class RenderTargetManager;
+	struct VulkanRenderingInheritance;
 	
 	class VulkanContext : public NonCopyable, public NonMovable
 	{
@@ -45,17 +50,37 @@ namespace Ailurus
 		static auto GetPresentQueueIndex() -> uint32_t;
 		static auto GetComputeQueueIndex() -> uint32_t;
 		static auto GetGraphicQueueIndex() -> uint32_t;
+		static auto GetTransferQueueIndex() -> uint32_t;
 		static auto GetPresentQueue() -> vk::Queue;
 		static auto GetGraphicQueue() -> vk::Queue;
 		static auto GetComputeQueue() -> vk::Queue;
+		static auto GetTransferQueue() -> vk::Queue;
 		static auto GetCommandPool() -> vk::CommandPool;
 		static auto GetSwapChain() -> VulkanSwapChain*;
 		static auto GetRenderTargetManager() -> RenderTargetManager*;
 		static auto GetPipelineManager() -> VulkanPipelineManager*;
+
+		/// Cache every pipeline creation goes through, null before the pipeline manager exists
+		static auto GetPipelineCache() -> vk::PipelineCache;
 		static auto GetResourceManager() -> VulkanResourceManager*;
 		static auto GetVertexLayoutManager() -> VulkanVertexLayoutManager*;
+		static auto GetGeometryManager() -> VulkanGeometryManager*;
+		static auto GetPersistentDescriptorAllocator() -> VulkanPersistentDescriptorAllocator*;
+		static auto GetUploadManager() -> VulkanUploadManager*;
 		static auto GetParallelFrameCount() -> uint32_t;
 
+		/// Frame in flight being recorded, in [0, GetParallelFrameCount())
+		static auto GetCurrentParallelFrameIndex() -> uint32_t;
+
+		/// Number of the frame being recorded, incremented on every submitted frame
+		static auto GetFrameNumber() -> uint64_t;
+
+		/// Highest frame number the GPU is known to have finished, frames finish in submission order
+		static auto GetCompletedFrameNumber() -> uint64_t;
+
+		/// Uniform ring of the frame being recorded, reset once the GPU is done with that frame
+		static auto GetFrameUniformRing() -> VulkanUniformRingBuffer*;
+
 		// Swap chain
 		static void RebuildSwapChain();
 		
@@ -69,8 +94,24 @@ namespace Ailurus
 		static bool SupportsMSAADepthResolve();
 		static vk::ResolveModeFlagBits GetMSAADepthResolveMode();
 
+		// Indirect drawing
+		static bool SupportsDrawIndirectCount();
+
+		// Bindless textures, update after bind arrays of combined image samplers indexed non uniformly
+		static bool SupportsBindlessTextures();
+		static uint32_t GetMaxBindlessTextures();
+
 		// Render
+		/// Record a secondary command buffer executed at the beginning of the next frame. Main thread only.
 		static void RecordSecondaryCommandBuffer(const RecordSecondaryCommandBufferFunction& recordFunction);
+
+		/// Record a secondary command buffer for the frame currently being rendered, from the calling
+		/// thread's command pool. Safe to call concurrently from JobSystem threads inside the RenderFrame
+		/// callback. The returned buffer is owned by the frame and must be executed by its primary buffer.
+		/// @param pInheritance Rendering scope the buffer is executed in, nullptr for outside rendering.
+		static auto RecordFrameSecondaryCommandBuffer(const VulkanRenderingInheritance* pInheritance,
+			const RecordSecondaryCommandBufferFunction& recordFunction) -> VulkanCommandBuffer*;
+
 		static void RenderFrame(bool* needRebuildSwapChain, const RenderFunction& recordCmdBufFunc);
 		static void WaitDeviceIdle();
 
@@ -87,19 +128,31 @@ namespace Ailurus
 
 		// Frame context
 		static bool WaitFrameFinish(uint32_t index);
+		static void RecycleFrameSecondaryCommandBuffers(uint32_t index);
 
 	private:
 		struct OnAirInfo
 		{
 			uint64_t frameCount;
+			uint64_t frameNumber;
+			std::vector<std::unique_ptr<VulkanCommandBuffer>> secondaryCommandBuffers;
+		};
+
+		/// Per-thread recording state of one frame, a command pool must only be used by one thread.
+		struct alignas(64) ThreadRecordContext
+		{
+			vk::CommandPool commandPool = nullptr;
+			uint32_t usedCount = 0;
 			std::vector<std::unique_ptr<VulkanCommandBuffer>> secondaryCommandBuffers;
 		};
 
 		struct FrameContext
 		{
 			std::optional<OnAirInfo> onAirInfo;
+			std::vector<ThreadRecordContext> threadRecordContexts;
 			std::unique_ptr<VulkanCommandBuffer> pRenderingCommandBuffer;
 			std::unique_ptr<VulkanDescriptorAllocator> pFrameDescriptorAllocator;
+			std::unique_ptr<VulkanUniformRingBuffer> pFrameUniformRing;
 			std::unique_ptr<VulkanSemaphore> imageReadySemaphore;
 			std::unique_ptr<VulkanSemaphore> renderFinishSemaphore;
 			std::unique_ptr<VulkanFence> renderFinishFence;
@@ -107,6 +160,8 @@ namespace Ailurus
 
 	private:
 		static uint32_t _parallelFrameCount;
+		static constexpr size_t FRAME_UNIFORM_RING_CAPACITY = 256 * 1024;
+		static constexpr uint32_t MAX_BINDLESS_TEXTURES = 4096;
 		static uint32_t _apiVersion;
 
 		// Init
@@ -121,9 +176,11 @@ namespace Ailurus
 		static uint32_t _presentQueueIndex;
 		static uint32_t _graphicQueueIndex;
 		static uint32_t _computeQueueIndex;
+		static uint32_t _transferQueueIndex;
 		static vk::Queue _vkPresentQueue;
 		static vk::Queue _vkGraphicQueue;
 		static vk::Queue _vkComputeQueue;
+		static vk::Queue _vkTransferQueue;
 		static vk::CommandPool _vkGraphicCommandPool;
 
 		// Swap chain
@@ -131,16 +188,23 @@ namespace Ailurus
 		static bool _vsyncEnabled;
 		static vk::SampleCountFlagBits _msaaSamples;
 		static bool _supportsMSAADepthResolve;
+		static bool _supportsDrawIndirectCount;
+		static uint32_t _maxBindlessTextures;
 		static vk::ResolveModeFlagBits _msaaDepthResolveMode;
 
 		// Managers
 		static std::unique_ptr<RenderTargetManager> _pRenderTargetManager;
 		static std::unique_ptr<VulkanResourceManager> _resourceManager;
 		static std::unique_ptr<VulkanVertexLayoutManager> _vertexLayoutManager;
+		static std::unique_ptr<VulkanGeometryManager> _geometryManager;
+		static std::unique_ptr<VulkanPersistentDescriptorAllocator> _persistentDescriptorAllocator;
 		static std::unique_ptr<VulkanPipelineManager> _pipelineManager;
+		static std::unique_ptr<VulkanUploadManager> _pUploadManager;
 
 		// Flight
 		static uint32_t _currentFrameIndex;
+		static uint64_t _frameNumber;
+		static uint64_t _completedFrameNumber;
 		static std::vector<FrameContext> _frameContext;
 
 		// Secondary command buffer
@@ -0,0 +1,109 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+#include <random>
+#include <set>
+#include <vector>
+#include <Ailurus/Container/DynamicBVH.hpp>
+#include "../Math/FrustumHelper.hpp"
+
+using namespace Ailurus;
+using FrustumTestHelper::MakeBoxFrustum;
+
+static AABBf MakeBox(const Vector3f& center, float halfSize)
+{
+    const Vector3f extents(halfSize, halfSize, halfSize);
+    return { center - extents, center + extents };
+}
+
+TEST_SUITE("DynamicBVH")
+{
+    TEST_CASE("Insert move remove")
+    {
+        DynamicBVH tree(0.5f);
+        CHECK_EQ(tree.GetLeafCount(), 0);
+        CHECK_EQ(tree.GetHeight(), 0);
+
+        int32_t a = tree.Insert(MakeBox({ 0, 0, 0 }, 1.0f), 10);
+        int32_t b = tree.Insert(MakeBox({ 10, 0, 0 }, 1.0f), 20);
+        CHECK_EQ(tree.GetLeafCount(), 2);
+        CHECK_EQ(tree.GetUserData(a), 10);
+        CHECK_EQ(tree.GetUserData(b), 20);
+
+        // Inside the fat box, no reinsertion
+        CHECK_FALSE(tree.Move(a, MakeBox({ 0.2f, 0, 0 }, 1.0f)));
+        CHECK(tree.Move(a, MakeBox({ 5, 0, 0 }, 1.0f)));
+
+        tree.SetUserData(b, 30);
+        CHECK_EQ(tree.GetUserData(b), 30);
+
+        tree.Remove(a);
+        CHECK_EQ(tree.GetLeafCount(), 1);
+
+        std::vector<uint32_t> result;
+        tree.Query(MakeBox({ 10, 0, 0 }, 0.1f), [&](uint32_t userData) { result.push_back(userData); });
+        REQUIRE_EQ(result.size(), 1);
+        CHECK_EQ(result[0], 30);
+    }
+
+    TEST_CASE("Queries match brute force")
+    {
+        constexpr int COUNT = 4000;
+
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+
+        DynamicBVH tree;
+        std::vector<AABBf> boxes;
+        std::vector<int32_t> nodes;
+        for (int i = 0; i < COUNT; i++)
+        {
+            boxes.push_back(MakeBox({ dist(rng), dist(rng), dist(rng) }, 1.0f));
+            nodes.push_back(tree.Insert(boxes.back(), i));
+        }
+
+        for (int i = 0; i < COUNT * 4; i++)
+        {
+            const int index = static_cast<int>(rng() % COUNT);
+            boxes[index] = MakeBox({ dist(rng), dist(rng), dist(rng) }, 1.0f);
+            tree.Move(nodes[index], boxes[index]);
+        }
+
+        // Remove the first quarter
+        for (int i = 0; i < COUNT / 4; i++)
+            tree.Remove(nodes[i]);
+
+        CHECK_EQ(tree.GetLeafCount(), COUNT - COUNT / 4);
+
+        // Balanced tree stays far below the leaf count
+        CHECK_LT(tree.GetHeight(), 32);
+
+        const Frustum frustum = MakeBoxFrustum(30.0f);
+        std::set<uint32_t> frustumResult;
+        tree.Query(frustum, [&](uint32_t userData) { frustumResult.insert(userData); });
+
+        const AABBf queryBox = MakeBox({ 0, 0, 0 }, 20.0f);
+        std::set<uint32_t> boxResult;
+        tree.Query(queryBox, [&](uint32_t userData) { boxResult.insert(userData); });
+
+        bool noFalseNegative = true;
+        bool noRemovedReported = true;
+        for (int i = 0; i < COUNT; i++)
+        {
+            const bool removed = i < COUNT / 4;
+            if (removed)
+            {
+                noRemovedReported &= frustumResult.count(i) == 0 && boxResult.count(i) == 0;
+                continue;
+            }
+
+            if (frustum.Intersects(boxes[i]))
+                noFalseNegative &= frustumResult.count(i) == 1;
+
+            if (queryBox.Intersects(boxes[i]))
+                noFalseNegative &= boxResult.count(i) == 1;
+        }
+
+        CHECK(noFalseNegative);
+        CHECK(noRemovedReported);
+    }
+}
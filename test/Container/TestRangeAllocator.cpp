@@ -0,0 +1,125 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <Ailurus/Container/RangeAllocator.hpp>
+
+using namespace Ailurus;
+
+TEST_SUITE("RangeAllocator")
+{
+    TEST_CASE("Allocate until full")
+    {
+        RangeAllocator allocator(100);
+        CHECK_EQ(allocator.Allocate(40), 0);
+        CHECK_EQ(allocator.Allocate(60), 40);
+        CHECK_EQ(allocator.Allocate(1), RangeAllocator::INVALID_OFFSET);
+        CHECK_EQ(allocator.GetUsedSize(), 100);
+        CHECK_EQ(allocator.GetFreeRangeCount(), 0);
+    }
+
+    TEST_CASE("Zero size")
+    {
+        RangeAllocator allocator(10);
+        CHECK_EQ(allocator.Allocate(0), RangeAllocator::INVALID_OFFSET);
+        CHECK_EQ(allocator.GetUsedSize(), 0);
+    }
+
+    TEST_CASE("Free merges neighbours")
+    {
+        RangeAllocator allocator(30);
+        const uint32_t a = allocator.Allocate(10);
+        const uint32_t b = allocator.Allocate(10);
+        const uint32_t c = allocator.Allocate(10);
+
+        allocator.Free(a, 10);
+        allocator.Free(c, 10);
+        CHECK_EQ(allocator.GetFreeRangeCount(), 2);
+
+        // Middle range joins both sides into one
+        allocator.Free(b, 10);
+        CHECK_EQ(allocator.GetFreeRangeCount(), 1);
+        CHECK_EQ(allocator.GetUsedSize(), 0);
+        CHECK_EQ(allocator.Allocate(30), 0);
+    }
+
+    TEST_CASE("First fit reuses holes")
+    {
+        RangeAllocator allocator(100);
+        const uint32_t a = allocator.Allocate(20);
+        allocator.Allocate(20);
+        allocator.Free(a, 20);
+
+        // Too large for the hole, taken from the tail
+        CHECK_EQ(allocator.Allocate(30), 40);
+
+        // Fits the hole
+        CHECK_EQ(allocator.Allocate(15), 0);
+        CHECK_EQ(allocator.Allocate(5), 15);
+    }
+
+    TEST_CASE("Grow keeps offsets and merges tail")
+    {
+        RangeAllocator allocator(10);
+        CHECK_EQ(allocator.Allocate(6), 0);
+        CHECK_EQ(allocator.Allocate(8), RangeAllocator::INVALID_OFFSET);
+
+        allocator.Grow(20);
+        CHECK_EQ(allocator.GetCapacity(), 20);
+        CHECK_EQ(allocator.GetFreeRangeCount(), 1);
+        CHECK_EQ(allocator.Allocate(14), 6);
+        CHECK_EQ(allocator.GetUsedSize(), 20);
+    }
+
+    TEST_CASE("Random allocations never overlap")
+    {
+        struct Range
+        {
+            uint32_t offset;
+            uint32_t size;
+        };
+
+        RangeAllocator allocator(4096);
+        std::mt19937 random(7);
+        std::vector<Range> live;
+
+        for (int step = 0; step < 5000; step++)
+        {
+            if (!live.empty() && random() % 2 == 0)
+            {
+                const size_t index = random() % live.size();
+                allocator.Free(live[index].offset, live[index].size);
+                live[index] = live.back();
+                live.pop_back();
+                continue;
+            }
+
+            const uint32_t size = 1 + random() % 64;
+            const uint32_t offset = allocator.Allocate(size);
+            if (offset != RangeAllocator::INVALID_OFFSET)
+                live.push_back(Range{ offset, size });
+        }
+
+        std::sort(live.begin(), live.end(), [](const Range& lhs, const Range& rhs) { return lhs.offset < rhs.offset; });
+
+        bool disjoint = true;
+        uint32_t usedSize = 0;
+        for (size_t i = 0; i < live.size(); i++)
+        {
+            usedSize += live[i].size;
+            disjoint &= live[i].offset + live[i].size <= allocator.GetCapacity();
+            if (i > 0)
+                disjoint &= live[i - 1].offset + live[i - 1].size <= live[i].offset;
+        }
+
+        CHECK(disjoint);
+        CHECK_EQ(usedSize, allocator.GetUsedSize());
+
+        for (const auto& range : live)
+            allocator.Free(range.offset, range.size);
+
+        CHECK_EQ(allocator.GetUsedSize(), 0);
+        CHECK_EQ(allocator.GetFreeRangeCount(), 1);
+    }
+}
@@ -0,0 +1,83 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+#include <memory>
+#include <string>
+#include <Ailurus/Container/SlotMap.hpp>
+
+using namespace Ailurus;
+
+TEST_SUITE("SlotMap")
+{
+    TEST_CASE("Insert and get")
+    {
+        SlotMap<std::string> slotMap;
+        const auto a = slotMap.Insert("a");
+        const auto b = slotMap.Insert("b");
+
+        CHECK(a.IsValid());
+        CHECK_NE(a.index, b.index);
+        REQUIRE(slotMap.Get(a) != nullptr);
+        CHECK_EQ(*slotMap.Get(a), "a");
+        CHECK_EQ(*slotMap.Get(b), "b");
+        CHECK_EQ(slotMap.Size(), 2);
+    }
+
+    TEST_CASE("Default handle never resolves")
+    {
+        SlotMap<int> slotMap;
+        slotMap.Insert(1);
+        CHECK_FALSE(SlotMapHandle{}.IsValid());
+        CHECK_EQ(slotMap.Get(SlotMapHandle{}), nullptr);
+        CHECK_EQ(slotMap.Get(SlotMapHandle{ 0, 0 }), nullptr);
+    }
+
+    TEST_CASE("Removed handle turns stale")
+    {
+        SlotMap<int> slotMap;
+        const auto a = slotMap.Insert(1);
+        CHECK(slotMap.Remove(a));
+        CHECK_FALSE(slotMap.Contains(a));
+        CHECK_EQ(slotMap.Get(a), nullptr);
+        CHECK_FALSE(slotMap.Remove(a));
+        CHECK_EQ(slotMap.Size(), 0);
+    }
+
+    TEST_CASE("Reused slot does not resolve old handles")
+    {
+        SlotMap<int> slotMap;
+        const auto a = slotMap.Insert(1);
+        slotMap.Remove(a);
+
+        const auto b = slotMap.Insert(2);
+        CHECK_EQ(b.index, a.index);
+        CHECK_NE(b.generation, a.generation);
+        CHECK_EQ(slotMap.Get(a), nullptr);
+        CHECK_EQ(*slotMap.Get(b), 2);
+        CHECK_EQ(slotMap.GetSlotCount(), 1);
+        CHECK_EQ(slotMap.GetFreeSlotCount(), 0);
+    }
+
+    TEST_CASE("Remove destroys the element")
+    {
+        SlotMap<std::shared_ptr<int>> slotMap;
+        auto value = std::make_shared<int>(5);
+        const auto a = slotMap.Insert(value);
+        CHECK_EQ(value.use_count(), 2);
+
+        slotMap.Remove(a);
+        CHECK_EQ(value.use_count(), 1);
+    }
+
+    TEST_CASE("Clear")
+    {
+        SlotMap<std::unique_ptr<int>> slotMap;
+        const auto a = slotMap.Insert(std::make_unique<int>(1));
+        const auto b = slotMap.Insert(std::make_unique<int>(2));
+        slotMap.Remove(a);
+
+        slotMap.Clear();
+        CHECK_EQ(slotMap.Size(), 0);
+        CHECK_EQ(slotMap.Get(b), nullptr);
+        CHECK_EQ(slotMap.GetFreeSlotCount(), 2);
+    }
+}
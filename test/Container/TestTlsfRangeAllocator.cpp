@@ -0,0 +1,150 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <Ailurus/Container/TlsfRangeAllocator.hpp>
+
+using namespace Ailurus;
+
+TEST_SUITE("TlsfRangeAllocator")
+{
+    TEST_CASE("Allocate until full")
+    {
+        TlsfRangeAllocator allocator(256);
+        const auto a = allocator.Allocate(128);
+        const auto b = allocator.Allocate(128);
+        CHECK_NE(a.node, TlsfRangeAllocator::INVALID_NODE);
+        CHECK_NE(b.node, TlsfRangeAllocator::INVALID_NODE);
+        CHECK_NE(a.offset, b.offset);
+        CHECK_EQ(allocator.Allocate(1).node, TlsfRangeAllocator::INVALID_NODE);
+        CHECK_EQ(allocator.GetUsedSize(), 256);
+        CHECK_EQ(allocator.GetAllocationCount(), 2);
+        CHECK_EQ(allocator.GetFreeBlockCount(), 0);
+    }
+
+    TEST_CASE("Zero and oversized requests")
+    {
+        TlsfRangeAllocator allocator(64);
+        CHECK_EQ(allocator.Allocate(0).node, TlsfRangeAllocator::INVALID_NODE);
+        CHECK_EQ(allocator.Allocate(65).node, TlsfRangeAllocator::INVALID_NODE);
+        CHECK(allocator.IsEmpty());
+    }
+
+    TEST_CASE("Alignment")
+    {
+        TlsfRangeAllocator allocator(4096);
+        const auto a = allocator.Allocate(10);
+        CHECK_EQ(a.offset, 0);
+
+        // Padding in front of the aligned block stays usable
+        const auto b = allocator.Allocate(100, 256);
+        CHECK_EQ(b.offset % 256, 0);
+        CHECK_EQ(allocator.GetUsedSize(), 110);
+
+        const auto c = allocator.Allocate(200);
+        CHECK_EQ(c.offset, 10);
+    }
+
+    TEST_CASE("Free merges neighbours")
+    {
+        TlsfRangeAllocator allocator(300);
+        const auto a = allocator.Allocate(100);
+        const auto b = allocator.Allocate(100);
+        const auto c = allocator.Allocate(100);
+
+        allocator.Free(a.node);
+        allocator.Free(c.node);
+        CHECK_EQ(allocator.GetFreeBlockCount(), 2);
+
+        // Middle block joins both sides into one
+        allocator.Free(b.node);
+        CHECK_EQ(allocator.GetFreeBlockCount(), 1);
+        CHECK(allocator.IsEmpty());
+        CHECK_EQ(allocator.Allocate(300).offset, 0);
+    }
+
+    TEST_CASE("Double free is ignored")
+    {
+        TlsfRangeAllocator allocator(100);
+        const auto a = allocator.Allocate(40);
+        allocator.Free(a.node);
+        allocator.Free(a.node);
+        CHECK_EQ(allocator.GetUsedSize(), 0);
+        CHECK_EQ(allocator.GetAllocationCount(), 0);
+    }
+
+    TEST_CASE("Good fit keeps large holes for large requests")
+    {
+        TlsfRangeAllocator allocator(1 << 20);
+        const auto small = allocator.Allocate(1024);
+        allocator.Allocate(64);
+        const auto large = allocator.Allocate(64 * 1024);
+        allocator.Allocate(64);
+
+        allocator.Free(small.node);
+        allocator.Free(large.node);
+
+        CHECK_EQ(allocator.Allocate(1000).offset, small.offset);
+        CHECK_EQ(allocator.Allocate(60 * 1024).offset, large.offset);
+    }
+
+    TEST_CASE("Random allocations never overlap")
+    {
+        struct Range
+        {
+            uint64_t offset;
+            uint64_t size;
+            uint32_t node;
+        };
+
+        TlsfRangeAllocator allocator(1 << 16);
+        std::mt19937 random(11);
+        std::vector<Range> live;
+
+        bool aligned = true;
+        for (int step = 0; step < 20000; step++)
+        {
+            if (!live.empty() && random() % 2 == 0)
+            {
+                const size_t index = random() % live.size();
+                allocator.Free(live[index].node);
+                live[index] = live.back();
+                live.pop_back();
+                continue;
+            }
+
+            const uint64_t size = 1 + random() % 700;
+            const uint64_t alignment = uint64_t{ 1 } << (random() % 9);
+            const auto allocation = allocator.Allocate(size, alignment);
+            if (allocation.node == TlsfRangeAllocator::INVALID_NODE)
+                continue;
+
+            aligned &= allocation.offset % alignment == 0;
+            live.push_back(Range{ allocation.offset, size, allocation.node });
+        }
+
+        std::sort(live.begin(), live.end(), [](const Range& lhs, const Range& rhs) { return lhs.offset < rhs.offset; });
+
+        bool disjoint = true;
+        uint64_t usedSize = 0;
+        for (size_t i = 0; i < live.size(); i++)
+        {
+            usedSize += live[i].size;
+            disjoint &= live[i].offset + live[i].size <= allocator.GetCapacity();
+            if (i > 0)
+                disjoint &= live[i - 1].offset + live[i - 1].size <= live[i].offset;
+        }
+
+        CHECK(aligned);
+        CHECK(disjoint);
+        CHECK_EQ(usedSize, allocator.GetUsedSize());
+
+        for (const auto& range : live)
+            allocator.Free(range.node);
+
+        CHECK(allocator.IsEmpty());
+        CHECK_EQ(allocator.GetFreeBlockCount(), 1);
+        CHECK_EQ(allocator.Allocate(1 << 16).offset, 0);
+    }
+}
@@ -0,0 +1,97 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <Ailurus/Systems/JobSystem/JobSystem.h>
+#include <Ailurus/Systems/SceneSystem/Component/CompStaticMeshRender.h>
+#include "Systems/RenderSystem/OcclusionCulling/OcclusionCulling.h"
+#include "Systems/RenderSystem/RenderWorld/RenderWorld.h"
+
+using namespace Ailurus;
+
+namespace
+{
+	// Identity view projection, world space is clip space with w = 1 and depth in [0, 1]
+	AABBf MakeBox(float minX, float minY, float maxX, float maxY, float nearDepth, float farDepth)
+	{
+		return AABBf({ minX, minY, nearDepth }, { maxX, maxY, farDepth });
+	}
+
+	struct Scene
+	{
+		std::vector<std::unique_ptr<CompStaticMeshRender>> meshRenders;
+		std::vector<MeshRenderProxy> proxies;
+		std::vector<uint32_t> visibleProxies;
+
+		CompStaticMeshRender* Add(const AABBf& worldAABB)
+		{
+			meshRenders.push_back(std::make_unique<CompStaticMeshRender>(AssetRef<Model>(nullptr), AssetRef<MaterialInstance>(nullptr)));
+			visibleProxies.push_back(static_cast<uint32_t>(proxies.size()));
+			proxies.push_back(MeshRenderProxy{ nullptr, meshRenders.back().get(), Matrix4x4f::Identity, worldAABB, worldAABB.GetCenter() });
+			return meshRenders.back().get();
+		}
+
+		uint32_t Cull(JobSystem* pJobSystem)
+		{
+			OcclusionCulling culling(pJobSystem);
+			return culling.Cull(proxies, Matrix4x4f::Identity, Vector3f(0.0f, 0.0f, -1.0f), visibleProxies);
+		}
+
+		bool IsVisible(uint32_t proxyIndex) const
+		{
+			return std::find(visibleProxies.begin(), visibleProxies.end(), proxyIndex) != visibleProxies.end();
+		}
+	};
+}
+
+TEST_SUITE("OcclusionCulling")
+{
+	TEST_CASE("Occluder with explicit hull hides what is behind it")
+	{
+		JobSystem jobSystem(2);
+		Scene scene;
+
+		const AABBf hull = MakeBox(-1.0f, -1.0f, 1.0f, 1.0f, 0.3f, 0.31f);
+		auto* pOccluder = scene.Add(hull);
+		pOccluder->SetOccluder(true);
+		pOccluder->SetOccluderBounds(hull);
+		scene.Add(MakeBox(-0.2f, -0.2f, 0.2f, 0.2f, 0.6f, 0.7f));
+		scene.Add(MakeBox(-0.2f, -0.2f, 0.2f, 0.2f, 0.1f, 0.2f));
+
+		CHECK_EQ(scene.Cull(&jobSystem), 1);
+		CHECK(scene.IsVisible(0));
+		CHECK_FALSE(scene.IsVisible(1));
+		CHECK(scene.IsVisible(2));
+	}
+
+	TEST_CASE("Occluder without hull is not rasterized and is still tested")
+	{
+		JobSystem jobSystem(2);
+		Scene scene;
+
+		// Concave occluder, its model bounds cover the screen but it has no hull of its own
+		auto* pHullless = scene.Add(MakeBox(-1.0f, -1.0f, 1.0f, 1.0f, 0.5f, 0.55f));
+		pHullless->SetOccluder(true);
+		CHECK_FALSE(pHullless->GetOccluderBounds().has_value());
+
+		// Seen through the occluder's openings
+		scene.Add(MakeBox(0.2f, -0.2f, 0.6f, 0.2f, 0.8f, 0.9f));
+
+		CHECK_EQ(scene.Cull(&jobSystem), 0);
+		CHECK(scene.IsVisible(0));
+		CHECK(scene.IsVisible(1));
+
+		// Behind a hulled occluder the hull-less one is culled like any other proxy
+		const AABBf wall = MakeBox(-1.0f, -1.0f, 1.0f, 1.0f, 0.3f, 0.31f);
+		auto* pWall = scene.Add(wall);
+		pWall->SetOccluder(true);
+		pWall->SetOccluderBounds(wall);
+
+		CHECK_EQ(scene.Cull(&jobSystem), 2);
+		CHECK_FALSE(scene.IsVisible(0));
+		CHECK_FALSE(scene.IsVisible(1));
+		CHECK(scene.IsVisible(2));
+	}
+}
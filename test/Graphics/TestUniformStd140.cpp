@@ -425,6 +425,61 @@ TEST_SUITE("Std140LayoutRules")
         }
     }
 
+    TEST_CASE("Access layouts for handle resolution")
+    {
+        auto structUniform = std::make_unique<UniformVariableStructure>();
+        structUniform->AddMember("matrix", std::make_unique<UniformVariableNumeric>(UniformValueType::Mat4));
+        structUniform->AddMember("count", std::make_unique<UniformVariableNumeric>(UniformValueType::Int));
+        structUniform->AddMember("distances", std::make_unique<UniformVariableArray>(
+            std::make_unique<UniformVariableNumeric>(UniformValueType::Float), 4));
+        structUniform->AddMember("colors", std::make_unique<UniformVariableArray>(
+            std::make_unique<UniformVariableNumeric>(UniformValueType::Vector4), 2));
+
+        std::vector<ShaderStage> stages = { ShaderStage::Vertex };
+        UniformBindingPoint bindingPoint(0, stages, "block", std::move(structUniform));
+
+        SUBCASE("Numeric members carry their value type")
+        {
+            auto layout = bindingPoint.GetAccessLayout("block.count");
+            REQUIRE(layout.has_value());
+            CHECK_EQ(layout->variableType, UniformVariableType::Numeric);
+            CHECK_EQ(layout->valueType, UniformValueType::Int);
+            CHECK_EQ(layout->offset, 64);
+            CHECK_EQ(layout->size, 4);
+        }
+
+        SUBCASE("Array names address every element")
+        {
+            auto layout = bindingPoint.GetAccessLayout("block.distances");
+            REQUIRE(layout.has_value());
+            CHECK_EQ(layout->variableType, UniformVariableType::Array);
+            CHECK_EQ(layout->valueType, UniformValueType::Float);
+            CHECK_EQ(layout->offset, bindingPoint.GetAccessOffset("block.distances[0]").value());
+            CHECK_EQ(layout->arrayStride, 16);
+            CHECK_EQ(layout->arrayCount, 4);
+            CHECK_EQ(layout->size, 64);
+
+            auto colors = bindingPoint.GetAccessLayout("block.colors");
+            REQUIRE(colors.has_value());
+            CHECK_EQ(colors->offset, layout->offset + layout->size);
+            CHECK_EQ(colors->size, 32);
+        }
+
+        SUBCASE("Structure name spans the whole block")
+        {
+            auto layout = bindingPoint.GetAccessLayout("block");
+            REQUIRE(layout.has_value());
+            CHECK_EQ(layout->variableType, UniformVariableType::Structure);
+            CHECK_EQ(layout->offset, 0);
+            CHECK_EQ(layout->size, bindingPoint.GetTotalSize());
+        }
+
+        SUBCASE("Unknown access has no layout")
+        {
+            CHECK_FALSE(bindingPoint.GetAccessLayout("block.missing").has_value());
+        }
+    }
+
     TEST_CASE("Std140 Edge Cases and Boundary Conditions")
     {
         SUBCASE("Consecutive scalars packing")
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <Ailurus/Math/Frustum.hpp>
+
+namespace FrustumTestHelper
+{
+	// Axis aligned box shaped frustum, planes point inwards
+	inline Ailurus::Frustum MakeBoxFrustum(float halfSize)
+	{
+		const Ailurus::Vector3f normals[6] = {
+			{ 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 }
+		};
+
+		Ailurus::Frustum frustum;
+		for (int i = 0; i < 6; i++)
+		{
+			frustum.planes[i].normal = normals[i];
+			frustum.planes[i].distance = halfSize;
+		}
+		return frustum;
+	}
+} // namespace FrustumTestHelper
@@ -0,0 +1,177 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+#include <chrono>
+#include <random>
+#include <vector>
+#include <Ailurus/Math/FrustumCulling.hpp>
+#include "FrustumHelper.hpp"
+
+using namespace Ailurus;
+using FrustumTestHelper::MakeBoxFrustum;
+
+namespace
+{
+	// Slanted planes so every normal component takes part
+	Frustum MakeSlantedFrustum()
+	{
+		Frustum frustum = MakeBoxFrustum(40.0f);
+		frustum.planes[0].normal = Vector3f(1.0f, 1.0f, 0.0f).Normalized();
+		frustum.planes[3].normal = Vector3f(0.0f, -1.0f, 1.0f).Normalized();
+		frustum.planes[5].normal = Vector3f(0.5f, 0.2f, -1.0f).Normalized();
+		return frustum;
+	}
+
+	void FillRandomBoxes(BoundingBoxArray& boxes, std::vector<AABBf>& reference, uint32_t count)
+	{
+		std::mt19937 rng(42);
+		std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+		std::uniform_real_distribution<float> size(0.1f, 5.0f);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const Vector3f center(position(rng), position(rng), position(rng));
+			const Vector3f extents(size(rng), size(rng), size(rng));
+			reference.push_back(AABBf(center - extents, center + extents));
+			boxes.Add(reference.back());
+		}
+	}
+
+	AABBf TransformCorners(const AABBf& aabb, const Matrix4x4f& matrix)
+	{
+		Vector3f newMin(FLT_MAX, FLT_MAX, FLT_MAX);
+		Vector3f newMax(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+		for (int i = 0; i < 8; i++)
+		{
+			const Vector4f corner((i & 1) ? aabb.max.x : aabb.min.x,
+				(i & 2) ? aabb.max.y : aabb.min.y,
+				(i & 4) ? aabb.max.z : aabb.min.z,
+				1.0f);
+			const Vector4f transformed = matrix * corner;
+			newMin = Vector3f::Min(newMin, Vector3f(transformed.x, transformed.y, transformed.z));
+			newMax = Vector3f::Max(newMax, Vector3f(transformed.x, transformed.y, transformed.z));
+		}
+		return { newMin, newMax };
+	}
+}
+
+TEST_SUITE("FrustumCulling")
+{
+	TEST_CASE("Center extent transform matches transformed corners")
+	{
+		const AABBf aabb({ -1.0f, -2.0f, 0.5f }, { 3.0f, 1.0f, 2.0f });
+
+		// Rotation around z by 30 degrees, non uniform scale, translation
+		const float c = std::cos(0.5235988f);
+		const float s = std::sin(0.5235988f);
+		const Matrix4x4f matrix = {
+			{ c * 2.0f, -s * 0.5f, 0.0f, 10.0f },
+			{ s * 2.0f, c * 0.5f, 0.0f, -4.0f },
+			{ 0.0f, 0.0f, 3.0f, 1.0f },
+			{ 0.0f, 0.0f, 0.0f, 1.0f },
+		};
+
+		const AABBf fast = aabb.Transform(matrix);
+		const AABBf reference = TransformCorners(aabb, matrix);
+		for (int axis = 0; axis < 3; axis++)
+		{
+			CHECK(fast.min[axis] == doctest::Approx(reference.min[axis]));
+			CHECK(fast.max[axis] == doctest::Approx(reference.max[axis]));
+		}
+	}
+
+	TEST_CASE("Batch culling matches scalar and Frustum::Intersects")
+	{
+		// Odd count to exercise the padding lanes
+		constexpr uint32_t COUNT = 1037;
+
+		BoundingBoxArray boxes;
+		std::vector<AABBf> reference;
+		FillRandomBoxes(boxes, reference, COUNT);
+		CHECK_EQ(boxes.Size(), COUNT);
+		CHECK_EQ(boxes.PaddedSize() % BoundingBoxArray::BATCH_SIZE, 0);
+
+		for (const Frustum& frustum : { MakeBoxFrustum(30.0f), MakeSlantedFrustum() })
+		{
+			std::vector<uint64_t> scalarMask;
+			std::vector<uint64_t> simdMask;
+			Math::CullBoundingBoxesScalar(frustum, boxes, scalarMask);
+			Math::CullBoundingBoxes(frustum, boxes, simdMask);
+
+			REQUIRE_EQ(scalarMask.size(), (COUNT + 63) / 64);
+			CHECK_EQ(scalarMask, simdMask);
+
+			uint32_t mismatch = 0;
+			uint32_t visibleCount = 0;
+			for (uint32_t i = 0; i < COUNT; i++)
+			{
+				const bool visible = Math::IsVisible(simdMask, i);
+				mismatch += visible != frustum.Intersects(reference[i]);
+				visibleCount += visible;
+			}
+
+			CHECK_EQ(mismatch, 0);
+			CHECK_GT(visibleCount, 0);
+			CHECK_LT(visibleCount, COUNT);
+
+			// Bits past the last box stay clear
+			CHECK_EQ(simdMask.back() >> (COUNT & 63), 0);
+		}
+	}
+
+	TEST_CASE("Set updates a box in place")
+	{
+		BoundingBoxArray boxes;
+		boxes.Add(AABBf({ 100, 100, 100 }, { 101, 101, 101 }));
+		boxes.Add(AABBf({ -1, -1, -1 }, { 1, 1, 1 }));
+
+		std::vector<uint64_t> mask;
+		Math::CullBoundingBoxes(MakeBoxFrustum(10.0f), boxes, mask);
+		CHECK_FALSE(Math::IsVisible(mask, 0));
+		CHECK(Math::IsVisible(mask, 1));
+
+		boxes.Set(0, AABBf({ 0, 0, 0 }, { 1, 1, 1 }));
+		Math::CullBoundingBoxes(MakeBoxFrustum(10.0f), boxes, mask);
+		CHECK(Math::IsVisible(mask, 0));
+
+		boxes.Clear();
+		CHECK_EQ(boxes.Size(), 0);
+		Math::CullBoundingBoxes(MakeBoxFrustum(10.0f), boxes, mask);
+		CHECK(mask.empty());
+	}
+}
+
+// Timing only, run with --no-skip
+TEST_SUITE("FrustumCullingBenchmark" * doctest::skip())
+{
+	TEST_CASE("Scalar vs batch")
+	{
+		constexpr uint32_t COUNT = 50000;
+		constexpr int ITERATIONS = 200;
+
+		BoundingBoxArray boxes;
+		std::vector<AABBf> reference;
+		FillRandomBoxes(boxes, reference, COUNT);
+		const Frustum frustum = MakeSlantedFrustum();
+
+		using Clock = std::chrono::steady_clock;
+		const auto measure = [&](auto&& func) -> double {
+			const auto start = Clock::now();
+			for (int i = 0; i < ITERATIONS; i++)
+				func();
+			return std::chrono::duration<double, std::micro>(Clock::now() - start).count() / ITERATIONS;
+		};
+
+		std::vector<uint64_t> mask;
+		uint32_t sink = 0;
+		const double intersectsUs = measure([&]() {
+			for (const AABBf& aabb : reference)
+				sink += frustum.Intersects(aabb);
+		});
+		const double scalarUs = measure([&]() { Math::CullBoundingBoxesScalar(frustum, boxes, mask); });
+		const double batchUs = measure([&]() { Math::CullBoundingBoxes(frustum, boxes, mask); });
+
+		MESSAGE(COUNT << " boxes: Frustum::Intersects " << intersectsUs << " us, scalar SoA "
+			<< scalarUs << " us, batch " << batchUs << " us (" << sink << ")");
+		CHECK_GT(batchUs, 0.0);
+	}
+}
@@ -0,0 +1,180 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <Ailurus/Math/LightClusterGrid.hpp>
+
+using namespace Ailurus;
+
+namespace
+{
+	constexpr float NEAR_PLANE = 0.1f;
+	constexpr float FAR_PLANE = 100.0f;
+
+	// Same convention as the camera, right handed view space looking down -z, depth in [0, 1]
+	Matrix4x4f MakePerspective(float halfWidth, float halfHeight)
+	{
+		return Matrix4x4f{
+			{ NEAR_PLANE / halfWidth, 0, 0, 0 },
+			{ 0, NEAR_PLANE / halfHeight, 0, 0 },
+			{ 0, 0, -FAR_PLANE / (FAR_PLANE - NEAR_PLANE), -(FAR_PLANE * NEAR_PLANE) / (FAR_PLANE - NEAR_PLANE) },
+			{ 0, 0, -1, 0 }
+		};
+	}
+
+	LightClusterGrid MakeGrid(const std::vector<Vector4f>& spheres)
+	{
+		LightClusterGrid grid;
+		grid.Setup(MakePerspective(0.16f, 0.09f), NEAR_PLANE, FAR_PLANE);
+		grid.SetLights(spheres.data(), static_cast<uint32_t>(spheres.size()));
+		grid.AssignSlices(0, LightClusterGrid::GRID_Z);
+		return grid;
+	}
+
+	bool HasLight(const LightClusterGrid& grid, const Vector3f& viewPosition, uint32_t light)
+	{
+		const auto& lights = grid.GetClusterLights(grid.GetClusterIndex(viewPosition));
+		return std::find(lights.begin(), lights.end(), light) != lights.end();
+	}
+}
+
+TEST_SUITE("LightClusterGrid")
+{
+	TEST_CASE("Slices grow exponentially from near to far")
+	{
+		LightClusterGrid grid;
+		grid.Setup(MakePerspective(0.16f, 0.09f), NEAR_PLANE, FAR_PLANE);
+
+		CHECK_EQ(grid.GetSliceDepth(0), doctest::Approx(NEAR_PLANE));
+		CHECK_EQ(grid.GetSliceDepth(LightClusterGrid::GRID_Z), doctest::Approx(FAR_PLANE));
+		CHECK_EQ(grid.GetSlice(NEAR_PLANE * 0.5f), 0);
+		CHECK_EQ(grid.GetSlice(FAR_PLANE * 2.0f), LightClusterGrid::GRID_Z - 1);
+
+		for (uint32_t slice = 0; slice < LightClusterGrid::GRID_Z; slice++)
+		{
+			const float middle = (grid.GetSliceDepth(slice) + grid.GetSliceDepth(slice + 1)) * 0.5f;
+			CHECK_EQ(grid.GetSlice(middle), slice);
+		}
+	}
+
+	TEST_CASE("Points find the clusters of lights around them")
+	{
+		const std::vector<Vector4f> spheres = {
+			{ 0.0f, 0.0f, -10.0f, 1.0f },
+			{ 5.0f, 2.0f, -20.0f, 3.0f },
+		};
+		const LightClusterGrid grid = MakeGrid(spheres);
+
+		CHECK(HasLight(grid, { 0.0f, 0.0f, -10.0f }, 0));
+		CHECK(HasLight(grid, { 0.9f, 0.0f, -10.0f }, 0));
+		CHECK(HasLight(grid, { 0.0f, 0.0f, -10.9f }, 0));
+		CHECK_FALSE(HasLight(grid, { 0.0f, 0.0f, -10.0f }, 1));
+
+		CHECK(HasLight(grid, { 5.0f, 2.0f, -20.0f }, 1));
+		CHECK(HasLight(grid, { 5.0f, 4.5f, -19.0f }, 1));
+
+		// Far away from both, in front and behind
+		CHECK(grid.GetClusterLights(grid.GetClusterIndex({ -3.0f, -1.5f, -10.0f })).empty());
+		CHECK(grid.GetClusterLights(grid.GetClusterIndex({ 0.0f, 0.0f, -60.0f })).empty());
+	}
+
+	TEST_CASE("Every point inside a light sees it")
+	{
+		std::mt19937 random(7);
+		std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+		std::vector<Vector4f> spheres;
+		for (int i = 0; i < 64; i++)
+		{
+			const float depth = 1.0f + (unit(random) * 0.5f + 0.5f) * 60.0f;
+			spheres.emplace_back(unit(random) * depth * 1.6f, unit(random) * depth * 0.9f, -depth,
+				0.2f + (unit(random) * 0.5f + 0.5f) * 5.0f);
+		}
+		const LightClusterGrid grid = MakeGrid(spheres);
+
+		bool allFound = true;
+		for (uint32_t light = 0; light < spheres.size(); light++)
+		{
+			const Vector4f& sphere = spheres[light];
+			for (int sample = 0; sample < 64; sample++)
+			{
+				const Vector3f offset(unit(random), unit(random), unit(random));
+				if (offset.Magnitude() > 1.0f)
+					continue;
+
+				const Vector3f point(sphere.x + offset.x * sphere.w, sphere.y + offset.y * sphere.w, sphere.z + offset.z * sphere.w);
+				if (-point.z < NEAR_PLANE || -point.z > FAR_PLANE)
+					continue;
+
+				// Only points on screen have a cluster
+				const float ndcX = point.x * NEAR_PLANE / 0.16f / -point.z;
+				const float ndcY = point.y * NEAR_PLANE / 0.09f / -point.z;
+				if (std::abs(ndcX) > 1.0f || std::abs(ndcY) > 1.0f)
+					continue;
+
+				allFound &= HasLight(grid, point, light);
+			}
+		}
+		CHECK(allFound);
+	}
+
+	TEST_CASE("Lights outside the depth range are dropped")
+	{
+		const std::vector<Vector4f> spheres = {
+			{ 0.0f, 0.0f, 5.0f, 1.0f },
+			{ 0.0f, 0.0f, -150.0f, 10.0f },
+			{ 0.0f, 0.0f, -10.0f, 0.0f },
+		};
+		const LightClusterGrid grid = MakeGrid(spheres);
+		CHECK_EQ(grid.GetIndexCount(), 0);
+	}
+
+	TEST_CASE("Write packs the cluster lists back to back")
+	{
+		const std::vector<Vector4f> spheres = {
+			{ 0.0f, 0.0f, -10.0f, 2.0f },
+			{ 1.0f, 0.0f, -10.0f, 2.0f },
+		};
+		const LightClusterGrid grid = MakeGrid(spheres);
+
+		std::vector<LightClusterGrid::ClusterRange> ranges(LightClusterGrid::CLUSTER_COUNT);
+		std::vector<uint32_t> indices(grid.GetIndexCount());
+		grid.Write(ranges.data(), indices.data());
+
+		bool matches = true;
+		uint32_t expectedOffset = 0;
+		for (uint32_t cluster = 0; cluster < LightClusterGrid::CLUSTER_COUNT; cluster++)
+		{
+			const auto& lights = grid.GetClusterLights(cluster);
+			matches &= ranges[cluster].offset == expectedOffset && ranges[cluster].count == lights.size();
+			for (uint32_t i = 0; i < lights.size(); i++)
+				matches &= indices[expectedOffset + i] == lights[i];
+			expectedOffset += static_cast<uint32_t>(lights.size());
+		}
+		CHECK(matches);
+		CHECK_EQ(expectedOffset, indices.size());
+		CHECK_GT(indices.size(), 0);
+	}
+
+	TEST_CASE("Slices assigned in parts match a single pass")
+	{
+		const std::vector<Vector4f> spheres = {
+			{ 0.0f, 0.0f, -3.0f, 2.5f },
+			{ -2.0f, 1.0f, -30.0f, 8.0f },
+		};
+		const LightClusterGrid single = MakeGrid(spheres);
+
+		LightClusterGrid parts;
+		parts.Setup(MakePerspective(0.16f, 0.09f), NEAR_PLANE, FAR_PLANE);
+		parts.SetLights(spheres.data(), static_cast<uint32_t>(spheres.size()));
+		for (uint32_t slice = 0; slice < LightClusterGrid::GRID_Z; slice += 5)
+			parts.AssignSlices(slice, slice + 5);
+
+		bool same = true;
+		for (uint32_t cluster = 0; cluster < LightClusterGrid::CLUSTER_COUNT; cluster++)
+			same &= single.GetClusterLights(cluster) == parts.GetClusterLights(cluster);
+		CHECK(same);
+	}
+}
@@ -0,0 +1,158 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+#include <vector>
+#include <Ailurus/Math/OcclusionBuffer.hpp>
+
+using namespace Ailurus;
+
+namespace
+{
+	constexpr uint32_t WIDTH = 64;
+	constexpr uint32_t HEIGHT = 32;
+
+	// Quad in normalized device coordinates, w = 1 so clip space equals NDC
+	struct Quad
+	{
+		std::vector<Vector4f> vertices;
+		std::vector<uint32_t> indices;
+	};
+
+	Quad MakeQuad(float minX, float minY, float maxX, float maxY, float depth)
+	{
+		Quad quad;
+		quad.vertices = {
+			{ minX, minY, depth, 1.0f },
+			{ maxX, minY, depth, 1.0f },
+			{ maxX, maxY, depth, 1.0f },
+			{ minX, maxY, depth, 1.0f },
+		};
+
+		// Second triangle wound the other way, both must fill
+		quad.indices = { 0, 1, 2, 0, 3, 2 };
+		return quad;
+	}
+
+	void Rasterize(OcclusionBuffer& buffer, const Quad& quad)
+	{
+		buffer.RasterizeTriangles(quad.vertices.data(), quad.indices.data(), static_cast<uint32_t>(quad.indices.size()), 0, HEIGHT);
+		buffer.BuildHierarchy();
+	}
+
+	AABBf MakeBox(float minX, float minY, float maxX, float maxY, float nearDepth, float farDepth)
+	{
+		return AABBf({ minX, minY, nearDepth }, { maxX, maxY, farDepth });
+	}
+}
+
+TEST_SUITE("OcclusionBuffer")
+{
+	TEST_CASE("Resize pads width and builds the mip chain")
+	{
+		OcclusionBuffer buffer;
+		buffer.Resize(62, 30);
+		CHECK_EQ(buffer.GetWidth(), 64);
+		CHECK_EQ(buffer.GetHeight(), 30);
+		CHECK_EQ(buffer.GetLevelCount(), 7);
+		CHECK_EQ(buffer.GetDepth(0, 10, 10), 1.0f);
+	}
+
+	TEST_CASE("Empty buffer occludes nothing")
+	{
+		OcclusionBuffer buffer;
+		buffer.Resize(WIDTH, HEIGHT);
+		buffer.BuildHierarchy();
+		CHECK(buffer.IsVisible(MakeBox(-0.5f, -0.5f, 0.5f, 0.5f, 0.9f, 0.95f), Matrix4x4f::Identity));
+	}
+
+	TEST_CASE("Full screen occluder hides boxes behind it")
+	{
+		OcclusionBuffer buffer;
+		buffer.Resize(WIDTH, HEIGHT);
+		Rasterize(buffer, MakeQuad(-1.0f, -1.0f, 1.0f, 1.0f, 0.5f));
+
+		CHECK_EQ(buffer.GetDepth(0, 0, 0), doctest::Approx(0.5f));
+		CHECK_EQ(buffer.GetDepth(0, WIDTH - 1, HEIGHT - 1), doctest::Approx(0.5f));
+		CHECK_EQ(buffer.GetDepth(buffer.GetLevelCount() - 1, 0, 0), doctest::Approx(0.5f));
+
+		// Behind, in front, straddling the occluder
+		CHECK_FALSE(buffer.IsVisible(MakeBox(-0.2f, -0.2f, 0.2f, 0.2f, 0.6f, 0.7f), Matrix4x4f::Identity));
+		CHECK(buffer.IsVisible(MakeBox(-0.2f, -0.2f, 0.2f, 0.2f, 0.3f, 0.4f), Matrix4x4f::Identity));
+		CHECK(buffer.IsVisible(MakeBox(-0.2f, -0.2f, 0.2f, 0.2f, 0.4f, 0.6f), Matrix4x4f::Identity));
+
+		// Large boxes go through coarse levels
+		CHECK_FALSE(buffer.IsVisible(MakeBox(-0.9f, -0.9f, 0.9f, 0.9f, 0.6f, 0.7f), Matrix4x4f::Identity));
+	}
+
+	TEST_CASE("Partial occluder keeps boxes reaching uncovered pixels")
+	{
+		OcclusionBuffer buffer;
+		buffer.Resize(WIDTH, HEIGHT);
+		Rasterize(buffer, MakeQuad(-1.0f, -1.0f, 0.0f, 1.0f, 0.5f));
+
+		CHECK_FALSE(buffer.IsVisible(MakeBox(-0.8f, -0.5f, -0.3f, 0.5f, 0.6f, 0.7f), Matrix4x4f::Identity));
+		CHECK(buffer.IsVisible(MakeBox(-0.3f, -0.5f, 0.3f, 0.5f, 0.6f, 0.7f), Matrix4x4f::Identity));
+		CHECK(buffer.IsVisible(MakeBox(0.2f, -0.5f, 0.6f, 0.5f, 0.6f, 0.7f), Matrix4x4f::Identity));
+	}
+
+	TEST_CASE("Depth is interpolated across the triangle")
+	{
+		OcclusionBuffer buffer;
+		buffer.Resize(WIDTH, HEIGHT);
+
+		Quad quad = MakeQuad(-1.0f, -1.0f, 1.0f, 1.0f, 0.0f);
+		quad.vertices[0].z = quad.vertices[3].z = 0.2f;
+		quad.vertices[1].z = quad.vertices[2].z = 0.8f;
+		Rasterize(buffer, quad);
+
+		CHECK_LT(buffer.GetDepth(0, 0, HEIGHT / 2), 0.22f);
+		CHECK_GT(buffer.GetDepth(0, WIDTH - 1, HEIGHT / 2), 0.78f);
+		CHECK_EQ(buffer.GetDepth(0, WIDTH / 2, HEIGHT / 2), doctest::Approx(0.5f).epsilon(0.02));
+	}
+
+	TEST_CASE("Triangles at the near plane are skipped")
+	{
+		OcclusionBuffer buffer;
+		buffer.Resize(WIDTH, HEIGHT);
+
+		Quad quad = MakeQuad(-1.0f, -1.0f, 1.0f, 1.0f, 0.5f);
+		quad.vertices[0].w = 0.0f;
+		Rasterize(buffer, quad);
+
+		// Only the triangle not using vertex 0 would remain, both use it
+		CHECK_EQ(buffer.GetDepth(0, WIDTH / 2, HEIGHT / 2), 1.0f);
+		CHECK(buffer.IsVisible(MakeBox(-0.2f, -0.2f, 0.2f, 0.2f, 0.6f, 0.7f), Matrix4x4f::Identity));
+	}
+
+	TEST_CASE("Row bands match a single pass")
+	{
+		const Quad quad = MakeQuad(-0.7f, -0.9f, 0.8f, 0.6f, 0.4f);
+
+		OcclusionBuffer single;
+		single.Resize(WIDTH, HEIGHT);
+		single.RasterizeTriangles(quad.vertices.data(), quad.indices.data(), 6, 0, HEIGHT);
+
+		OcclusionBuffer banded;
+		banded.Resize(WIDTH, HEIGHT);
+		for (uint32_t row = 0; row < HEIGHT; row += 5)
+		{
+			banded.ClearRows(row, row + 5);
+			banded.RasterizeTriangles(quad.vertices.data(), quad.indices.data(), 6, row, row + 5);
+		}
+
+		bool same = true;
+		for (uint32_t y = 0; y < HEIGHT; y++)
+			for (uint32_t x = 0; x < WIDTH; x++)
+				same &= single.GetDepth(0, x, y) == banded.GetDepth(0, x, y);
+		CHECK(same);
+	}
+
+	TEST_CASE("Boxes reaching the camera are visible")
+	{
+		OcclusionBuffer buffer;
+		buffer.Resize(WIDTH, HEIGHT);
+		Rasterize(buffer, MakeQuad(-1.0f, -1.0f, 1.0f, 1.0f, 0.5f));
+
+		CHECK(buffer.IsVisible(MakeBox(-0.2f, -0.2f, 0.2f, 0.2f, -0.1f, 0.7f), Matrix4x4f::Identity));
+	}
+}
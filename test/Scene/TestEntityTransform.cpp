@@ -0,0 +1,59 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+#include <Ailurus/Systems/SceneSystem/Entity/Entity.h>
+
+using namespace Ailurus;
+
+static void CheckWorldPosition(const Entity& entity, const Vector3f& expected)
+{
+	const Vector4f translation = entity.GetModelMatrix().GetCol(3);
+	CHECK(translation.x == doctest::Approx(expected.x));
+	CHECK(translation.y == doctest::Approx(expected.y));
+	CHECK(translation.z == doctest::Approx(expected.z));
+}
+
+TEST_SUITE("EntityTransform")
+{
+	TEST_CASE("Local matrix cache follows transform changes")
+	{
+		Entity entity(1);
+		CHECK(entity.GetModelMatrix() == Matrix4x4f::Identity);
+
+		entity.SetPosition({ 1.0f, 2.0f, 3.0f });
+		CheckWorldPosition(entity, { 1.0f, 2.0f, 3.0f });
+
+		entity.SetPosition({ -1.0f, 0.0f, 0.0f });
+		CheckWorldPosition(entity, { -1.0f, 0.0f, 0.0f });
+	}
+
+	TEST_CASE("Parent changes propagate to descendants")
+	{
+		Entity root(1);
+		Entity child(2);
+		Entity grandChild(3);
+
+		child.SetParent(&root);
+		grandChild.SetParent(&child);
+
+		root.SetPosition({ 10.0f, 0.0f, 0.0f });
+		child.SetPosition({ 0.0f, 5.0f, 0.0f });
+		grandChild.SetPosition({ 0.0f, 0.0f, 1.0f });
+		CheckWorldPosition(grandChild, { 10.0f, 5.0f, 1.0f });
+
+		// Matrices are cached now, moving the root must still reach the grandchild
+		root.SetPosition({ 20.0f, 0.0f, 0.0f });
+		CheckWorldPosition(child, { 20.0f, 5.0f, 0.0f });
+		CheckWorldPosition(grandChild, { 20.0f, 5.0f, 1.0f });
+
+		root.SetScale({ 2.0f, 2.0f, 2.0f });
+		CheckWorldPosition(grandChild, { 20.0f, 10.0f, 2.0f });
+
+		// Reparent directly under the root
+		grandChild.SetParent(&root);
+		CheckWorldPosition(grandChild, { 20.0f, 0.0f, 2.0f });
+
+		grandChild.SetParent(nullptr);
+		CheckWorldPosition(grandChild, { 0.0f, 0.0f, 1.0f });
+	}
+}
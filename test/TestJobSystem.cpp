@@ -0,0 +1,281 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include <vector>
+#include "Ailurus/Container/WorkStealingDeque.hpp"
+#include "Ailurus/Systems/JobSystem/JobSystem.h"
+
+using namespace Ailurus;
+
+TEST_SUITE("WorkStealingDeque")
+{
+    TEST_CASE("Owner push pop is LIFO")
+    {
+        WorkStealingDeque<int, 8> deque;
+        CHECK_EQ(deque.GetSize(), 8);
+        CHECK(deque.Empty());
+
+        for (int i = 0; i < 8; i++)
+            CHECK(deque.Push(i));
+
+        // Full
+        CHECK_FALSE(deque.Push(8));
+
+        for (int i = 7; i >= 0; i--)
+        {
+            auto value = deque.Pop();
+            REQUIRE(value.has_value());
+            CHECK_EQ(*value, i);
+        }
+
+        CHECK_FALSE(deque.Pop().has_value());
+        CHECK(deque.Empty());
+    }
+
+    TEST_CASE("Steal is FIFO")
+    {
+        WorkStealingDeque<int, 8> deque;
+        deque.Push(1);
+        deque.Push(2);
+        deque.Push(3);
+
+        CHECK_EQ(*deque.Steal(), 1);
+        CHECK_EQ(*deque.Pop(), 3);
+        CHECK_EQ(*deque.Steal(), 2);
+        CHECK_FALSE(deque.Steal().has_value());
+    }
+
+    TEST_CASE("Concurrent steal")
+    {
+        constexpr int COUNT = 100000;
+        constexpr int THIEF_COUNT = 4;
+
+        WorkStealingDeque<int, 1024> deque;
+        std::atomic<bool> done = false;
+        std::atomic<int64_t> stolenSum = 0;
+        std::atomic<int> stolenCount = 0;
+
+        std::vector<std::thread> thieves;
+        for (int t = 0; t < THIEF_COUNT; t++)
+        {
+            thieves.emplace_back([&]() {
+                while (!done.load() || !deque.Empty())
+                {
+                    if (auto value = deque.Steal())
+                    {
+                        stolenSum += *value;
+                        stolenCount++;
+                    }
+                }
+            });
+        }
+
+        int64_t ownerSum = 0;
+        int ownerCount = 0;
+        for (int i = 1; i <= COUNT; i++)
+        {
+            while (!deque.Push(i))
+            {
+                if (auto value = deque.Pop())
+                {
+                    ownerSum += *value;
+                    ownerCount++;
+                }
+            }
+        }
+
+        while (auto value = deque.Pop())
+        {
+            ownerSum += *value;
+            ownerCount++;
+        }
+
+        done = true;
+        for (auto& thief : thieves)
+            thief.join();
+
+        CHECK_EQ(ownerCount + stolenCount.load(), COUNT);
+        CHECK_EQ(ownerSum + stolenSum.load(), static_cast<int64_t>(COUNT) * (COUNT + 1) / 2);
+    }
+}
+
+TEST_SUITE("JobSystem")
+{
+    TEST_CASE("Thread index")
+    {
+        JobSystem jobSystem(3);
+        CHECK_EQ(jobSystem.GetWorkerCount(), 3);
+        CHECK_EQ(jobSystem.GetThreadCount(), 4);
+        CHECK(jobSystem.IsMainThread());
+        CHECK_EQ(jobSystem.GetCurrentThreadIndex(), JobSystem::MAIN_THREAD_INDEX);
+
+        std::atomic<bool> allValid = true;
+        JobCounter counter;
+        for (int i = 0; i < 64; i++)
+        {
+            jobSystem.Schedule([&]() {
+                if (jobSystem.GetCurrentThreadIndex() >= jobSystem.GetThreadCount())
+                    allValid = false;
+            }, &counter);
+        }
+        jobSystem.Wait(&counter);
+
+        CHECK(allValid.load());
+
+        uint32_t foreignIndex = 0;
+        std::thread([&]() { foreignIndex = jobSystem.GetCurrentThreadIndex(); }).join();
+        CHECK_EQ(foreignIndex, JobSystem::INVALID_THREAD_INDEX);
+    }
+
+    TEST_CASE("Schedule and wait")
+    {
+        JobSystem jobSystem(4);
+
+        constexpr int COUNT = 10000;
+        std::atomic<int> executed = 0;
+        JobCounter counter;
+        for (int i = 0; i < COUNT; i++)
+            jobSystem.Schedule([&]() { executed++; }, &counter);
+
+        jobSystem.Wait(&counter);
+
+        CHECK(counter.IsDone());
+        CHECK_EQ(executed.load(), COUNT);
+    }
+
+    TEST_CASE("Single worker")
+    {
+        JobSystem jobSystem(1);
+
+        std::atomic<int> executed = 0;
+        JobCounter counter;
+        for (int i = 0; i < 100; i++)
+            jobSystem.Schedule([&]() { executed++; }, &counter);
+
+        jobSystem.Wait(&counter);
+        CHECK_EQ(executed.load(), 100);
+    }
+
+    TEST_CASE("Parallel for")
+    {
+        JobSystem jobSystem(4);
+
+        constexpr uint32_t COUNT = 100003;
+        std::vector<uint32_t> data(COUNT, 0);
+        jobSystem.ParallelFor(COUNT, 1000, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++)
+                data[i] = i;
+        });
+
+        bool allSet = true;
+        for (uint32_t i = 0; i < COUNT; i++)
+            allSet &= data[i] == i;
+
+        CHECK(allSet);
+    }
+
+    TEST_CASE("Dependencies")
+    {
+        JobSystem jobSystem(4);
+
+        std::atomic<int> first = 0;
+        std::atomic<bool> orderCorrect = true;
+
+        JobCounter firstCounter;
+        JobCounter secondCounter;
+
+        // Continuation registered before the dependency has any job
+        for (int i = 0; i < 100; i++)
+        {
+            jobSystem.Schedule([&]() {
+                std::this_thread::yield();
+                first++;
+            }, &firstCounter);
+        }
+
+        jobSystem.ScheduleAfter(&firstCounter, [&]() {
+            if (first.load() != 100)
+                orderCorrect = false;
+        }, &secondCounter);
+
+        jobSystem.Wait(&secondCounter);
+
+        CHECK(orderCorrect.load());
+        CHECK(firstCounter.IsDone());
+
+        // Dependency already done, runs immediately
+        std::atomic<bool> ran = false;
+        jobSystem.ScheduleAfter(&firstCounter, [&]() { ran = true; }, &secondCounter);
+        jobSystem.Wait(&secondCounter);
+        CHECK(ran.load());
+    }
+
+    TEST_CASE("Nested jobs")
+    {
+        JobSystem jobSystem(4);
+
+        std::atomic<int> executed = 0;
+        JobCounter outer;
+        for (int i = 0; i < 16; i++)
+        {
+            jobSystem.Schedule([&]() {
+                JobCounter inner;
+                for (int j = 0; j < 16; j++)
+                    jobSystem.Schedule([&]() { executed++; }, &inner);
+                jobSystem.Wait(&inner);
+            }, &outer);
+        }
+
+        jobSystem.Wait(&outer);
+        CHECK_EQ(executed.load(), 16 * 16);
+    }
+
+    TEST_CASE("Main thread jobs")
+    {
+        JobSystem jobSystem(2);
+
+        std::atomic<bool> ranOnMainThread = true;
+        std::atomic<int> executed = 0;
+
+        JobCounter mainCounter;
+        JobCounter workerCounter;
+        for (int i = 0; i < 32; i++)
+        {
+            jobSystem.Schedule([&]() {
+                jobSystem.RunOnMainThread([&]() {
+                    if (!jobSystem.IsMainThread())
+                        ranOnMainThread = false;
+                    executed++;
+                }, &mainCounter);
+            }, &workerCounter);
+        }
+
+        jobSystem.Wait(&workerCounter);
+        jobSystem.PumpMainThreadJobs();
+        jobSystem.Wait(&mainCounter);
+
+        CHECK(ranOnMainThread.load());
+        CHECK_EQ(executed.load(), 32);
+    }
+
+    TEST_CASE("Wait does not run main thread jobs")
+    {
+        JobSystem jobSystem(2);
+
+        std::atomic<int> executed = 0;
+        jobSystem.RunOnMainThread([&]() { executed++; });
+
+        std::atomic<int> sum = 0;
+        jobSystem.ParallelFor(1000, 10, [&](uint32_t begin, uint32_t end) {
+            sum += static_cast<int>(end - begin);
+        });
+
+        CHECK_EQ(sum.load(), 1000);
+        CHECK_EQ(executed.load(), 0);
+
+        jobSystem.PumpMainThreadJobs();
+        CHECK_EQ(executed.load(), 1);
+    }
+}
@@ -0,0 +1,222 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+#include <array>
+#include <cmath>
+#include <map>
+#include <vector>
+#include "Ailurus/Utility/MeshSimplifier.h"
+
+using namespace Ailurus;
+
+namespace
+{
+    struct TestMesh
+    {
+        std::vector<std::array<float, 3>> positions;
+        std::vector<uint32_t> indices;
+
+        uint32_t VertexCount() const { return static_cast<uint32_t>(positions.size()); }
+        uint32_t IndexCount() const { return static_cast<uint32_t>(indices.size()); }
+    };
+
+    // Flat grid in the xy plane, every vertex unique, open border all around
+    TestMesh MakeGrid(uint32_t cells)
+    {
+        TestMesh mesh;
+        for (uint32_t y = 0; y <= cells; y++)
+            for (uint32_t x = 0; x <= cells; x++)
+                mesh.positions.push_back({ static_cast<float>(x), static_cast<float>(y), 0.0f });
+
+        const uint32_t row = cells + 1;
+        for (uint32_t y = 0; y < cells; y++)
+        {
+            for (uint32_t x = 0; x < cells; x++)
+            {
+                const uint32_t i = y * row + x;
+                mesh.indices.insert(mesh.indices.end(), { i, i + 1, i + row + 1, i, i + row + 1, i + row });
+            }
+        }
+        return mesh;
+    }
+
+    // Closed unit sphere from a subdivided octahedron, vertices shared between triangles
+    TestMesh MakeSphere(uint32_t subdivisions)
+    {
+        TestMesh mesh;
+        mesh.positions = { { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+        mesh.indices = { 0, 2, 4, 2, 1, 4, 1, 3, 4, 3, 0, 4, 2, 0, 5, 1, 2, 5, 3, 1, 5, 0, 3, 5 };
+
+        for (uint32_t s = 0; s < subdivisions; s++)
+        {
+            std::map<std::pair<uint32_t, uint32_t>, uint32_t> midpoints;
+            auto midpoint = [&mesh, &midpoints](uint32_t a, uint32_t b) -> uint32_t {
+                const auto key = std::make_pair(std::min(a, b), std::max(a, b));
+                const auto itr = midpoints.find(key);
+                if (itr != midpoints.end())
+                    return itr->second;
+
+                std::array<float, 3> p;
+                for (int i = 0; i < 3; i++)
+                    p[i] = (mesh.positions[a][i] + mesh.positions[b][i]) * 0.5f;
+                const float length = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+                for (float& value : p)
+                    value /= length;
+
+                mesh.positions.push_back(p);
+                return midpoints[key] = mesh.VertexCount() - 1;
+            };
+
+            std::vector<uint32_t> indices;
+            for (size_t t = 0; t < mesh.indices.size(); t += 3)
+            {
+                const uint32_t a = mesh.indices[t], b = mesh.indices[t + 1], c = mesh.indices[t + 2];
+                const uint32_t ab = midpoint(a, b), bc = midpoint(b, c), ca = midpoint(c, a);
+                indices.insert(indices.end(), { a, ab, ca, ab, b, bc, ca, bc, c, ab, bc, ca });
+            }
+            mesh.indices = std::move(indices);
+        }
+        return mesh;
+    }
+
+    std::vector<uint32_t> Simplify(const TestMesh& mesh, uint32_t targetIndexCount, float maxError, float* pError = nullptr)
+    {
+        return MeshSimplifier::Simplify(mesh.positions[0].data(), mesh.VertexCount(), sizeof(float) * 3,
+            mesh.indices.data(), mesh.IndexCount(), targetIndexCount, maxError, pError);
+    }
+
+    bool IsValidTriangleList(const std::vector<uint32_t>& indices, uint32_t vertexCount)
+    {
+        if (indices.size() % 3 != 0)
+            return false;
+
+        for (size_t t = 0; t < indices.size(); t += 3)
+        {
+            const uint32_t a = indices[t], b = indices[t + 1], c = indices[t + 2];
+            if (a >= vertexCount || b >= vertexCount || c >= vertexCount || a == b || b == c || a == c)
+                return false;
+        }
+        return true;
+    }
+
+    std::array<float, 3> FaceNormal(const TestMesh& mesh, uint32_t a, uint32_t b, uint32_t c)
+    {
+        const auto& pa = mesh.positions[a];
+        const auto& pb = mesh.positions[b];
+        const auto& pc = mesh.positions[c];
+        const float e1[3] = { pb[0] - pa[0], pb[1] - pa[1], pb[2] - pa[2] };
+        const float e2[3] = { pc[0] - pa[0], pc[1] - pa[1], pc[2] - pa[2] };
+        return { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+    }
+}
+
+TEST_SUITE("MeshSimplifier")
+{
+    TEST_CASE("Target above the input returns it unchanged")
+    {
+        const TestMesh mesh = MakeSphere(1);
+        const auto result = Simplify(mesh, mesh.IndexCount(), 1.0f);
+        CHECK_EQ(result, mesh.indices);
+    }
+
+    TEST_CASE("Closed sphere reaches the target and keeps its orientation")
+    {
+        const TestMesh mesh = MakeSphere(3);
+        const uint32_t target = mesh.IndexCount() / 4;
+
+        float error = -1.0f;
+        const auto result = Simplify(mesh, target, 1.0f, &error);
+
+        CHECK(IsValidTriangleList(result, mesh.VertexCount()));
+        CHECK_LE(result.size(), target);
+        CHECK_GT(result.size(), 0);
+        CHECK_GT(error, 0.0f);
+        CHECK_LT(error, 0.2f);
+
+        // Outward facing triangles stay outward facing, thin slivers may end up edge on
+        bool outward = true;
+        for (size_t t = 0; t < result.size(); t += 3)
+        {
+            const auto normal = FaceNormal(mesh, result[t], result[t + 1], result[t + 2]);
+            const auto& p = mesh.positions[result[t]];
+            const float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+            outward &= normal[0] * p[0] + normal[1] * p[1] + normal[2] * p[2] > -0.01f * length;
+        }
+        CHECK(outward);
+    }
+
+    TEST_CASE("Error limit stops the collapses")
+    {
+        const TestMesh mesh = MakeSphere(3);
+
+        float error = -1.0f;
+        const auto result = Simplify(mesh, 0, 1e-4f, &error);
+        CHECK_EQ(result.size(), mesh.indices.size());
+        CHECK_EQ(error, 0.0f);
+
+        const auto looser = Simplify(mesh, 0, 0.05f, &error);
+        CHECK_LT(looser.size(), mesh.indices.size());
+        CHECK_LE(error, 0.05f);
+    }
+
+    TEST_CASE("Flat interior collapses for free, the border stays")
+    {
+        const TestMesh mesh = MakeGrid(8);
+
+        float error = -1.0f;
+        const auto result = Simplify(mesh, 0, 1e-3f, &error);
+        CHECK(IsValidTriangleList(result, mesh.VertexCount()));
+        CHECK_LT(result.size(), mesh.indices.size() / 2);
+        CHECK_EQ(error, doctest::Approx(0.0f));
+
+        // Every border vertex is still referenced
+        std::vector<bool> used(mesh.VertexCount(), false);
+        for (const uint32_t index : result)
+            used[index] = true;
+
+        bool bordersKept = true;
+        for (uint32_t i = 0; i < mesh.VertexCount(); i++)
+        {
+            const auto& p = mesh.positions[i];
+            if (p[0] == 0.0f || p[1] == 0.0f || p[0] == 8.0f || p[1] == 8.0f)
+                bordersKept &= used[i];
+        }
+        CHECK(bordersKept);
+    }
+
+    TEST_CASE("Seam vertices are not moved")
+    {
+        // Two halves of a grid share the middle column by position only, like a texture seam
+        TestMesh mesh = MakeGrid(8);
+        const uint32_t row = 9;
+        const uint32_t firstDuplicate = mesh.VertexCount();
+        for (uint32_t y = 0; y < row; y++)
+            mesh.positions.push_back(mesh.positions[y * row + 4]);
+
+        for (size_t i = 0; i < mesh.indices.size(); i += 3)
+        {
+            // Triangles right of the seam use the duplicated column
+            const uint32_t a = mesh.indices[i], b = mesh.indices[i + 1], c = mesh.indices[i + 2];
+            if (a % row < 4 || b % row < 4 || c % row < 4)
+                continue;
+
+            for (size_t j = i; j < i + 3; j++)
+            {
+                if (mesh.indices[j] % row == 4)
+                    mesh.indices[j] = firstDuplicate + mesh.indices[j] / row;
+            }
+        }
+
+        const auto result = Simplify(mesh, 0, 1e-3f);
+        CHECK(IsValidTriangleList(result, mesh.VertexCount()));
+        CHECK_LT(result.size(), mesh.indices.size());
+
+        std::vector<bool> used(mesh.VertexCount(), false);
+        for (const uint32_t index : result)
+            used[index] = true;
+
+        bool seamKept = true;
+        for (uint32_t y = 0; y < row; y++)
+            seamKept &= used[y * row + 4] && used[firstDuplicate + y];
+        CHECK(seamKept);
+    }
+}
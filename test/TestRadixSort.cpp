@@ -0,0 +1,129 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+#include "Ailurus/Utility/RadixSort.h"
+
+using namespace Ailurus;
+
+namespace
+{
+    struct Item
+    {
+        uint64_t key;
+        uint32_t order;
+    };
+
+    std::vector<Item> MakeItems(size_t count, uint64_t keyMask, uint32_t seed)
+    {
+        std::mt19937_64 random(seed);
+        std::vector<Item> items(count);
+        for (size_t i = 0; i < count; i++)
+            items[i] = Item{ random() & keyMask, static_cast<uint32_t>(i) };
+        return items;
+    }
+
+    bool IsSortedAndStable(const std::vector<Item>& items)
+    {
+        for (size_t i = 1; i < items.size(); i++)
+        {
+            if (items[i - 1].key > items[i].key)
+                return false;
+            if (items[i - 1].key == items[i].key && items[i - 1].order > items[i].order)
+                return false;
+        }
+        return true;
+    }
+}
+
+TEST_SUITE("RadixSort")
+{
+    TEST_CASE("Empty and single")
+    {
+        std::vector<Item> scratch;
+        std::vector<Item> items;
+        RadixSort(items, scratch, [](const Item& item) { return item.key; });
+        CHECK(items.empty());
+
+        items.push_back(Item{ 42, 0 });
+        RadixSort(items, scratch, [](const Item& item) { return item.key; });
+        REQUIRE_EQ(items.size(), 1);
+        CHECK_EQ(items[0].key, 42);
+    }
+
+    TEST_CASE("Small input")
+    {
+        std::vector<Item> scratch;
+        auto items = MakeItems(50, 0xFF, 1);
+        RadixSort(items, scratch, [](const Item& item) { return item.key; });
+        CHECK(IsSortedAndStable(items));
+    }
+
+    TEST_CASE("Full 64-bit keys")
+    {
+        std::vector<Item> scratch;
+        auto items = MakeItems(10000, ~uint64_t(0), 2);
+        auto expected = items;
+        std::stable_sort(expected.begin(), expected.end(), [](const Item& lhs, const Item& rhs) { return lhs.key < rhs.key; });
+
+        RadixSort(items, scratch, [](const Item& item) { return item.key; });
+
+        CHECK(IsSortedAndStable(items));
+        bool same = true;
+        for (size_t i = 0; i < items.size(); i++)
+            same &= items[i].order == expected[i].order;
+        CHECK(same);
+    }
+
+    TEST_CASE("Stable with duplicate keys")
+    {
+        std::vector<Item> scratch;
+        auto items = MakeItems(5000, 0x7, 3);
+        RadixSort(items, scratch, [](const Item& item) { return item.key; });
+        CHECK(IsSortedAndStable(items));
+    }
+
+    TEST_CASE("Sparse key bits")
+    {
+        // Only high and low bytes vary, middle passes are skipped
+        std::vector<Item> scratch;
+        auto items = MakeItems(3000, 0xFF000000000000FFull, 4);
+        RadixSort(items, scratch, [](const Item& item) { return item.key; });
+        CHECK(IsSortedAndStable(items));
+    }
+
+    TEST_CASE("Identical keys")
+    {
+        std::vector<Item> scratch;
+        auto items = MakeItems(1000, 0, 5);
+        RadixSort(items, scratch, [](const Item& item) { return item.key; });
+        CHECK(IsSortedAndStable(items));
+        CHECK_EQ(items.front().order, 0);
+        CHECK_EQ(items.back().order, 999);
+    }
+}
+
+TEST_SUITE("RadixSortBenchmark" * doctest::skip())
+{
+    TEST_CASE("Radix vs std::sort")
+    {
+        constexpr size_t COUNT = 100000;
+        const auto source = MakeItems(COUNT, ~uint64_t(0), 6);
+
+        auto items = source;
+        std::vector<Item> scratch;
+        auto start = std::chrono::steady_clock::now();
+        RadixSort(items, scratch, [](const Item& item) { return item.key; });
+        const auto radixTime = std::chrono::steady_clock::now() - start;
+
+        items = source;
+        start = std::chrono::steady_clock::now();
+        std::sort(items.begin(), items.end(), [](const Item& lhs, const Item& rhs) { return lhs.key < rhs.key; });
+        const auto stdTime = std::chrono::steady_clock::now() - start;
+
+        MESSAGE("RadixSort " << COUNT << " items: " << std::chrono::duration<double, std::milli>(radixTime).count()
+            << " ms, std::sort: " << std::chrono::duration<double, std::milli>(stdTime).count() << " ms");
+    }
+}